@@ -112,11 +112,19 @@ DrlEMImpl::DrlEMImpl() : jh(NULL), _execute_method(NULL), method_lookup_table()
     nMethodsRecompiled=0;
     tick=0;
     port_mutex_create(&recompilationLock, APR_THREAD_MUTEX_NESTED);
+    nCompilationThreads=0;
+    compilationThreadsStopped=false;
+    hycond_create(&recompilationQueueCond);
+    nRequestsQueued=0;
+    maxQueueLength=0;
+    totalQueueLatency=0;
+    maxQueueLatency=0;
     initProfileAccess();
 }
 
 DrlEMImpl::~DrlEMImpl() {
     deallocateResources();
+    hycond_destroy(&recompilationQueueCond);
     port_mutex_destroy(&recompilationLock);
 }
 
@@ -133,6 +141,9 @@ void DrlEMImpl::initProfileAccess() {
     profileAccessInterface.eb_profiler_get_entry_threshold = eb_profiler_get_entry_threshold;
     profileAccessInterface.eb_profiler_sync_mode_callback = (void (*)(Method_Profile_Handle))vm_create_helper_for_function((void *(*)(void *))eb_profiler_sync_mode_callback);
     profileAccessInterface.eb_profiler_get_backedge_threshold = eb_profiler_get_backedge_threshold;
+    profileAccessInterface.eb_profiler_get_osr_pc_addr = eb_profiler_get_osr_pc_addr;
+    profileAccessInterface.eb_profiler_get_osr_entry_pc_addr = eb_profiler_get_osr_entry_pc_addr;
+    profileAccessInterface.eb_profiler_osr_callback = (void* (*)(Method_Profile_Handle))vm_create_helper_for_function((void *(*)(void *))eb_profiler_osr_callback);
 
     
     //EDGE profile
@@ -361,6 +372,7 @@ bool DrlEMImpl::init() {
     std::string config = readConfiguration();
     if (!config.empty()) {
         buildChains(config);
+        initCompilationThreads(config);
     }
     return !chains.empty();
 }
@@ -513,6 +525,10 @@ void DrlEMImpl::buildChains(std::string& config) {
 }
 
 void DrlEMImpl::deinit() {
+    compilationThreadsShutdown();
+    if (nCompilationThreads > 0 && log_is_info_enabled(LOG_DOMAIN)) {
+        logCompilationQueueStats();
+    }
 }
 
 //______________________________________________________________________________
@@ -587,6 +603,20 @@ static U_32 toNum(const std::string& numStr, bool *rc ) {
     return 0;
 }
 
+void DrlEMImpl::initCompilationThreads(const std::string& config) {
+    std::string value = getParam(config, "compilationThreads");
+    if (value.empty()) {
+        return;
+    }
+    bool ok = false;
+    U_32 n = toNum(value, &ok);
+    if (!ok) {
+        LECHO(9, "EM: illegal '{0}' value" << "compilationThreads");
+        return;
+    }
+    nCompilationThreads = n;
+}
+
 ProfileCollector* DrlEMImpl::createProfileCollector(const std::string& profilerName, const std::string& config, RStep* step)  {
     ProfileCollector* pc = getProfileCollector(profilerName);
     if (pc != NULL){
@@ -778,19 +808,101 @@ void DrlEMImpl::methodProfileIsReady(MethodProfile* mp) {
     
     port_mutex_lock(&recompilationLock);
     if (methodsInRecompile.find((Method_Profile_Handle)mp)!=methodsInRecompile.end()) {
-        //method is already recompiling by another thread or by this thread(recursion)
+        //method is already recompiling (or queued) by another thread or by this thread(recursion)
         port_mutex_unlock(&recompilationLock);
         return;
     }
     
     methodsInRecompile.insert((Method_Profile_Handle)mp);
     nMethodsRecompiled++;
+    size_t n = nMethodsRecompiled;
+
+    if (nCompilationThreads > 0 && !compilationThreadsStopped) {
+        //leave the compilation to the background threads, hottest methods go first
+        RecompilationRequest req;
+        req.mp = mp;
+        req.n = n;
+        req.hotness = mp->getHotness();
+        req.enqueueTime = apr_time_now();
+        recompilationQueue.push_back(req);
+        std::push_heap(recompilationQueue.begin(), recompilationQueue.end());
+
+        nRequestsQueued++;
+        maxQueueLength = std::max(maxQueueLength, recompilationQueue.size());
+        hycond_notify(&recompilationQueueCond);
+        port_mutex_unlock(&recompilationLock);
+        return;
+    }
     port_mutex_unlock(&recompilationLock);
 
+    recompileMethod(mp, n);
+
+    port_mutex_lock(&recompilationLock);
+    methodsInRecompile.erase((Method_Profile_Handle)mp);
+    port_mutex_unlock(&recompilationLock);
+}
+
+void* DrlEMImpl::compileOsrEntry(MethodProfile* mp) {
+    RStep* nextStep = getNextStep(mp->pc->genJit);
+    if (nextStep == NULL || mp->pc->type != EM_PCTYPE_ENTRY_BACKEDGE) {
+        return NULL;
+    }
+    EBMethodProfile* ebmp = (EBMethodProfile*)mp;
+
+    //the frame asking for OSR waits for the compilation, so it is never left to the background threads
+    if (method_get_code_block_addr_jit_new(mp->mh, nextStep->jit, 0) == NULL) {
+        port_mutex_lock(&recompilationLock);
+        size_t n = 0;
+        if (methodsInRecompile.find((Method_Profile_Handle)mp)!=methodsInRecompile.end()) {
+            RecompilationQueue::iterator it = recompilationQueue.begin(), end = recompilationQueue.end();
+            while (it != end && it->mp != mp) {
+                ++it;
+            }
+            if (it == end) {
+                //compiling by another thread, this frame goes on with the current code
+                port_mutex_unlock(&recompilationLock);
+                return NULL;
+            }
+            n = it->n;
+            recompilationQueue.erase(it);
+            std::make_heap(recompilationQueue.begin(), recompilationQueue.end());
+        } else {
+            methodsInRecompile.insert((Method_Profile_Handle)mp);
+            nMethodsRecompiled++;
+            n = nMethodsRecompiled;
+        }
+        port_mutex_unlock(&recompilationLock);
+
+        recompileMethod(mp, n);
+
+        port_mutex_lock(&recompilationLock);
+        methodsInRecompile.erase((Method_Profile_Handle)mp);
+        port_mutex_unlock(&recompilationLock);
+    }
+
+    if (ebmp->osrEntryPc == EM_NO_OSR_PC || ebmp->osrEntryPc != ebmp->osrPc) {
+        return NULL;
+    }
+    return method_get_code_block_addr_jit_new(mp->mh, nextStep->jit, 0);
+}
+
+RStep* DrlEMImpl::getNextStep(JIT_Handle jit) const {
+    for (RChains::const_iterator it = chains.begin(), end = chains.end(); it!=end; ++it) {
+        RChain* chain = *it;
+        for (RSteps::const_iterator sit = chain->steps.begin(), send = chain->steps.end(); sit!=send; ++sit) {
+            if ((*sit)->jit == jit) {
+                ++sit;
+                return sit!=send ? *sit : NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+void DrlEMImpl::recompileMethod(MethodProfile* mp, size_t n) {
     const char* methodName = NULL;
     const char* className = NULL;
     const char* signature = NULL;
-    size_t n = nMethodsRecompiled;
 
     JIT_Handle jit = mp->pc->genJit;
     for (RChains::const_iterator it = chains.begin(), end = chains.end(); it!=end; ++it) {
@@ -829,11 +941,55 @@ void DrlEMImpl::methodProfileIsReady(MethodProfile* mp) {
             }
         }
     }
+}
+
+void DrlEMImpl::compilationThreadRun() {
     port_mutex_lock(&recompilationLock);
-    methodsInRecompile.erase((Method_Profile_Handle)mp);
+    while (!compilationThreadsStopped) {
+        if (recompilationQueue.empty()) {
+            hycond_wait(&recompilationQueueCond, &recompilationLock);
+            continue;
+        }
+        std::pop_heap(recompilationQueue.begin(), recompilationQueue.end());
+        RecompilationRequest req = recompilationQueue.back();
+        recompilationQueue.pop_back();
+
+        apr_time_t latency = apr_time_now() - req.enqueueTime;
+        totalQueueLatency += latency;
+        maxQueueLatency = std::max(maxQueueLatency, latency);
+        port_mutex_unlock(&recompilationLock);
+
+        recompileMethod(req.mp, req.n);
+
+        port_mutex_lock(&recompilationLock);
+        methodsInRecompile.erase((Method_Profile_Handle)req.mp);
+    }
     port_mutex_unlock(&recompilationLock);
 }
 
+void DrlEMImpl::compilationThreadsShutdown() {
+    port_mutex_lock(&recompilationLock);
+    compilationThreadsStopped = true;
+    //the requests left are dropped: nobody is going to run the recompiled code
+    for (RecompilationQueue::const_iterator it = recompilationQueue.begin(), end = recompilationQueue.end(); it!=end; ++it) {
+        methodsInRecompile.erase((Method_Profile_Handle)it->mp);
+    }
+    recompilationQueue.clear();
+    hycond_notify_all(&recompilationQueueCond);
+    port_mutex_unlock(&recompilationLock);
+}
+
+void DrlEMImpl::logCompilationQueueStats() const {
+    size_t nDone = nRequestsQueued - recompilationQueue.size();
+    std::ostringstream msg;
+    msg << "EM: compilation threads: " << nCompilationThreads
+        << ", requests queued: " << nRequestsQueued
+        << ", max queue length: " << maxQueueLength
+        << ", avg queue latency: " << (nDone == 0 ? 0 : totalQueueLatency / nDone) << "us"
+        << ", max queue latency: " << maxQueueLatency << "us";
+    INFO2(LOG_DOMAIN, msg.str().c_str());
+}
+
 ProfileCollector* DrlEMImpl::getProfileCollector(EM_PCTYPE type, JIT_Handle jh, EM_JIT_PC_Role jitRole) const {
     for (ProfileCollectors::const_iterator it = collectors.begin(), end = collectors.end(); it!=end; ++it) {
         ProfileCollector* pc = *it;
@@ -876,6 +1032,22 @@ int DrlEMImpl::getTbsTimeout() const {
 
 void DrlEMImpl::classloaderUnloadingCallback(Class_Loader_Handle class_handle) {
     //notify every profile collector about classloader unloading
+
+    //queued profiles of the unloaded classes must not be compiled
+    port_mutex_lock(&recompilationLock);
+    RecompilationQueue::iterator last = recompilationQueue.begin();
+    for (RecompilationQueue::iterator it = recompilationQueue.begin(), end = recompilationQueue.end(); it!=end; ++it) {
+        if (class_get_class_loader(method_get_class(it->mp->mh)) == class_handle) {
+            methodsInRecompile.erase((Method_Profile_Handle)it->mp);
+        } else {
+            *last++ = *it;
+        }
+    }
+    if (last != recompilationQueue.end()) {
+        recompilationQueue.erase(last, recompilationQueue.end());
+        std::make_heap(recompilationQueue.begin(), recompilationQueue.end());
+    }
+    port_mutex_unlock(&recompilationLock);
 }
 
 void DrlEMImpl::registerCodeChunk(Method_Handle method_handle, void *code_addr,
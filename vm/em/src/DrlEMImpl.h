@@ -30,6 +30,7 @@
 #include "jni.h"
 
 #include <apr_dso.h>
+#include <apr_time.h>
 #include <string>
 #include <set>
 #include <vector>
@@ -42,6 +43,18 @@ class DrlEMImpl;
 typedef std::vector<RChain*> RChains;
 typedef std::vector<RStep*> RSteps;
 
+/** Recompilation request waiting for a background compilation thread */
+struct RecompilationRequest {
+    MethodProfile* mp;
+    size_t n;           // recompilation number, for logging
+    U_64 hotness;       // profile hotness when the profile became ready
+    apr_time_t enqueueTime;
+
+    // std heap functions keep the largest element first: the hottest method is compiled first
+    bool operator<(const RecompilationRequest& r) const {return hotness < r.hotness;}
+};
+typedef std::vector<RecompilationRequest> RecompilationQueue;
+
 
 /** Recompilation step. One recompilation chain can have 1 or more recompilation steps */
 class RStep {
@@ -104,11 +117,17 @@ public:
 
 //EM_PC interface impl:
     virtual void methodProfileIsReady(MethodProfile* mp);
+    virtual void* compileOsrEntry(MethodProfile* mp);
 
     virtual bool needTbsThreadSupport() const;
     virtual void tbsTimeout();
     virtual int getTbsTimeout() const;
 
+//background compilation threads, run by VM in its own threads
+    unsigned int getNumCompilationThreads() const {return nCompilationThreads;}
+    void compilationThreadRun();
+    void compilationThreadsShutdown();
+
 //EM PC access interface
     ProfileCollector* getProfileCollector(EM_PCTYPE type, JIT_Handle jh, EM_JIT_PC_Role jitRole) const;
 
@@ -121,6 +140,10 @@ private:
     ProfileCollector* createProfileCollector(const std::string& profilerName, const std::string& config, RStep* step);
     ProfileCollector* getProfileCollector(const std::string& name) const;
     std::string getJITLibFromCmdLine(const std::string& jitName) const;
+    void initCompilationThreads(const std::string& config);
+    void recompileMethod(MethodProfile* mp, size_t n);
+    RStep* getNextStep(JIT_Handle jit) const;
+    void logCompilationQueueStats() const;
 
     void deallocateResources();
     
@@ -140,6 +163,14 @@ private:
     osmutex_t recompilationLock;
     std::set<Method_Profile_Handle> methodsInRecompile;
 
+    // requests are queued only if nCompilationThreads > 0, all fields are guarded by recompilationLock
+    unsigned int nCompilationThreads;
+    bool compilationThreadsStopped;
+    hycond_t recompilationQueueCond;
+    RecompilationQueue recompilationQueue;
+    size_t nRequestsQueued, maxQueueLength;
+    apr_time_t totalQueueLatency, maxQueueLatency;
+
     Method_Lookup_Table method_lookup_table;
 };
 
@@ -40,6 +40,8 @@ class EM_PC_Interface {
 public:
     virtual ~EM_PC_Interface(){};
     virtual void methodProfileIsReady(MethodProfile* mp) =0;
+    // compiles the method synchronously for on-stack replacement, returns the OSR entry or NULL
+    virtual void* compileOsrEntry(MethodProfile* mp) =0;
 };
 
 class MethodProfile {
@@ -48,6 +50,9 @@ public:
         : pc(_pc), mh(_mh){}
     virtual ~MethodProfile(){}
 
+    /** Counter based estimate used by EM to order recompilation requests, hotter first */
+    virtual U_64 getHotness() const {return 0;}
+
     ProfileCollector* pc;
     Method_Handle mh;
 };
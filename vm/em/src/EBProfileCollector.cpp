@@ -79,6 +79,18 @@ void* eb_profiler_get_backedge_counter_addr(Method_Profile_Handle mph) {
     return (void*)&((EBMethodProfile*)mp)->backedgeCounter;
 }
 
+void* eb_profiler_get_osr_pc_addr(Method_Profile_Handle mph) {
+    MethodProfile* mp = (MethodProfile*)mph;
+    assert(mp->pc->type == EM_PCTYPE_ENTRY_BACKEDGE);
+    return (void*)&((EBMethodProfile*)mp)->osrPc;
+}
+
+void* eb_profiler_get_osr_entry_pc_addr(Method_Profile_Handle mph) {
+    MethodProfile* mp = (MethodProfile*)mph;
+    assert(mp->pc->type == EM_PCTYPE_ENTRY_BACKEDGE);
+    return (void*)&((EBMethodProfile*)mp)->osrEntryPc;
+}
+
 char eb_profiler_is_in_sync_mode(PC_Handle pch) {
     assert(pch!=NULL);
     ProfileCollector* pc = (ProfileCollector*)pch;
@@ -94,6 +106,13 @@ void __stdcall eb_profiler_sync_mode_callback(Method_Profile_Handle mph) {
     ((EBProfileCollector*)mp->pc)->syncModeJitCallback(mp);
 }
 
+void* __stdcall eb_profiler_osr_callback(Method_Profile_Handle mph) {
+    assert(mph!=NULL);
+    MethodProfile* mp = (MethodProfile*)mph;
+    assert(mp->pc->type == EM_PCTYPE_ENTRY_BACKEDGE);
+    return ((EBProfileCollector*)mp->pc)->osrJitCallback(mp);
+}
+
 U_32 eb_profiler_get_entry_threshold(PC_Handle pch) {
     assert(pch!=NULL);
     ProfileCollector* pc = (ProfileCollector*)pch;
@@ -204,6 +223,24 @@ void EBProfileCollector::syncModeJitCallback(MethodProfile* mp) {
     em->methodProfileIsReady(mp);
 }
 
+void* EBProfileCollector::osrJitCallback(MethodProfile* mp) {
+    assert(mp->pc == this);
+    EBMethodProfile* ebmp = (EBMethodProfile*)mp;
+    if (loggingEnabled) {
+        std::ostringstream msg;
+        msg <<"EM: profiler["<<name.c_str()<<"] OSR requested [pc:"<<ebmp->osrPc
+            <<" b:"<<ebmp->backedgeCounter<<"] "<<class_get_name(method_get_class(mp->mh))
+            <<"::"<<method_get_name(mp->mh)<<method_get_descriptor(mp->mh);
+        INFO2(catName.c_str(), msg.str().c_str());
+    }
+    void* entry = em->compileOsrEntry(mp);
+    if (entry == NULL) {
+        // step over the limit, so the loop does not ask again on the next iteration
+        ebmp->backedgeCounter++;
+    }
+    return entry;
+}
+
 static void addProfilesForClassloader(Class_Loader_Handle h, EBProfiles& from, EBProfiles& to, bool erase) {
     for (EBProfiles::iterator it = from.begin(), end = from.end(); it!=end; ++it) {
         EBMethodProfile* profile = *it;
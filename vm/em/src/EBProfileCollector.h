@@ -63,6 +63,7 @@ public:
     
     EBMethodProfile* createProfile(Method_Handle mh);
     void syncModeJitCallback(MethodProfile* mp);
+    void* osrJitCallback(MethodProfile* mp);
 
     U_32 getEntryThreshold() const {return eThreshold;}
     U_32 getBackedgeThreshold() const {return bThreshold;}
@@ -103,8 +104,12 @@ private:
 class EBMethodProfile : public MethodProfile {
 public:
     EBMethodProfile(EBProfileCollector* pc, Method_Handle mh) 
-        : MethodProfile(pc, mh), entryCounter(0), backedgeCounter(0){}
+        : MethodProfile(pc, mh), entryCounter(0), backedgeCounter(0), 
+        osrPc(EM_NO_OSR_PC), osrEntryPc(EM_NO_OSR_PC){}
+    virtual U_64 getHotness() const {return (U_64)entryCounter + backedgeCounter;}
     U_32 entryCounter, backedgeCounter;
+    // loop header requested for on-stack replacement and the one compiled in
+    U_32 osrPc, osrEntryPc;
 };
 
 
@@ -112,6 +117,9 @@ Method_Profile_Handle eb_profiler_create_profile(PC_Handle ph, Method_Handle mh)
 void* eb_profiler_get_entry_counter_addr(Method_Profile_Handle mph);
 void*eb_profiler_get_backedge_counter_addr(Method_Profile_Handle mph);
 void  __stdcall eb_profiler_sync_mode_callback(PC_Handle mph);
+void* eb_profiler_get_osr_pc_addr(Method_Profile_Handle mph);
+void* eb_profiler_get_osr_entry_pc_addr(Method_Profile_Handle mph);
+void* __stdcall eb_profiler_osr_callback(Method_Profile_Handle mph);
 char  eb_profiler_is_in_sync_mode(PC_Handle pch);
 U_32 eb_profiler_get_entry_threshold(PC_Handle pch);
 U_32 eb_profiler_get_backedge_threshold(PC_Handle pch);
@@ -146,6 +146,12 @@ U_32* EdgeMethodProfile::getCounter( U_32 key ) const
     return (U_32*)&counters.front() + idx;
 }
 
+U_64 EdgeMethodProfile::getHotness() const
+{
+    U_32 backEdgeMaxValue = counters.empty() ? 0 : *std::max_element(counters.begin(), counters.end());
+    return (U_64)entryCounter + backEdgeMaxValue;
+}
+
 void EdgeMethodProfile::dump( const char* banner )
 {
     const char* methodName = method_get_name(mh);
@@ -85,6 +85,7 @@ public:
     void setHotMethod() { _isHot = true; }
     bool isHot() const  { return _isHot; }
     U_32* getCounter( U_32 key ) const;
+    virtual U_64 getHotness() const;
 
     U_32 entryCounter;   // point to the method entry counter
     std::vector<U_32> counters;
@@ -75,6 +75,18 @@ ClassloaderUnloadingCallback(Class_Loader_Handle class_handle) {
     DrlEMFactory::getEMInstance()->classloaderUnloadingCallback(class_handle);        
 }
 
+static void
+CompilationThreadRun()
+{
+    DrlEMFactory::getEMInstance()->compilationThreadRun();
+}
+
+static void
+CompilationThreadsShutdown()
+{
+    DrlEMFactory::getEMInstance()->compilationThreadsShutdown();
+}
+
 static const char*
 GetName() {
     return OPEN_EM;
@@ -96,6 +108,7 @@ GetVendor() {
 }
 
 char* tbs_timeout = NULL;
+char* compilation_threads = NULL;
 static apr_pool_t* em_pool = NULL;
 
 static const char*
@@ -107,6 +120,11 @@ GetProperty(const char* key) {
             tbs_timeout = apr_itoa(em_pool, DrlEMFactory::getEMInstance()->getTbsTimeout());
         }
         return tbs_timeout;
+    } else if (!strcmp(key, OPEN_EM_VM_COMPILATION_THREADS)) {
+        if (NULL == compilation_threads) {
+            compilation_threads = apr_itoa(em_pool, DrlEMFactory::getEMInstance()->getNumCompilationThreads());
+        }
+        return compilation_threads;
     } else {
         return NULL;
     }
@@ -182,6 +200,8 @@ int EmInitialize(OpenComponentHandle* p_component,
     vm_intf->UnregisterCodeChunk = UnregisterCodeChunk;
     vm_intf->ProfilerThreadTimeout = ProfilerThreadTimeout;
     vm_intf->ClassloaderUnloadingCallback = ClassloaderUnloadingCallback;
+    vm_intf->CompilationThreadRun = CompilationThreadRun;
+    vm_intf->CompilationThreadsShutdown = CompilationThreadsShutdown;
 
     *p_component = (OpenComponentHandle) c_intf;
     *p_allocator = (OpenInstanceAllocatorHandle) a_intf;
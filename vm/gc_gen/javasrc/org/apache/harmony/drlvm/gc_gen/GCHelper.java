@@ -233,6 +233,21 @@ public class GCHelper {
      */
     public static boolean GEN_MODE = getGenMode();
 
+    /**
+     * States whether the generational write barrier marks cards instead of
+     * remembering slots. Set with the -XX:gc.card_table=true JRE Option.
+     */
+    public static final boolean CARD_TABLE_MODE = getCardTableMode();
+
+    /**
+     * Card table base address, biased with the heap start so that the card byte of
+     * an address is at CARD_TABLE_BASE + (address >>> CARD_SHIFT_COUNT).
+     */
+    private static final Address CARD_TABLE_BASE = Address.fromLong(getCardTableBase());
+    private static final Address CARD_TABLE_HEAP_START = Address.fromLong(getCardTableHeapStart());
+    private static final int  CARD_SHIFT_COUNT = 9;
+    private static final byte CARD_DIRTY = 1;
+
     /**
      * Write Barrier for GC. This method is used to update the slot with the value 
      * provided. 
@@ -243,6 +258,16 @@ public class GCHelper {
      */
     @Inline
     public static void write_barrier_slot_rem(Address p_target, Address p_objSlot, Address p_objBase) {
+
+        /* Card marking: dirty the card of the object header, whatever the target is.
+           Static fields are written with null base and are skipped by the heap start check. */
+        if (CARD_TABLE_MODE) {
+            p_objSlot.store(p_target);
+            if (GEN_MODE && p_objBase.GE(CARD_TABLE_HEAP_START)) {
+                CARD_TABLE_BASE.store(CARD_DIRTY, p_objBase.toWord().rshl(CARD_SHIFT_COUNT).toOffset());
+            }
+            return;
+        }
       
        /* If the slot is in NOS or the target is not in NOS, we simply return*/
         if(p_objSlot.GE(NOS_BOUNDARY) || p_target.LT(NOS_BOUNDARY) || !GEN_MODE) {
@@ -337,6 +362,9 @@ public class GCHelper {
     private static native int helperCallback();
     private static native boolean getGenMode(); 
     private static native long getNosBoundary();    
+    private static native boolean getCardTableMode();
+    private static native long getCardTableBase();
+    private static native long getCardTableHeapStart();
     private static native int TLSGCOffset();
 
  
@@ -33,6 +33,66 @@ typedef struct Uncompressed_Root{
 
 POINTER_SIZE_INT vtable_base = 0;
 POINTER_SIZE_INT HEAP_BASE = 0;
+unsigned int HEAP_REF_SHIFT = 0;
+
+/* The cheapest mode that can address the whole heap is chosen, in this order:
+   zero base and no shift, zero base and shift, heap_start as base and no shift,
+   heap_start as base and shift. */
+void gc_set_compressed_ref_mode(void* heap_start, void* heap_end)
+{
+#ifdef COMPRESS_REFERENCE
+  POINTER_SIZE_INT start = (POINTER_SIZE_INT)heap_start;
+  POINTER_SIZE_INT end = (POINTER_SIZE_INT)heap_end;
+
+#ifndef _IPF_
+  if(end <= COMPRESSED_REF_UNSHIFTED_SPAN){
+    HEAP_BASE = 0;
+    HEAP_REF_SHIFT = 0;
+  }else if(end <= COMPRESSED_REF_SHIFTED_SPAN){
+    HEAP_BASE = 0;
+    HEAP_REF_SHIFT = COMPRESSED_REF_SHIFT_BITS;
+  }else
+#endif
+  if(end - start <= COMPRESSED_REF_UNSHIFTED_SPAN){
+    HEAP_BASE = start;
+    HEAP_REF_SHIFT = 0;
+  }else if(end - start <= COMPRESSED_REF_MAX_SPAN){
+    HEAP_BASE = start;
+    HEAP_REF_SHIFT = COMPRESSED_REF_SHIFT_BITS;
+  }else{
+    LDIE(87, "Max heap size {0}MB is too large for compressed references, the limit is {1}MB" << (end - start)/MB << COMPRESSED_REF_MAX_SPAN/MB);
+  }
+
+  INFO2("gc.process", "GC: compressed references base "<<(void*)HEAP_BASE<<", shift "<<HEAP_REF_SHIFT<<"\n");
+#else
+  HEAP_BASE = (POINTER_SIZE_INT)heap_start;
+#endif
+}
+
+/* The heap is reserved right below the 4GB or 32GB line, so that there is
+   as much room as possible for the native heap below it. The address is only
+   a hint to the OS; the result is checked and released if it's not low enough. */
+void* gc_reserve_zero_based_heap(POINTER_SIZE_INT size)
+{
+#if defined(COMPRESS_REFERENCE) && !defined(_IPF_)
+  POINTER_SIZE_INT ceilings[2] = { COMPRESSED_REF_UNSHIFTED_SPAN, COMPRESSED_REF_SHIFTED_SPAN };
+
+  for(unsigned int i=0; i<2; i++){
+    POINTER_SIZE_INT ceiling = ceilings[i];
+    if(size + SPACE_ALLOC_UNIT > ceiling) continue;
+
+    void* hint = (void*)round_down_to_size(ceiling - size, SPACE_ALLOC_UNIT);
+    void* reserved = vm_reserve_mem_near(hint, size);
+    if(!reserved) continue;
+
+    if((POINTER_SIZE_INT)reserved + size <= ceiling)
+      return reserved;
+
+    vm_release_mem(reserved, size);
+  }
+#endif
+  return NULL;
+}
 
 void gc_set_uncompressed_rootset(GC *gc)
 {
@@ -49,4 +49,16 @@ FORCE_INLINE void gc_compressed_rootset_add_entry(GC *gc, REF *p_ref)
   assert(gc->root_set);
 }
 
+FORCE_INLINE void collector_compressed_rootset_add_entry(Collector *collector, REF *p_ref)
+{
+  Vector_Block *root_set = collector->root_set;
+  vector_block_add_entry(root_set, (POINTER_SIZE_INT)p_ref);
+
+  if(!vector_block_is_full(root_set)) return;
+
+  pool_put_entry(gc_metadata.gc_rootset_pool, root_set);
+  collector->root_set = free_set_pool_get_entry(&gc_metadata);
+  assert(collector->root_set);
+}
+
 #endif /* #ifndef _COMPRESSED_REF_H_ */
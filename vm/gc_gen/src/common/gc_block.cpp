@@ -201,8 +201,13 @@ Partial_Reveal_Object* block_get_next_marked_object(Block_Header* block, void**
   return next_marked_obj;
 }
 
+/* With the mark bitmap, the next marked object is found as fast as the prefetched pointer is read,
+   so nothing is written into the dead objects. */
 Partial_Reveal_Object *block_get_first_marked_obj_prefetch_next(Block_Header *block, void **start_pos)
 {
+  if(gc_mark_bitmap_in_use)
+    return block_get_first_marked_object(block, start_pos);
+
   Partial_Reveal_Object *cur_obj = (Partial_Reveal_Object *)block->base;
   Partial_Reveal_Object *block_end = (Partial_Reveal_Object *)block->free;
   
@@ -238,6 +243,9 @@ Partial_Reveal_Object *block_get_first_marked_obj_after_prefetch(Block_Header *b
 
 Partial_Reveal_Object *block_get_next_marked_obj_prefetch_next(Block_Header *block, void **start_pos)
 {
+  if(gc_mark_bitmap_in_use)
+    return block_get_next_marked_object(block, start_pos);
+
   Partial_Reveal_Object *cur_obj = *(Partial_Reveal_Object **)start_pos;
   Partial_Reveal_Object *block_end = (Partial_Reveal_Object *)block->free;
 
@@ -311,6 +319,8 @@ Partial_Reveal_Object *block_get_next_marked_obj_after_prefetch(Block_Header *bl
                   cur_marked_obj = obj_get_prefetched_next_pointer(cur_obj); 
     */
     return NULL;
+  else if(gc_mark_bitmap_in_use)
+    cur_marked_obj = next_marked_obj_in_block(cur_obj, block_end);
   else
     cur_marked_obj = obj_get_prefetched_next_pointer(cur_obj);
   
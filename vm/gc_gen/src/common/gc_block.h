@@ -38,7 +38,8 @@ enum Block_Status {
   BLOCK_IN_COMPACT = 0x8,
   BLOCK_COMPACTED = 0x10,
   BLOCK_TARGET = 0x20,
-  BLOCK_DEST = 0x40
+  BLOCK_DEST = 0x40,
+  BLOCK_PINNED = 0x80
 };
 
 typedef struct Block_Header {
@@ -206,6 +207,10 @@ inline  Partial_Reveal_Object* obj_get_prefetched_next_pointer(Partial_Reveal_Ob
 
 inline Partial_Reveal_Object *next_marked_obj_in_block(Partial_Reveal_Object *cur_obj, Partial_Reveal_Object *block_end)
 {
+  /* the dead objects are skipped a bitmap word at a time */
+  if(gc_mark_bitmap_in_use)
+    return mark_bitmap_next_marked(cur_obj, block_end);
+
   while(cur_obj < block_end){
     if( obj_is_marked_in_vt(cur_obj))
       return cur_obj;
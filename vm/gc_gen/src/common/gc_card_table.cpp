@@ -0,0 +1,179 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "gc_card_table.h"
+#include "gc_space.h"
+#include "gc_metadata.h"
+#include "../gen/gen.h"
+#include "../los/lspace.h"
+#include "../los/free_area_pool.h"
+#include "../thread/collector.h"
+
+Boolean gc_use_card_table = FALSE;
+U_8* card_table_base = NULL;
+void* card_table_heap_start = NULL;
+void* card_table_heap_end = NULL;
+
+static U_8* card_table = NULL;
+static POINTER_SIZE_INT card_table_size = 0;
+
+void gc_card_table_initialize(GC* gc)
+{
+  card_table_heap_start = gc->heap_start;
+  card_table_heap_end = gc->heap_end;
+
+  POINTER_SIZE_INT heap_size = (POINTER_SIZE_INT)gc->heap_end - (POINTER_SIZE_INT)gc->heap_start;
+  card_table_size = round_up_to_size(heap_size >> CARD_SHIFT_COUNT, vm_get_system_alloc_unit());
+
+  /* the table is mapped as a whole; the os only backs the pages that get dirtied */
+  card_table = (U_8*)vm_alloc_mem(NULL, card_table_size);
+  if(card_table == NULL){
+    LDIE(88, "gc.base: Can't allocate the card table of {0} bytes." << card_table_size);
+  }
+  memset(card_table, CARD_CLEAN, card_table_size);
+
+  card_table_base = card_table - ((POINTER_SIZE_INT)card_table_heap_start >> CARD_SHIFT_COUNT);
+}
+
+void gc_card_table_destruct(GC* gc)
+{
+  if(card_table == NULL) return;
+
+  vm_free_mem(card_table, card_table_size);
+  card_table = NULL;
+  card_table_base = NULL;
+}
+
+void gc_card_table_clear(GC* gc)
+{
+  memset(card_table, CARD_CLEAN, card_table_size);
+}
+
+static Boolean cards_have_dirty(U_8* first_card, U_8* end_card)
+{
+  /* cards are mostly clean, so check a word at a time */
+  U_8* card = first_card;
+  while(card < end_card && ((POINTER_SIZE_INT)card & (BYTES_PER_WORD - 1)))
+    if(*card++ != CARD_CLEAN) return TRUE;
+
+  while(card + BYTES_PER_WORD <= end_card){
+    if(*(POINTER_SIZE_INT*)card) return TRUE;
+    card += BYTES_PER_WORD;
+  }
+
+  while(card < end_card)
+    if(*card++ != CARD_CLEAN) return TRUE;
+
+  return FALSE;
+}
+
+void allocator_object_write_barrier(Partial_Reveal_Object* p_object, Collector* allocator);
+
+static FORCE_INLINE void obj_scan_if_card_dirty(Collector* collector, Partial_Reveal_Object* p_obj)
+{
+  if(!card_is_dirty(p_obj) || !object_has_ref_field(p_obj)) return;
+
+  /* remembers the slots pointing to NOS in collector->rem_set */
+  allocator_object_write_barrier(p_obj, collector);
+}
+
+static void block_scan_dirty_cards(Collector* collector, Block_Header* block)
+{
+  U_8* first_card = card_table_card_addr(block);
+  U_8* end_card = card_table_card_addr((void*)((POINTER_SIZE_INT)block + GC_BLOCK_SIZE_BYTES));
+  if(!cards_have_dirty(first_card, end_card)) return;
+
+  Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)block->base;
+  Partial_Reveal_Object* block_end = (Partial_Reveal_Object*)block->free;
+  while(p_obj < block_end){
+    obj_scan_if_card_dirty(collector, p_obj);
+    p_obj = obj_end(p_obj);
+  }
+
+  memset(first_card, CARD_CLEAN, end_card - first_card);
+}
+
+/* LOS is not organized in blocks, but it can be walked from the beginning since the free areas
+   are headed with a zero word and their size, like in lspace_get_next_marked_object. */
+static void lspace_scan_dirty_cards(Collector* collector, Lspace* lspace)
+{
+  U_8* first_card = card_table_card_addr(lspace->heap_start);
+  U_8* end_card = card_table_card_addr(lspace->heap_end);
+  if(!cards_have_dirty(first_card, end_card)) return;
+
+  POINTER_SIZE_INT next_area_start = (POINTER_SIZE_INT)lspace->heap_start;
+  POINTER_SIZE_INT heap_end = (POINTER_SIZE_INT)lspace->heap_end;
+  while(next_area_start < heap_end){
+    if(!*(POINTER_SIZE_INT*)next_area_start){
+      assert(((Free_Area*)next_area_start)->size);
+      next_area_start += ((Free_Area*)next_area_start)->size;
+      continue;
+    }
+
+    Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)next_area_start;
+    obj_scan_if_card_dirty(collector, p_obj);
+
+    unsigned int hash_extend_size = 0;
+#ifdef USE_32BITS_HASHCODE
+    hash_extend_size = hashcode_is_attached(p_obj)? GC_OBJECT_ALIGNMENT : 0;
+#endif
+    next_area_start += ALIGN_UP_TO_KILO(vm_object_size(p_obj) + hash_extend_size);
+  }
+
+  memset(first_card, CARD_CLEAN, end_card - first_card);
+}
+
+static volatile unsigned int los_scan_claimed;
+
+static void collector_scan_dirty_cards(Collector* collector)
+{
+  GC* gc = collector->gc;
+  GC_Metadata* metadata = gc->metadata;
+  Blocked_Space* mos = (Blocked_Space*)collector->collect_space;
+
+  collector->rem_set = free_set_pool_get_entry(metadata);
+
+  /* LOS is scanned by whoever comes first */
+  if(gc_has_los() && atomic_cas32(&los_scan_claimed, TRUE, FALSE) == FALSE)
+    lspace_scan_dirty_cards(collector, (Lspace*)gc_get_los((GC_Gen*)gc));
+
+  /* the last MOS block is linked to the first NOS block */
+  Block_Header* block = blocked_space_block_iterator_next(mos);
+  while(block && block->block_idx <= mos->ceiling_block_idx){
+    block_scan_dirty_cards(collector, block);
+    block = blocked_space_block_iterator_next(mos);
+  }
+
+  pool_put_entry(metadata->collector_remset_pool, collector->rem_set);
+  collector->rem_set = NULL;
+}
+
+void collector_execute_task(GC* gc, TaskType task_func, Space* space);
+
+void gc_card_table_scan(GC* gc)
+{
+  /* NOS is evacuated anyway, its cards are just cleaned */
+  Space* nos = gc_get_nos((GC_Gen*)gc);
+  U_8* first_nos_card = card_table_card_addr(nos->heap_start);
+  memset(first_nos_card, CARD_CLEAN, card_table_card_addr(nos->heap_end) - first_nos_card);
+
+  Blocked_Space* mos = (Blocked_Space*)gc_get_mos((GC_Gen*)gc);
+  blocked_space_block_iterator_init(mos);
+  los_scan_claimed = FALSE;
+
+  collector_execute_task(gc, (TaskType)collector_scan_dirty_cards, (Space*)mos);
+}
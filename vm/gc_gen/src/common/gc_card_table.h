@@ -0,0 +1,66 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _GC_CARD_TABLE_H_
+#define _GC_CARD_TABLE_H_
+
+#include "gc_common.h"
+
+/* Card table for generational mode, an alternative to the mutator remsets (gc.card_table).
+   The heap is divided into cards of CARD_SIZE_BYTES, each has one byte in the table.
+   The write barrier dirties the card of the object header being written, regardless of
+   the target, so it is a single unconditional store and never needs a remset block.
+   At a minor collection, the collectors claim the MOS blocks (and the LOS) in parallel,
+   scan the objects whose header card is dirty, and remember their slots pointing to NOS
+   in the collector remsets, which then go into the rootset as usual.
+   card_table_base is biased with the heap start, so that the card of an address is simply
+   card_table_base[addr >> CARD_SHIFT_COUNT]. GCHelper.java depends on this layout. */
+
+#define CARD_SHIFT_COUNT 9
+#define CARD_SIZE_BYTES (1 << CARD_SHIFT_COUNT)
+
+#define CARD_CLEAN 0
+#define CARD_DIRTY 1
+
+extern Boolean gc_use_card_table;
+extern U_8* card_table_base;
+extern void* card_table_heap_start;
+extern void* card_table_heap_end;
+
+FORCE_INLINE U_8* card_table_card_addr(void* addr)
+{ return &card_table_base[(POINTER_SIZE_INT)addr >> CARD_SHIFT_COUNT]; }
+
+FORCE_INLINE void card_table_dirty_obj(Partial_Reveal_Object* p_obj)
+{
+  /* static fields are written with NULL base, they are roots anyway */
+  if((void*)p_obj < card_table_heap_start || (void*)p_obj >= card_table_heap_end) return;
+  *card_table_card_addr(p_obj) = CARD_DIRTY;
+}
+
+FORCE_INLINE Boolean card_is_dirty(void* addr)
+{ return *card_table_card_addr(addr) != CARD_CLEAN; }
+
+void gc_card_table_initialize(GC* gc);
+void gc_card_table_destruct(GC* gc);
+
+/* called at major collection, when the remsets are dropped */
+void gc_card_table_clear(GC* gc);
+
+/* called at minor collection in gc_set_rootset, uses the collectors */
+void gc_card_table_scan(GC* gc);
+
+#endif /* _GC_CARD_TABLE_H_ */
@@ -28,6 +28,7 @@
 #include "../mark_sweep/gc_ms.h"
 #include "../move_compact/gc_mc.h"
 #include "../common/space_tuner.h"
+#include "gc_phase_time.h"
 #include "interior_pointer.h"
 #include "collection_scheduler.h"
 #include "gc_concurrent.h"
@@ -70,6 +71,9 @@ void gc_destruct_collector_alloc(GC* gc, Collector* collector)
 
 void gc_copy_interior_pointer_table_to_rootset();
 
+GC_Phase_Times gc_phase_times;
+const char* gc_phase_names[GC_PHASE_NUM] = { "rootset", "mark", "reference", "compact", "fix", "los", "other" };
+
 /*used for computing collection time and mutator time*/
 static int64 collection_start_time = time_now();
 static int64 collection_end_time = time_now();
@@ -140,6 +144,7 @@ void gc_reset_after_collection(GC* gc)
     gc_put_finref_to_vm(gc);
     gc_reset_finref_metadata(gc);
     gc_activate_finref_threads((GC*)gc);
+    gc_update_softref_clock(gc);
 #ifndef BUILD_IN_REFERENT
   } else {
     gc_clear_weakref_pools(gc);
@@ -175,6 +180,8 @@ void gc_reclaim_heap(GC* gc, unsigned int gc_cause)
   }
 
    set_gc_start_time();
+  gc_phase_times_reset(collection_start_time);
+  gc_reset_collector_time_working(gc);
   int64 time_mutator = get_gc_start_time() - get_gc_end_time();
   
   gc->num_collections++;
@@ -199,6 +206,7 @@ void gc_reclaim_heap(GC* gc, unsigned int gc_cause)
   gc_set_rootset_type(ROOTSET_IS_REF);
   gc_prepare_rootset(gc);
   unlock(gc->lock_enum);
+  gc_phase_end(GC_PHASE_ROOTSET);
     
   gc->in_collection = TRUE;
   
@@ -216,12 +224,25 @@ void gc_reclaim_heap(GC* gc, unsigned int gc_cause)
 #endif
 
   set_gc_end_time();
+  gc_phase_end(GC_PHASE_OTHER);
 
   int64 time_collection = get_gc_end_time() - get_gc_start_time();
 
 #if !defined(USE_UNIQUE_MARK_SWEEP_GC)&&!defined(USE_UNIQUE_MOVE_COMPACT_GC)
   gc_gen_collection_verbose_info((GC_Gen*)gc, time_collection, time_mutator);
   gc_gen_space_verbose_info((GC_Gen*)gc);
+
+  /* the roots are still in the rootset pool */
+  if(gc->cause == GC_CAUSE_HEAP_DUMP || gc->cause == GC_CAUSE_CLASS_HISTOGRAM){
+    if(gc->cause == GC_CAUSE_HEAP_DUMP)
+      gc_gen_heap_dump_in_pause((GC_Gen*)gc);
+    else
+      gc_gen_class_histogram_in_pause((GC_Gen*)gc);
+    /* the mutators are still stopped, so the pause goes on till here */
+    set_gc_end_time();
+    time_collection = get_gc_end_time() - get_gc_start_time();
+  }
+  gc_gen_pause_log_record((GC_Gen*)gc, time_collection);
 #endif
 
   gc_reset_after_collection(gc);
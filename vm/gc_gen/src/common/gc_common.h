@@ -36,6 +36,7 @@
 #include "gc_for_class.h"
 #include "gc_platform.h"
 #include "gc_properties.h"
+#include "gc_mark_bitmap.h"
 
 #include "../common/gc_for_barrier.h"
 
@@ -86,6 +87,28 @@
 typedef void (*TaskType)(void*);
 
 extern POINTER_SIZE_INT HEAP_BASE;
+extern unsigned int HEAP_REF_SHIFT;
+
+#ifdef COMPRESS_REFERENCE
+
+/* 32-bit references shifted by the object alignment bits */
+#define COMPRESSED_REF_SHIFT_BITS 3
+#define COMPRESSED_REF_UNSHIFTED_SPAN ((POINTER_SIZE_INT)1 << 32)
+#define COMPRESSED_REF_SHIFTED_SPAN (COMPRESSED_REF_UNSHIFTED_SPAN << COMPRESSED_REF_SHIFT_BITS)
+
+/* IPF JIT only knows the unshifted decoding with a non-zero base */
+#ifdef _IPF_
+#define COMPRESSED_REF_MAX_SPAN COMPRESSED_REF_UNSHIFTED_SPAN
+#else
+#define COMPRESSED_REF_MAX_SPAN COMPRESSED_REF_SHIFTED_SPAN
+#endif
+
+#endif /* COMPRESS_REFERENCE */
+
+/* set HEAP_BASE and HEAP_REF_SHIFT once the heap is reserved */
+void gc_set_compressed_ref_mode(void* heap_start, void* heap_end);
+/* try to reserve the heap low enough for zero-based compressed references, NULL if failed */
+void* gc_reserve_zero_based_heap(POINTER_SIZE_INT size);
 
 //#define COMPRESS_REFERENCE // Now it's a VM-wide macro, defined in build file 
 
@@ -102,6 +125,9 @@ extern POINTER_SIZE_INT HEAP_BASE;
 /////////////////////////////////////////////
 //Compress reference related!///////////////////
 /////////////////////////////////////////////
+/* A compressed reference is the object's offset from HEAP_BASE shifted right by HEAP_REF_SHIFT.
+   HEAP_BASE is 0 when the heap is reserved low enough (zero-based mode), and HEAP_REF_SHIFT is
+   the object alignment bits when the heap is larger than 4GB. See gc_set_compressed_ref_mode(). */
 FORCE_INLINE REF obj_ptr_to_ref(Partial_Reveal_Object *p_obj)
 {
 #ifdef COMPRESS_REFERENCE
@@ -113,7 +139,7 @@ FORCE_INLINE REF obj_ptr_to_ref(Partial_Reveal_Object *p_obj)
     return (REF)0;
   }
   else
-    return (REF) ((POINTER_SIZE_INT) p_obj - HEAP_BASE);
+    return (REF) (((POINTER_SIZE_INT) p_obj - HEAP_BASE) >> HEAP_REF_SHIFT);
 #else
     return (REF)p_obj;
 #endif
@@ -125,7 +151,7 @@ FORCE_INLINE Partial_Reveal_Object *ref_to_obj_ptr(REF ref)
   if(!ref){
     return NULL; 
   }
-  return (Partial_Reveal_Object *)(HEAP_BASE + ref);
+  return (Partial_Reveal_Object *)(HEAP_BASE + ((POINTER_SIZE_INT)ref << HEAP_REF_SHIFT));
 
 #else
   return (Partial_Reveal_Object *)ref;
@@ -133,6 +159,27 @@ FORCE_INLINE Partial_Reveal_Object *ref_to_obj_ptr(REF ref)
 
 }
 
+/* The forwarding pointer kept in obj_info shares the low bits with the mark/forward bits, so it
+   can't be a shifted reference. We keep the unshifted heap offset, which is object aligned.
+   obj_info is pointer-sized, so the offset fits even when the heap is larger than 4GB. */
+FORCE_INLINE Obj_Info_Type obj_ptr_to_fw_oi(Partial_Reveal_Object *p_obj)
+{
+#ifdef COMPRESS_REFERENCE
+  return (Obj_Info_Type)((POINTER_SIZE_INT)p_obj - HEAP_BASE);
+#else
+  return (Obj_Info_Type)p_obj;
+#endif
+}
+
+FORCE_INLINE Partial_Reveal_Object *fw_oi_to_obj_ptr(Obj_Info_Type oi)
+{
+#ifdef COMPRESS_REFERENCE
+  return (Partial_Reveal_Object *)(HEAP_BASE + (POINTER_SIZE_INT)oi);
+#else
+  return (Partial_Reveal_Object *)oi;
+#endif
+}
+
 FORCE_INLINE Partial_Reveal_Object *read_slot(REF *p_slot)
 {  return ref_to_obj_ptr(*p_slot); }
 
@@ -166,11 +213,17 @@ inline int* object_ref_iterator_next(int* iterator)
 
 /****************************************/
 
+/* In a slide-compact collection with gc.mark_bitmap, the mark bit is kept in the side bitmap
+   instead, see gc_mark_bitmap.h. The other vt bit, the hashcode one, stays in the vt. */
 inline Boolean obj_is_marked_in_vt(Partial_Reveal_Object *obj) 
-{  return (((VT_SIZE_INT)obj_get_vt_raw(obj) & CONST_MARK_BIT) != 0); }
+{
+  if(gc_mark_bitmap_in_use) return mark_bitmap_is_marked(obj);
+  return (((VT_SIZE_INT)obj_get_vt_raw(obj) & CONST_MARK_BIT) != 0);
+}
 
 inline Boolean obj_mark_in_vt(Partial_Reveal_Object *obj) 
 {  
+  if(gc_mark_bitmap_in_use) return mark_bitmap_mark(obj);
   VT vt = obj_get_vt_raw(obj);
   if((VT_SIZE_INT)vt & CONST_MARK_BIT) return FALSE;
   obj_set_vt(obj,  (VT)( (VT_SIZE_INT)vt | CONST_MARK_BIT ) );
@@ -179,11 +232,16 @@ inline Boolean obj_mark_in_vt(Partial_Reveal_Object *obj)
 
 inline void obj_unmark_in_vt(Partial_Reveal_Object *obj) 
 { 
+  if(gc_mark_bitmap_in_use){
+    mark_bitmap_unmark(obj);
+    return;
+  }
   VT vt = obj_get_vt_raw(obj);
   obj_set_vt(obj, (VT)((VT_SIZE_INT)vt & ~CONST_MARK_BIT));
 }
 
 inline void obj_clear_dual_bits_in_vt(Partial_Reveal_Object* p_obj){
+  if(gc_mark_bitmap_in_use) mark_bitmap_unmark(p_obj);
   VT vt = obj_get_vt_raw(p_obj);
   obj_set_vt(p_obj,(VT)((VT_SIZE_INT)vt & DUAL_MARKBITS_MASK));
 }
@@ -204,7 +262,7 @@ inline void obj_clear_dual_bits_in_oi(Partial_Reveal_Object *obj)
 inline Partial_Reveal_Object *obj_get_fw_in_oi(Partial_Reveal_Object *obj) 
 {
   assert(get_obj_info_raw(obj) & CONST_FORWARD_BIT);
-  return (Partial_Reveal_Object*)(ref_to_obj_ptr((REF)(get_obj_info_raw(obj) & ~CONST_FORWARD_BIT)));
+  return fw_oi_to_obj_ptr(get_obj_info_raw(obj) & ~CONST_FORWARD_BIT);
 }
 
 inline Boolean obj_is_fw_in_oi(Partial_Reveal_Object *obj) 
@@ -213,8 +271,7 @@ inline Boolean obj_is_fw_in_oi(Partial_Reveal_Object *obj)
 inline void obj_set_fw_in_oi(Partial_Reveal_Object *obj,void *dest)
 {  
   assert(!(get_obj_info_raw(obj) & CONST_FORWARD_BIT));
-  REF dest = obj_ptr_to_ref((Partial_Reveal_Object *) dest);
-  set_obj_info(obj,(Obj_Info_Type)dest | CONST_FORWARD_BIT); 
+  set_obj_info(obj, obj_ptr_to_fw_oi((Partial_Reveal_Object *) dest) | CONST_FORWARD_BIT); 
 }
 
 
@@ -249,7 +306,7 @@ inline void mark_bit_flip()
 inline Partial_Reveal_Object *obj_get_fw_in_oi(Partial_Reveal_Object *obj) 
 {
   assert(get_obj_info_raw(obj) & FLIP_FORWARD_BIT);
-  return (Partial_Reveal_Object*) ( ref_to_obj_ptr( (REF)get_obj_info(obj) ) );
+  return fw_oi_to_obj_ptr(get_obj_info(obj));
 }
 
 inline Boolean obj_is_fw_in_oi(Partial_Reveal_Object *obj) 
@@ -265,7 +322,7 @@ inline void obj_set_fw_in_oi(Partial_Reveal_Object *obj, void *dest)
   /* It's important to clear the FLIP_FORWARD_BIT before collection ends, since it is the same as
      next minor cycle's FLIP_MARK_BIT. And if next cycle is major, it is also confusing
      as FLIP_FORWARD_BIT. (The bits are flipped only in minor collection). */
-  Obj_Info_Type dst = (Obj_Info_Type)obj_ptr_to_ref((Partial_Reveal_Object *) dest);     
+  Obj_Info_Type dst = obj_ptr_to_fw_oi((Partial_Reveal_Object *) dest);     
   set_obj_info(obj, dst | FLIP_FORWARD_BIT); 
 }
 
@@ -460,6 +517,11 @@ inline Boolean collect_last_is_minor(GC* gc)
 
 void mark_scan_pool(Collector* collector);
 
+/* work-stealing marking support, see mark_scan_pool.cpp */
+typedef void (*Mark_Drain_Func)(Collector* collector);
+void collector_mark_steal_init(Collector* collector);
+void collector_mark_steal(Collector* collector, Mark_Drain_Func drain);
+
 inline void mark_scan_heap(Collector* collector)
 {
     mark_scan_pool(collector);    
@@ -24,6 +24,7 @@
 #include "../gen/gen.h"
 #include "../thread/mutator.h"
 #include "gc_for_barrier.h"
+#include "gc_card_table.h"
 #include "../mark_sweep/wspace_mark_sweep.h"
 #include "../common/gc_concurrent.h"
 #include "../common/gc_common.h"
@@ -345,6 +346,8 @@ Boolean gc_heap_copy_object_array(Managed_Object_Handle src_array, unsigned int
     //rem obj after is for mostly concurrent
     if(WB_REM_SOURCE_OBJ == write_barrier_function) {
 	 write_barrier_rem_source_obj(dst_array);
+    }else if(WB_CARD_MARK == write_barrier_function) {
+      card_table_dirty_obj((Partial_Reveal_Object*)dst_array);
     }
 
     return TRUE;
@@ -358,6 +361,11 @@ void gc_heap_wrote_object (Managed_Object_Handle p_obj_written )
     return;
 
   /* for array copy and object clone */
+  if(WB_CARD_MARK == write_barrier_function){
+    card_table_dirty_obj((Partial_Reveal_Object*)p_obj_written);
+    return;
+  }
+
 #ifdef USE_REM_SLOTS
   gc_object_write_barrier(p_obj_written); 
 #else
@@ -383,6 +391,10 @@ void gc_heap_slot_write_ref (Managed_Object_Handle p_obj_holding_ref,Managed_Obj
       gen_write_barrier_rem_obj(p_obj_holding_ref, p_target);
 #endif
       break;      
+    case WB_CARD_MARK:
+      *p_slot = p_target;
+      card_table_dirty_obj((Partial_Reveal_Object*)p_obj_holding_ref);
+      break;
     case WB_REM_SOURCE_OBJ:
       *p_slot = p_target;
       write_barrier_rem_source_obj(p_obj_holding_ref);
@@ -33,7 +33,8 @@ enum Write_Barrier_Function{
   WB_REM_OLD_VAR       = 0x03,
   WB_REM_NEW_VAR       = 0x04,
   WB_REM_OBJ_SNAPSHOT  = 0x05,
-  WB_CON_DEBUG = 0x06
+  WB_CON_DEBUG = 0x06,
+  WB_CARD_MARK         = 0x07
 };
 
 inline void gc_set_barrier_function(unsigned int wb_function)
@@ -30,6 +30,7 @@
 #include "../mark_sweep/gc_ms.h"
 #include "../move_compact/gc_mc.h"
 #include "interior_pointer.h"
+#include "object_pin.h"
 #include "../thread/conclctor.h"
 #include "../thread/collector.h"
 #include "../verify/verify_live_heap.h"
@@ -197,11 +198,25 @@ void gc_add_root_set_entry(Managed_Object_Handle *ref, Boolean is_pinned)
      flip the bit for major collection, we may find it's marked there.
      So we can't do assert about oi except we really want. */
   assert( address_belongs_to_gc_heap(p_obj, p_global_gc));
+  if(rootset_enumerated_in_parallel){
+    collector_rootset_add_entry((Collector*)gc_get_tls(), p_ref);
+    return;
+  }
   gc_rootset_add_entry(p_global_gc, p_ref);
 } 
 
+/* guards the shared weak root set and interior pointer table while the
+   collectors enumerate the thread stacks in parallel */
+static SpinLock rootset_lock = FREE_LOCK;
+
 void gc_add_root_set_entry_interior_pointer (void **slot, int offset, Boolean is_pinned) 
 {  
+  if(rootset_enumerated_in_parallel){
+    lock(rootset_lock);
+    add_root_set_entry_interior_pointer(slot, offset, is_pinned); 
+    unlock(rootset_lock);
+    return;
+  }
   add_root_set_entry_interior_pointer(slot, offset, is_pinned); 
 }
 
@@ -212,6 +227,10 @@ void gc_add_compressed_root_set_entry(REF* ref, Boolean is_pinned)
   Partial_Reveal_Object* p_obj = read_slot(p_ref);
   assert(!obj_is_marked_in_vt(p_obj));
   assert( address_belongs_to_gc_heap(p_obj, p_global_gc));
+  if(rootset_enumerated_in_parallel){
+    collector_compressed_rootset_add_entry((Collector*)gc_get_tls(), p_ref);
+    return;
+  }
   gc_compressed_rootset_add_entry(p_global_gc, p_ref);
 }
 
@@ -235,9 +254,20 @@ void gc_add_weak_root_set_entry(Managed_Object_Handle *ref, Boolean is_pinned, B
 #endif
   assert( !obj_is_marked_in_vt(p_obj));
   assert( address_belongs_to_gc_heap(p_obj, p_global_gc));
+  if(rootset_enumerated_in_parallel){
+    lock(rootset_lock);
+    gc_weak_rootset_add_entry(p_global_gc, p_ref, is_short_weak);
+    unlock(rootset_lock);
+    return;
+  }
   gc_weak_rootset_add_entry(p_global_gc, p_ref, is_short_weak);
 }
 
+Boolean gc_enumerate_thread_stacks_in_parallel(unsigned int num_threads)
+{
+  return gc_parallel_enumerate_thread_stacks(p_global_gc, num_threads);
+}
+
 extern Boolean IGNORE_FORCE_GC;
 
 /* VM to force GC */
@@ -251,12 +281,49 @@ void gc_force_gc()
   vm_gc_unlock_enum();
 }
 
+/* VM to dump the heap, see gen_heap_dump.cpp */
+Boolean gc_dump_heap(const char* file_name)
+{
+#if defined(USE_UNIQUE_MARK_SWEEP_GC) || defined(USE_UNIQUE_MOVE_COMPACT_GC)
+  return FALSE;
+#else
+  return gc_gen_dump_heap((GC_Gen*)p_global_gc, file_name);
+#endif
+}
+
+/* VM to print the class histogram, see gen_class_histogram.cpp */
+Boolean gc_print_class_histogram(const char* file_name)
+{
+#if defined(USE_UNIQUE_MARK_SWEEP_GC) || defined(USE_UNIQUE_MOVE_COMPACT_GC)
+  return FALSE;
+#else
+  return gc_gen_print_class_histogram((GC_Gen*)p_global_gc, file_name);
+#endif
+}
+
+/* the user asked for a data dump, e.g., with Ctrl+Break */
+void gc_notify_data_dump_request()
+{
+#if !defined(USE_UNIQUE_MARK_SWEEP_GC) && !defined(USE_UNIQUE_MOVE_COMPACT_GC)
+  if(gc_class_histogram_on_signal)
+    gc_gen_print_class_histogram((GC_Gen*)p_global_gc, NULL);
+  if(gc_heap_dump_on_signal)
+    gc_gen_dump_heap((GC_Gen*)p_global_gc, NULL);
+#endif
+}
+
 void* gc_heap_base_address() 
 {  return gc_heap_base(p_global_gc); }
 
 void* gc_heap_ceiling_address() 
 {  return gc_heap_ceiling(p_global_gc); }
 
+void* gc_heap_compressed_base_address()
+{  return (void*)HEAP_BASE; }
+
+U_32 gc_heap_compressed_shift()
+{  return HEAP_REF_SHIFT; }
+
 /* this is a contract between vm and gc */
 void mutator_initialize(GC* gc, void* tls_gc_info);
 void mutator_destruct(GC* gc, void* tls_gc_info); 
@@ -324,13 +391,26 @@ void gc_vm_initialized()
 { return; }
 
 Boolean gc_is_object_pinned (Managed_Object_Handle obj)
-{  return 0; }
+{  return gc_pin_table_contains((Partial_Reveal_Object*)obj); }
 
+/* The object is read from the handle with gc disabled, so it can't be moved in between. 
+   An object that can't be pinned is silently ignored, and the caller can check with gc_is_object_pinned. */
 void gc_pin_object (Managed_Object_Handle* p_object) 
-{  return; }
+{
+  hythread_suspend_disable();
+  Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)*p_object;
+  if(p_obj && gc_obj_is_pinnable(p_global_gc, p_obj))
+    gc_pin_table_add(p_obj);
+  hythread_suspend_enable();
+}
 
 void gc_unpin_object (Managed_Object_Handle* p_object) 
-{  return; }
+{
+  hythread_suspend_disable();
+  Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)*p_object;
+  if(p_obj) gc_pin_table_remove(p_obj);
+  hythread_suspend_enable();
+}
 
 Managed_Object_Handle gc_get_next_live_object(void *iterator) 
 {  assert(0); return NULL; }
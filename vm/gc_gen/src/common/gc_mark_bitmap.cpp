@@ -0,0 +1,98 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "gc_common.h"
+
+Boolean gc_mark_bitmap = FALSE;
+volatile Boolean gc_mark_bitmap_in_use = FALSE;
+POINTER_SIZE_INT* mark_bitmap_base = NULL;
+void* mark_bitmap_heap_start = NULL;
+void* mark_bitmap_heap_end = NULL;
+
+static POINTER_SIZE_INT* mark_bitmap = NULL;
+static POINTER_SIZE_INT mark_bitmap_size = 0;
+
+void gc_mark_bitmap_initialize(void* heap_start, void* heap_end)
+{
+  mark_bitmap_heap_start = heap_start;
+  mark_bitmap_heap_end = heap_end;
+
+  POINTER_SIZE_INT heap_size = (POINTER_SIZE_INT)heap_end - (POINTER_SIZE_INT)heap_start;
+  mark_bitmap_size = round_up_to_size(heap_size >> (MARK_BITMAP_GRANULE_SHIFT + BIT_SHIFT_TO_BITS_PER_BYTE), vm_get_system_alloc_unit());
+
+  /* the os only backs the pages that get touched, and only the bits of the committed
+     parts of the spaces are cleared, see gc_mark_bitmap_clear */
+  mark_bitmap = (POINTER_SIZE_INT*)vm_alloc_mem(NULL, mark_bitmap_size);
+  if(mark_bitmap == NULL){
+    LDIE(89, "gc.base: Can't allocate the mark bitmap of {0} bytes." << mark_bitmap_size);
+  }
+
+  /* the heap start is block aligned, so the bias is a whole number of words */
+  mark_bitmap_base = mark_bitmap - ((POINTER_SIZE_INT)heap_start >> (MARK_BITMAP_GRANULE_SHIFT + MARK_BITMAP_WORD_SHIFT));
+}
+
+void gc_mark_bitmap_destruct()
+{
+  if(mark_bitmap == NULL) return;
+
+  vm_free_mem(mark_bitmap, mark_bitmap_size);
+  mark_bitmap = NULL;
+  mark_bitmap_base = NULL;
+}
+
+void gc_mark_bitmap_clear(void* start, void* end, unsigned int stripe, unsigned int num_stripes)
+{
+  if(start < mark_bitmap_heap_start) start = mark_bitmap_heap_start;
+  if(end > mark_bitmap_heap_end) end = mark_bitmap_heap_end;
+  if(start >= end) return;
+
+  /* whole words: the bits after an end that is not word aligned are of the next space,
+     which is cleared as well, or of uncommitted memory, which has no objects */
+  POINTER_SIZE_INT first_word = ((POINTER_SIZE_INT)start >> MARK_BITMAP_GRANULE_SHIFT) >> MARK_BITMAP_WORD_SHIFT;
+  POINTER_SIZE_INT end_word = (((POINTER_SIZE_INT)end >> MARK_BITMAP_GRANULE_SHIFT) + MARK_BITMAP_WORD_MASK) >> MARK_BITMAP_WORD_SHIFT;
+  POINTER_SIZE_INT num_words = end_word - first_word;
+
+  POINTER_SIZE_INT stripe_words = (num_words + num_stripes - 1) / num_stripes;
+  POINTER_SIZE_INT stripe_start = stripe_words * stripe;
+  if(stripe_start >= num_words) return;
+
+  POINTER_SIZE_INT size = stripe_words;
+  if(stripe_start + size > num_words) size = num_words - stripe_start;
+  memset(&mark_bitmap_base[first_word + stripe_start], 0, size * sizeof(POINTER_SIZE_INT));
+}
+
+unsigned int mark_bitmap_num_marked(void* start, void* end)
+{
+  if(start >= end) return 0;
+
+  POINTER_SIZE_INT bit_index = mark_bitmap_bit_index(start);
+  POINTER_SIZE_INT end_index = (POINTER_SIZE_INT)end >> MARK_BITMAP_GRANULE_SHIFT;
+  POINTER_SIZE_INT* p_word = (POINTER_SIZE_INT*)mark_bitmap_word_addr(bit_index);
+  POINTER_SIZE_INT* p_end_word = (POINTER_SIZE_INT*)mark_bitmap_word_addr(end_index);
+
+  POINTER_SIZE_INT first_mask = ~(mark_bitmap_bit_mask(bit_index) - 1);
+  POINTER_SIZE_INT end_mask = mark_bitmap_bit_mask(end_index) - 1;
+  if(p_word == p_end_word)
+    return mark_bitmap_word_num_bits(*p_word & first_mask & end_mask);
+
+  unsigned int num = mark_bitmap_word_num_bits(*p_word & first_mask);
+  while(++p_word < p_end_word)
+    num += mark_bitmap_word_num_bits(*p_word);
+  /* the word of end is only there if end is not word aligned */
+  if(end_mask) num += mark_bitmap_word_num_bits(*p_end_word & end_mask);
+  return num;
+}
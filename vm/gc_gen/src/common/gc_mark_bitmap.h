@@ -0,0 +1,169 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _GC_MARK_BITMAP_H_
+#define _GC_MARK_BITMAP_H_
+
+/* Side mark bitmap for the slide-compact major collection (gc.mark_bitmap).
+   The heap has one bit for every GC_OBJECT_ALIGNMENT bytes, the bit of an object is the one
+   of its start address. While gc_mark_bitmap_in_use is set, the obj_*_in_vt mark primitives
+   of gc_common.h use the bitmap instead of the low bit of the vtable word, so marking doesn't
+   write into the objects, and the compaction walks the live objects of a block by scanning
+   the bitmap words instead of stepping through every dead object.
+   The bitmap is cleared by the collectors in parallel at the start of the collection, so it
+   doesn't matter what the previous collection has left there, e.g., in pinned blocks. Only the
+   bits of the committed parts of the spaces are cleared, since there are no objects elsewhere,
+   so the bitmap pages of a heap that never grew are never touched.
+   Like the card table, mark_bitmap_base is biased with the heap start.
+   This file is included by gc_common.h, so it only depends on what is included before. */
+
+#ifdef POINTER64
+#define MARK_BITMAP_WORD_SHIFT 6
+#else
+#define MARK_BITMAP_WORD_SHIFT 5
+#endif
+#define MARK_BITMAP_WORD_BITS (1 << MARK_BITMAP_WORD_SHIFT)
+#define MARK_BITMAP_WORD_MASK (MARK_BITMAP_WORD_BITS - 1)
+
+#define MARK_BITMAP_GRANULE_SHIFT ((GC_OBJECT_ALIGNMENT == 8) ? 3 : 2)
+
+extern Boolean gc_mark_bitmap;
+extern volatile Boolean gc_mark_bitmap_in_use;
+extern POINTER_SIZE_INT* mark_bitmap_base;
+extern void* mark_bitmap_heap_start;
+extern void* mark_bitmap_heap_end;
+
+FORCE_INLINE POINTER_SIZE_INT mark_bitmap_bit_index(void* addr)
+{
+  assert(addr >= mark_bitmap_heap_start && addr < mark_bitmap_heap_end);
+  return (POINTER_SIZE_INT)addr >> MARK_BITMAP_GRANULE_SHIFT;
+}
+
+FORCE_INLINE void* mark_bitmap_bit_addr(POINTER_SIZE_INT bit_index)
+{ return (void*)(bit_index << MARK_BITMAP_GRANULE_SHIFT); }
+
+FORCE_INLINE volatile POINTER_SIZE_INT* mark_bitmap_word_addr(POINTER_SIZE_INT bit_index)
+{ return &mark_bitmap_base[bit_index >> MARK_BITMAP_WORD_SHIFT]; }
+
+FORCE_INLINE POINTER_SIZE_INT mark_bitmap_bit_mask(POINTER_SIZE_INT bit_index)
+{ return (POINTER_SIZE_INT)1 << (bit_index & MARK_BITMAP_WORD_MASK); }
+
+FORCE_INLINE Boolean mark_bitmap_is_marked(Partial_Reveal_Object* p_obj)
+{
+  POINTER_SIZE_INT bit_index = mark_bitmap_bit_index(p_obj);
+  return (*mark_bitmap_word_addr(bit_index) & mark_bitmap_bit_mask(bit_index)) != 0;
+}
+
+/* the neighbors in the word can be marked or unmarked by other collectors at the same time */
+FORCE_INLINE Boolean mark_bitmap_mark(Partial_Reveal_Object* p_obj)
+{
+  POINTER_SIZE_INT bit_index = mark_bitmap_bit_index(p_obj);
+  volatile POINTER_SIZE_INT* p_word = mark_bitmap_word_addr(bit_index);
+  POINTER_SIZE_INT mask = mark_bitmap_bit_mask(bit_index);
+
+  POINTER_SIZE_INT old_word = *p_word;
+  while(!(old_word & mask)){
+    POINTER_SIZE_INT temp = atomic_casptrsz(p_word, old_word | mask, old_word);
+    if(temp == old_word) return TRUE;
+    old_word = *p_word;
+  }
+  return FALSE; /* already marked */
+}
+
+FORCE_INLINE void mark_bitmap_unmark(Partial_Reveal_Object* p_obj)
+{
+  POINTER_SIZE_INT bit_index = mark_bitmap_bit_index(p_obj);
+  volatile POINTER_SIZE_INT* p_word = mark_bitmap_word_addr(bit_index);
+  POINTER_SIZE_INT mask = mark_bitmap_bit_mask(bit_index);
+
+  POINTER_SIZE_INT old_word = *p_word;
+  while(old_word & mask){
+    POINTER_SIZE_INT temp = atomic_casptrsz(p_word, old_word & ~mask, old_word);
+    if(temp == old_word) return;
+    old_word = *p_word;
+  }
+}
+
+FORCE_INLINE unsigned int mark_bitmap_word_lowest_bit(POINTER_SIZE_INT word)
+{
+  assert(word);
+#if defined(__GNUC__)
+#ifdef POINTER64
+  return (unsigned int)__builtin_ctzll((unsigned long long)word);
+#else
+  return (unsigned int)__builtin_ctz((unsigned int)word);
+#endif
+#else
+  unsigned int bit = 0;
+  while(!(word & 1)){
+    word >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+FORCE_INLINE unsigned int mark_bitmap_word_num_bits(POINTER_SIZE_INT word)
+{
+#if defined(__GNUC__)
+#ifdef POINTER64
+  return (unsigned int)__builtin_popcountll((unsigned long long)word);
+#else
+  return (unsigned int)__builtin_popcount((unsigned int)word);
+#endif
+#else
+  unsigned int num = 0;
+  for(; word; num++)
+    word &= word - 1;
+  return num;
+#endif
+}
+
+/* the first marked object in [start, end), or NULL */
+FORCE_INLINE Partial_Reveal_Object* mark_bitmap_next_marked(void* start, void* end)
+{
+  if(start >= end) return NULL;
+
+  POINTER_SIZE_INT bit_index = mark_bitmap_bit_index(start);
+  POINTER_SIZE_INT end_index = (POINTER_SIZE_INT)end >> MARK_BITMAP_GRANULE_SHIFT;
+  volatile POINTER_SIZE_INT* p_word = mark_bitmap_word_addr(bit_index);
+  /* the bits below start in the first word are masked out */
+  POINTER_SIZE_INT word = *p_word & ~(mark_bitmap_bit_mask(bit_index) - 1);
+  POINTER_SIZE_INT word_index = bit_index & ~(POINTER_SIZE_INT)MARK_BITMAP_WORD_MASK;
+
+  while(!word){
+    word_index += MARK_BITMAP_WORD_BITS;
+    if(word_index >= end_index) return NULL;
+    word = *++p_word;
+  }
+
+  bit_index = word_index + mark_bitmap_word_lowest_bit(word);
+  if(bit_index >= end_index) return NULL;
+  return (Partial_Reveal_Object*)mark_bitmap_bit_addr(bit_index);
+}
+
+void gc_mark_bitmap_initialize(void* heap_start, void* heap_end);
+void gc_mark_bitmap_destruct();
+
+/* clears one of num_stripes parts of the bits of [start, end), called by every collector */
+void gc_mark_bitmap_clear(void* start, void* end, unsigned int stripe, unsigned int num_stripes);
+
+/* the number of marked objects in [start, end). There is no bit for the object ends,
+   so this is a count of the objects, not of their bytes. */
+unsigned int mark_bitmap_num_marked(void* start, void* end);
+
+#endif /* _GC_MARK_BITMAP_H_ */
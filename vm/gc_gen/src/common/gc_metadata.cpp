@@ -24,9 +24,11 @@
 #include "../finalizer_weakref/finalizer_weakref.h"
 #include "gc_block.h"
 #include "compressed_ref.h"
+#include "gc_card_table.h"
 #include "../utils/sync_stack.h"
 #include "../gen/gen.h"
 #include "../verify/verify_live_heap.h"
+#include "gc_concurrent.h"
 
 #define GC_METADATA_SIZE_BYTES (1*MB)
 #define GC_METADATA_EXTEND_SIZE_BYTES (1*MB)
@@ -35,6 +37,7 @@
 
 GC_Metadata gc_metadata;
 unsigned int rootset_type;
+Boolean rootset_enumerated_in_parallel = FALSE;
 
 void gc_metadata_initialize(GC* gc)
 {
@@ -326,6 +329,26 @@ void gc_set_rootset(GC* gc)
         root_set = pool_get_entry( collector_remset_pool );
     }
 
+    if(gc_use_card_table) gc_card_table_clear(gc);
+
+  }else if(gc_use_card_table){ /* generational ALGO_MINOR with card marking */
+
+    /* mutator remsets are not used. The collectors scan the dirty cards into collector_remset_pool */
+    root_set = pool_get_entry( mutator_remset_pool );
+    while(root_set){
+        vector_block_clear(root_set);
+        pool_put_entry(free_set_pool, root_set);
+        root_set = pool_get_entry( mutator_remset_pool );
+    }
+
+    gc_card_table_scan(gc);
+
+    root_set = pool_get_entry( collector_remset_pool );
+    while(root_set){
+        pool_put_entry(gc_rootset_pool, root_set);
+        root_set = pool_get_entry( collector_remset_pool );
+    }
+
   }else{ /* generational ALGO_MINOR */
 
     /* all the remsets are put into the shared pool */
@@ -403,6 +426,56 @@ void gc_reset_rootset(GC* gc)
   return;
 }
 
+static void put_rootset_block(Pool* rootset_pool, Vector_Block* root_set)
+{
+  if(vector_block_is_empty(root_set))
+    pool_put_entry(gc_metadata.free_set_pool, root_set);
+  else
+    pool_put_entry(rootset_pool, root_set);
+}
+
+static void collector_enumerate_thread_stacks(Collector* collector)
+{
+  /* gc_add_root_set_entry finds the collector through the tls */
+  void* saved_tls = gc_get_tls();
+  gc_set_tls(collector);
+
+  assert(collector->root_set == NULL);
+  collector->root_set = free_set_pool_get_entry(&gc_metadata);
+#ifdef COMPRESS_REFERENCE
+  assert(collector->uncompressed_root_set == NULL);
+  collector->uncompressed_root_set = free_set_pool_get_entry(&gc_metadata);
+#endif
+
+  vm_enumerate_thread_stacks();
+
+  /* the blocks go to the pools before gc_set_rootset puts gc->root_set back,
+     so they stay in front of the remsets, see gc_clear_remset */
+  put_rootset_block(gc_metadata.gc_rootset_pool, collector->root_set);
+  collector->root_set = NULL;
+#ifdef COMPRESS_REFERENCE
+  put_rootset_block(gc_metadata.gc_uncompressed_rootset_pool, collector->uncompressed_root_set);
+  collector->uncompressed_root_set = NULL;
+#endif
+
+  gc_set_tls(saved_tls);
+}
+
+Boolean gc_parallel_enumerate_thread_stacks(GC* gc, unsigned int num_threads)
+{
+  /* the collectors may be busy with concurrent marking */
+  if(gc_is_specify_con_gc()) return FALSE;
+
+  unsigned int num_collectors = min(gc->num_collectors, num_threads);
+  if(num_collectors < 2) return FALSE;
+
+  INFO2("gc.process", "GC: enumerate " << num_threads << " thread stacks with " << num_collectors << " collectors ...\n");
+  rootset_enumerated_in_parallel = TRUE;
+  collector_execute_enumeration_task(gc, (TaskType)collector_enumerate_thread_stacks, num_collectors);
+  rootset_enumerated_in_parallel = FALSE;
+  return TRUE;
+}
+
 void gc_clear_rootset(GC* gc)
 {
   gc_reset_interior_pointer_table();
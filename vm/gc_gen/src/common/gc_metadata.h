@@ -24,6 +24,7 @@
 #include "gc_common.h"
 #include "../utils/vector_block.h"
 #include "../utils/sync_pool.h"
+#include "../utils/stealable_stack.h"
 #include "../thread/collector.h"
 #include "../thread/mutator.h"
 
@@ -214,6 +215,30 @@ FORCE_INLINE void collector_tracestack_push(Collector* collector, void* p_task)
   assert(collector->trace_stack);
 }
 
+extern Boolean GC_MARK_STEAL;
+
+/* Marking pushes go to the collector's stealable mark stack when work stealing is on. 
+   When it is off, or the mark stack is full, they go to the trace_stack as before. */
+FORCE_INLINE void collector_markstack_push(Collector* collector, void* p_obj)
+{
+  if(GC_MARK_STEAL && stealable_stack_push(collector->mark_stack, (POINTER_SIZE_INT)p_obj))
+    return;
+
+  collector_tracestack_push(collector, p_obj);
+}
+
+FORCE_INLINE void* collector_markstack_pop(Collector* collector)
+{
+  if(GC_MARK_STEAL){
+    POINTER_SIZE_INT p_obj = stealable_stack_pop(collector->mark_stack);
+    if(p_obj) return (void*)p_obj;
+  }
+
+  Vector_Block* trace_stack = collector->trace_stack;
+  if(vector_stack_is_empty(trace_stack)) return NULL;
+  return (void*)vector_stack_pop(trace_stack);
+}
+
 inline void gc_weak_rootset_add_entry(GC* gc, Partial_Reveal_Object** p_ref, Boolean is_short_weak)
 {
   //assert(is_short_weak == FALSE); //Currently no need for short_weak_roots
@@ -231,6 +256,11 @@ inline void gc_weak_rootset_add_entry(GC* gc, Partial_Reveal_Object** p_ref, Boo
 
 extern unsigned int rootset_type;
 
+/* TRUE while the collectors enumerate the thread stacks, each into its own root set */
+extern Boolean rootset_enumerated_in_parallel;
+
+Boolean gc_parallel_enumerate_thread_stacks(GC* gc, unsigned int num_threads);
+
 enum ROOTSET_TYPE{
   ROOTSET_IS_OBJ = 0x01,
   ROOTSET_IS_REF = 0x02
@@ -292,4 +322,46 @@ inline void gc_rootset_add_entry(GC* gc, Partial_Reveal_Object** p_ref)
 }
 #endif
 
+#ifdef COMPRESS_REFERENCE
+
+inline void collector_rootset_add_entry(Collector* collector, Partial_Reveal_Object** p_ref)
+{
+  Vector_Block* uncompressed_root_set = collector->uncompressed_root_set;
+  Partial_Reveal_Object* p_obj = *p_ref;
+
+  /* the same layout as in gc_rootset_add_entry */
+  vector_block_add_entry(uncompressed_root_set, (POINTER_SIZE_INT)p_ref);
+  assert(!vector_block_is_full(uncompressed_root_set));
+  if(rootset_type == ROOTSET_IS_REF)
+    vector_block_add_entry(uncompressed_root_set, (POINTER_SIZE_INT)obj_ptr_to_ref(p_obj));
+  else if(rootset_type == ROOTSET_IS_OBJ)
+    vector_block_add_entry(uncompressed_root_set, (POINTER_SIZE_INT)p_obj);
+
+  if( !vector_block_is_full(uncompressed_root_set)) return;
+
+  pool_put_entry(gc_metadata.gc_uncompressed_rootset_pool, uncompressed_root_set);
+  collector->uncompressed_root_set = free_set_pool_get_entry(&gc_metadata);
+  assert(collector->uncompressed_root_set);
+}
+
+#else /* COMPRESS_REFERENCE */
+
+inline void collector_rootset_add_entry(Collector* collector, Partial_Reveal_Object** p_ref)
+{
+  Vector_Block* root_set = collector->root_set;
+
+  if(rootset_type == ROOTSET_IS_REF)
+    vector_block_add_entry(root_set, (POINTER_SIZE_INT)p_ref);
+  else if(rootset_type == ROOTSET_IS_OBJ)
+    vector_block_add_entry(root_set, (POINTER_SIZE_INT)*p_ref);
+
+  if( !vector_block_is_full(root_set)) return;
+
+  pool_put_entry(gc_metadata.gc_rootset_pool, root_set);
+  collector->root_set = free_set_pool_get_entry(&gc_metadata);
+  assert(collector->root_set);
+}
+
+#endif /* COMPRESS_REFERENCE */
+
 #endif /* #ifndef _GC_METADATA_H_ */
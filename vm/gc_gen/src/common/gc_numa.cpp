@@ -0,0 +1,178 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#define LOG_DOMAIN "gc.numa"
+#include "gc_numa.h"
+
+Boolean gc_numa = FALSE;
+unsigned int gc_numa_num_nodes = 1;
+void* numa_heap_start = NULL;
+unsigned int numa_stripe_shift_count = NUMA_MIN_STRIPE_SHIFT_COUNT;
+
+Numa_Block_Pool* nos_numa_pools = NULL;
+Numa_Block_Pool* mos_numa_pools = NULL;
+
+static Numa_Block_Pool* numa_pools_create()
+{
+  unsigned int size = sizeof(Numa_Block_Pool) * gc_numa_num_nodes;
+  Numa_Block_Pool* pools = (Numa_Block_Pool*)STD_MALLOC(size);
+  memset(pools, 0, size);
+  for(unsigned int i = 0; i < gc_numa_num_nodes; i++)
+    pools[i].lock = FREE_LOCK;
+  return pools;
+}
+
+void gc_numa_initialize(GC* gc, void* blocked_start)
+{
+  gc_numa_num_nodes = port_vmem_numa_nodes();
+  if(gc_numa_num_nodes < 2){
+    INFO2("gc.numa", "GC: gc.numa is ignored, the machine has a single NUMA node.");
+    gc_numa_num_nodes = 1;
+    gc_numa = FALSE;
+    return;
+  }
+
+  numa_heap_start = gc->heap_start;
+  POINTER_SIZE_INT heap_start = (POINTER_SIZE_INT)gc->heap_start;
+  POINTER_SIZE_INT heap_end = (POINTER_SIZE_INT)gc->heap_end;
+  while(((heap_end - heap_start) >> numa_stripe_shift_count) > NUMA_MAX_NUM_STRIPES)
+    numa_stripe_shift_count++;
+
+  /* LOS objects are shared by everybody */
+  if((POINTER_SIZE_INT)blocked_start > heap_start)
+    port_vmem_interleave(gc->heap_start, (POINTER_SIZE_INT)blocked_start - heap_start);
+
+  POINTER_SIZE_INT stripe_start = (POINTER_SIZE_INT)blocked_start;
+  while(stripe_start < heap_end){
+    POINTER_SIZE_INT stripe_idx = (stripe_start - heap_start) >> numa_stripe_shift_count;
+    POINTER_SIZE_INT stripe_end = heap_start + ((stripe_idx + 1) << numa_stripe_shift_count);
+    if(stripe_end > heap_end) stripe_end = heap_end;
+
+    unsigned int node = gc_numa_addr_node((void*)stripe_start);
+    if(port_vmem_bind_node((void*)stripe_start, stripe_end - stripe_start, node) != APR_SUCCESS){
+      LWARN(69, "gc.numa is ignored, the heap can't be bound to the NUMA nodes.");
+      gc_numa_num_nodes = 1;
+      gc_numa = FALSE;
+      return;
+    }
+    stripe_start = stripe_end;
+  }
+
+  nos_numa_pools = numa_pools_create();
+  mos_numa_pools = numa_pools_create();
+
+  INFO2("gc.numa", "GC: NUMA mode with " << gc_numa_num_nodes << " nodes, heap stripe size "
+        << ((POINTER_SIZE_INT)1 << numa_stripe_shift_count)/KB << "KB");
+}
+
+void gc_numa_destruct(GC* gc)
+{
+  if(!gc_numa) return;
+
+  STD_FREE(nos_numa_pools);
+  STD_FREE(mos_numa_pools);
+  nos_numa_pools = NULL;
+  mos_numa_pools = NULL;
+}
+
+void gc_numa_bind_collector(unsigned int collector_index)
+{
+  unsigned int node = collector_index % gc_numa_num_nodes;
+  if(port_vmem_run_on_node(node) != APR_SUCCESS)
+    TRACE2("gc.numa", "GC: collector " << collector_index << " can't be bound to NUMA node " << node);
+}
+
+static Block_Header* numa_pool_get(Numa_Block_Pool* pool)
+{
+  if(pool->num_blocks == 0) return NULL;
+
+  Block_Header* block = NULL;
+  lock(pool->lock);
+  if(pool->num_blocks)
+    block = pool->blocks[--pool->num_blocks];
+  unlock(pool->lock);
+  return block;
+}
+
+static Boolean numa_pool_put(Numa_Block_Pool* pool, Block_Header* block)
+{
+  Boolean ok = FALSE;
+  lock(pool->lock);
+  if(pool->num_blocks < NUMA_POOL_CAPACITY){
+    pool->blocks[pool->num_blocks++] = block;
+    ok = TRUE;
+  }
+  unlock(pool->lock);
+  return ok;
+}
+
+/* same as fspace_alloc_block, the blocks kept for pinned objects are skipped */
+static Block_Header* space_claim_free_block(Blocked_Space* space)
+{
+  unsigned int old_free_idx = space->free_block_idx;
+  unsigned int new_free_idx = old_free_idx+1;
+  while(old_free_idx <= space->ceiling_block_idx){
+    unsigned int allocated_idx = atomic_cas32(&space->free_block_idx, new_free_idx, old_free_idx);
+    if(allocated_idx == old_free_idx){
+      Block_Header* block = (Block_Header*)&(space->blocks[allocated_idx - space->first_block_idx]);
+      if(block->status == BLOCK_FREE) return block;
+    }
+    old_free_idx = space->free_block_idx;
+    new_free_idx = old_free_idx+1;
+  }
+  return NULL;
+}
+
+Block_Header* gc_numa_alloc_block(Blocked_Space* space, Numa_Block_Pool* pools)
+{
+  unsigned int node = port_vmem_numa_current_node();
+  Block_Header* block = numa_pool_get(&pools[node]);
+  if(block) return block;
+
+  for(unsigned int i = 0; i < NUMA_REMOTE_CLAIMS; i++){
+    block = space_claim_free_block(space);
+    if(block == NULL) break;
+
+    unsigned int home_node = gc_numa_addr_node(block);
+    if(home_node == node || !numa_pool_put(&pools[home_node], block))
+      return block;
+  }
+
+  /* the space is out, or the next blocks are all homed on other nodes */
+  for(unsigned int i = 0; i < gc_numa_num_nodes; i++){
+    block = numa_pool_get(&pools[(node + i) % gc_numa_num_nodes]);
+    if(block) return block;
+  }
+  return NULL;
+}
+
+Boolean gc_numa_pools_have_block(Numa_Block_Pool* pools)
+{
+  for(unsigned int i = 0; i < gc_numa_num_nodes; i++)
+    if(pools[i].num_blocks) return TRUE;
+  return FALSE;
+}
+
+void gc_numa_reset_pools()
+{
+  if(!gc_numa) return;
+
+  for(unsigned int i = 0; i < gc_numa_num_nodes; i++){
+    nos_numa_pools[i].num_blocks = 0;
+    mos_numa_pools[i].num_blocks = 0;
+  }
+}
@@ -0,0 +1,74 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _GC_NUMA_H_
+#define _GC_NUMA_H_
+
+#include "gc_common.h"
+#include "gc_space.h"
+
+/* NUMA mode for the generational heap (gc.numa).
+   The heap of the blocked spaces is bound to the nodes in stripes, so the home node of a
+   block is a function of its address and doesn't change when the NOS boundary moves.
+   The LOS part of the heap, if its extent is fixed, is interleaved over the nodes instead.
+   NOS and MOS blocks are still handed out in address order. A thread that gets a block
+   homed on another node puts it into that node's pool and tries again a few times, so the
+   mutators allocate from their local node, and the collectors, which are bound to the
+   nodes round-robin, copy the survivors to their local node. The pools are emptied after
+   every collection; a block left there is just an empty block below free_block_idx. */
+
+#define NUMA_MIN_STRIPE_SHIFT_COUNT 21  /* 2MB, not to split large pages */
+#define NUMA_MAX_NUM_STRIPES 4096       /* every stripe is a separate mapping in the OS */
+#define NUMA_POOL_CAPACITY 1024         /* in blocks */
+#define NUMA_REMOTE_CLAIMS 8            /* blocks of other nodes taken before giving up */
+
+typedef struct Numa_Block_Pool{
+  SpinLock lock;
+  unsigned int num_blocks;
+  Block_Header* blocks[NUMA_POOL_CAPACITY];
+}Numa_Block_Pool;
+
+extern Boolean gc_numa;
+extern unsigned int gc_numa_num_nodes;
+extern void* numa_heap_start;
+extern unsigned int numa_stripe_shift_count;
+
+/* one pool per node for each space */
+extern Numa_Block_Pool* nos_numa_pools;
+extern Numa_Block_Pool* mos_numa_pools;
+
+inline unsigned int gc_numa_addr_node(void* addr)
+{
+  POINTER_SIZE_INT stripe = ((POINTER_SIZE_INT)addr - (POINTER_SIZE_INT)numa_heap_start) >> numa_stripe_shift_count;
+  return (unsigned int)(stripe % gc_numa_num_nodes);
+}
+
+/* blocked_start is where the striped part of the heap begins, the part below it is LOS */
+void gc_numa_initialize(GC* gc, void* blocked_start);
+void gc_numa_destruct(GC* gc);
+
+/* binds the calling collector thread to a node, the collectors are spread round-robin */
+void gc_numa_bind_collector(unsigned int collector_index);
+
+/* returns a free block of the space, homed on the current node if possible, or NULL if the space is out */
+Block_Header* gc_numa_alloc_block(Blocked_Space* space, Numa_Block_Pool* pools);
+Boolean gc_numa_pools_have_block(Numa_Block_Pool* pools);
+
+/* called at the end of every collection */
+void gc_numa_reset_pools();
+
+#endif /* _GC_NUMA_H_ */
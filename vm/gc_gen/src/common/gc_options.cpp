@@ -25,6 +25,7 @@
 
 /* for ALLOC_PREFETCH related micro definition */
 #include "../thread/gc_thread.h" 
+#include "../utils/prefetch_fifo.h"
 
 extern char* GC_VERIFY;
 extern POINTER_SIZE_INT NOS_SIZE;
@@ -36,6 +37,19 @@ extern POINTER_SIZE_INT MOS_RESERVE_SIZE;
 extern Boolean GEN_NONGEN_SWITCH;
 
 extern Boolean FORCE_FULL_COMPACT;
+extern Boolean gc_use_card_table;
+extern Boolean gc_mark_bitmap;
+extern Boolean gc_numa;
+extern unsigned int gc_uncommit_delay;
+extern POINTER_SIZE_INT gc_soft_max_heap_size;
+extern char* gc_pause_log_file;
+extern unsigned int gc_pause_target;
+extern Boolean gc_adaptive_tlab;
+extern POINTER_SIZE_INT gc_alloc_sample_interval;
+extern char* gc_heap_dump_file;
+extern Boolean gc_heap_dump_on_oom;
+extern Boolean gc_heap_dump_on_signal;
+extern Boolean gc_class_histogram_on_signal;
 
 extern unsigned int NUM_CONCLCTORS;
 extern unsigned int NUM_CON_MARKERS;
@@ -47,8 +61,10 @@ extern unsigned int MAJOR_COLLECTORS;
 
 extern Boolean IGNORE_VTABLE_TRACING;
 extern Boolean IGNORE_FINREF;
+extern unsigned int gc_softref_lru_ms_per_mb;
 
 extern Boolean JVMTI_HEAP_ITERATION ;
+extern Boolean GC_MARK_STEAL;
 extern Boolean IGNORE_FORCE_GC;
 
 POINTER_SIZE_INT HEAP_SIZE_DEFAULT = 256 * MB;
@@ -170,6 +186,109 @@ GC* gc_parse_options()
     if( major_algo) vm_properties_destroy_value(major_algo);
   }
 
+  if (vm_property_is_set("gc.card_table", VM_PROPERTIES) == 1) {
+    gc_use_card_table = vm_property_get_boolean("gc.card_table");
+    /* dirty cards are scanned by walking the MOS blocks and LOS */
+    if(gc_use_card_table && (gc_is_unique_space() || major_is_marksweep())){
+      LWARN(67, "gc.card_table is only supported with a compacting major collector, ignored.");
+      gc_use_card_table = FALSE;
+    }
+    /* pick up the card marking barrier if gen mode is already set */
+    if(gc_is_gen_mode()) gc_set_gen_mode(TRUE);
+  }
+
+  if (vm_property_is_set("gc.numa", VM_PROPERTIES) == 1) {
+    gc_numa = vm_property_get_boolean("gc.numa");
+    /* the block pools are only in the forwarding NOS and the compacted MOS */
+    if(gc_numa && (gc_is_unique_space() || major_is_marksweep() || minor_is_semispace())){
+      LWARN(70, "gc.numa is only supported with the forwarding minor and compacting major collectors, ignored.");
+      gc_numa = FALSE;
+    }
+  }
+
+  if (vm_property_is_set("gc.uncommit_delay", VM_PROPERTIES) == 1) {
+    gc_uncommit_delay = vm_property_get_integer("gc.uncommit_delay");
+    /* the free memory is only known for the forwarding NOS, the compacted MOS and LOS */
+    if(gc_uncommit_delay && (gc_is_unique_space() || major_is_marksweep() || minor_is_semispace())){
+      LWARN(72, "gc.uncommit_delay is only supported with the forwarding minor and compacting major collectors, ignored.");
+      gc_uncommit_delay = 0;
+    }
+  }
+
+  if (vm_property_is_set("gc.pause_log", VM_PROPERTIES) == 1) {
+    /* the space sizes are only known for the blocked MOS and LOS */
+    if(gc_is_unique_space() || major_is_marksweep()){
+      LWARN(73, "gc.pause_log is only supported with the compacting major collectors, ignored.");
+    }else{
+      char* value = vm_properties_get_value("gc.pause_log", VM_PROPERTIES);
+      gc_pause_log_file = strdup(value);
+      vm_properties_destroy_value(value);
+    }
+  }
+
+  if (vm_property_is_set("gc.pause_target", VM_PROPERTIES) == 1) {
+    gc_pause_target = vm_property_get_integer("gc.pause_target");
+    /* NOS is sized by the space adaptation, which needs the blocked MOS */
+    if(gc_pause_target && (gc_is_unique_space() || major_is_marksweep())){
+      LWARN(74, "gc.pause_target is only supported with the compacting major collectors, ignored.");
+      gc_pause_target = 0;
+    }
+  }
+
+  if (vm_property_is_set("gc.mark_bitmap", VM_PROPERTIES) == 1) {
+    gc_mark_bitmap = vm_property_get_boolean("gc.mark_bitmap");
+    /* the bitmap covers the heap of GC_Gen, and the mark-sweep MOS has its own mark table */
+    if(gc_mark_bitmap && (gc_is_unique_space() || major_is_marksweep())){
+      LWARN(76, "gc.mark_bitmap is only supported with the compacting major collectors, ignored.");
+      gc_mark_bitmap = FALSE;
+    }
+  }
+
+  if (vm_property_is_set("gc.adaptive_tlab", VM_PROPERTIES) == 1) {
+    gc_adaptive_tlab = vm_property_get_boolean("gc.adaptive_tlab");
+    /* the TLAB runs are claimed in the forwarding NOS */
+    if(gc_adaptive_tlab && (gc_is_unique_space() || minor_is_semispace())){
+      LWARN(77, "gc.adaptive_tlab is only supported with the forwarding minor collector, ignored.");
+      gc_adaptive_tlab = FALSE;
+    }
+  }
+
+  if (vm_property_is_set("gc.alloc_sample_interval", VM_PROPERTIES) == 1) {
+    gc_alloc_sample_interval = vm_property_get_size("gc.alloc_sample_interval");
+    /* the sampler counts the bytes at the NOS block refills and the LOS allocations */
+    if(gc_alloc_sample_interval && gc_is_unique_space()){
+      LWARN(78, "gc.alloc_sample_interval is only supported with the generational heap, ignored.");
+      gc_alloc_sample_interval = 0;
+    }
+  }
+
+  if (vm_property_is_set("gc.heap_dump_on_oom", VM_PROPERTIES) == 1)
+    gc_heap_dump_on_oom = vm_property_get_boolean("gc.heap_dump_on_oom");
+
+  if (vm_property_is_set("gc.heap_dump_on_signal", VM_PROPERTIES) == 1)
+    gc_heap_dump_on_signal = vm_property_get_boolean("gc.heap_dump_on_signal");
+
+  /* the heap is walked block by block after a major collection of GC_Gen */
+  if((gc_heap_dump_on_oom || gc_heap_dump_on_signal) && gc_is_unique_space()){
+    LWARN(80, "gc.heap_dump_on_oom and gc.heap_dump_on_signal are only supported with the generational heap, ignored.");
+    gc_heap_dump_on_oom = FALSE;
+    gc_heap_dump_on_signal = FALSE;
+  }
+
+  if (vm_property_is_set("gc.class_histogram_on_signal", VM_PROPERTIES) == 1) {
+    gc_class_histogram_on_signal = vm_property_get_boolean("gc.class_histogram_on_signal");
+    if(gc_class_histogram_on_signal && gc_is_unique_space()){
+      LWARN(81, "gc.class_histogram_on_signal is only supported with the generational heap, ignored.");
+      gc_class_histogram_on_signal = FALSE;
+    }
+  }
+
+  if (vm_property_is_set("gc.heap_dump_file", VM_PROPERTIES) == 1) {
+    char* value = vm_properties_get_value("gc.heap_dump_file", VM_PROPERTIES);
+    gc_heap_dump_file = strdup(value);
+    vm_properties_destroy_value(value);
+  }
+
   if (vm_property_is_set("gc.gen_mode", VM_PROPERTIES) == 1) {
     Boolean gen_mode = vm_property_get_boolean("gc.gen_mode");
     gc_set_gen_mode(gen_mode);
@@ -234,8 +353,17 @@ GC* gc_parse_options()
   min_heap_size_bytes = min_heap_size;
   max_heap_size_bytes = max_heap_size;
 
+  if (vm_property_is_set("gc.soft_max_heap_size", VM_PROPERTIES) == 1) {
+    gc_soft_max_heap_size = vm_property_get_size("gc.soft_max_heap_size");
+    if(gc_soft_max_heap_size >= max_heap_size) gc_soft_max_heap_size = 0;
+  }
+
   if (vm_property_is_set("gc.nos_size", VM_PROPERTIES) == 1) {
     NOS_SIZE = vm_property_get_size("gc.nos_size");
+    if(NOS_SIZE && gc_pause_target){
+      LWARN(75, "gc.pause_target is ignored, the NOS size is fixed by gc.nos_size.");
+      gc_pause_target = 0;
+    }
   }
 
   if (vm_property_is_set("gc.min_nos_size", VM_PROPERTIES) == 1) {
@@ -294,6 +422,10 @@ GC* gc_parse_options()
     IGNORE_FINREF = vm_property_get_boolean("gc.ignore_finref");
   }
 
+  if (vm_property_is_set("gc.softref_lru_ms_per_mb", VM_PROPERTIES) == 1) {
+    gc_softref_lru_ms_per_mb = vm_property_get_integer("gc.softref_lru_ms_per_mb");
+  }
+
   if (vm_property_is_set("gc.verify", VM_PROPERTIES) == 1) {
     char* value = vm_properties_get_value("gc.verify", VM_PROPERTIES);
     GC_VERIFY = strdup(value);
@@ -309,13 +441,21 @@ GC* gc_parse_options()
     JVMTI_HEAP_ITERATION = vm_property_get_boolean("gc.heap_iteration");
   }
 
+  if (vm_property_is_set("gc.mark_steal", VM_PROPERTIES) == 1) {
+    GC_MARK_STEAL = vm_property_get_boolean("gc.mark_steal");
+  }
+
   if (vm_property_is_set("gc.ignore_vtable_tracing", VM_PROPERTIES) == 1) {
     IGNORE_VTABLE_TRACING = vm_property_get_boolean("gc.ignore_vtable_tracing");
   }
 
   if (vm_property_is_set("gc.use_large_page", VM_PROPERTIES) == 1){
     char* value = vm_properties_get_value("gc.use_large_page", VM_PROPERTIES);
-    large_page_hint = strdup(value);
+    /* "thp" asks for transparent huge pages, anything else is a hugetlbfs mount point */
+    if(!strcmp(value, "thp"))
+      gc_use_thp = TRUE;
+    else
+      large_page_hint = strdup(value);
     vm_properties_destroy_value(value);
   }
 
@@ -421,6 +561,16 @@ GC* gc_parse_options()
   if(vm_property_is_set("gc.mark_prefetch",VM_PROPERTIES) ==1) {
     mark_prefetch = vm_property_get_boolean("gc.mark_prefetch");
   }  
+
+  if(vm_property_is_set("gc.mark_prefetch_distance",VM_PROPERTIES) ==1) {
+    int distance = vm_property_get_integer("gc.mark_prefetch_distance");
+    if(distance < 1) distance = 1;
+    if(distance > PREFETCH_FIFO_MAX_SIZE) distance = PREFETCH_FIFO_MAX_SIZE;
+    mark_prefetch_distance = (unsigned int)distance;
+    if(!mark_prefetch) {
+      LWARN(68, "Mark prefetch distance set with mark prefetch disabled!");
+    }
+  }
 #endif
 
   return gc;
@@ -0,0 +1,60 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _GC_PHASE_TIME_H_
+#define _GC_PHASE_TIME_H_
+
+#include "gc_platform.h"
+
+/* The wall time of the phases of a collection, measured in every build.
+   A phase is ended where the collection is single threaded: in the thread that runs the
+   collection, or in the section the last collector of a pass runs alone. The time since the
+   previous phase end is added to the phase, so a phase can be ended more than once. */
+
+enum GC_Phase{
+  GC_PHASE_ROOTSET,     /* stopping the threads and enumerating the roots */
+  GC_PHASE_MARK,        /* marking, or tracing and copying in a minor collection */
+  GC_PHASE_REFERENCE,   /* finalizable objects and weak references */
+  GC_PHASE_COMPACT,     /* computing the targets and moving the objects */
+  GC_PHASE_FIX,         /* repointing the references to the moved objects */
+  GC_PHASE_LOS,         /* LOS sweeping or compaction */
+  GC_PHASE_OTHER,       /* the rest, the space adaptation for example */
+  GC_PHASE_NUM
+};
+
+typedef struct GC_Phase_Times{
+  int64 phase_time[GC_PHASE_NUM];
+  int64 last_phase_end;
+}GC_Phase_Times;
+
+extern GC_Phase_Times gc_phase_times;
+extern const char* gc_phase_names[GC_PHASE_NUM];
+
+inline void gc_phase_times_reset(int64 collection_start_time)
+{
+  memset(gc_phase_times.phase_time, 0, sizeof(gc_phase_times.phase_time));
+  gc_phase_times.last_phase_end = collection_start_time;
+}
+
+inline void gc_phase_end(GC_Phase phase)
+{
+  int64 now = time_now();
+  gc_phase_times.phase_time[phase] += now - gc_phase_times.last_phase_end;
+  gc_phase_times.last_phase_end = now;
+}
+
+#endif /* _GC_PHASE_TIME_H_ */
@@ -43,6 +43,8 @@
 #include <open/hythread_ext.h>
 
 extern char* large_page_hint;
+extern Boolean gc_use_thp;
+extern POINTER_SIZE_INT gc_heap_page_size;
 
 #ifndef _DEBUG
 
@@ -84,6 +86,8 @@ extern char* large_page_hint;
 
 #ifdef PREFETCH_SUPPORTED
 extern Boolean mark_prefetch;
+/* how many objects or slots the tracing loops prefetch ahead when mark_prefetch is on */
+extern unsigned int mark_prefetch_distance;
 #endif
 
 #define ABS_DIFF(x, y) (((x)>(y))?((x)-(y)):((y)-(x)))
@@ -199,6 +203,7 @@ inline U_32 atomic_add32(volatile unsigned int  *mem, unsigned int  val)
 
 #ifndef _WINDOWS_
 #include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 inline unsigned int vm_get_system_alloc_unit()
@@ -278,6 +283,21 @@ inline void *vm_reserve_mem(void* start, POINTER_SIZE_INT size)
   return address;
 }
 
+/* unlike vm_reserve_mem, start is only a hint and existing mappings are never replaced.
+   The caller has to check where the memory is actually reserved. */
+inline void *vm_reserve_mem_near(void* start, POINTER_SIZE_INT size)
+{
+  void* address;
+#ifdef _WINDOWS_
+  address = VirtualAlloc(start, size, MEM_RESERVE, PAGE_READWRITE);
+#else
+  address = mmap(start, size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+  if(address == MAP_FAILED) address = NULL;
+#endif /* ifdef _WINDOWS_ else */
+
+  return address;
+}
+
 inline Boolean vm_release_mem(void* start, POINTER_SIZE_INT size) 
 {
   return vm_unmap_mem(start, size);
@@ -312,6 +332,18 @@ inline Boolean vm_decommit_mem(void* start, POINTER_SIZE_INT size)
   return result;
 }
 
+/* gives the physical pages back to the OS. The memory stays committed and reads as zeros
+   when it's touched again. */
+inline Boolean vm_discard_mem(void* start, POINTER_SIZE_INT size)
+{
+#ifdef _WINDOWS_
+  if(!VirtualFree(start, size, MEM_DECOMMIT)) return FALSE;
+  return VirtualAlloc(start, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+  return madvise(start, size, MADV_DONTNEED) == 0;
+#endif /* ifdef _WINDOWS_ else */
+}
+
 inline void mem_fence()
 {
   port_rw_barrier(); 
@@ -320,6 +352,15 @@ inline void mem_fence()
 inline int64 time_now() 
 {  return apr_time_now(); }
 
+inline unsigned int vm_get_process_id()
+{
+#ifdef _WINDOWS_
+  return (unsigned int)GetCurrentProcessId();
+#else
+  return (unsigned int)getpid();
+#endif
+}
+
 inline void string_to_upper(char* s)
 {
   while(*s){
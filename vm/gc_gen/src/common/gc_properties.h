@@ -24,7 +24,9 @@ enum GC_CAUSE{
   GC_CAUSE_LOS_IS_FULL,
   GC_CAUSE_MOS_IS_FULL,
   GC_CAUSE_RUNTIME_FORCE_GC,
-  GC_CAUSE_CONCURRENT_GC
+  GC_CAUSE_CONCURRENT_GC,
+  GC_CAUSE_HEAP_DUMP,
+  GC_CAUSE_CLASS_HISTOGRAM
 };
 
 extern unsigned int GC_PROP;
@@ -21,6 +21,42 @@
 #define LOG_DOMAIN "gc.base"
 #include "gc_common.h"
 char* large_page_hint = NULL;
+/* gc.use_large_page=thp, or the fallback if the hugetlbfs pages can't be had */
+Boolean gc_use_thp = FALSE;
+/* the page size the heap is backed with */
+POINTER_SIZE_INT gc_heap_page_size = 0;
+
+static void thp_unavailable()
+{
+  LWARN(71, "GC large_page: Transparent huge pages are not available.\nGC large_page: Check that /sys/kernel/mm/transparent_hugepage/enabled is not set to never.");
+  LWARN(47, "GC use small pages.");
+  gc_use_thp = FALSE;
+}
+
+/* the alignment the heap needs to get transparent huge pages, 0 if they are not used */
+POINTER_SIZE_INT thp_heap_alignment()
+{
+  if(!gc_use_thp) return 0;
+
+  POINTER_SIZE_INT huge_page_size = port_vmem_huge_page_size();
+  if(huge_page_size == 0) thp_unavailable();
+  return huge_page_size;
+}
+
+void thp_advise_heap(void* start, POINTER_SIZE_INT size)
+{
+  /* the heap is in hugetlbfs pages already */
+  if(large_page_hint) return;
+
+  gc_heap_page_size = port_vmem_page_sizes()[0];
+  if(!gc_use_thp) return;
+
+  if(port_vmem_advise_huge_pages(start, size) != APR_SUCCESS){
+    thp_unavailable();
+    return;
+  }
+  gc_heap_page_size = port_vmem_huge_page_size();
+}
 
 #if defined (_WINDOWS_)
 Boolean set_privilege(HANDLE process, LPCTSTR priv_name, Boolean is_enable)
@@ -71,8 +107,10 @@ void* alloc_large_pages(size_t size, const char* hint)
     if(alloc_addr == NULL){
       LWARN(49, "GC large_page: No required number of large pages found. Please reboot.....");
       return NULL;
-    }else
+    }else{
+      gc_heap_page_size = port_vmem_page_sizes()[1];
       return alloc_addr;
+    }
   }else{
     LWARN(50, "GC large_page: Check that you have permissions:\nGC large_page: Control Panel->Administrative Tools->Local Security Settings->->User Rights Assignment->Lock pages in memory.\nGC large_page: Start VM as soon after reboot as possible, because large pages become fragmented and unusable after a while.\nGC large_page: Heap size should be multiple of large page size.");
     return NULL;
@@ -172,6 +210,7 @@ void* alloc_large_pages(size_t size, const char* hint){
     LWARN(58, "GC large_page: Large pages allocation failed.");
     return NULL;
   }
+  gc_heap_page_size = proc_huge_page_size;
   return alloc_addr;
 }
 #elif defined(FREEBSD)
@@ -23,6 +23,7 @@
 #include "../thread/collector.h"
 #include "../gen/gen.h"
 #include "../finalizer_weakref/finalizer_weakref.h"
+#include "../utils/prefetch_fifo.h"
 
 #ifdef GC_GEN_STATS
 #include "../gen/gen_stats.h"
@@ -33,7 +34,7 @@ static FORCE_INLINE void scan_slot(Collector* collector, REF *p_ref)
   if( p_obj == NULL) return;
 
   if(obj_mark_in_vt(p_obj))
-    collector_tracestack_push(collector, p_obj);
+    collector_markstack_push(collector, p_obj);
 #ifdef GC_GEN_STATS
     GC_Gen_Collector_Stats* stats = (GC_Gen_Collector_Stats*)collector->stats;
     gc_gen_collector_update_marked_obj_stats_major(stats);
@@ -53,7 +54,7 @@ static FORCE_INLINE void scan_object(Collector* collector, Partial_Reveal_Object
     if(vtable->vtmark == VT_UNMARKED) {
       vtable->vtmark = VT_MARKED;
       if(obj_mark_in_vt(vtable->jlC))
-        collector_tracestack_push(collector, vtable->jlC);
+        collector_markstack_push(collector, vtable->jlC);
     }
   
   if( !object_has_ref_field(p_obj) ) return;
@@ -68,6 +69,10 @@ static FORCE_INLINE void scan_object(Collector* collector, Partial_Reveal_Object
     p_ref = (REF *)((POINTER_SIZE_INT)array + (int)array_first_element_offset(array));
 
     for (unsigned int i = 0; i < array_length; i++) {
+#ifdef PREFETCH_SUPPORTED
+      if(mark_prefetch && i + mark_prefetch_distance < array_length)
+        PREFETCH(read_slot(p_ref + i + mark_prefetch_distance));
+#endif
       scan_slot(collector, p_ref+i);
     }   
 
@@ -77,6 +82,10 @@ static FORCE_INLINE void scan_object(Collector* collector, Partial_Reveal_Object
     int* ref_iterator = object_ref_iterator_init(p_obj);
     
     for(unsigned int i=0; i<num_refs; i++){  
+#ifdef PREFETCH_SUPPORTED
+      if(mark_prefetch && i + 1 < num_refs)
+        PREFETCH(read_slot(object_ref_iterator_get(ref_iterator+i+1, p_obj)));
+#endif
       p_ref = object_ref_iterator_get(ref_iterator+i, p_obj);  
       scan_slot(collector, p_ref);
     }    
@@ -90,23 +99,161 @@ static FORCE_INLINE void scan_object(Collector* collector, Partial_Reveal_Object
 }
 
 
+#ifdef PREFETCH_SUPPORTED
+/* The grey objects are popped mark_prefetch_distance objects ahead of scanning,
+   and their headers are prefetched when they are popped. */
+static void drain_markstack_prefetch(Collector* collector)
+{
+  Prefetch_Fifo fifo;
+  prefetch_fifo_init(&fifo);
+
+  while(TRUE){
+    while(prefetch_fifo_size(&fifo) < mark_prefetch_distance){
+      Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)collector_markstack_pop(collector);
+      if(!p_obj) break;
+      PREFETCH(p_obj);
+      prefetch_fifo_put(&fifo, (POINTER_SIZE_INT)p_obj);
+    }
+    if(prefetch_fifo_is_empty(&fifo)) break;
+    scan_object(collector, (Partial_Reveal_Object*)prefetch_fifo_get(&fifo));
+  }
+}
+#endif
+
+static void drain_markstack(Collector* collector)
+{
+#ifdef PREFETCH_SUPPORTED
+  if(mark_prefetch){
+    drain_markstack_prefetch(collector);
+    return;
+  }
+#endif
+
+  Partial_Reveal_Object* p_obj;
+  while((p_obj = (Partial_Reveal_Object*)collector_markstack_pop(collector)))
+    scan_object(collector, p_obj);
+}
+
 static void trace_object(Collector* collector, Partial_Reveal_Object *p_obj)
 { 
   scan_object(collector, p_obj);
-  
-  Vector_Block* trace_stack = collector->trace_stack;
-  while( !vector_stack_is_empty(trace_stack)){
-    p_obj = (Partial_Reveal_Object *)vector_stack_pop(trace_stack); 
-    scan_object(collector, p_obj);
-    trace_stack = collector->trace_stack;
-  }
-    
+  drain_markstack(collector);
   return; 
 }
 
 /* for marking phase termination detection */
 static volatile unsigned int num_finished_collectors = 0;
 
+/* ============================================================================ */
+/* Work-stealing marking. 
+   Every collector marks from its own Stealable_Stack, roots included. Overflowed entries
+   go to the trace_stack and then to mark_task_pool as full Vector_Blocks. An idle collector
+   first takes a whole block from mark_task_pool, then tries to steal single objects from
+   randomly picked victims, and finally enters the termination protocol below. */
+
+Boolean GC_MARK_STEAL = FALSE;
+
+static volatile unsigned int num_finished_markers = 0;
+
+void collector_mark_steal_init(Collector* collector)
+{
+  /* reset by the first collector coming in, as num_finished_collectors above */
+  atomic_cas32(&num_finished_markers, 0, collector->gc->num_active_collectors);
+}
+
+static FORCE_INLINE unsigned int collector_next_victim(Collector* collector, unsigned int num_active_collectors)
+{
+  /* xorshift, good enough to spread the thieves */
+  unsigned int seed = collector->steal_seed;
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  collector->steal_seed = seed;
+  return seed % num_active_collectors;
+}
+
+static Boolean collector_mark_steal_task(Collector* collector)
+{
+  GC* gc = collector->gc;
+  GC_Metadata* metadata = gc->metadata;
+
+  /* overflowed tasks are taken as a whole: they become our trace_stack */
+  Vector_Block* mark_task = pool_get_entry(metadata->mark_task_pool);
+  if(mark_task){
+    Vector_Block* trace_stack = collector->trace_stack;
+    assert(vector_stack_is_empty(trace_stack));
+    vector_stack_clear(trace_stack);
+    pool_put_entry(metadata->free_task_pool, trace_stack);
+    collector->trace_stack = mark_task;
+    return TRUE;
+  }
+
+  unsigned int num_active_collectors = gc->num_active_collectors;
+  if(num_active_collectors == 1) return FALSE;
+
+  for(unsigned int i = 0; i < 2*num_active_collectors; i++){
+    Collector* victim = gc->collectors[collector_next_victim(collector, num_active_collectors)];
+    if(victim == collector) continue;
+
+    POINTER_SIZE_INT p_obj = stealable_stack_steal(victim->mark_stack);
+    if(p_obj){
+      collector_markstack_push(collector, (void*)p_obj);
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+static Boolean gc_has_mark_task(GC* gc)
+{
+  if(!pool_is_empty(gc->metadata->mark_task_pool)) return TRUE;
+
+  unsigned int num_active_collectors = gc->num_active_collectors;
+  for(unsigned int i = 0; i < num_active_collectors; i++)
+    if(!stealable_stack_is_empty(gc->collectors[i]->mark_stack)) return TRUE;
+
+  return FALSE;
+}
+
+/* Only an idle collector (empty mark stack and trace_stack) counts itself as finished. 
+   Tasks are only generated by collectors that are not counted, so when all are counted 
+   there is no task anywhere and marking is done. A counted collector that sees some task 
+   uncounts itself and goes back to stealing. */
+static Boolean collector_mark_steal_terminate(Collector* collector)
+{
+  GC* gc = collector->gc;
+  unsigned int num_active_collectors = gc->num_active_collectors;
+
+  assert(stealable_stack_is_empty(collector->mark_stack));
+  assert(vector_stack_is_empty(collector->trace_stack));
+
+  atomic_inc32(&num_finished_markers);
+  while(num_finished_markers != num_active_collectors){
+    if(gc_has_mark_task(gc)){
+      atomic_dec32(&num_finished_markers);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/* Marks till no collector has anything left, shared by all the mark paths with gc.mark_steal.
+   The entries of the mark stacks are the business of drain, which empties the mark stack
+   of the collector: they are objects, or slots for the fallback marking. */
+void collector_mark_steal(Collector* collector, Mark_Drain_Func drain)
+{
+  do{
+    drain(collector);
+  }while(collector_mark_steal_task(collector) || !collector_mark_steal_terminate(collector));
+
+  GC_Metadata* metadata = collector->gc->metadata;
+  vector_stack_clear(collector->trace_stack);
+  pool_put_entry(metadata->free_task_pool, collector->trace_stack);
+  collector->trace_stack = NULL;
+}
+
 /* NOTE:: Only marking in object header is idempotent.
    Originally, we have to mark the object before put it into markstack, to 
    guarantee there is only one occurrance of an object in markstack. This is to
@@ -133,6 +280,7 @@ void mark_scan_pool(Collector* collector)
   /* reset the num_finished_collectors to be 0 by one collector. This is necessary for the barrier later. */
   unsigned int num_active_collectors = gc->num_active_collectors;
   atomic_cas32( &num_finished_collectors, 0, num_active_collectors);
+  if(GC_MARK_STEAL) collector_mark_steal_init(collector);
    
   collector->trace_stack = free_task_pool_get_entry(metadata);
 
@@ -157,7 +305,7 @@ void mark_scan_pool(Collector* collector)
          This can be worked around if we want. 
       */
       if(obj_mark_in_vt(p_obj)){
-        collector_tracestack_push(collector, p_obj);
+        collector_markstack_push(collector, p_obj);
 #ifdef GC_GEN_STATS
         gc_gen_collector_update_rootset_ref_num(stats);
         gc_gen_collector_update_marked_obj_stats_major(stats);
@@ -167,6 +315,13 @@ void mark_scan_pool(Collector* collector)
     } 
     root_set = pool_iterator_next(metadata->gc_rootset_pool);
   }
+
+  if(GC_MARK_STEAL){
+    /* roots stay in our own mark stack, idle collectors steal them */
+    collector_mark_steal(collector, drain_markstack);
+    return;
+  }
+
   /* put back the last trace_stack task */    
   pool_put_entry(metadata->mark_task_pool, collector->trace_stack);
   
@@ -0,0 +1,279 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "object_pin.h"
+#include <vector>
+
+/* The pinned objects are kept in an open addressing hash table with their pin count,
+   so that a lookup costs the same with any number of pins. The table is at most
+   half full and grows by doubling, an entry is removed by shifting back the entries
+   that follow it in its probe sequence, so there are no deleted entries. */
+typedef struct pinned_obj_entry_struct{
+  Partial_Reveal_Object* p_obj;
+  unsigned int count;
+} pinned_obj_entry;
+
+#define PIN_TABLE_INIT_CAPACITY 64
+
+static pinned_obj_entry* pinned_obj_table = NULL;
+static unsigned int pinned_obj_table_capacity = 0; /* power of 2 */
+static SpinLock pinned_obj_table_lock = FREE_LOCK;
+volatile unsigned int num_pinned_objects = 0;
+
+/* blocks set to BLOCK_PINNED in current (or last) collection */
+static std::vector<Block_Header*> pinned_block_list;
+unsigned int num_pinned_blocks = 0;
+
+Boolean gc_obj_is_pinnable(GC* gc, Partial_Reveal_Object* p_obj)
+{
+  /* the unique mark-sweep and move-compact gc don't pin objects */
+  if(gc_is_unique_space()) return FALSE;
+
+  if(!address_belongs_to_gc_heap(p_obj, gc)) return FALSE;
+
+  /* LOS objects are only slid by LOS compaction, which can leave a hole for them */
+  if(gc_has_los() && (void*)p_obj < los_boundary) return TRUE;
+
+  /* semi-space NOS and mark-sweep MOS have no block status to keep a block in place */
+  if(minor_is_semispace() || major_is_marksweep()) return FALSE;
+
+  return TRUE;
+}
+
+inline unsigned int pin_table_hash(Partial_Reveal_Object* p_obj, unsigned int capacity)
+{
+  POINTER_SIZE_INT key = (POINTER_SIZE_INT)p_obj >> 3;
+  return (unsigned int)((key ^ (key >> 10) ^ (key >> 20)) & (capacity - 1));
+}
+
+/* the entry of p_obj, or the empty entry where it would be */
+static pinned_obj_entry* pin_table_find_slot(pinned_obj_entry* table, unsigned int capacity, Partial_Reveal_Object* p_obj)
+{
+  unsigned int index = pin_table_hash(p_obj, capacity);
+  while(table[index].p_obj != NULL && table[index].p_obj != p_obj)
+    index = (index + 1) & (capacity - 1);
+  return &table[index];
+}
+
+static void pin_table_grow()
+{
+  unsigned int capacity = pinned_obj_table_capacity ? pinned_obj_table_capacity << 1 : PIN_TABLE_INIT_CAPACITY;
+  unsigned int size = capacity * sizeof(pinned_obj_entry);
+  pinned_obj_entry* table = (pinned_obj_entry*)STD_MALLOC(size);
+  assert(table);
+  memset(table, 0, size);
+
+  for(unsigned int i=0; i<pinned_obj_table_capacity; i++)
+    if(pinned_obj_table[i].p_obj != NULL)
+      *pin_table_find_slot(table, capacity, pinned_obj_table[i].p_obj) = pinned_obj_table[i];
+
+  if(pinned_obj_table) STD_FREE(pinned_obj_table);
+  pinned_obj_table = table;
+  pinned_obj_table_capacity = capacity;
+}
+
+static void pin_table_remove_entry(pinned_obj_entry* entry)
+{
+  unsigned int mask = pinned_obj_table_capacity - 1;
+  unsigned int hole = (unsigned int)(entry - pinned_obj_table);
+  unsigned int index = hole;
+  while(TRUE){
+    index = (index + 1) & mask;
+    Partial_Reveal_Object* p_obj = pinned_obj_table[index].p_obj;
+    if(p_obj == NULL) break;
+    /* the entry can fill the hole if its home is not in (hole, index] */
+    unsigned int home = pin_table_hash(p_obj, pinned_obj_table_capacity);
+    if(((index - home) & mask) >= ((index - hole) & mask)){
+      pinned_obj_table[hole] = pinned_obj_table[index];
+      hole = index;
+    }
+  }
+  pinned_obj_table[hole].p_obj = NULL;
+  pinned_obj_table[hole].count = 0;
+}
+
+void gc_pin_table_add(Partial_Reveal_Object* p_obj)
+{
+  lock(pinned_obj_table_lock);
+  if((num_pinned_objects + 1) * 2 > pinned_obj_table_capacity)
+    pin_table_grow();
+  pinned_obj_entry* entry = pin_table_find_slot(pinned_obj_table, pinned_obj_table_capacity, p_obj);
+  if(entry->p_obj == NULL){
+    entry->p_obj = p_obj;
+    num_pinned_objects++;
+  }
+  entry->count++;
+  unlock(pinned_obj_table_lock);
+}
+
+void gc_pin_table_remove(Partial_Reveal_Object* p_obj)
+{
+  lock(pinned_obj_table_lock);
+  /* the object might be unpinnable when it was pinned */
+  if(num_pinned_objects){
+    pinned_obj_entry* entry = pin_table_find_slot(pinned_obj_table, pinned_obj_table_capacity, p_obj);
+    if(entry->p_obj != NULL && --entry->count == 0){
+      pin_table_remove_entry(entry);
+      num_pinned_objects--;
+    }
+  }
+  unlock(pinned_obj_table_lock);
+}
+
+Boolean gc_pin_table_contains(Partial_Reveal_Object* p_obj)
+{
+  if(!num_pinned_objects) return FALSE;
+
+  lock(pinned_obj_table_lock);
+  Boolean result = obj_is_pinned(p_obj);
+  unlock(pinned_obj_table_lock);
+  return result;
+}
+
+Boolean obj_is_pinned(Partial_Reveal_Object* p_obj)
+{
+  if(!num_pinned_objects) return FALSE;
+  return pin_table_find_slot(pinned_obj_table, pinned_obj_table_capacity, p_obj)->p_obj != NULL;
+}
+
+/* The objects in a pinned block can be marked in vt (major collection) or in oi (minor collection),
+   or carry a stale oi mark bit from last minor collection, which is this collection's fw bit after
+   the bits flipping. */
+static void pinned_block_clear_marks(Block_Header* block, Boolean clear_vt)
+{
+  Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)block->base;
+  Partial_Reveal_Object* block_end = (Partial_Reveal_Object*)block->free;
+
+  while(p_obj < block_end){
+    if(obj_vt_is_to_next_obj(p_obj)){
+      p_obj = obj_get_next_obj_from_vt(p_obj);
+      continue;
+    }
+    if(clear_vt) obj_clear_dual_bits_in_vt(p_obj);
+    obj_clear_dual_bits_in_oi(p_obj);
+    p_obj = obj_end(p_obj);
+  }
+}
+
+void gc_prepare_pinned_blocks(GC* gc)
+{
+  /* A fallback collection follows a failed minor collection, where NOS blocks were already pinned.
+     It goes on to pin MOS blocks. */
+  Boolean is_fallback = collect_is_fallback();
+  if(!is_fallback){
+    pinned_block_list.clear();
+    num_pinned_blocks = 0;
+  }
+
+  if(!num_pinned_objects) return;
+
+  Boolean is_major = collect_is_major();
+  for(unsigned int i=0; i<pinned_obj_table_capacity; i++){
+    Partial_Reveal_Object* p_obj = pinned_obj_table[i].p_obj;
+    if(p_obj == NULL || (void*)p_obj < los_boundary) continue;
+    /* minor collection never moves MOS objects */
+    if(!is_major && !obj_belongs_to_nos(p_obj)) continue;
+
+    Block_Header* block = GC_BLOCK_HEADER(p_obj);
+    if(block->status == BLOCK_PINNED) continue;
+
+    block->status = BLOCK_PINNED;
+    block->new_free = block->free;
+    /* move-compact looks up the offset table for forwarding address of objects in MOS and NOS */
+    block_clear_table(block);
+    if(is_fallback) pinned_block_clear_marks(block, FALSE);
+    pinned_block_list.push_back(block);
+  }
+
+  num_pinned_blocks = (unsigned int)pinned_block_list.size();
+}
+
+/* The dead objects of a pinned block stay in place with references that were not fixed, so
+   every run of them is turned into one that the block walkers skip (see obj_set_vt_to_next_obj),
+   and the marks of the live objects are cleared. The live objects are marked in vt (major
+   collection), in the mark bitmap (slide-compact with gc.mark_bitmap, whose bits stay till next
+   such collection), or with this collection's mark bit in oi (minor collection). */
+static void pinned_block_reset(Block_Header* block, Boolean is_major, Boolean marks_in_bitmap)
+{
+  Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)block->base;
+  Partial_Reveal_Object* block_end = (Partial_Reveal_Object*)block->free;
+  Partial_Reveal_Object* dead_start = NULL;
+
+  while(p_obj < block_end){
+    Partial_Reveal_Object* next_obj;
+    Boolean is_live;
+    if(obj_vt_is_to_next_obj(p_obj)){
+      next_obj = obj_get_next_obj_from_vt(p_obj);
+      is_live = FALSE;
+    }else{
+      next_obj = obj_end(p_obj);
+      if(marks_in_bitmap)
+        is_live = mark_bitmap_is_marked(p_obj);
+      else if(is_major)
+        is_live = obj_is_marked_in_vt(p_obj);
+      else
+        is_live = obj_is_marked_in_oi(p_obj);
+    }
+
+    if(is_live){
+      if(dead_start){
+        obj_set_vt_to_next_obj(dead_start, p_obj);
+        dead_start = NULL;
+      }
+      obj_clear_dual_bits_in_vt(p_obj);
+      obj_clear_dual_bits_in_oi(p_obj);
+    }else if(!dead_start){
+      dead_start = p_obj;
+    }
+    p_obj = next_obj;
+  }
+  if(dead_start) obj_set_vt_to_next_obj(dead_start, block_end);
+}
+
+void gc_reset_pinned_blocks(GC* gc)
+{
+  Boolean is_major = collect_is_major();
+  Boolean marks_in_bitmap = is_major && gc_mark_bitmap && major_is_compact_slide();
+
+  /* the list is kept till next collection, so that the spaces can still query it after the collection */
+  for(unsigned int i=0; i<num_pinned_blocks; i++){
+    Block_Header* block = pinned_block_list[i];
+    pinned_block_reset(block, is_major, marks_in_bitmap);
+    block->status = BLOCK_USED;
+  }
+}
+
+Boolean blocked_space_has_pinned_blocks(Blocked_Space* space)
+{
+  for(unsigned int i=0; i<num_pinned_blocks; i++){
+    unsigned int block_idx = pinned_block_list[i]->block_idx;
+    if(block_idx >= space->first_block_idx && block_idx <= space->ceiling_block_idx)
+      return TRUE;
+  }
+  return FALSE;
+}
+
+unsigned int blocked_space_last_pinned_block_idx(Blocked_Space* space)
+{
+  unsigned int last_idx = 0;
+  for(unsigned int i=0; i<num_pinned_blocks; i++){
+    unsigned int block_idx = pinned_block_list[i]->block_idx;
+    if(block_idx >= space->first_block_idx && block_idx <= space->ceiling_block_idx && block_idx > last_idx)
+      last_idx = block_idx;
+  }
+  return last_idx;
+}
@@ -0,0 +1,61 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _OBJECT_PIN_H_
+#define _OBJECT_PIN_H_
+
+#include "gc_common.h"
+#include "gc_space.h"
+
+/* Object pinning, used by JNI critical sections to hand out direct pointers.
+   Pinned objects are kept in a hash table with a pin count.
+   A pinned LOS object is simply not slid by the LOS compaction.
+   For NOS and MOS the granularity is a block: at the beginning of each collection,
+   every block that holds a pinned object is set to BLOCK_PINNED, and all objects
+   in it stay in place, i.e., they are neither forwarded nor compacted, and the block
+   is not given to any collector as compaction target. The block is set back to
+   BLOCK_USED after the collection, when its dead objects are turned into runs the
+   block walkers skip, since their references were not fixed. */
+
+extern volatile unsigned int num_pinned_objects;
+extern unsigned int num_pinned_blocks;
+
+Boolean gc_obj_is_pinnable(GC* gc, Partial_Reveal_Object* p_obj);
+void gc_pin_table_add(Partial_Reveal_Object* p_obj);
+void gc_pin_table_remove(Partial_Reveal_Object* p_obj);
+Boolean gc_pin_table_contains(Partial_Reveal_Object* p_obj);
+/* same as gc_pin_table_contains without the lock, for the collectors: the table doesn't
+   change during a collection, since the mutators pin objects with gc disabled */
+Boolean obj_is_pinned(Partial_Reveal_Object* p_obj);
+
+/* called when the world is stopped, before and after the real collection */
+void gc_prepare_pinned_blocks(GC* gc);
+void gc_reset_pinned_blocks(GC* gc);
+
+Boolean blocked_space_has_pinned_blocks(Blocked_Space* space);
+unsigned int blocked_space_last_pinned_block_idx(Blocked_Space* space);
+
+/* only valid inside a collection */
+FORCE_INLINE Boolean obj_is_in_pinned_block(Partial_Reveal_Object* p_obj)
+{
+  if(!num_pinned_blocks) return FALSE;
+  /* LOS is not organized in blocks */
+  if((void*)p_obj < los_boundary) return FALSE;
+  return GC_BLOCK_HEADER(p_obj)->status == BLOCK_PINNED;
+}
+
+#endif /* _OBJECT_PIN_H_ */
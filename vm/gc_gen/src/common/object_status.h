@@ -22,6 +22,7 @@
 #include "../mark_sweep/gc_ms.h"
 #include "../move_compact/gc_mc.h"
 #include "../mark_sweep/wspace_mark_sweep.h"
+#include "object_pin.h"
 
 
 inline Boolean obj_is_dead_in_gen_minor_gc(Partial_Reveal_Object *p_obj)
@@ -33,12 +34,17 @@ inline Boolean obj_is_dead_in_gen_minor_gc(Partial_Reveal_Object *p_obj)
    * In partially forwarding situation live objects in the non-forwarding half NOS will only be marked but not forwarded.
    * FIXME:: new implementation of partial forwarding does not use MARK_BIT for non-fw objects. 
    * so I changed the original  obj_is_marked_or_fw_in_oi(p_obj) to obj_is_fw_in_oi(p_obj).
+   * Live objects in pinned blocks are not forwarded but marked.
    */
-  return obj_belongs_to_nos(p_obj) && !obj_is_fw_in_oi(p_obj);
+  return obj_belongs_to_nos(p_obj) && !obj_is_fw_in_oi(p_obj)
+          && !(obj_is_in_pinned_block(p_obj) && obj_is_marked_in_oi(p_obj));
 }
 
 inline Boolean obj_is_dead_in_nongen_minor_gc(Partial_Reveal_Object *p_obj)
 {
+  if(obj_belongs_to_nos(p_obj) && obj_is_in_pinned_block(p_obj))
+    return !obj_is_marked_in_oi(p_obj);
+
   return (obj_belongs_to_nos(p_obj) && !obj_is_fw_in_oi(p_obj))
           || (!obj_belongs_to_nos(p_obj) && !obj_is_marked_in_oi(p_obj));
 }
@@ -109,6 +115,9 @@ inline Boolean obj_need_move(GC *gc, Partial_Reveal_Object *p_obj)
   Cspace *cspace = gc_mc_get_cspace((GC_MC*)gc);
   return cspace->move_object;
 #endif
+  /* objects in pinned blocks are kept in place by both minor and major collections */
+  if(obj_is_in_pinned_block(p_obj)) return FALSE;
+
   if(collect_is_minor()){
     if(!obj_belongs_to_nos(p_obj)) return FALSE;
     if(minor_is_semispace())
@@ -21,6 +21,7 @@
 
 #include "space_tuner.h"
 #include <math.h>
+#include "object_pin.h"
 
 struct GC_Gen;
 struct Mspace;
@@ -97,6 +98,9 @@ void gc_compute_space_tune_size_before_marking(GC* gc)
 {
   if(collect_is_minor())  return;
   
+  /* the blocks holding pinned objects can't be transferred between MOS and LOS */
+  if(num_pinned_objects) return;
+
   gc_decide_space_tune(gc);
   
   Space_Tuner* tuner = gc->tuner;
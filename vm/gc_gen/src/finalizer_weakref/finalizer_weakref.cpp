@@ -21,6 +21,9 @@
 
 #include "open/types.h"
 #include "open/vm_gc.h"
+#include "open/vm_field_access.h"
+#include "open/vm_class_info.h"
+#include "open/vm_class_manipulation.h"
 #include "finalizer_weakref.h"
 #include "../thread/mutator.h"
 #include "../common/gc_metadata.h"
@@ -36,6 +39,59 @@
 Boolean IGNORE_FINREF = FALSE;
 Boolean DURING_RESURRECTION = FALSE;
 
+/* LRU soft references (gc.softref_lru_ms_per_mb=<ms>).
+ * SoftReference stamps itself with its static clock when it's created and when get() is called,
+ * and the GC sets the clock to the time of every collection. A major collection keeps the referent
+ * of a soft reference alive if the reference was used less than ms_per_mb milliseconds ago for
+ * every MB that was free after the previous collection, so the referents of the recently used
+ * references survive while there is room, and all of them are cleared when the heap is full.
+ * Without the option every soft reference is cleared by a major collection, as before.
+ */
+unsigned int gc_softref_lru_ms_per_mb = 0;
+unsigned int softref_timestamp_offset = 0;  /* 0 if the policy is off */
+int64 softref_lru_clock = 0;                /* in milliseconds */
+int64 softref_lru_interval = 0;
+static int64 *p_softref_clock = NULL;       /* SoftReference.clock */
+
+void gc_softref_class_prepared(Class_Handle ch)
+{
+  if(!gc_softref_lru_ms_per_mb || softref_timestamp_offset) return;
+  
+  Class_Handle softref_class = class_get_extended_class(ch, "java/lang/ref/SoftReference");
+  if(!softref_class) return;
+  
+  unsigned int timestamp_offset = 0;
+  int64 *p_clock = NULL;
+  unsigned int num_fields = class_number_fields(softref_class);
+  for(unsigned int i = 0; i < num_fields; i++){
+    Field_Handle field = class_get_field(softref_class, (U_16)i);
+    if(!strcmp(field_get_name(field), "timestamp"))
+      timestamp_offset = field_get_offset(field);
+    else if(!strcmp(field_get_name(field), "clock"))
+      p_clock = (int64*)field_get_address(field);
+  }
+  if(!timestamp_offset || !p_clock){
+    INFO2("gc.base", "GC: gc.softref_lru_ms_per_mb is ignored, SoftReference has no timestamp.");
+    gc_softref_lru_ms_per_mb = 0;
+    return;
+  }
+  
+  softref_lru_clock = time_now() / 1000;
+  *p_clock = softref_lru_clock;
+  p_softref_clock = p_clock;
+  softref_timestamp_offset = timestamp_offset;
+}
+
+/* called after every collection, the mutators are still suspended */
+void gc_update_softref_clock(GC *gc)
+{
+  if(!softref_timestamp_offset) return;
+  
+  softref_lru_clock = time_now() / 1000;
+  *p_softref_clock = softref_lru_clock;
+  softref_lru_interval = (gc_free_memory() / MB) * gc_softref_lru_ms_per_mb;
+}
+
 static void finref_add_repset_from_pool(GC *gc, Pool *pool)
 {
   finref_reset_repset(gc);
@@ -269,8 +325,54 @@ static void resurrect_finalizable_objects(Collector *collector)
   /* fianlizable objs have been added to finref repset pool or updated by tracing */
 }
 
+/* the ref object stays in the pool if its referent is dead, it will be enqueued */
+static inline void identify_dead_ref(Collector *collector, REF *p_ref, Vector_Block **p_repset)
+{
+  GC *gc = collector->gc;
+  Partial_Reveal_Object *p_obj = read_slot(p_ref);
+  assert(p_obj);
+  REF *p_referent_field = obj_get_referent_field(p_obj);
+  if(collect_is_fallback())
+    fallback_update_fw_ref(p_referent_field);
+    
+  Partial_Reveal_Object *p_referent = read_slot(p_referent_field);
+  
+  if(!p_referent){  
+    /* referent field has been cleared. I forgot why we set p_ref with NULL here. 
+       I guess it's because this ref_obj was processed in abother p_ref already, so
+       there is no need to keep same ref_obj in this p_ref. */
+    *p_ref = (REF)NULL;
+    return;
+  }
+  if(!gc_obj_is_dead(gc, p_referent)){  // referent is alive
+    if(obj_need_move(gc, p_referent)){
+      if(collect_is_minor()){
+        assert(obj_is_fw_in_oi(p_referent));
+        Partial_Reveal_Object* p_new_referent = obj_get_fw_in_oi(p_referent);
+        write_slot(p_referent_field, p_new_referent);
+        /* if it's gen mode, and referent stays in NOS, we need keep p_referent_field in collector remset.
+           This leads to the ref obj live even it is actually only weakly-reachable in next gen-mode collection. 
+           This simplifies the design. Otherwise, we need remember the refobj in MOS seperately and process them seperately. */
+        if(gc_is_gen_mode())
+          if(addr_belongs_to_nos(p_new_referent) && !addr_belongs_to_nos(p_obj))
+            collector_remset_add_entry(collector, ( Partial_Reveal_Object**)p_referent_field); 
+
+      } else{ // if(collect_move_object()){ the condition is redundant because obj_need_move already checks 
+        *p_repset = finref_add_repset_entry(gc, *p_repset, p_referent_field);
+      }
+    }
+    *p_ref = (REF)NULL;
+  }else{
+    /* else, the referent is dead (weakly reachable), clear the referent field */
+    *p_referent_field = (REF)NULL; 
+    /* for dead referent, p_ref is not set NULL. p_ref keeps the ref object, which
+       will be moved to VM for enqueueing. */
+  }
+}
+
 static void identify_dead_refs(GC *gc, Pool *pool)
 {
+  Finref_Metadata *metadata = gc->finref_metadata;
   if(collect_need_update_repset())
     finref_reset_repset(gc);
 
@@ -278,48 +380,8 @@ static void identify_dead_refs(GC *gc, Pool *pool)
   Vector_Block *block = pool_iterator_next(pool);
   while(block){
     POINTER_SIZE_INT *iter = vector_block_iterator_init(block);
-    for(; !vector_block_iterator_end(block, iter); iter = vector_block_iterator_advance(block, iter)){
-      REF *p_ref = (REF*)iter;
-      Partial_Reveal_Object *p_obj = read_slot(p_ref);
-      assert(p_obj);
-      REF *p_referent_field = obj_get_referent_field(p_obj);
-      if(collect_is_fallback())
-        fallback_update_fw_ref(p_referent_field);
-        
-      Partial_Reveal_Object *p_referent = read_slot(p_referent_field);
-      
-      if(!p_referent){  
-        /* referent field has been cleared. I forgot why we set p_ref with NULL here. 
-           I guess it's because this ref_obj was processed in abother p_ref already, so
-           there is no need to keep same ref_obj in this p_ref. */
-        *p_ref = (REF)NULL;
-        continue;
-      }
-      if(!gc_obj_is_dead(gc, p_referent)){  // referent is alive
-        if(obj_need_move(gc, p_referent)){
-          if(collect_is_minor()){
-            assert(obj_is_fw_in_oi(p_referent));
-            Partial_Reveal_Object* p_new_referent = obj_get_fw_in_oi(p_referent);
-            write_slot(p_referent_field, p_new_referent);
-            /* if it's gen mode, and referent stays in NOS, we need keep p_referent_field in collector remset.
-               This leads to the ref obj live even it is actually only weakly-reachable in next gen-mode collection. 
-               This simplifies the design. Otherwise, we need remember the refobj in MOS seperately and process them seperately. */
-            if(gc_is_gen_mode())
-              if(addr_belongs_to_nos(p_new_referent) && !addr_belongs_to_nos(p_obj))
-                collector_remset_add_entry(gc->collectors[0], ( Partial_Reveal_Object**)p_referent_field); 
-
-          } else{ // if(collect_move_object()){ the condition is redundant because obj_need_move already checks 
-            finref_repset_add_entry(gc, p_referent_field);
-          }
-        }
-        *p_ref = (REF)NULL;
-      }else{
-	      /* else, the referent is dead (weakly reachable), clear the referent field */
-	      *p_referent_field = (REF)NULL; 
-	      /* for dead referent, p_ref is not set NULL. p_ref keeps the ref object, which
-	         will be moved to VM for enqueueing. */
-      }
-    }/* for each ref object */
+    for(; !vector_block_iterator_end(block, iter); iter = vector_block_iterator_advance(block, iter))
+      identify_dead_ref(gc->collectors[0], (REF*)iter, &metadata->repset);
     
     block = pool_iterator_next(pool);
   }
@@ -330,6 +392,33 @@ static void identify_dead_refs(GC *gc, Pool *pool)
   }
 }
 
+/* Called by all the collectors. The blocks of work_pool are moved to pool when they are done,
+ * and every collector has its own repset block, which is put to the repset pool at the end.
+ */
+static void collector_identify_dead_refs(Collector *collector, Pool *work_pool, Pool *pool)
+{
+  GC *gc = collector->gc;
+  Boolean update_repset = collect_need_update_repset();
+  Vector_Block *repset = update_repset ? finref_get_free_block(gc) : NULL;
+
+  Vector_Block *block = pool_get_entry(work_pool);
+  while(block){
+    POINTER_SIZE_INT *iter = vector_block_iterator_init(block);
+    for(; !vector_block_iterator_end(block, iter); iter = vector_block_iterator_advance(block, iter)){
+      REF *p_ref = (REF*)iter;
+      identify_dead_ref(collector, p_ref, &repset);
+      /* same as finref_add_repset_from_pool(), the ref object of a dead referent is moved with the heap */
+      if(update_repset && *p_ref && obj_need_move(gc, read_slot(p_ref)))
+        repset = finref_add_repset_entry(gc, repset, p_ref);
+    }
+    pool_put_entry(pool, block);
+    block = pool_get_entry(work_pool);
+  }
+
+  if(update_repset)
+    pool_put_entry(gc->finref_metadata->repset_pool, repset);
+}
+
 static void identify_dead_softrefs(Collector *collector)
 {
   GC *gc = collector->gc;
@@ -496,8 +585,8 @@ static void finalizable_objs_fallback(GC *gc)
       /* Perhaps obj has been resurrected by previous resurrections. If the fin-obj was resurrected, we need put it back to obj_with_fin pool.
          For minor collection, the resurrected obj was forwarded, so we need use the new copy.*/
       if(!gc_obj_is_dead(gc, p_obj) && obj_belongs_to_nos(p_obj)){
-        /* Even in NOS, not all live objects are forwarded due to the partial-forward algortihm */ 
-        if(!NOS_PARTIAL_FORWARD || fspace_obj_to_be_forwarded(p_obj)){
+        /* Even in NOS, not all live objects are forwarded due to the partial-forward algortihm and pinning */ 
+        if((!NOS_PARTIAL_FORWARD || fspace_obj_to_be_forwarded(p_obj)) && !obj_is_in_pinned_block(p_obj)){
           write_slot(p_ref , obj_get_fw_in_oi(p_obj));
           p_obj = read_slot(p_ref);
         }
@@ -578,13 +667,47 @@ static void resurrection_fallback_handler(GC *gc)
   assert(metadata->repset == NULL);
 }
 
+/* Called by the last collector after marking, before collector_identify_weakrefs() is called by all
+ * the collectors. Then collector_identify_finref() only does the rest of the work.
+ */
+void gc_prepare_identify_weakrefs(GC *gc)
+{
+  Finref_Metadata *metadata = gc->finref_metadata;
+  
+  gc_set_weakref_sets(gc);
+  assert(pool_is_empty(metadata->softref_work_pool));
+  assert(pool_is_empty(metadata->weakref_work_pool));
+  
+  Pool *pool = metadata->softref_pool;
+  metadata->softref_pool = metadata->softref_work_pool;
+  metadata->softref_work_pool = pool;
+  pool = metadata->weakref_pool;
+  metadata->weakref_pool = metadata->weakref_work_pool;
+  metadata->weakref_work_pool = pool;
+  
+  metadata->weakrefs_identified = TRUE;
+}
+
+void collector_identify_weakrefs(Collector *collector)
+{
+  Finref_Metadata *metadata = collector->gc->finref_metadata;
+  
+  if(!collect_is_minor())
+    collector_identify_dead_refs(collector, metadata->softref_work_pool, metadata->softref_pool);
+  collector_identify_dead_refs(collector, metadata->weakref_work_pool, metadata->weakref_pool);
+}
+
 void collector_identify_finref(Collector *collector)
 {
   GC *gc = collector->gc;
+  Finref_Metadata *metadata = gc->finref_metadata;
   
-  gc_set_weakref_sets(gc);
-  identify_dead_softrefs(collector);
-  identify_dead_weakrefs(collector);
+  if(!metadata->weakrefs_identified){
+    gc_set_weakref_sets(gc);
+    identify_dead_softrefs(collector);
+    identify_dead_weakrefs(collector);
+  }
+  metadata->weakrefs_identified = FALSE;
   identify_finalizable_objects(collector);
   resurrect_finalizable_objects(collector);
   gc->collect_result = gc_collection_result(gc);
@@ -795,6 +918,8 @@ static void nondestructively_fix_finref_pool(GC *gc, Pool *pool, Boolean pointer
         if(obj_is_fw_in_oi(p_obj))
           moving_mark_sweep_update_ref(gc, p_ref, double_fix);
       } else { /* major slide compact */
+        /* objects in pinned blocks are not moved and have no fw */
+        if(obj_is_in_pinned_block(p_obj)) continue;
         assert((obj_is_marked_in_vt(p_obj) && obj_is_fw_in_oi(p_obj)));
         write_slot(p_ref , obj_get_fw_in_oi(p_obj));
       }
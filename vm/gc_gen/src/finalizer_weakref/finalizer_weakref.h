@@ -54,6 +54,18 @@ inline REF *obj_get_referent_field(Partial_Reveal_Object *p_obj)
   return (REF*)((U_8*)p_obj+get_gc_referent_offset());
 }
 
+/* LRU soft references (gc.softref_lru_ms_per_mb), see finalizer_weakref.cpp */
+extern unsigned int softref_timestamp_offset;
+extern int64 softref_lru_clock;
+extern int64 softref_lru_interval;
+
+inline Boolean softref_is_recently_used(Partial_Reveal_Object *p_obj)
+{
+  if(!softref_timestamp_offset) return FALSE;
+  int64 timestamp = *(int64*)((U_8*)p_obj + softref_timestamp_offset);
+  return softref_lru_clock - timestamp < softref_lru_interval;
+}
+
 extern Boolean DURING_RESURRECTION;
 typedef void (* Scan_Slot_Func)(Collector *collector, REF *p_ref);
 inline void scan_weak_reference(Collector *collector, Partial_Reveal_Object *p_obj, Scan_Slot_Func scan_slot)
@@ -71,7 +83,7 @@ inline void scan_weak_reference(Collector *collector, Partial_Reveal_Object *p_o
   }
   switch(type){
     case SOFT_REFERENCE :
-      if(collect_is_minor())
+      if(collect_is_minor() || softref_is_recently_used(p_obj))
         scan_slot(collector, p_referent_field);
       else
         collector_add_softref(collector, p_obj);
@@ -118,6 +130,12 @@ extern void put_all_fin_on_exit(GC *gc);
 extern void gc_update_finref_repointed_refs(GC *gc, Boolean double_fix);
 extern void gc_activate_finref_threads(GC *gc);
 
+extern void gc_prepare_identify_weakrefs(GC *gc);
+extern void collector_identify_weakrefs(Collector *collector);
+
+extern void gc_softref_class_prepared(Class_Handle ch);
+extern void gc_update_softref_clock(GC *gc);
+
 void gc_copy_finaliable_obj_to_rootset(GC *gc);
 
 #endif // _FINREF_H_
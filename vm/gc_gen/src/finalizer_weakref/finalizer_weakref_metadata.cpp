@@ -61,6 +61,8 @@ void gc_finref_metadata_initialize(GC *gc)
   finref_metadata.softref_pool = sync_pool_create();
   finref_metadata.weakref_pool = sync_pool_create();
   finref_metadata.phanref_pool = sync_pool_create();
+  finref_metadata.softref_work_pool = sync_pool_create();
+  finref_metadata.weakref_work_pool = sync_pool_create();
   finref_metadata.repset_pool = sync_pool_create();
   finref_metadata.fallback_ref_pool = sync_pool_create();
   
@@ -77,6 +79,7 @@ void gc_finref_metadata_initialize(GC *gc)
   
   finref_metadata.pending_finalizers = FALSE;
   finref_metadata.pending_weakrefs = FALSE;
+  finref_metadata.weakrefs_identified = FALSE;
   finref_metadata.gc_referent_offset = 0;
   
   gc->finref_metadata = &finref_metadata;
@@ -95,6 +98,8 @@ void gc_finref_metadata_destruct(GC *gc)
   sync_pool_destruct(metadata->softref_pool);
   sync_pool_destruct(metadata->weakref_pool);
   sync_pool_destruct(metadata->phanref_pool);
+  sync_pool_destruct(metadata->softref_work_pool);
+  sync_pool_destruct(metadata->weakref_work_pool);
   sync_pool_destruct(metadata->repset_pool);
   
   metadata->finalizable_obj_set = NULL;
@@ -341,6 +346,15 @@ void finref_repset_add_entry(GC *gc, REF* p_ref)
   metadata->repset = finref_metadata_add_entry(gc, metadata->repset, metadata->repset_pool, (POINTER_SIZE_INT)p_ref);
 }
 
+/* the repset of a collector identifying the weak references in parallel */
+Vector_Block *finref_add_repset_entry(GC *gc, Vector_Block *vector_block_in_use, REF *p_ref)
+{
+  assert(*p_ref);
+  assert(read_slot(p_ref));
+  Finref_Metadata *metadata = gc->finref_metadata;
+  return finref_metadata_add_entry(gc, vector_block_in_use, metadata->repset_pool, (POINTER_SIZE_INT)p_ref);
+}
+
 /* This function is only used by resurrection fallback */
 Vector_Block *finref_add_fallback_ref(GC *gc, Vector_Block *vector_block_in_use, Partial_Reveal_Object *p_obj)
 {
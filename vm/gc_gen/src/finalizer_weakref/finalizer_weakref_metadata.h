@@ -44,6 +44,8 @@ typedef struct Finref_Metadata{
   Pool *softref_pool;                           // temporary buffer for soft references identified during one single GC
   Pool *weakref_pool;                           // temporary buffer for weak references identified during one single GC
   Pool *phanref_pool;                           // temporary buffer for phantom references identified during one single GC
+  Pool *softref_work_pool;                      // soft references waiting to be identified by the collectors
+  Pool *weakref_work_pool;                      // weak references waiting to be identified by the collectors
   
   Pool *repset_pool;                            // repointed reference slot sets
   
@@ -54,6 +56,7 @@ typedef struct Finref_Metadata{
   
   Boolean pending_finalizers;                   // there are objects waiting to be finalized
   Boolean pending_weakrefs;                     // there are weak references waiting to be enqueued
+  Boolean weakrefs_identified;                  // the soft and weak references have been identified in parallel
   
   unsigned int gc_referent_offset;              // the referent field's offset in Reference Class; it is a constant during VM's liftime
 }Finref_Metadata;
@@ -77,6 +80,7 @@ extern void collector_add_softref(Collector *collector, Partial_Reveal_Object *r
 extern void collector_add_weakref(Collector *collector, Partial_Reveal_Object *ref);
 extern void collector_add_phanref(Collector *collector, Partial_Reveal_Object *ref);
 extern void finref_repset_add_entry(GC *gc, REF* ref);
+extern Vector_Block *finref_add_repset_entry(GC *gc, Vector_Block *vector_block_in_use, REF *p_ref);
 extern Vector_Block *finref_add_fallback_ref(GC *gc, Vector_Block *vector_block_in_use, Partial_Reveal_Object *p_ref);
 
 extern Boolean obj_with_fin_pool_is_empty(GC *gc);
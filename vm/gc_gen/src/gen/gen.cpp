@@ -24,6 +24,10 @@
 #include "../verify/verify_live_heap.h"
 #include "../common/space_tuner.h"
 #include "../common/compressed_ref.h"
+#include "../common/object_pin.h"
+#include "../common/gc_card_table.h"
+#include "../common/gc_numa.h"
+#include "../common/gc_phase_time.h"
 
 #ifdef USE_32BITS_HASHCODE
 #include "../common/hashcode.h"
@@ -60,7 +64,7 @@ void gc_set_gen_mode(Boolean status)
 {
   if(status){
     gc_set_gen_flag(); 
-    gc_set_barrier_function(WB_REM_SOURCE_REF);
+    gc_set_barrier_function(gc_use_card_table? WB_CARD_MARK : WB_REM_SOURCE_REF);
   }else{
     gc_clear_gen_flag();
     gc_set_barrier_function(WB_REM_NIL);
@@ -98,6 +102,8 @@ static POINTER_SIZE_INT determine_los_size(POINTER_SIZE_INT min_heap_size)
 }
 
 void *alloc_large_pages(size_t size, const char *hint);
+POINTER_SIZE_INT thp_heap_alignment();
+void thp_advise_heap(void* start, POINTER_SIZE_INT size);
 
 void gc_gen_init_verbose(GC_Gen *gc);
 void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_SIZE_INT max_heap_size)
@@ -178,11 +184,25 @@ void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_S
 
   if(large_page_hint) 
     LOS_ADJUST_BOUNDARY = TRUE;
+
+#ifdef COMPRESS_REFERENCE
+  /* reserving twice the max heap size may not be addressable by compressed references */
+  if(max_heap_size + max_heap_size > COMPRESSED_REF_MAX_SPAN)
+    LOS_ADJUST_BOUNDARY = TRUE;
+#endif
   
   reserved_base = NULL;
 
+  /* transparent huge pages are only had in the huge page aligned parts of the heap */
+  POINTER_SIZE_INT heap_align = SPACE_ALLOC_UNIT;
+
   if(!LOS_ADJUST_BOUNDARY) {
-     reserved_base = vm_reserve_mem(NULL, max_heap_size+max_heap_size + SPACE_ALLOC_UNIT);
+     heap_align = max(heap_align, thp_heap_alignment());
+#ifdef COMPRESS_REFERENCE
+     reserved_base = gc_reserve_zero_based_heap(max_heap_size+max_heap_size + heap_align);
+     if(!reserved_base)
+#endif
+     reserved_base = vm_reserve_mem(NULL, max_heap_size+max_heap_size + heap_align);
      if(!reserved_base) 
        LOS_ADJUST_BOUNDARY= TRUE;
    }
@@ -194,9 +214,10 @@ void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_S
       if(reserved_base){
         LWARN(46, "GC use large pages.");
       } else {
+        /* fall back to transparent huge pages, then to small pages */
         free(large_page_hint);
         large_page_hint = NULL;
-        LWARN(47, "GC use small pages.");
+        gc_use_thp = TRUE;
       }
     }
   
@@ -205,12 +226,17 @@ void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_S
       LDIE(79, "Max heap size is smaller than min heap size. Please choose other values.");
     }
 
+    heap_align = max(heap_align, thp_heap_alignment());
     unsigned int max_size_reduced = 0;
-    reserved_base = vm_reserve_mem(NULL, max_heap_size + SPACE_ALLOC_UNIT);
+#ifdef COMPRESS_REFERENCE
+    reserved_base = gc_reserve_zero_based_heap(max_heap_size + heap_align);
+    if(!reserved_base)
+#endif
+    reserved_base = vm_reserve_mem(NULL, max_heap_size + heap_align);
     while( !reserved_base ){
       max_size_reduced += SPACE_ALLOC_UNIT;
       max_heap_size -= SPACE_ALLOC_UNIT;
-      reserved_base = vm_reserve_mem(NULL, max_heap_size + SPACE_ALLOC_UNIT);
+      reserved_base = vm_reserve_mem(NULL, max_heap_size + heap_align);
     }
     
     physical_start = reserved_base;
@@ -220,7 +246,7 @@ void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_S
       exit(0);
     }
     
-    reserved_base = (void*)round_up_to_size((POINTER_SIZE_INT)reserved_base, SPACE_ALLOC_UNIT);
+    reserved_base = (void*)round_up_to_size((POINTER_SIZE_INT)reserved_base, heap_align);
     assert(!((POINTER_SIZE_INT)reserved_base % SPACE_ALLOC_UNIT));
   }
   
@@ -264,7 +290,7 @@ void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_S
 #endif  /* large page */
     physical_start = reserved_base;
         
-    reserved_base = (void*)round_up_to_size((POINTER_SIZE_INT)reserved_base, SPACE_ALLOC_UNIT);
+    reserved_base = (void*)round_up_to_size((POINTER_SIZE_INT)reserved_base, heap_align);
     assert(!((POINTER_SIZE_INT)reserved_base % SPACE_ALLOC_UNIT));
     
     reserved_end = (void*)((POINTER_SIZE_INT)reserved_base + max_heap_size +max_heap_size );
@@ -275,11 +301,14 @@ void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_S
   }
 #endif  /* STATIC_NOS_MAPPING else */
 
-  HEAP_BASE = (POINTER_SIZE_INT)reserved_base;
+  thp_advise_heap(reserved_base, (POINTER_SIZE_INT)reserved_end - (POINTER_SIZE_INT)reserved_base);
+  gc_set_compressed_ref_mode(reserved_base, reserved_end);
   
   gc_gen->physical_start = physical_start;
   gc_gen->heap_start = reserved_base;
   gc_gen->heap_end = reserved_end;
+  if(gc_use_card_table) gc_card_table_initialize((GC*)gc_gen);
+  if(gc_mark_bitmap) gc_mark_bitmap_initialize(gc_gen->heap_start, gc_gen->heap_end);
 #ifdef STATIC_NOS_MAPPING
   gc_gen->reserved_heap_size = los_mos_reserve_size + nos_reserve_size;
 #else
@@ -300,6 +329,19 @@ void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_S
   max_heap_size_bytes = max_heap_size;
   min_heap_size_bytes = min_heap_size;
 
+  /* bind the heap before the spaces touch it */
+  if(gc_numa){
+#ifdef STATIC_NOS_MAPPING
+    gc_numa_initialize((GC*)gc_gen, reserved_base);
+#else
+    /* with an adjustable LOS boundary the whole heap is striped */
+    if(LOS_ADJUST_BOUNDARY)
+      gc_numa_initialize((GC*)gc_gen, reserved_base);
+    else
+      gc_numa_initialize((GC*)gc_gen, (void*)((POINTER_SIZE_INT)reserved_base + max_heap_size));
+#endif
+  }
+
   gc_los_initialize(gc_gen, reserved_base, los_size);
   if(LOS_ADJUST_BOUNDARY)
     gc_mos_initialize(gc_gen, (void*)((POINTER_SIZE_INT)reserved_base + los_size), mos_reserve_size, mos_commit_size);
@@ -327,6 +369,9 @@ void gc_gen_initialize(GC_Gen *gc_gen, POINTER_SIZE_INT min_heap_size, POINTER_S
   gc_gen_stats_initialize(gc_gen);
 #endif
 
+  gc_gen_uncommit_initialize(gc_gen);
+  gc_gen_pause_log_initialize(gc_gen);
+
   gc_gen_init_verbose(gc_gen);
   return;
 }
@@ -360,6 +405,12 @@ void gc_gen_destruct(GC_Gen *gc_gen)
 
 #endif /* !STATIC_NOS_MAPPING */
 
+  gc_card_table_destruct((GC*)gc_gen);
+  gc_mark_bitmap_destruct();
+  gc_numa_destruct((GC*)gc_gen);
+  gc_gen_uncommit_destruct(gc_gen);
+  gc_gen_pause_log_destruct(gc_gen);
+
 #ifdef GC_GEN_STATS
   gc_gen_stats_destruct(gc_gen);
 #endif
@@ -451,7 +502,9 @@ Boolean TRACE_JLC_VIA_VTABLE = FALSE;
 
 void gc_gen_decide_collection_kind(GC_Gen* gc, unsigned int cause)
 {
-  if(gc->next_collect_force_major || cause== GC_CAUSE_LOS_IS_FULL || FORCE_FULL_COMPACT)
+  /* the heap dump and the class histogram walk the heap after a full collection */
+  if(gc->next_collect_force_major || cause== GC_CAUSE_LOS_IS_FULL || cause == GC_CAUSE_HEAP_DUMP
+     || cause == GC_CAUSE_CLASS_HISTOGRAM || FORCE_FULL_COMPACT)
     collect_set_major_normal();
   else
     collect_set_minor();
@@ -593,6 +646,13 @@ static void gc_gen_adjust_heap_size(GC_Gen* gc)
   new_heap_total_size = round_down_to_size(new_heap_total_size, SPACE_ALLOC_UNIT);
 
 
+  /* the heap goes over the soft max only as far as it takes to get the survive ratio under the threshold */
+  if(gc_soft_max_heap_size){
+    POINTER_SIZE_INT soft_max_size = max(gc_soft_max_heap_size, (POINTER_SIZE_INT)((float)heap_surviving_size / threshold_survive_ratio));
+    soft_max_size = round_up_to_size(soft_max_size, SPACE_ALLOC_UNIT);
+    if(new_heap_total_size > soft_max_size) new_heap_total_size = soft_max_size;
+  }
+
   if(new_heap_total_size <= heap_total_size) return;
   /*If there is only small piece of area left not committed, we just merge it into the heap at once*/
   if(new_heap_total_size + (max_heap_size_bytes >> 5) > max_heap_size_bytes - LOS_HEAD_RESERVE_FOR_HEAP_BASE) 
@@ -775,14 +835,21 @@ void gc_gen_reclaim_heap(GC_Gen *gc, int64 gc_start_time)
   if(!major_is_marksweep()){
     gc_gen_update_space_info_before_gc(gc);
     gc_compute_space_tune_size_before_marking((GC*)gc);
+    gc_gen_uncommit_before_gc(gc);
+    gc_gen_pause_log_before_gc(gc);
+    gc_gen_pause_target_before_gc(gc);
   }
   
+  gc_prepare_pinned_blocks((GC*)gc);
+  gc_update_mutator_tlabs((GC*)gc);
+
   gc->collect_result = TRUE;
 #ifdef GC_GEN_STATS
   gc_gen_stats_reset_before_collection(gc);
 #endif
 
   nos_prepare_for_collection(nos);
+  gc_phase_end(GC_PHASE_OTHER);
 
   if(collect_is_minor()){
 
@@ -797,6 +864,7 @@ void gc_gen_reclaim_heap(GC_Gen *gc, int64 gc_start_time)
       mos_used_blocks_before_minor = ((Blocked_Space*)mos)->free_block_idx - ((Blocked_Space*)mos)->first_block_idx;
     
     nos_collection(nos);
+    gc_phase_end(GC_PHASE_MARK);
 
 #ifdef GC_GEN_STATS
     gc_gen_collector_stats_verbose_minor_collection(gc);
@@ -814,6 +882,7 @@ void gc_gen_reclaim_heap(GC_Gen *gc, int64 gc_start_time)
       gc->stats->num_minor_collections++;
 #endif
       los_collection(los);
+      gc_phase_end(GC_PHASE_LOS);
     }
     
     mos->move_object = TRUE;
@@ -828,7 +897,9 @@ void gc_gen_reclaim_heap(GC_Gen *gc, int64 gc_start_time)
       los->move_object = TRUE;
     
     mos_collection(mos); /* collect mos and nos  together */
+    gc_phase_end(GC_PHASE_COMPACT);
     los_collection(los);
+    gc_phase_end(GC_PHASE_LOS);
     
     if(!major_is_marksweep())
       los->move_object = FALSE;
@@ -869,8 +940,14 @@ void gc_gen_reclaim_heap(GC_Gen *gc, int64 gc_start_time)
     if(!major_is_marksweep())
       los->move_object = TRUE;
 
+    /* MOS blocks with pinned objects were not pinned in the minor collection */
+    gc_prepare_pinned_blocks((GC*)gc);
+    gc_phase_end(GC_PHASE_OTHER);
+
     mos_collection(mos); /* collect both mos and nos */
+    gc_phase_end(GC_PHASE_COMPACT);
     los_collection(los);
+    gc_phase_end(GC_PHASE_LOS);
     if(!major_is_marksweep())
       los->move_object = FALSE;
     
@@ -891,6 +968,8 @@ void gc_gen_reclaim_heap(GC_Gen *gc, int64 gc_start_time)
   if(collect_is_major())
     mos_reset_after_collection(mos);
   
+  gc_reset_pinned_blocks((GC*)gc);
+  
   if(verify_live_heap && (!major_is_marksweep()))
     gc_verify_heap((GC*)gc, FALSE);
   
@@ -901,10 +980,18 @@ void gc_gen_reclaim_heap(GC_Gen *gc, int64 gc_start_time)
   
   if(!major_is_marksweep()){ /* adaptations here */
     
-    if(collect_is_major())
+    /* NOS blocks holding pinned objects stay in place, so NOS can't be resized */
+    Boolean nos_has_pinned_blocks = blocked_space_has_pinned_blocks((Blocked_Space*)nos);
+
+    if(collect_is_major() && !nos_has_pinned_blocks)
       gc_gen_adjust_heap_size(gc);  /* adjust committed GC heap size */
       
     gc_gen_adapt(gc, pause_time); /* 1. decide next collection kind; 2. adjust nos_boundary */
+
+    /* The remsets are dropped in major collection, so the refs from MOS to the objects kept in NOS
+       are not remembered. Only a major collection can trace them. */
+    if(gc_is_gen_mode() && collect_is_major() && nos_has_pinned_blocks)
+      gc->next_collect_force_major = TRUE;
     
     gc_space_tuner_reset((GC*)gc); /* related to los_boundary adjustment */
   }
@@ -913,6 +1000,8 @@ void gc_gen_reclaim_heap(GC_Gen *gc, int64 gc_start_time)
   if(gc_is_gen_mode()) {
     gc_reset_collectors_rem_set((GC*)gc);
   }
+  gc_numa_reset_pools();
+  gc_gen_uncommit_after_gc(gc);
   
 #ifdef GC_GEN_STATS
   gc_gen_stats_update_after_collection(gc);
@@ -1041,7 +1130,10 @@ void gc_gen_collection_verbose_info(GC_Gen *gc, int64 pause_time, int64 time_mut
   }
 
   INFO2("gc.collect","GC: pause time: "<<(pause_time>>10)<<"ms"
-    <<"\nGC: mutator time from last collection: "<<(time_mutator>>10)<<"ms\n");
+    <<"\nGC: mutator time from last collection: "<<(time_mutator>>10)<<"ms");
+
+  for(unsigned int i = 0; i < GC_PHASE_NUM; i++)
+    INFO2("gc.collect","GC: "<<gc_phase_names[i]<<" phase time: "<<gc_phase_times.phase_time[i]<<"us");
 
 }
 
@@ -1077,7 +1169,9 @@ inline void gc_gen_init_verbose(GC_Gen *gc)
     <<"\ninitial mos size: "<<verbose_print_size(gc->mos->committed_heap_size)
     <<"\nmos collection algo: "
     <<(major_is_compact_move()?"move compact":"slide compact")
-    <<"\ninitial los size: "<<verbose_print_size(gc->los->committed_heap_size)<<"\n");
+    <<"\ninitial los size: "<<verbose_print_size(gc->los->committed_heap_size)
+    <<"\nheap page size: "<<verbose_print_size(gc_heap_page_size)
+    <<(large_page_hint?" (large pages)":(gc_use_thp?" (transparent huge pages)":""))<<"\n");
 }
 
 void gc_gen_wrapup_verbose(GC_Gen* gc)
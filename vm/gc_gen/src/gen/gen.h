@@ -194,6 +194,42 @@ void gc_gen_iterate_heap(GC_Gen *gc);
 
 void gc_gen_start_concurrent_mark(GC_Gen* gc);
 
+/* heap uncommit, see gen_uncommit.cpp */
+extern unsigned int gc_uncommit_delay;
+extern POINTER_SIZE_INT gc_soft_max_heap_size;
+void gc_gen_uncommit_initialize(GC_Gen* gc);
+void gc_gen_uncommit_destruct(GC_Gen* gc);
+void gc_gen_uncommit_before_gc(GC_Gen* gc);
+void gc_gen_uncommit_after_gc(GC_Gen* gc);
+
+/* structured pause log, see gen_pause_log.cpp */
+extern char* gc_pause_log_file;
+void gc_gen_pause_log_initialize(GC_Gen* gc);
+void gc_gen_pause_log_destruct(GC_Gen* gc);
+void gc_gen_pause_log_before_gc(GC_Gen* gc);
+void gc_gen_pause_log_record(GC_Gen* gc, int64 pause_time);
+
+/* pause target mode, see gen_adapt.cpp */
+extern unsigned int gc_pause_target;
+void gc_gen_pause_target_before_gc(GC_Gen* gc);
+
+/* parallel walk of the live heap, see gen_heap_walk.cpp */
+typedef void (*Heap_Walk_Func)(unsigned int walker, Partial_Reveal_Object* p_obj);
+void gc_gen_walk_heap(GC_Gen* gc, Heap_Walk_Func func);
+
+/* HPROF heap dump, see gen_heap_dump.cpp */
+extern char* gc_heap_dump_file;
+extern Boolean gc_heap_dump_on_oom;
+extern Boolean gc_heap_dump_on_signal;
+Boolean gc_gen_dump_heap(GC_Gen* gc, const char* file_name);
+void gc_gen_heap_dump_in_pause(GC_Gen* gc);
+void gc_gen_heap_dump_on_oom(GC_Gen* gc);
+
+/* class histogram, see gen_class_histogram.cpp */
+extern Boolean gc_class_histogram_on_signal;
+Boolean gc_gen_print_class_histogram(GC_Gen* gc, const char* file_name);
+void gc_gen_class_histogram_in_pause(GC_Gen* gc);
+
 extern Boolean GEN_NONGEN_SWITCH ;
 
 POINTER_SIZE_INT mos_free_space_size(Space* mos);
@@ -21,6 +21,9 @@
 
 #include "gen.h"
 #include "../common/space_tuner.h"
+#include "../common/object_pin.h"
+#include "../common/gc_phase_time.h"
+#include "../common/gc_metadata.h"
 #include <math.h>
 
 #define NOS_COPY_RESERVE_DELTA (GC_BLOCK_SIZE_BYTES<<1)
@@ -184,6 +187,134 @@ void gc_gen_mode_adapt(GC_Gen* gc, int64 pause_time)
   return;
 }
 
+/* Pause target mode (gc.pause_target=<ms>).
+   NOS is sized so that the predicted minor collection pause stays under the target. The
+   pause is modeled as a cost per root (the roots and the remsets counted before the
+   collection), a fixed cost, and the survivors divided by the copy rate, where the survivors
+   are proportional to the NOS size. The model is fitted after every minor collection from
+   the phase times, and NOS is given the largest size the model allows, within the size
+   computed from the free space. A separate model is kept for the gen and the nongen minor
+   collections. With gc.gen_nongen_switch the mode that allows the larger NOS is taken,
+   and a mode that can't meet the target even with the smallest NOS is left for the other. */
+
+unsigned int gc_pause_target = 0; /* in milliseconds, 0 if there is no target */
+
+/* the predicted pause is kept under this fraction of the target, the model is an average */
+#define PAUSE_TARGET_MARGIN 0.8f
+/* the other mode is taken only if it allows a NOS this much larger */
+#define PAUSE_TARGET_MODE_SWITCH_RATIO 1.25f
+
+typedef struct Pause_Model{
+  float time_per_root;  /* in us */
+  float fixed_time;     /* in us */
+  float copy_rate;      /* survivor bytes per us */
+  float survive_ratio;  /* survivor bytes per NOS byte */
+  unsigned int num_samples;
+}Pause_Model;
+
+enum{ PAUSE_MODEL_NONGEN, PAUSE_MODEL_GEN, PAUSE_MODEL_NUM };
+static Pause_Model pause_models[PAUSE_MODEL_NUM];
+static unsigned int num_roots_before_gc = 0;
+
+void gc_gen_pause_target_before_gc(GC_Gen* gc)
+{
+  if(!gc_pause_target) return;
+
+  /* the remsets have been put into the rootset pool too */
+  Pool* rootset_pool = gc->metadata->gc_rootset_pool;
+  unsigned int num_roots = 0;
+  pool_iterator_init(rootset_pool);
+  Vector_Block* root_set = pool_iterator_next(rootset_pool);
+  while(root_set){
+    num_roots += vector_block_entry_count(root_set);
+    root_set = pool_iterator_next(rootset_pool);
+  }
+  num_roots_before_gc = num_roots;
+}
+
+inline float pause_model_average(float average, float sample, unsigned int num_samples)
+{ return num_samples ? (average + sample)/2.0f : sample; }
+
+static void pause_model_update(GC_Gen* gc, int64 pause_time)
+{
+  Space* nos = gc->nos;
+  Blocked_Space* mos = (Blocked_Space*)gc->mos;
+  Pause_Model* model = &pause_models[gc_is_gen_mode() ? PAUSE_MODEL_GEN : PAUSE_MODEL_NONGEN];
+
+  /* the semispace NOS keeps the young survivors */
+  POINTER_SIZE_INT survivor_size = mos->last_alloced_size;
+  if(minor_is_semispace())
+    survivor_size += nos_used_space_size(nos);
+
+  int64 root_time = gc_phase_times.phase_time[GC_PHASE_ROOTSET];
+  int64 copy_time = gc_phase_times.phase_time[GC_PHASE_MARK];
+  int64 fixed_time = pause_time - root_time - copy_time;
+  if(fixed_time < 0) fixed_time = 0;
+
+  float time_per_root = num_roots_before_gc ? (float)root_time/(float)num_roots_before_gc : 0.0f;
+  float survive_ratio = (float)survivor_size/(float)space_committed_size(nos);
+
+  model->time_per_root = pause_model_average(model->time_per_root, time_per_root, model->num_samples);
+  model->fixed_time = pause_model_average(model->fixed_time, (float)fixed_time, model->num_samples);
+  model->survive_ratio = pause_model_average(model->survive_ratio, survive_ratio, model->num_samples);
+  /* with few survivors the copy time is mostly tracing, it doesn't give a rate */
+  if(copy_time > 0 && survivor_size >= GC_BLOCK_SIZE_BYTES){
+    float copy_rate = (float)survivor_size/(float)copy_time;
+    model->copy_rate = model->copy_rate ? (model->copy_rate + copy_rate)/2.0f : copy_rate;
+  }
+  model->num_samples++;
+}
+
+/* the largest NOS whose predicted minor pause is under the target, 0 if there is none */
+static POINTER_SIZE_INT pause_model_max_nos_size(Pause_Model* model)
+{
+  float budget = (float)gc_pause_target * 1000.0f * PAUSE_TARGET_MARGIN
+                   - model->time_per_root * num_roots_before_gc - model->fixed_time;
+  if(budget <= 0.0f) return 0;
+  if(model->copy_rate == 0.0f || model->survive_ratio < 0.001f) return max_nos_size_bytes;
+
+  float nos_size = budget * model->copy_rate / model->survive_ratio;
+  if(nos_size >= (float)max_nos_size_bytes) return max_nos_size_bytes;
+  return round_down_to_size((POINTER_SIZE_INT)nos_size, GC_BLOCK_SIZE_BYTES);
+}
+
+static void gc_pause_target_adapt_mode(GC_Gen* gc)
+{
+  /* the barrier must be there, and NOS must be empty, so that no MOS to NOS ref is missed */
+  if(!GEN_NONGEN_SWITCH || !minor_is_forward()) return;
+  if(blocked_space_has_pinned_blocks((Blocked_Space*)gc->nos)) return;
+
+  Boolean gen_mode = gc_is_gen_mode();
+  Pause_Model* curr_model = &pause_models[gen_mode ? PAUSE_MODEL_GEN : PAUSE_MODEL_NONGEN];
+  Pause_Model* other_model = &pause_models[gen_mode ? PAUSE_MODEL_NONGEN : PAUSE_MODEL_GEN];
+  if(!curr_model->num_samples) return;
+
+  POINTER_SIZE_INT curr_nos_size = pause_model_max_nos_size(curr_model);
+  Boolean switch_mode;
+  if(other_model->num_samples)
+    switch_mode = (float)pause_model_max_nos_size(other_model) > (float)curr_nos_size * PAUSE_TARGET_MODE_SWITCH_RATIO;
+  else
+    switch_mode = curr_nos_size < min_nos_size_bytes;
+
+  if(switch_mode){
+    INFO2("gc.space", "GC: pause target: switching to "<<(gen_mode ? "nongen" : "gen")<<" minor collections after GC["<<gc->num_collections<<"]");
+    gc_set_gen_mode(!gen_mode);
+  }
+}
+
+/* caps the NOS size computed from the free space */
+static POINTER_SIZE_INT gc_pause_target_nos_size(GC_Gen* gc, POINTER_SIZE_INT nos_size)
+{
+  Pause_Model* model = &pause_models[gc_is_gen_mode() ? PAUSE_MODEL_GEN : PAUSE_MODEL_NONGEN];
+  if(!model->num_samples) return nos_size;
+
+  POINTER_SIZE_INT target_nos_size = max(pause_model_max_nos_size(model), min_nos_size_bytes);
+  if(target_nos_size >= nos_size) return nos_size;
+
+  TRACE2("gc.space", "GC: pause target: NOS limited to "<<verbose_print_size(target_nos_size)<<" after GC["<<gc->num_collections<<"]");
+  return target_nos_size;
+}
+
 struct Mspace;
 void mspace_set_expected_threshold_ratio(Mspace* mos, float threshold_ratio);
 
@@ -291,6 +422,12 @@ static void gc_decide_next_collect(GC_Gen* gc, int64 pause_time)
     last_total_free_size = total_free_size;
   }
 
+  if(gc_pause_target){
+    if(collect_is_minor()) pause_model_update(gc, pause_time);
+    gc_pause_target_adapt_mode(gc);
+    return;
+  }
+
   gc_gen_mode_adapt(gc,pause_time);
 
   return;
@@ -334,6 +471,15 @@ Boolean gc_compute_new_space_size(GC_Gen* gc, POINTER_SIZE_INT* mos_size, POINTE
   /*If total free is smaller than one block, there is no room for us to adjust*/
   if(total_free < GC_BLOCK_SIZE_BYTES)  return FALSE;
 
+  /* NOS is sized to keep the heap in use under the soft max. The free space beyond it
+     is left to MOS, where it stays idle unless the live data grows, and is uncommitted. */
+  if(gc_soft_max_heap_size){
+    POINTER_SIZE_INT heap_in_use = space_committed_size(los) + used_mos_size;
+    POINTER_SIZE_INT soft_free = (gc_soft_max_heap_size > heap_in_use)? gc_soft_max_heap_size - heap_in_use : 0;
+    soft_free = max(soft_free, min_nos_size_bytes);
+    if(total_free > soft_free) total_free = soft_free;
+  }
+
   POINTER_SIZE_INT nos_reserve_size;
   if( MOS_RESERVE_SIZE == 0){
     /*To reserve some MOS space to avoid fallback situation. 
@@ -370,6 +516,9 @@ Boolean gc_compute_new_space_size(GC_Gen* gc, POINTER_SIZE_INT* mos_size, POINTE
   if(gc->force_gen_mode){
     new_nos_size = min_nos_size_bytes;
   }
+
+  if(gc_pause_target)
+    new_nos_size = gc_pause_target_nos_size(gc, new_nos_size);
  
   new_mos_size = total_size - new_nos_size;
 #ifdef STATIC_NOS_MAPPING
@@ -388,6 +537,9 @@ void gc_gen_adapt(GC_Gen* gc, int64 pause_time)
 
   if(NOS_SIZE) return;
 
+  /* nos_boundary can't move across the NOS blocks that hold pinned objects */
+  if(blocked_space_has_pinned_blocks((Blocked_Space*)gc->nos)) return;
+
   Blocked_Space* nos = (Blocked_Space*)gc->nos;
   Blocked_Space* mos = (Blocked_Space*)gc->mos;
   
@@ -453,6 +605,9 @@ void gc_gen_adapt(GC_Gen* gc, int64 pause_time)
 
   if(NOS_SIZE) return;
 
+  /* nos_boundary can't move across the NOS blocks that hold pinned objects */
+  if(blocked_space_has_pinned_blocks((Blocked_Space*)gc->nos)) return;
+
   POINTER_SIZE_INT new_nos_size;
   POINTER_SIZE_INT new_mos_size;
 
@@ -0,0 +1,142 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#define LOG_DOMAIN "gc.base"
+#include "gen.h"
+#include "../utils/vtable_map.h"
+
+/* Class histogram (gc.class_histogram_on_signal and the gc_print_class_histogram export).
+   Like the heap dump, it's computed in a major collection of its own, so it only counts the
+   live objects. The collectors walk the heap in parallel (see gen_heap_walk.cpp) and count
+   the objects and their bytes in maps of their own keyed by the vtable, which are merged when
+   the walk is done. The classes are printed by decreasing bytes while the world is stopped,
+   so that no class is unloaded under the printing. */
+
+Boolean gc_class_histogram_on_signal = FALSE;
+
+/* the maps of the collectors, while a histogram is taken */
+static Vtable_Map* histogram_maps = NULL;
+static FILE* histogram_out = NULL;
+static volatile unsigned int histogram_in_progress = 0;
+
+static void histogram_count_object(unsigned int walker, Partial_Reveal_Object* p_obj)
+{
+  Vtable_Map_Entry* entry = vtable_map_get(&histogram_maps[walker], decode_vt(obj_get_vt(p_obj)));
+  entry->num_objs++;
+  entry->objs_size += vm_object_size(p_obj);
+}
+
+static int histogram_entry_compare(const void* a, const void* b)
+{
+  Vtable_Map_Entry* entry1 = *(Vtable_Map_Entry**)a;
+  Vtable_Map_Entry* entry2 = *(Vtable_Map_Entry**)b;
+  if(entry1->objs_size != entry2->objs_size)
+    return (entry1->objs_size < entry2->objs_size)? 1 : -1;
+  return (entry1->num_objs < entry2->num_objs) - (entry1->num_objs > entry2->num_objs);
+}
+
+static void histogram_print(Vtable_Map* histogram)
+{
+  Vtable_Map_Entry** entries = (Vtable_Map_Entry**)STD_MALLOC((histogram->num_entries + 1) * sizeof(Vtable_Map_Entry*));
+  assert(entries);
+  unsigned int num_entries = 0;
+  for(unsigned int i = 0; i < histogram->capacity; i++)
+    if(histogram->entries[i].vt) entries[num_entries++] = &histogram->entries[i];
+  assert(num_entries == histogram->num_entries);
+  qsort(entries, num_entries, sizeof(Vtable_Map_Entry*), histogram_entry_compare);
+
+  uint64 total_objs = 0;
+  uint64 total_size = 0;
+  fprintf(histogram_out, "\n num     #instances         #bytes  class name\n");
+  fprintf(histogram_out, "----------------------------------------------\n");
+  for(unsigned int i = 0; i < num_entries; i++){
+    Vtable_Map_Entry* entry = entries[i];
+    fprintf(histogram_out, "%4u: %14" FMT64 "u %14" FMT64 "u  %s\n", i + 1, (uint64)entry->num_objs,
+            (uint64)entry->objs_size, vtable_get_gcvt(entry->vt)->gc_class_name);
+    total_objs += entry->num_objs;
+    total_size += entry->objs_size;
+  }
+  fprintf(histogram_out, "Total %14" FMT64 "u %14" FMT64 "u\n", total_objs, total_size);
+  fflush(histogram_out);
+
+  STD_FREE(entries);
+}
+
+void gc_gen_class_histogram_in_pause(GC_Gen* gc)
+{
+  if(histogram_maps == NULL) return;
+
+  int64 start_time = time_now();
+  gc_gen_walk_heap(gc, histogram_count_object);
+
+  Vtable_Map histogram;
+  vtable_map_initialize(&histogram);
+  for(unsigned int i = 0; i < gc->num_collectors; i++){
+    Vtable_Map* map = &histogram_maps[i];
+    for(unsigned int j = 0; j < map->capacity; j++){
+      Vtable_Map_Entry* entry = &map->entries[j];
+      if(entry->vt == NULL) continue;
+      Vtable_Map_Entry* class_entry = vtable_map_get(&histogram, entry->vt);
+      class_entry->num_objs += entry->num_objs;
+      class_entry->objs_size += entry->objs_size;
+    }
+  }
+  histogram_print(&histogram);
+  vtable_map_destruct(&histogram);
+
+  INFO2("gc.base", "GC: class histogram printed in "<<(time_now() - start_time)/1000<<" ms of pause");
+}
+
+Boolean gc_gen_print_class_histogram(GC_Gen* gc, const char* file_name)
+{
+  /* the walk needs the world stopped after a full collection */
+  if(gc_is_specify_con_gc()){
+    INFO2("gc.base", "GC: the class histogram is not supported with the concurrent collection.");
+    return FALSE;
+  }
+
+  /* one histogram at a time */
+  if(atomic_cas32(&histogram_in_progress, 1, 0) != 0)
+    return FALSE;
+
+  histogram_out = file_name? fopen(file_name, "w") : stdout;
+  if(histogram_out == NULL){
+    histogram_in_progress = 0;
+    return FALSE;
+  }
+
+  unsigned int num_maps = gc->num_collectors;
+  histogram_maps = (Vtable_Map*)STD_MALLOC(num_maps * sizeof(Vtable_Map));
+  assert(histogram_maps);
+  for(unsigned int i = 0; i < num_maps; i++)
+    vtable_map_initialize(&histogram_maps[i]);
+
+  vm_gc_lock_enum();
+  gc_reclaim_heap((GC*)gc, GC_CAUSE_CLASS_HISTOGRAM);
+  vm_gc_unlock_enum();
+
+  for(unsigned int i = 0; i < num_maps; i++)
+    vtable_map_destruct(&histogram_maps[i]);
+  STD_FREE(histogram_maps);
+  histogram_maps = NULL;
+
+  Boolean succeeded = !ferror(histogram_out);
+  if(file_name && fclose(histogram_out)) succeeded = FALSE;
+  histogram_out = NULL;
+  histogram_in_progress = 0;
+  return succeeded;
+}
@@ -0,0 +1,695 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#define LOG_DOMAIN "gc.base"
+#include "gen.h"
+#include "../common/gc_metadata.h"
+#include "../utils/vtable_map.h"
+#include "open/vm_field_access.h"
+#include "open/vm_class_manipulation.h"
+
+/* HPROF heap dump (gc.heap_dump_on_oom, gc.heap_dump_on_signal, gc.heap_dump_file, and the
+   gc_dump_heap export).
+   The dump is taken in a major collection of its own, so it only has the live objects. While
+   the world is stopped, the collectors walk the heap in parallel (see gen_heap_walk.cpp) and
+   every one of them writes the records of its objects to its own segment file, through a
+   buffer that is written out as a HEAP DUMP SEGMENT record when it's full. The main thread
+   writes the strings, the classes and the roots at the head of the dump. The segment files
+   are appended to the dump after the world is resumed.
+   The class ids are the VM class handles, and the object ids are the object addresses. The
+   static fields are not written, the objects they reference are roots of the dump. */
+
+char* gc_heap_dump_file = NULL;
+Boolean gc_heap_dump_on_oom = FALSE;
+Boolean gc_heap_dump_on_signal = FALSE;
+
+#define HPROF_STRING            0x01
+#define HPROF_LOAD_CLASS        0x02
+#define HPROF_STACK_TRACE       0x05
+#define HPROF_HEAP_DUMP_SEGMENT 0x1C
+#define HPROF_HEAP_DUMP_END     0x2C
+
+#define HPROF_ROOT_UNKNOWN      0xFF
+#define HPROF_ROOT_STICKY_CLASS 0x05
+#define HPROF_CLASS_DUMP        0x20
+#define HPROF_INSTANCE_DUMP     0x21
+#define HPROF_OBJ_ARRAY_DUMP    0x22
+#define HPROF_PRIM_ARRAY_DUMP   0x23
+
+enum Hprof_Type{
+  HPROF_OBJECT = 2,
+  HPROF_BOOLEAN = 4,
+  HPROF_CHAR,
+  HPROF_FLOAT,
+  HPROF_DOUBLE,
+  HPROF_BYTE,
+  HPROF_SHORT,
+  HPROF_INT,
+  HPROF_LONG
+};
+
+#define HPROF_ID_SIZE ((unsigned int)sizeof(POINTER_SIZE_INT))
+#define HPROF_STACK_TRACE_SERIAL 1
+#define HPROF_BUFFER_SIZE (1 * MB)
+
+typedef struct Hprof_Writer{
+  FILE* file;
+  U_8* buf;
+  unsigned int used;
+  Boolean heap_segments; /* the buffer is written out as a HEAP DUMP SEGMENT record */
+  Boolean in_large_record; /* a record larger than the buffer, in a segment of its own */
+  Boolean failed;
+}Hprof_Writer;
+
+typedef struct Hprof_Field{
+  unsigned int offset;
+  unsigned int type;
+}Hprof_Field;
+
+/* the instance fields of a class and of its superclasses, in the order of an instance dump */
+typedef struct Hprof_Class{
+  unsigned int num_fields;
+  unsigned int values_size;
+  Hprof_Field fields[1];
+}Hprof_Class;
+
+typedef struct Hprof_Walker{
+  Hprof_Writer writer;
+  char* segment_file_name;
+  Vtable_Map classes; /* the data of an entry is the Hprof_Class of a non-array class */
+}Hprof_Walker;
+
+typedef struct Heap_Dump{
+  char* file_name;
+  FILE* file;
+  Hprof_Walker* walkers;
+  unsigned int num_walkers;
+  POINTER_SIZE_INT num_objs;
+  Boolean failed;
+}Heap_Dump;
+
+/* the dump taken by the current collection */
+static Heap_Dump* heap_dump = NULL;
+static volatile unsigned int heap_dump_in_progress = 0;
+static volatile unsigned int heap_dumped_on_oom = 0;
+static unsigned int num_heap_dumps = 0;
+
+static void writer_initialize(Hprof_Writer* writer, FILE* file, Boolean heap_segments)
+{
+  writer->file = file;
+  writer->buf = (U_8*)STD_MALLOC(HPROF_BUFFER_SIZE);
+  writer->used = 0;
+  writer->heap_segments = heap_segments;
+  writer->in_large_record = FALSE;
+  writer->failed = (writer->buf == NULL);
+}
+
+static void writer_destruct(Hprof_Writer* writer)
+{
+  if(writer->buf) STD_FREE(writer->buf);
+  writer->buf = NULL;
+}
+
+static void writer_write(Hprof_Writer* writer, const void* data, POINTER_SIZE_INT size)
+{
+  if(writer->failed) return;
+  if(fwrite(data, 1, size, writer->file) != size)
+    writer->failed = TRUE;
+}
+
+inline void put_u4(U_8* p, U_32 value)
+{
+  p[0] = (U_8)(value >> 24);
+  p[1] = (U_8)(value >> 16);
+  p[2] = (U_8)(value >> 8);
+  p[3] = (U_8)value;
+}
+
+static void writer_write_segment_header(Hprof_Writer* writer, U_32 size)
+{
+  U_8 header[9];
+  header[0] = HPROF_HEAP_DUMP_SEGMENT;
+  put_u4(&header[1], 0);
+  put_u4(&header[5], size);
+  writer_write(writer, header, sizeof(header));
+}
+
+static void writer_flush(Hprof_Writer* writer)
+{
+  if(!writer->used) return;
+  if(writer->heap_segments && !writer->in_large_record)
+    writer_write_segment_header(writer, writer->used);
+  writer_write(writer, writer->buf, writer->used);
+  writer->used = 0;
+}
+
+/* the low size bytes of value, big endian */
+inline void writer_put(Hprof_Writer* writer, U_64 value, unsigned int size)
+{
+  if(writer->used + size > HPROF_BUFFER_SIZE) writer_flush(writer);
+  U_8* p = writer->buf + writer->used;
+  for(int i = (int)size - 1; i >= 0; i--){
+    p[i] = (U_8)value;
+    value >>= 8;
+  }
+  writer->used += size;
+}
+
+inline void writer_id(Hprof_Writer* writer, const void* id)
+{ writer_put(writer, (U_64)(POINTER_SIZE_INT)id, HPROF_ID_SIZE); }
+
+/* a field or an array element, read in the byte order of the machine */
+inline void writer_value(Hprof_Writer* writer, void* p_value, unsigned int size)
+{
+  switch(size){
+  case 1:  writer_put(writer, *(U_8*)p_value, 1); break;
+  case 2:  writer_put(writer, *(U_16*)p_value, 2); break;
+  case 4:  writer_put(writer, *(U_32*)p_value, 4); break;
+  default: writer_put(writer, *(U_64*)p_value, 8); break;
+  }
+}
+
+static void writer_top_record(Hprof_Writer* writer, unsigned int tag, U_32 size)
+{
+  assert(!writer->heap_segments);
+  writer_put(writer, tag, 1);
+  writer_put(writer, 0, 4);
+  writer_put(writer, size, 4);
+}
+
+/* a heap dump record is never split across segments, the one that doesn't fit in the
+   buffer gets a segment of its own and is written through the buffer */
+static void writer_begin_record(Hprof_Writer* writer, U_64 size)
+{
+  assert(writer->heap_segments);
+  if(writer->used + size <= HPROF_BUFFER_SIZE) return;
+
+  writer_flush(writer);
+  if(size <= HPROF_BUFFER_SIZE) return;
+
+  writer_write_segment_header(writer, (U_32)size);
+  writer->in_large_record = TRUE;
+}
+
+static void writer_end_record(Hprof_Writer* writer)
+{
+  if(!writer->in_large_record) return;
+  writer_flush(writer);
+  writer->in_large_record = FALSE;
+}
+
+static unsigned int hprof_type_size(unsigned int type)
+{
+  switch(type){
+  case HPROF_OBJECT:  return HPROF_ID_SIZE;
+  case HPROF_BOOLEAN:
+  case HPROF_BYTE:    return 1;
+  case HPROF_CHAR:
+  case HPROF_SHORT:   return 2;
+  case HPROF_FLOAT:
+  case HPROF_INT:     return 4;
+  default:            return 8;
+  }
+}
+
+static unsigned int hprof_type_of_descriptor(char descriptor)
+{
+  switch(descriptor){
+  case 'Z': return HPROF_BOOLEAN;
+  case 'C': return HPROF_CHAR;
+  case 'F': return HPROF_FLOAT;
+  case 'D': return HPROF_DOUBLE;
+  case 'B': return HPROF_BYTE;
+  case 'S': return HPROF_SHORT;
+  case 'I': return HPROF_INT;
+  case 'J': return HPROF_LONG;
+  default:  return HPROF_OBJECT;
+  }
+}
+
+static unsigned int hprof_field_type(Field_Handle field)
+{
+  /* the magic fields hold addresses, not references */
+  if(field_is_magic(field))
+    return (sizeof(POINTER_SIZE_INT) == 8)? HPROF_LONG : HPROF_INT;
+  return hprof_type_of_descriptor(field_get_descriptor(field)[0]);
+}
+
+static Hprof_Class* hprof_class_create(Class_Handle ch)
+{
+  unsigned int num_fields = class_num_instance_fields_recursive(ch);
+  Hprof_Class* clss = (Hprof_Class*)STD_MALLOC(sizeof(Hprof_Class) + num_fields * sizeof(Hprof_Field));
+  assert(clss);
+  clss->num_fields = 0;
+  clss->values_size = 0;
+
+  /* the fields of the class first, then the ones of its superclasses */
+  for(; ch; ch = class_get_super_class(ch)){
+    unsigned int num_class_fields = class_num_instance_fields(ch);
+    for(unsigned int i = 0; i < num_class_fields; i++){
+      Field_Handle field = class_get_instance_field(ch, i);
+      Hprof_Field* hprof_field = &clss->fields[clss->num_fields++];
+      hprof_field->offset = field_get_offset(field);
+      hprof_field->type = hprof_field_type(field);
+      clss->values_size += hprof_type_size(hprof_field->type);
+    }
+  }
+  assert(clss->num_fields == num_fields);
+  return clss;
+}
+
+static void heap_dump_array(Hprof_Writer* writer, Partial_Reveal_Array* array, GC_VTable_Info* gcvt)
+{
+  unsigned int length = array->array_len;
+  U_8* p_elem = (U_8*)array + gcvt->array_first_elem_offset;
+
+  if(object_has_ref_field((Partial_Reveal_Object*)array)){
+    writer_begin_record(writer, 1 + HPROF_ID_SIZE + 4 + 4 + HPROF_ID_SIZE + (U_64)length * HPROF_ID_SIZE);
+    writer_put(writer, HPROF_OBJ_ARRAY_DUMP, 1);
+    writer_id(writer, array);
+    writer_put(writer, HPROF_STACK_TRACE_SERIAL, 4);
+    writer_put(writer, length, 4);
+    writer_id(writer, gcvt->gc_clss);
+    REF* p_ref = (REF*)p_elem;
+    for(unsigned int i = 0; i < length; i++)
+      writer_id(writer, read_slot(p_ref + i));
+  }else{
+    /* the element type is in the name of the array class, e.g., "[I" */
+    unsigned int type = hprof_type_of_descriptor(gcvt->gc_class_name[1]);
+    unsigned int elem_size = gcvt->array_elem_size;
+    assert(elem_size == hprof_type_size(type));
+    writer_begin_record(writer, 1 + HPROF_ID_SIZE + 4 + 4 + 1 + (U_64)length * elem_size);
+    writer_put(writer, HPROF_PRIM_ARRAY_DUMP, 1);
+    writer_id(writer, array);
+    writer_put(writer, HPROF_STACK_TRACE_SERIAL, 4);
+    writer_put(writer, length, 4);
+    writer_put(writer, type, 1);
+    for(unsigned int i = 0; i < length; i++)
+      writer_value(writer, p_elem + i * elem_size, elem_size);
+  }
+  writer_end_record(writer);
+}
+
+static void heap_dump_object(unsigned int walker_index, Partial_Reveal_Object* p_obj)
+{
+  Hprof_Walker* walker = &heap_dump->walkers[walker_index];
+  Hprof_Writer* writer = &walker->writer;
+  Partial_Reveal_VTable* vt = decode_vt(obj_get_vt(p_obj));
+  GC_VTable_Info* gcvt = vtable_get_gcvt(vt);
+
+  Vtable_Map_Entry* entry = vtable_map_get(&walker->classes, vt);
+  entry->num_objs++;
+
+  if(object_is_array(p_obj)){
+    heap_dump_array(writer, (Partial_Reveal_Array*)p_obj, gcvt);
+    return;
+  }
+
+  if(!entry->data) entry->data = hprof_class_create(gcvt->gc_clss);
+  Hprof_Class* clss = (Hprof_Class*)entry->data;
+
+  writer_begin_record(writer, 1 + HPROF_ID_SIZE + 4 + HPROF_ID_SIZE + 4 + clss->values_size);
+  writer_put(writer, HPROF_INSTANCE_DUMP, 1);
+  writer_id(writer, p_obj);
+  writer_put(writer, HPROF_STACK_TRACE_SERIAL, 4);
+  writer_id(writer, gcvt->gc_clss);
+  writer_put(writer, clss->values_size, 4);
+  for(unsigned int i = 0; i < clss->num_fields; i++){
+    Hprof_Field* field = &clss->fields[i];
+    U_8* p_field = (U_8*)p_obj + field->offset;
+    if(field->type == HPROF_OBJECT)
+      writer_id(writer, read_slot((REF*)p_field));
+    else
+      writer_value(writer, p_field, hprof_type_size(field->type));
+  }
+  writer_end_record(writer);
+}
+
+/* adds the class and its superclasses to the classes of the dump, the data of an entry is
+   the class handle */
+static void heap_dump_add_class(Vtable_Map* classes, Partial_Reveal_VTable* vt)
+{
+  while(vt){
+    Vtable_Map_Entry* entry = vtable_map_get(classes, vt);
+    if(entry->data) return;
+
+    Class_Handle ch = vtable_get_gcvt(vt)->gc_clss;
+    entry->data = ch;
+    Class_Handle super_class = class_get_super_class(ch);
+    vt = super_class? (Partial_Reveal_VTable*)class_get_vtable(super_class) : NULL;
+  }
+}
+
+static int string_compare(const void* a, const void* b)
+{
+  POINTER_SIZE_INT s1 = (POINTER_SIZE_INT)*(const char**)a;
+  POINTER_SIZE_INT s2 = (POINTER_SIZE_INT)*(const char**)b;
+  return (s1 > s2) - (s1 < s2);
+}
+
+/* the names of the classes and of their fields, the string ids are the name pointers */
+static void heap_dump_write_strings(Hprof_Writer* writer, Vtable_Map* classes)
+{
+  unsigned int num_strings = 0;
+  for(unsigned int i = 0; i < classes->capacity; i++){
+    Class_Handle ch = (Class_Handle)classes->entries[i].data;
+    if(ch) num_strings += 1 + class_num_instance_fields(ch);
+  }
+
+  const char** strings = (const char**)STD_MALLOC((num_strings + 1) * sizeof(char*));
+  assert(strings);
+  num_strings = 0;
+  for(unsigned int i = 0; i < classes->capacity; i++){
+    Class_Handle ch = (Class_Handle)classes->entries[i].data;
+    if(!ch) continue;
+    strings[num_strings++] = class_get_name(ch);
+    unsigned int num_fields = class_num_instance_fields(ch);
+    for(unsigned int j = 0; j < num_fields; j++)
+      strings[num_strings++] = field_get_name(class_get_instance_field(ch, j));
+  }
+
+  qsort(strings, num_strings, sizeof(char*), string_compare);
+  for(unsigned int i = 0; i < num_strings; i++){
+    if(i && strings[i] == strings[i-1]) continue;
+    U_32 length = (U_32)strlen(strings[i]);
+    writer_top_record(writer, HPROF_STRING, HPROF_ID_SIZE + length);
+    writer_id(writer, strings[i]);
+    for(U_32 j = 0; j < length; j++)
+      writer_put(writer, (U_8)strings[i][j], 1);
+  }
+  STD_FREE(strings);
+}
+
+static void heap_dump_write_class(Hprof_Writer* writer, Partial_Reveal_VTable* vt, Class_Handle ch)
+{
+  unsigned int num_fields = class_num_instance_fields(ch);
+  unsigned int instance_size = class_is_array(ch)? 0 : vtable_get_gcvt(vt)->gc_allocated_size;
+
+  writer_begin_record(writer, 1 + 7 * HPROF_ID_SIZE + 4 + 4 + 2 + 2 + 2 + num_fields * (HPROF_ID_SIZE + 1));
+  writer_put(writer, HPROF_CLASS_DUMP, 1);
+  writer_id(writer, ch);
+  writer_put(writer, HPROF_STACK_TRACE_SERIAL, 4);
+  writer_id(writer, class_get_super_class(ch));
+  /* class loader, signers, protection domain and two reserved ids */
+  for(unsigned int i = 0; i < 5; i++)
+    writer_id(writer, NULL);
+  writer_put(writer, instance_size, 4);
+  writer_put(writer, 0, 2); /* constant pool */
+  writer_put(writer, 0, 2); /* static fields */
+  writer_put(writer, num_fields, 2);
+  for(unsigned int i = 0; i < num_fields; i++){
+    Field_Handle field = class_get_instance_field(ch, i);
+    writer_id(writer, field_get_name(field));
+    writer_put(writer, hprof_field_type(field), 1);
+  }
+  writer_end_record(writer);
+}
+
+static void heap_dump_write_roots(Hprof_Writer* writer, GC* gc)
+{
+  /* the major collection has left only the roots in the pool */
+  Pool* root_set_pool = gc->metadata->gc_rootset_pool;
+  pool_iterator_init(root_set_pool);
+  while(Vector_Block* root_set = pool_iterator_next(root_set_pool)){
+    POINTER_SIZE_INT* iter = vector_block_iterator_init(root_set);
+    while(!vector_block_iterator_end(root_set, iter)){
+      Partial_Reveal_Object* p_obj = read_slot((REF*)*iter);
+      iter = vector_block_iterator_advance(root_set, iter);
+      if(p_obj == NULL) continue;
+      writer_begin_record(writer, 1 + HPROF_ID_SIZE);
+      writer_put(writer, HPROF_ROOT_UNKNOWN, 1);
+      writer_id(writer, p_obj);
+    }
+  }
+}
+
+/* the head of the dump, after the objects were written by the walkers */
+static void heap_dump_write_head(Heap_Dump* dump, GC* gc)
+{
+  Vtable_Map classes;
+  vtable_map_initialize(&classes);
+  for(unsigned int i = 0; i < dump->num_walkers; i++){
+    Vtable_Map* walker_classes = &dump->walkers[i].classes;
+    for(unsigned int j = 0; j < walker_classes->capacity; j++){
+      Vtable_Map_Entry* entry = &walker_classes->entries[j];
+      if(entry->vt == NULL) continue;
+      heap_dump_add_class(&classes, entry->vt);
+      dump->num_objs += entry->num_objs;
+    }
+  }
+
+  Hprof_Writer writer;
+  writer_initialize(&writer, dump->file, FALSE);
+
+  const char* format = "JAVA PROFILE 1.0.2";
+  writer_write(&writer, format, strlen(format) + 1);
+  writer_put(&writer, HPROF_ID_SIZE, 4);
+  writer_put(&writer, (U_64)(time_now() / 1000), 8);
+
+  heap_dump_write_strings(&writer, &classes);
+
+  U_32 class_serial = 0;
+  for(unsigned int i = 0; i < classes.capacity; i++){
+    Class_Handle ch = (Class_Handle)classes.entries[i].data;
+    if(!ch) continue;
+    writer_top_record(&writer, HPROF_LOAD_CLASS, 4 + HPROF_ID_SIZE + 4 + HPROF_ID_SIZE);
+    writer_put(&writer, ++class_serial, 4);
+    writer_id(&writer, ch);
+    writer_put(&writer, HPROF_STACK_TRACE_SERIAL, 4);
+    writer_id(&writer, class_get_name(ch));
+  }
+
+  /* the empty stack trace of all the objects */
+  writer_top_record(&writer, HPROF_STACK_TRACE, 4 + 4 + 4);
+  writer_put(&writer, HPROF_STACK_TRACE_SERIAL, 4);
+  writer_put(&writer, 0, 4);
+  writer_put(&writer, 0, 4);
+  writer_flush(&writer);
+
+  /* the roots and the classes in the first heap dump segment */
+  writer.heap_segments = TRUE;
+  heap_dump_write_roots(&writer, gc);
+  for(unsigned int i = 0; i < classes.capacity; i++){
+    Vtable_Map_Entry* entry = &classes.entries[i];
+    if(!entry->data) continue;
+    writer_begin_record(&writer, 1 + HPROF_ID_SIZE);
+    writer_put(&writer, HPROF_ROOT_STICKY_CLASS, 1);
+    writer_id(&writer, entry->data);
+    /* the java.lang.Class object is dumped as an instance */
+    if(entry->vt->jlC){
+      writer_begin_record(&writer, 1 + HPROF_ID_SIZE);
+      writer_put(&writer, HPROF_ROOT_UNKNOWN, 1);
+      writer_id(&writer, entry->vt->jlC);
+    }
+    heap_dump_write_class(&writer, entry->vt, (Class_Handle)entry->data);
+  }
+  writer_flush(&writer);
+
+  if(writer.failed) dump->failed = TRUE;
+  writer_destruct(&writer);
+  vtable_map_destruct(&classes);
+}
+
+void gc_gen_heap_dump_in_pause(GC_Gen* gc)
+{
+  if(heap_dump == NULL) return;
+
+  int64 start_time = time_now();
+
+  gc_gen_walk_heap(gc, heap_dump_object);
+  for(unsigned int i = 0; i < heap_dump->num_walkers; i++)
+    writer_flush(&heap_dump->walkers[i].writer);
+
+  heap_dump_write_head(heap_dump, (GC*)gc);
+
+  INFO2("gc.base", "GC: heap dump of "<<heap_dump->num_objs<<" objects written in "
+        <<(time_now() - start_time)/1000<<" ms of pause");
+}
+
+static char* heap_dump_file_name()
+{
+  char default_name[32];
+  const char* name = gc_heap_dump_file;
+  if(name == NULL){
+    sprintf(default_name, "java_pid%u.hprof", vm_get_process_id());
+    name = default_name;
+  }
+
+  /* the later dumps don't overwrite the first one */
+  char* file_name = (char*)STD_MALLOC(strlen(name) + 16);
+  assert(file_name);
+  if(num_heap_dumps)
+    sprintf(file_name, "%s.%u", name, num_heap_dumps);
+  else
+    strcpy(file_name, name);
+  num_heap_dumps++;
+  return file_name;
+}
+
+static void heap_dump_close(Heap_Dump* dump)
+{
+  for(unsigned int i = 0; i < dump->num_walkers; i++){
+    Hprof_Walker* walker = &dump->walkers[i];
+    if(walker->writer.file){
+      fclose(walker->writer.file);
+      remove(walker->segment_file_name);
+    }
+    writer_destruct(&walker->writer);
+    if(walker->segment_file_name) STD_FREE(walker->segment_file_name);
+
+    Vtable_Map* classes = &walker->classes;
+    if(classes->entries == NULL) continue;
+    for(unsigned int j = 0; j < classes->capacity; j++)
+      if(classes->entries[j].data) STD_FREE(classes->entries[j].data);
+    vtable_map_destruct(classes);
+  }
+  if(dump->walkers) STD_FREE(dump->walkers);
+  dump->walkers = NULL;
+
+  if(dump->file){
+    if(fclose(dump->file)) dump->failed = TRUE;
+    if(dump->failed) remove(dump->file_name);
+    dump->file = NULL;
+  }
+}
+
+static Boolean heap_dump_open(Heap_Dump* dump, char* file_name, unsigned int num_walkers)
+{
+  memset(dump, 0, sizeof(Heap_Dump));
+  dump->file_name = file_name;
+  dump->file = fopen(file_name, "wb");
+  if(dump->file == NULL) return FALSE;
+
+  dump->walkers = (Hprof_Walker*)STD_MALLOC(num_walkers * sizeof(Hprof_Walker));
+  assert(dump->walkers);
+  memset(dump->walkers, 0, num_walkers * sizeof(Hprof_Walker));
+  dump->num_walkers = num_walkers;
+
+  for(unsigned int i = 0; i < num_walkers; i++){
+    Hprof_Walker* walker = &dump->walkers[i];
+    walker->segment_file_name = (char*)STD_MALLOC(strlen(file_name) + 16);
+    assert(walker->segment_file_name);
+    sprintf(walker->segment_file_name, "%s.seg%u", file_name, i);
+    FILE* file = fopen(walker->segment_file_name, "w+b");
+    if(file == NULL){
+      dump->failed = TRUE;
+      return FALSE;
+    }
+    writer_initialize(&walker->writer, file, TRUE);
+    vtable_map_initialize(&walker->classes);
+  }
+  return TRUE;
+}
+
+/* appends the segment files to the dump, with the world running */
+static void heap_dump_finish(Heap_Dump* dump)
+{
+  U_8* buf = (U_8*)STD_MALLOC(HPROF_BUFFER_SIZE);
+  if(buf == NULL){
+    dump->failed = TRUE;
+    return;
+  }
+
+  for(unsigned int i = 0; i < dump->num_walkers && !dump->failed; i++){
+    Hprof_Writer* writer = &dump->walkers[i].writer;
+    if(writer->failed || fflush(writer->file)){
+      dump->failed = TRUE;
+      break;
+    }
+    rewind(writer->file);
+    size_t size;
+    while((size = fread(buf, 1, HPROF_BUFFER_SIZE, writer->file)) > 0){
+      if(fwrite(buf, 1, size, dump->file) != size){
+        dump->failed = TRUE;
+        break;
+      }
+    }
+    if(ferror(writer->file)) dump->failed = TRUE;
+  }
+  STD_FREE(buf);
+
+  if(!dump->failed){
+    U_8 end_record[9];
+    end_record[0] = HPROF_HEAP_DUMP_END;
+    put_u4(&end_record[1], 0);
+    put_u4(&end_record[5], 0);
+    if(fwrite(end_record, 1, sizeof(end_record), dump->file) != sizeof(end_record))
+      dump->failed = TRUE;
+  }
+}
+
+Boolean gc_gen_dump_heap(GC_Gen* gc, const char* file_name)
+{
+  /* the dump needs the world stopped after a full collection */
+  if(gc_is_specify_con_gc()){
+    INFO2("gc.base", "GC: the heap dump is not supported with the concurrent collection.");
+    return FALSE;
+  }
+
+  /* one dump at a time */
+  if(atomic_cas32(&heap_dump_in_progress, 1, 0) != 0)
+    return FALSE;
+
+  char* name;
+  if(file_name){
+    name = (char*)STD_MALLOC(strlen(file_name) + 1);
+    assert(name);
+    strcpy(name, file_name);
+  }else{
+    name = heap_dump_file_name();
+  }
+
+  INFO2("gc.base", "GC: dumping the heap to "<<name);
+  int64 start_time = time_now();
+
+  Heap_Dump dump;
+  if(heap_dump_open(&dump, name, gc->num_collectors)){
+    heap_dump = &dump;
+    vm_gc_lock_enum();
+    gc_reclaim_heap((GC*)gc, GC_CAUSE_HEAP_DUMP);
+    vm_gc_unlock_enum();
+    heap_dump = NULL;
+    /* the copy of the segment files may take long, so it's done with suspend enabled, which
+       the out of memory dump, called in gc_alloc, doesn't have */
+    int disable_count = hythread_reset_suspend_disable();
+    heap_dump_finish(&dump);
+    hythread_set_suspend_disable(disable_count);
+  }else{
+    dump.failed = TRUE;
+  }
+  heap_dump_close(&dump);
+
+  Boolean succeeded = !dump.failed;
+  if(succeeded){
+    INFO2("gc.base", "GC: heap dump "<<name<<" created in "<<(time_now() - start_time)/1000<<" ms");
+  }else{
+    LWARN(79, "Can't write the heap dump to {0}." << name);
+  }
+
+  STD_FREE(name);
+  heap_dump_in_progress = 0;
+  return succeeded;
+}
+
+void gc_gen_heap_dump_on_oom(GC_Gen* gc)
+{
+  if(!gc_heap_dump_on_oom) return;
+
+  /* only the first out of memory is dumped */
+  if(atomic_cas32(&heap_dumped_on_oom, 1, 0) != 0) return;
+  gc_gen_dump_heap(gc, NULL);
+}
@@ -0,0 +1,214 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#define LOG_DOMAIN "gc.base"
+#include "gen.h"
+#include "../mark_sweep/wspace_alloc.h"
+
+/* Parallel walk of the live heap for the heap dump and the class histogram.
+   It's called by the main thread of a collection while the world is stopped, after the
+   major collection has compacted or swept the heap, so every object in the walked ranges
+   is live: gc_reset_pinned_blocks has turned the dead objects left in the pinned blocks into
+   runs that are skipped. The heap is cut into units: a MOS or NOS block, a run of LOS objects
+   of about WALK_LOS_UNIT_SIZE, or a chunk of the mark-sweep MOS. The collectors claim the
+   units one by one, and call the walk function with their index for every object of a unit. */
+
+#define WALK_LOS_UNIT_SIZE (4 * MB)
+
+enum Heap_Walk_Unit_Kind{
+  WALK_UNIT_BLOCK,
+  WALK_UNIT_LOS,
+  WALK_UNIT_CHUNK
+};
+
+typedef struct Heap_Walk_Unit{
+  void* start;
+  void* end; /* the chunk header for WALK_UNIT_CHUNK */
+  unsigned int kind;
+}Heap_Walk_Unit;
+
+static Heap_Walk_Unit* walk_units = NULL;
+static unsigned int num_walk_units = 0;
+static unsigned int walk_units_capacity = 0;
+static volatile unsigned int next_walk_unit = 0;
+static Heap_Walk_Func walk_func = NULL;
+
+static void walk_units_add(void* start, void* end, unsigned int kind)
+{
+  if(num_walk_units == walk_units_capacity){
+    unsigned int capacity = walk_units_capacity? walk_units_capacity << 1 : 1024;
+    Heap_Walk_Unit* units = (Heap_Walk_Unit*)STD_MALLOC(capacity * sizeof(Heap_Walk_Unit));
+    assert(units);
+    if(walk_units){
+      memcpy(units, walk_units, num_walk_units * sizeof(Heap_Walk_Unit));
+      STD_FREE(walk_units);
+    }
+    walk_units = units;
+    walk_units_capacity = capacity;
+  }
+  Heap_Walk_Unit* unit = &walk_units[num_walk_units++];
+  unit->start = start;
+  unit->end = end;
+  unit->kind = kind;
+}
+
+static void blocked_space_add_walk_units(Blocked_Space* space, unsigned int num_blocks)
+{
+  for(unsigned int i = 0; i < num_blocks; i++){
+    Block_Header* block = (Block_Header*)&space->blocks[i];
+    if(block->free > block->base)
+      walk_units_add(block->base, block->free, WALK_UNIT_BLOCK);
+  }
+}
+
+static POINTER_SIZE_INT los_obj_size(Partial_Reveal_Object* p_obj)
+{
+  unsigned int hash_extend_size = 0;
+#ifdef USE_32BITS_HASHCODE
+  hash_extend_size = hashcode_is_attached(p_obj)? GC_OBJECT_ALIGNMENT : 0;
+#endif
+  return ALIGN_UP_TO_KILO(vm_object_size(p_obj) + hash_extend_size);
+}
+
+/* the LOS is stepped through by the main thread to find where the objects start, which only
+   reads one word per object */
+static void lspace_add_walk_units(Lspace* lspace)
+{
+  POINTER_SIZE_INT p = (POINTER_SIZE_INT)lspace->heap_start;
+  POINTER_SIZE_INT space_end = (POINTER_SIZE_INT)lspace->heap_end;
+  POINTER_SIZE_INT unit_start = 0;
+
+  while(p < space_end){
+    if(!*((POINTER_SIZE_INT*)p)){
+      if(unit_start) walk_units_add((void*)unit_start, (void*)p, WALK_UNIT_LOS);
+      unit_start = 0;
+      p += ((Free_Area*)p)->size;
+      continue;
+    }
+    if(!unit_start) unit_start = p;
+    p += los_obj_size((Partial_Reveal_Object*)p);
+    if(p - unit_start >= WALK_LOS_UNIT_SIZE){
+      walk_units_add((void*)unit_start, (void*)p, WALK_UNIT_LOS);
+      unit_start = 0;
+    }
+  }
+  if(unit_start) walk_units_add((void*)unit_start, (void*)p, WALK_UNIT_LOS);
+}
+
+static void wspace_add_walk_units(Wspace* wspace)
+{
+  Chunk_Header_Basic* chunk = (Chunk_Header_Basic*)space_heap_start((Space*)wspace);
+  Chunk_Header_Basic* space_end = (Chunk_Header_Basic*)space_heap_end((Space*)wspace);
+
+  while(chunk < space_end){
+    if(chunk->status & (CHUNK_NORMAL | CHUNK_ABNORMAL))
+      walk_units_add(((Chunk_Header*)chunk)->base, chunk, WALK_UNIT_CHUNK);
+    chunk = chunk->adj_next;
+  }
+}
+
+static void walk_block(unsigned int walker, Heap_Walk_Unit* unit)
+{
+  Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)unit->start;
+  Partial_Reveal_Object* block_end = (Partial_Reveal_Object*)unit->end;
+
+  while(p_obj < block_end){
+    if(obj_vt_is_to_next_obj(p_obj)){
+      p_obj = obj_get_next_obj_from_vt(p_obj);
+      continue;
+    }
+    walk_func(walker, p_obj);
+    p_obj = obj_end(p_obj);
+  }
+}
+
+static void walk_los(unsigned int walker, Heap_Walk_Unit* unit)
+{
+  POINTER_SIZE_INT p = (POINTER_SIZE_INT)unit->start;
+  POINTER_SIZE_INT unit_end = (POINTER_SIZE_INT)unit->end;
+
+  while(p < unit_end){
+    walk_func(walker, (Partial_Reveal_Object*)p);
+    p += los_obj_size((Partial_Reveal_Object*)p);
+  }
+}
+
+static void walk_chunk(unsigned int walker, Heap_Walk_Unit* unit)
+{
+  Chunk_Header* chunk = (Chunk_Header*)unit->end;
+
+  if(chunk->status & CHUNK_ABNORMAL){
+    walk_func(walker, (Partial_Reveal_Object*)chunk->base);
+    return;
+  }
+
+  /* the sweep has left the live slots with the allocation color */
+  for(unsigned int i = 0; i < chunk->slot_num; i++)
+    if(slot_is_alloc_in_table(chunk->table, i))
+      walk_func(walker, (Partial_Reveal_Object*)slot_index_to_addr(chunk, i));
+}
+
+static void collector_walk_heap(Collector* collector)
+{
+  unsigned int walker = (unsigned int)(POINTER_SIZE_INT)collector->thread_handle;
+
+  while(TRUE){
+    unsigned int index = atomic_inc32(&next_walk_unit);
+    if(index >= num_walk_units) break;
+
+    Heap_Walk_Unit* unit = &walk_units[index];
+    switch(unit->kind){
+    case WALK_UNIT_BLOCK: walk_block(walker, unit); break;
+    case WALK_UNIT_LOS:   walk_los(walker, unit); break;
+    case WALK_UNIT_CHUNK: walk_chunk(walker, unit); break;
+    default: assert(0);
+    }
+  }
+}
+
+void gc_gen_walk_heap(GC_Gen* gc, Heap_Walk_Func func)
+{
+  num_walk_units = 0;
+
+  if(major_is_marksweep()){
+    wspace_add_walk_units((Wspace*)gc_get_mos(gc));
+  }else{
+    Blocked_Space* mos = (Blocked_Space*)gc_get_mos(gc);
+    blocked_space_add_walk_units(mos, mos->free_block_idx - mos->first_block_idx);
+  }
+  /* the major collection moves the NOS objects to MOS, but for the blocks kept for pinned
+     objects in the forwarding NOS. Those blocks are left wherever they are while the free
+     block index of NOS is reset, so all the NOS blocks are looked at */
+  if(!minor_is_semispace()){
+    Blocked_Space* nos = (Blocked_Space*)gc_get_nos(gc);
+    blocked_space_add_walk_units(nos, nos->num_managed_blocks);
+  }
+  if(gc_get_los(gc))
+    lspace_add_walk_units((Lspace*)gc_get_los(gc));
+
+  walk_func = func;
+  next_walk_unit = 0;
+  collector_execute_enumeration_task((GC*)gc, (TaskType)collector_walk_heap, gc->num_collectors);
+  walk_func = NULL;
+
+  TRACE2("gc.base", "GC: walked "<<num_walk_units<<" heap units with "<<gc->num_collectors<<" collectors");
+
+  STD_FREE(walk_units);
+  walk_units = NULL;
+  walk_units_capacity = 0;
+  num_walk_units = 0;
+}
@@ -0,0 +1,145 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#define LOG_DOMAIN "gc.base"
+#include "gen.h"
+#include "../common/gc_phase_time.h"
+
+/* Structured pause log (gc.pause_log=<file>).
+   Every collection appends one line to the file, a JSON object with the cause and the kind
+   of the collection, the pause time and the phase times, the used and committed sizes of
+   the heap and of every space before and after the collection, the bytes promoted to MOS by
+   a minor collection, and the time every collector spent in the collection tasks. The file
+   is flushed after every line, so it can be followed while the application runs. */
+
+char* gc_pause_log_file = NULL;
+
+static FILE* pause_log = NULL;
+
+typedef struct Space_Sizes{
+  POINTER_SIZE_INT used;
+  POINTER_SIZE_INT committed;
+}Space_Sizes;
+
+enum Pause_Log_Space{ PAUSE_LOG_NOS, PAUSE_LOG_MOS, PAUSE_LOG_LOS, PAUSE_LOG_NUM_SPACES };
+static const char* pause_log_space_names[PAUSE_LOG_NUM_SPACES] = { "nos", "mos", "los" };
+
+static Space_Sizes sizes_before_gc[PAUSE_LOG_NUM_SPACES];
+
+void gc_gen_pause_log_initialize(GC_Gen* gc)
+{
+  if(!gc_pause_log_file) return;
+
+  pause_log = fopen(gc_pause_log_file, "a");
+  if(!pause_log)
+    INFO2("gc.base", "GC: gc.pause_log is ignored, "<<gc_pause_log_file<<" can't be opened.");
+}
+
+void gc_gen_pause_log_destruct(GC_Gen* gc)
+{
+  if(pause_log) fclose(pause_log);
+  pause_log = NULL;
+  if(gc_pause_log_file) free(gc_pause_log_file);
+  gc_pause_log_file = NULL;
+}
+
+static void gc_gen_get_space_sizes(GC_Gen* gc, Space_Sizes* sizes)
+{
+  Space* los = gc_get_los(gc);
+
+  sizes[PAUSE_LOG_NOS].used = nos_used_space_size(gc_get_nos(gc));
+  sizes[PAUSE_LOG_NOS].committed = space_committed_size(gc_get_nos(gc));
+  sizes[PAUSE_LOG_MOS].used = mos_used_space_size(gc_get_mos(gc));
+  sizes[PAUSE_LOG_MOS].committed = space_committed_size(gc_get_mos(gc));
+  sizes[PAUSE_LOG_LOS].committed = space_committed_size(los);
+  sizes[PAUSE_LOG_LOS].used = sizes[PAUSE_LOG_LOS].committed - lspace_free_memory_size((Lspace*)los);
+}
+
+void gc_gen_pause_log_before_gc(GC_Gen* gc)
+{
+  if(!pause_log) return;
+
+  gc_gen_get_space_sizes(gc, sizes_before_gc);
+}
+
+static const char* gc_cause_name(unsigned int cause)
+{
+  switch(cause){
+  case GC_CAUSE_NOS_IS_FULL:      return "nos_full";
+  case GC_CAUSE_LOS_IS_FULL:      return "los_full";
+  case GC_CAUSE_MOS_IS_FULL:      return "mos_full";
+  case GC_CAUSE_RUNTIME_FORCE_GC: return "forced";
+  case GC_CAUSE_CONCURRENT_GC:    return "concurrent";
+  case GC_CAUSE_HEAP_DUMP:        return "heap_dump";
+  case GC_CAUSE_CLASS_HISTOGRAM:  return "class_histogram";
+  default:                        return "unknown";
+  }
+}
+
+static const char* gc_collect_kind_name()
+{
+  if(collect_is_minor()) return "minor";
+  if(collect_is_fallback()) return "fallback";
+  return "major";
+}
+
+static void pause_log_print_sizes(const char* name, Space_Sizes* before, Space_Sizes* after)
+{
+  fprintf(pause_log, "\"%s\":{\"used_before\":%" FMT64 "u,\"used_after\":%" FMT64 "u,"
+          "\"committed_before\":%" FMT64 "u,\"committed_after\":%" FMT64 "u}",
+          name, (uint64)before->used, (uint64)after->used, (uint64)before->committed, (uint64)after->committed);
+}
+
+void gc_gen_pause_log_record(GC_Gen* gc, int64 pause_time)
+{
+  if(!pause_log) return;
+
+  Space_Sizes sizes_after_gc[PAUSE_LOG_NUM_SPACES];
+  gc_gen_get_space_sizes(gc, sizes_after_gc);
+
+  Space_Sizes heap_before = {0, 0};
+  Space_Sizes heap_after = {0, 0};
+  for(unsigned int i = 0; i < PAUSE_LOG_NUM_SPACES; i++){
+    heap_before.used += sizes_before_gc[i].used;
+    heap_before.committed += sizes_before_gc[i].committed;
+    heap_after.used += sizes_after_gc[i].used;
+    heap_after.committed += sizes_after_gc[i].committed;
+  }
+
+  /* what a minor collection has copied to MOS; the fallback collection has compacted it too */
+  POINTER_SIZE_INT promoted_size = 0;
+  if(collect_is_minor() && sizes_after_gc[PAUSE_LOG_MOS].used > sizes_before_gc[PAUSE_LOG_MOS].used)
+    promoted_size = sizes_after_gc[PAUSE_LOG_MOS].used - sizes_before_gc[PAUSE_LOG_MOS].used;
+
+  fprintf(pause_log, "{\"gc\":%u,\"cause\":\"%s\",\"kind\":\"%s\",\"pause_us\":%" FMT64 "d,\"phases_us\":{",
+          gc->num_collections, gc_cause_name(gc->cause), gc_collect_kind_name(), pause_time);
+  for(unsigned int i = 0; i < GC_PHASE_NUM; i++)
+    fprintf(pause_log, "%s\"%s\":%" FMT64 "d", i ? "," : "", gc_phase_names[i], gc_phase_times.phase_time[i]);
+  fprintf(pause_log, "},");
+
+  pause_log_print_sizes("heap", &heap_before, &heap_after);
+  for(unsigned int i = 0; i < PAUSE_LOG_NUM_SPACES; i++){
+    fprintf(pause_log, ",");
+    pause_log_print_sizes(pause_log_space_names[i], &sizes_before_gc[i], &sizes_after_gc[i]);
+  }
+
+  fprintf(pause_log, ",\"promoted\":%" FMT64 "u,\"collectors_us\":[", (uint64)promoted_size);
+  for(unsigned int i = 0; i < gc->num_collectors; i++)
+    fprintf(pause_log, "%s%" FMT64 "d", i ? "," : "", gc->collectors[i]->time_working);
+  fprintf(pause_log, "]}\n");
+  fflush(pause_log);
+}
@@ -55,6 +55,7 @@ void gc_gen_stats_reset_before_collection(GC_Gen* gc)
     stats->los_suviving_obj_num = 0;
     stats->los_suviving_obj_size = 0;
     stats->is_los_collected = false;  
+    stats->los_compact_time = 0;
   }
 }
 
@@ -101,6 +102,9 @@ void gc_gen_stats_verbose(GC_Gen* gc)
 {
   GC_Gen_Stats* stats = gc->stats;
   Boolean is_los_collected = stats->is_los_collected;
+  TRACE2("gc.space", "GC: Mutator TLAB stats: "
+    <<"\nGC: num refills: " << stats->num_tlab_refills
+    <<"\nGC: size wasted: " << verbose_print_size(stats->tlab_waste_size) << "\n");
   if (collect_is_minor()){
     TRACE2("gc.space", "GC: NOS Collection stats: "
       <<"\nGC: " << (gc_is_gen_mode()?"generational":"nongenerational")
@@ -121,7 +125,8 @@ void gc_gen_stats_verbose(GC_Gen* gc)
       <<"\nGC: collection algo: "<<(collect_is_major()?"slide compact":"mark sweep")
       <<"\nGC: num surviving objs: "<<stats->los_suviving_obj_num
       <<"\nGC: size surviving objs: "<<verbose_print_size(stats->los_suviving_obj_size)
-      <<"\nGC: surviving ratio: "<<(int)(stats->los_surviving_ratio*100)<<"%\n");
+      <<"\nGC: surviving ratio: "<<(int)(stats->los_surviving_ratio*100)<<"%"
+      <<"\nGC: compaction time: "<<stats->los_compact_time<<"us\n");
   }
 
 }
@@ -36,6 +36,10 @@ typedef struct GC_Gen_Stats {
   unsigned int obj_num_los_alloc;
   POINTER_SIZE_INT total_size_los_alloc;
 
+  /*mutator TLAB info since last collection*/
+  unsigned int num_tlab_refills;
+  POINTER_SIZE_INT tlab_waste_size;
+
   /*minor related info*/
   unsigned int nos_surviving_obj_num_minor;
   POINTER_SIZE_INT nos_surviving_obj_size_minor;
@@ -54,6 +58,7 @@ typedef struct GC_Gen_Stats {
   POINTER_SIZE_INT los_suviving_obj_size;
   float los_surviving_ratio;
   int los_collection_algo;
+  int64 los_compact_time; /*wall time of the parallel los compaction phases, in microseconds*/
 
 }GC_Gen_Stats;
 
@@ -0,0 +1,178 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#define LOG_DOMAIN "gc.base"
+#include "gen.h"
+
+/* Heap uncommit (gc.uncommit_delay=<ms>).
+   The heap is watched in units of a block. Before and after every collection the units
+   are checked against the free blocks of NOS and MOS and the free areas of LOS, and a unit
+   that is not entirely free is stamped with the current time. After the collection the free
+   units whose stamp is older than the delay are given back to the OS. The memory stays
+   mapped, so nothing has to be done when it's allocated again: it comes back zeroed when it's
+   touched, and the unit gets a new stamp at the next collection. The head of a unit, which
+   holds the block header, is never given back. */
+
+unsigned int gc_uncommit_delay = 0; /* in milliseconds, 0 if the heap is never uncommitted */
+POINTER_SIZE_INT gc_soft_max_heap_size = 0;
+
+#define UNIT_RELEASED ((int64)-1)
+
+static void* units_start = NULL;
+static unsigned int num_units = 0;
+/* the last time a unit was seen in use, or UNIT_RELEASED */
+static int64* unit_used_time = NULL;
+static U_8* unit_is_free = NULL;
+static POINTER_SIZE_INT unit_keep_size = 0;
+
+inline unsigned int addr_to_unit(void* addr)
+{ return (unsigned int)(((POINTER_SIZE_INT)addr - (POINTER_SIZE_INT)units_start) >> GC_BLOCK_SHIFT_COUNT); }
+
+inline void* unit_to_addr(unsigned int unit)
+{ return (void*)((POINTER_SIZE_INT)units_start + ((POINTER_SIZE_INT)unit << GC_BLOCK_SHIFT_COUNT)); }
+
+void gc_gen_uncommit_initialize(GC_Gen* gc)
+{
+  if(!gc_uncommit_delay) return;
+
+  /* the large pages are locked in memory */
+  if(large_page_hint){
+    INFO2("gc.base", "GC: gc.uncommit_delay is ignored with large pages.");
+    gc_uncommit_delay = 0;
+    return;
+  }
+
+  unit_keep_size = round_up_to_size(GC_BLOCK_HEADER_SIZE_BYTES, (int)port_vmem_page_sizes()[0]);
+  if(unit_keep_size >= GC_BLOCK_SIZE_BYTES){
+    INFO2("gc.base", "GC: gc.uncommit_delay is ignored, the pages are as large as the heap blocks.");
+    gc_uncommit_delay = 0;
+    return;
+  }
+
+  units_start = gc->heap_start;
+  num_units = (unsigned int)(((POINTER_SIZE_INT)gc->heap_end - (POINTER_SIZE_INT)gc->heap_start) >> GC_BLOCK_SHIFT_COUNT);
+  unit_used_time = (int64*)STD_MALLOC(num_units * sizeof(int64));
+  unit_is_free = (U_8*)STD_MALLOC(num_units);
+  assert(unit_used_time && unit_is_free);
+
+  int64 now = time_now();
+  for(unsigned int i = 0; i < num_units; i++)
+    unit_used_time[i] = now;
+  memset(unit_is_free, 0, num_units);
+}
+
+void gc_gen_uncommit_destruct(GC_Gen* gc)
+{
+  if(!gc_uncommit_delay) return;
+
+  STD_FREE(unit_used_time);
+  STD_FREE(unit_is_free);
+  unit_used_time = NULL;
+  unit_is_free = NULL;
+}
+
+static void mark_free_units(void* start, void* end)
+{
+  POINTER_SIZE_INT first = round_up_to_size((POINTER_SIZE_INT)start, GC_BLOCK_SIZE_BYTES);
+  POINTER_SIZE_INT last = round_down_to_size((POINTER_SIZE_INT)end, GC_BLOCK_SIZE_BYTES);
+  for(POINTER_SIZE_INT unit = first; unit < last; unit += GC_BLOCK_SIZE_BYTES)
+    unit_is_free[addr_to_unit((void*)unit)] = 1;
+}
+
+static void blocked_space_mark_free_units(Blocked_Space* space)
+{
+  /* the blocks kept for pinned objects are not free */
+  for(unsigned int idx = space->free_block_idx; idx <= space->ceiling_block_idx; idx++){
+    Block_Header* block = (Block_Header*)&space->blocks[idx - space->first_block_idx];
+    if(block->status == BLOCK_FREE)
+      unit_is_free[addr_to_unit(block)] = 1;
+  }
+}
+
+static void lspace_mark_free_units(Lspace* lspace)
+{
+  Free_Area_Pool* pool = lspace->free_pool;
+  for(unsigned int i = 0; i < NUM_FREE_LIST; i++){
+    Bidir_List* head = (Bidir_List*)&pool->sized_area_list[i];
+    for(Bidir_List* item = head->next; item != head; item = item->next){
+      Free_Area* area = (Free_Area*)item;
+      /* the area header stays where it is */
+      mark_free_units((void*)((POINTER_SIZE_INT)area + sizeof(Free_Area)), (void*)((POINTER_SIZE_INT)area + area->size));
+    }
+  }
+}
+
+/* stamps the units of the space in use, and releases the idle ones if asked to */
+static POINTER_SIZE_INT space_update_units(Space* space, int64 now, Boolean release)
+{
+  unsigned int first = addr_to_unit(space->heap_start);
+  POINTER_SIZE_INT end = round_up_to_size((POINTER_SIZE_INT)space->heap_start + space->committed_heap_size, GC_BLOCK_SIZE_BYTES);
+  unsigned int last = addr_to_unit((void*)end);
+  int64 delay = (int64)gc_uncommit_delay * 1000;
+  POINTER_SIZE_INT released_size = 0;
+
+  for(unsigned int i = first; i < last; i++){
+    if(!unit_is_free[i]){
+      unit_used_time[i] = now;
+      continue;
+    }
+    unit_is_free[i] = 0;
+    if(!release || unit_used_time[i] == UNIT_RELEASED || now - unit_used_time[i] < delay)
+      continue;
+
+    void* start = (void*)((POINTER_SIZE_INT)unit_to_addr(i) + unit_keep_size);
+    if(vm_discard_mem(start, GC_BLOCK_SIZE_BYTES - unit_keep_size)){
+      unit_used_time[i] = UNIT_RELEASED;
+      released_size += GC_BLOCK_SIZE_BYTES - unit_keep_size;
+    }
+  }
+  return released_size;
+}
+
+static void gc_gen_update_units(GC_Gen* gc, Boolean release)
+{
+  Space* nos = gc_get_nos(gc);
+  Space* mos = gc_get_mos(gc);
+  Space* los = gc_get_los(gc);
+
+  blocked_space_mark_free_units((Blocked_Space*)nos);
+  blocked_space_mark_free_units((Blocked_Space*)mos);
+  lspace_mark_free_units((Lspace*)los);
+
+  int64 now = time_now();
+  POINTER_SIZE_INT released_size = space_update_units(nos, now, release)
+                                 + space_update_units(mos, now, release)
+                                 + space_update_units(los, now, release);
+
+  if(released_size)
+    INFO2("gc.space", "GC: released "<<verbose_print_size(released_size)<<" of idle heap memory after GC["<<gc->num_collections<<"]");
+}
+
+void gc_gen_uncommit_before_gc(GC_Gen* gc)
+{
+  if(!gc_uncommit_delay) return;
+
+  /* what the mutators have allocated since the last collection */
+  gc_gen_update_units(gc, FALSE);
+}
+
+void gc_gen_uncommit_after_gc(GC_Gen* gc)
+{
+  if(!gc_uncommit_delay) return;
+
+  gc_gen_update_units(gc, TRUE);
+}
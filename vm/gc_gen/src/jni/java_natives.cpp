@@ -21,6 +21,7 @@
 #include "environment.h"
 #include "../thread/gc_thread.h"
 #include "../gen/gen.h"
+#include "../common/gc_card_table.h"
 #include "java_support.h"
 
 #ifdef __cplusplus
@@ -47,6 +48,21 @@ JNIEXPORT jboolean JNICALL Java_org_apache_harmony_drlvm_gc_1gen_GCHelper_getGen
     return (jboolean)gc_is_gen_mode();
 }
 
+JNIEXPORT jboolean JNICALL Java_org_apache_harmony_drlvm_gc_1gen_GCHelper_getCardTableMode(JNIEnv *e, jclass c)
+{
+    return (jboolean)gc_use_card_table;
+}
+
+JNIEXPORT jobject JNICALL Java_org_apache_harmony_drlvm_gc_1gen_GCHelper_getCardTableBase(JNIEnv *e, jclass c)
+{
+    return (jobject)card_table_base;
+}
+
+JNIEXPORT jobject JNICALL Java_org_apache_harmony_drlvm_gc_1gen_GCHelper_getCardTableHeapStart(JNIEnv *e, jclass c)
+{
+    return (jobject)card_table_heap_start;
+}
+
 JNIEXPORT void JNICALL Java_org_apache_harmony_drlvm_gc_1gen_GCHelper_helperCallback(JNIEnv *e, jclass c)
 {
     java_helper_inlined = TRUE;
@@ -77,12 +77,27 @@ typedef struct Lspace{
   void* scompact_fa_end;
 }Lspace;
 
+/* Thread local LOS caches.
+   A mutator takes an area of LOS_CACHE_SIZE from the pool and bump-allocates the objects up to
+   LOS_CACHE_MAX_OBJ_SIZE from it without touching the pool lists. The rest of the area is kept
+   formatted as a free area for the heap walks, and goes back to the pool when the mutator context
+   is reset for a collection or the thread goes away. */
+#define LOS_CACHE_SIZE (1*MB)
+#define LOS_CACHE_MAX_OBJ_SIZE (LOS_CACHE_SIZE >> 2)
+
+struct Mutator;
+
 Lspace *lspace_initialize(GC* gc, void* reserved_base, POINTER_SIZE_INT lspace_size);
 void lspace_destruct(Lspace* lspace);
 Managed_Object_Handle lspace_alloc(unsigned size, Allocator* allocator);
 void* lspace_try_alloc(Lspace* lspace, POINTER_SIZE_INT alloc_size);
-void lspace_sliding_compact(Collector* collector, Lspace* lspace);
+void lspace_flush_mutator_cache(Mutator* mutator);
+/* LOS compaction: lspace_compute_compact_regions is called by one collector, then all the
+   collectors call lspace_compute_object_target, and later lspace_sliding_compact */
+void lspace_compute_compact_regions(Lspace* lspace);
 void lspace_compute_object_target(Collector* collector, Lspace* lspace);
+void lspace_sliding_compact(Collector* collector, Lspace* lspace);
+void lspace_release_compact_regions(Lspace* lspace);
 void lspace_reset_for_slide(Lspace* lspace);
 void lspace_collection(Lspace* lspace);
 
@@ -102,19 +117,33 @@ inline POINTER_SIZE_INT lspace_committed_size(Lspace* lspace)
     return 0;
 }
 
-inline Partial_Reveal_Object* lspace_get_next_marked_object( Lspace* lspace, unsigned int* iterate_index)
+/* the marked objects starting below end */
+inline Partial_Reveal_Object* lspace_get_next_marked_object_before( Lspace* lspace, unsigned int* iterate_index, void* end)
 {
     POINTER_SIZE_INT next_area_start = (POINTER_SIZE_INT)lspace->heap_start + (*iterate_index) * KB;
     BOOLEAN reach_heap_end = 0;
     unsigned int hash_extend_size = 0;
 
+    /* the free areas and the dead objects are skipped a bitmap word at a time */
+    if(gc_mark_bitmap_in_use){
+        Partial_Reveal_Object* p_obj = mark_bitmap_next_marked((void*)next_area_start, end);
+        if(p_obj){
+#ifdef USE_32BITS_HASHCODE
+            hash_extend_size  = (hashcode_is_attached(p_obj))?GC_OBJECT_ALIGNMENT:0;
+#endif
+            POINTER_SIZE_INT obj_size = ALIGN_UP_TO_KILO(vm_object_size(p_obj) + hash_extend_size);
+            *iterate_index = (unsigned int)(((POINTER_SIZE_INT)p_obj + obj_size - (POINTER_SIZE_INT)lspace->heap_start) >> BIT_SHIFT_TO_KILO);
+        }
+        return p_obj;
+    }
+
     while(!reach_heap_end){
         //FIXME: This while shoudl be if, try it!
-        while((next_area_start< (POINTER_SIZE_INT)lspace->heap_end)&&!*((POINTER_SIZE_INT*)next_area_start)){
+        while((next_area_start< (POINTER_SIZE_INT)end)&&!*((POINTER_SIZE_INT*)next_area_start)){
             assert(((Free_Area*)next_area_start)->size);
             next_area_start += ((Free_Area*)next_area_start)->size;            
         }
-        if(next_area_start < (POINTER_SIZE_INT)lspace->heap_end){
+        if(next_area_start < (POINTER_SIZE_INT)end){
             //If there is a living object at this addr, return it, and update iterate_index
 
 #ifdef USE_32BITS_HASHCODE
@@ -138,6 +167,11 @@ inline Partial_Reveal_Object* lspace_get_next_marked_object( Lspace* lspace, uns
 
 }
 
+inline Partial_Reveal_Object* lspace_get_next_marked_object( Lspace* lspace, unsigned int* iterate_index)
+{
+    return lspace_get_next_marked_object_before(lspace, iterate_index, lspace->heap_end);
+}
+
 inline Partial_Reveal_Object* lspace_get_first_marked_object(Lspace* lspace, unsigned int* mark_bit_idx)
 {
     return lspace_get_next_marked_object(lspace, mark_bit_idx);
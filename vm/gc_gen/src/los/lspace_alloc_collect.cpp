@@ -24,6 +24,8 @@
 #include "../common/space_tuner.h"
 #include "../common/gc_concurrent.h"
 #include "../common/collection_scheduler.h"
+#include "../common/object_pin.h"
+#include "../thread/mutator.h"
 #ifdef GC_GEN_STATS
 #include "../gen/gen_stats.h"
 #endif
@@ -44,7 +46,8 @@ static unsigned int free_pool_nr_list_is_empty(Free_Area_Pool* pool, unsigned in
     Bidir_List* head = (Bidir_List*)(&pool->sized_area_list[list_index]);
     return (head->next == head);
 }
-static void* free_pool_former_lists_atomic_take_area_piece(Free_Area_Pool* pool, unsigned int list_hint, POINTER_SIZE_INT size)
+/* If wait is FALSE, the list is given up when another thread holds its lock */
+static void* free_pool_former_lists_atomic_take_area_piece(Free_Area_Pool* pool, unsigned int list_hint, POINTER_SIZE_INT size, Boolean wait)
 {
     Free_Area* free_area;
     void* p_result;
@@ -55,7 +58,10 @@ static void* free_pool_former_lists_atomic_take_area_piece(Free_Area_Pool* pool,
 
     assert(list_hint < MAX_LIST_INDEX);
 
-    free_pool_lock_nr_list(pool, list_hint);
+    if(wait)
+        free_pool_lock_nr_list(pool, list_hint);
+    else if(!try_lock(head->lock))
+        return NULL;
     /*Other LOS allocation may race with this one, so check list status here.*/
     if(free_pool_nr_list_is_empty(pool, list_hint)){
         free_pool_unlock_nr_list(pool, list_hint);
@@ -98,7 +104,7 @@ static void* free_pool_former_lists_atomic_take_area_piece(Free_Area_Pool* pool,
     return NULL;
 }
 
-static void* free_pool_last_list_atomic_take_area_piece(Free_Area_Pool* pool, POINTER_SIZE_INT size)
+static void* free_pool_last_list_atomic_take_area_piece(Free_Area_Pool* pool, POINTER_SIZE_INT size, Boolean wait)
 {
     void* p_result;
     POINTER_SIZE_SINT remain_size = 0;
@@ -108,7 +114,10 @@ static void* free_pool_last_list_atomic_take_area_piece(Free_Area_Pool* pool, PO
     unsigned int new_list_nr = 0;        
     Lockable_Bidir_List* head = &(pool->sized_area_list[MAX_LIST_INDEX]);
     
-    free_pool_lock_nr_list(pool, MAX_LIST_INDEX );
+    if(wait)
+        free_pool_lock_nr_list(pool, MAX_LIST_INDEX );
+    else if(!try_lock(head->lock))
+        return NULL;
     /*The last list is empty.*/
     if(free_pool_nr_list_is_empty(pool, MAX_LIST_INDEX)){
         free_pool_unlock_nr_list(pool, MAX_LIST_INDEX );                
@@ -153,7 +162,8 @@ static void* free_pool_last_list_atomic_take_area_piece(Free_Area_Pool* pool, PO
     return NULL;
 }
 
-void* lspace_try_alloc(Lspace* lspace, POINTER_SIZE_INT alloc_size){
+static void* lspace_try_take_area(Lspace* lspace, POINTER_SIZE_INT alloc_size, Boolean wait)
+{
   void* p_result = NULL;
   Free_Area_Pool* pool = lspace->free_pool;  
   unsigned int list_hint = pool_list_index_with_size(alloc_size);  
@@ -162,42 +172,91 @@ void* lspace_try_alloc(Lspace* lspace, POINTER_SIZE_INT alloc_size){
   while((!p_result) && (list_hint <= MAX_LIST_INDEX)){
       /*List hint is not the last list, so look for it in former lists.*/
       if(list_hint < MAX_LIST_INDEX){
-          p_result = free_pool_former_lists_atomic_take_area_piece(pool, list_hint, alloc_size);
-          if(p_result){
-              memset(p_result, 0, alloc_size);
-              uint64 vold = lspace->last_alloced_size;
-              uint64 vnew = vold + alloc_size;
-              while( vold != port_atomic_cas64(&lspace->last_alloced_size, vnew, vold) ){                      
-                  vold = lspace->last_alloced_size;
-                  vnew = vold + alloc_size;
-              }
-              return p_result;
-          }else{
-              list_hint ++;
-              list_hint = pool_list_get_next_flag(pool, list_hint);
-              continue;
-          }
+          p_result = free_pool_former_lists_atomic_take_area_piece(pool, list_hint, alloc_size, wait);
+          if(p_result) return p_result;
+          list_hint ++;
+          list_hint = pool_list_get_next_flag(pool, list_hint);
       }
       /*List hint is the last list, so look for it in the last list.*/
       else
       {
-          p_result = free_pool_last_list_atomic_take_area_piece(pool, alloc_size);
-          if(p_result){
-              memset(p_result, 0, alloc_size);
-              uint64 vold = lspace->last_alloced_size;
-              uint64 vnew = vold + alloc_size;
-              while( vold != port_atomic_cas64(&lspace->last_alloced_size, vnew, vold) ){                      
-                  vold = lspace->last_alloced_size;
-                  vnew = vold + alloc_size;
-              }
-              return p_result;
-          }
-          else break;
+          p_result = free_pool_last_list_atomic_take_area_piece(pool, alloc_size, wait);
+          break;
       }
   }
   return p_result;
 }
 
+static void lspace_add_alloced_size(Lspace* lspace, int64 size)
+{
+  uint64 vold = lspace->last_alloced_size;
+  uint64 vnew = vold + size;
+  while( vold != port_atomic_cas64(&lspace->last_alloced_size, vnew, vold) ){                      
+      vold = lspace->last_alloced_size;
+      vnew = vold + size;
+  }
+}
+
+void* lspace_try_alloc(Lspace* lspace, POINTER_SIZE_INT alloc_size){
+  /* The lists held by other threads are passed over first, the area can as well be cut from a larger one.
+     Only when that finds nothing the lists are waited for. */
+  void* p_result = lspace_try_take_area(lspace, alloc_size, FALSE);
+  if(!p_result)
+    p_result = lspace_try_take_area(lspace, alloc_size, TRUE);
+  if(p_result){
+    memset(p_result, 0, alloc_size);
+    lspace_add_alloced_size(lspace, alloc_size);
+  }
+  return p_result;
+}
+
+/* The cache area is counted as allocated when it's taken, and what is left of it is uncounted when it's given back */
+void lspace_flush_mutator_cache(Mutator* mutator)
+{
+  if(!mutator->los_cache_free) return;
+
+  Lspace* lspace = (Lspace*)gc_get_los((GC_Gen*)mutator->gc);
+  POINTER_SIZE_INT size = (POINTER_SIZE_INT)mutator->los_cache_end - (POINTER_SIZE_INT)mutator->los_cache_free;
+  void* start = mutator->los_cache_free;
+  mutator->los_cache_free = NULL;
+  mutator->los_cache_end = NULL;
+  if(!size) return;
+
+  lspace_add_alloced_size(lspace, -(int64)size);
+  /* a piece too small for the pool stays a free area until LOS is swept or compacted */
+  Free_Area* area = free_area_new(start, size);
+  if(!area) return;
+
+  Free_Area_Pool* pool = lspace->free_pool;
+  unsigned int list_index = pool_list_index_with_size(size);
+  free_pool_lock_nr_list(pool, list_index);
+  free_pool_add_area(pool, area);
+  free_pool_unlock_nr_list(pool, list_index);
+}
+
+static void* lspace_cache_alloc(Lspace* lspace, Mutator* mutator, POINTER_SIZE_INT alloc_size)
+{
+  POINTER_SIZE_INT cache_free = (POINTER_SIZE_INT)mutator->los_cache_free;
+  if(cache_free + alloc_size > (POINTER_SIZE_INT)mutator->los_cache_end){
+    lspace_flush_mutator_cache(mutator);
+    /* the object is allocated from the pool directly if no area is at hand */
+    void* area = lspace_try_take_area(lspace, LOS_CACHE_SIZE, FALSE);
+    if(!area) return NULL;
+    lspace_add_alloced_size(lspace, LOS_CACHE_SIZE);
+    cache_free = (POINTER_SIZE_INT)area;
+    mutator->los_cache_end = (void*)(cache_free + LOS_CACHE_SIZE);
+  }
+
+  void* p_result = (void*)cache_free;
+  cache_free += alloc_size;
+  mutator->los_cache_free = (void*)cache_free;
+  /* the rest of the cache has to be walkable as a free area */
+  if(cache_free < (POINTER_SIZE_INT)mutator->los_cache_end)
+    free_area_new((void*)cache_free, (POINTER_SIZE_INT)mutator->los_cache_end - cache_free);
+  memset(p_result, 0, alloc_size);
+  return p_result;
+}
+
 void* lspace_alloc(unsigned size, Allocator *allocator)
 {
     unsigned int try_count = 0;
@@ -207,6 +266,8 @@ void* lspace_alloc(unsigned size, Allocator *allocator)
     Free_Area_Pool* pool = lspace->free_pool;
     
     while( try_count < 2 ){
+        if(alloc_size <= LOS_CACHE_MAX_OBJ_SIZE && (p_result = lspace_cache_alloc(lspace, (Mutator*)allocator, alloc_size)))
+          return p_result;
         if(p_result = lspace_try_alloc(lspace, alloc_size))
           return p_result;
 
@@ -238,12 +299,146 @@ void* lspace_alloc(unsigned size, Allocator *allocator)
     return NULL;
 }
 
-void lspace_compute_object_target(Collector* collector, Lspace* lspace)
+/* LOS compaction is done in regions of about this much surviving data. The destinations
+   are prefix-summed over the regions before the collectors claim them, so the regions are
+   forwarded and moved in parallel. */
+#define LOS_COMPACT_REGION_SIZE (4*MB)
+
+typedef struct Los_Compact_Region{
+  Partial_Reveal_Object* first_obj;
+  /* the first object of the next region, or the heap end */
+  void* end;
+  /* the area the region is moved into, holes before pinned objects included */
+  void* dest_start;
+  void* dest_end;
+  /* the regions whose objects are still in the way of the move */
+  unsigned int first_dep;
+  unsigned int end_dep;
+  volatile Boolean is_moved;
+}Los_Compact_Region;
+
+static Los_Compact_Region* los_regions = NULL;
+static unsigned int num_los_regions = 0;
+static volatile unsigned int next_los_region_for_target = 0;
+static volatile unsigned int next_los_region_for_slide = 0;
+#ifdef GC_GEN_STATS
+static volatile unsigned int num_los_finished_collectors = 0;
+static volatile unsigned int los_slide_started = 0;
+static volatile int64 los_compact_phase_start = 0;
+#endif
+
+/* the size of the object once it's at dest_addr, slide_compact_process_hashcode attaches the hashcode of a moved object */
+static unsigned int lspace_obj_size_at_target(Partial_Reveal_Object* p_obj, void* dest_addr)
+{
+  unsigned int obj_size = vm_object_size(p_obj);
+#ifdef USE_32BITS_HASHCODE
+  if(hashcode_is_attached(p_obj))
+    obj_size += GC_OBJECT_ALIGNMENT;
+  else
+    precompute_hashcode_extend_size(p_obj, dest_addr, &obj_size);
+#endif
+  return obj_size;
+}
+
+#ifdef GC_GEN_STATS
+/* the collector finishing a parallel phase adds its time from the phase start */
+static void lspace_compact_phase_finish(Collector* collector)
+{
+  GC* gc = collector->gc;
+  unsigned int old_num = atomic_inc32(&num_los_finished_collectors);
+  if(++old_num == gc->num_active_collectors){
+    ((GC_Gen*)gc)->stats->los_compact_time += time_now() - los_compact_phase_start;
+    num_los_finished_collectors = 0;
+  }
+}
+#endif
+
+/* Walks the object headers once and cuts the marked objects into regions.
+   Called by one collector after the marking, before the collectors call lspace_compute_object_target. */
+void lspace_compute_compact_regions(Lspace* lspace)
 {
+#ifdef GC_GEN_STATS
+  los_compact_phase_start = time_now();
+  num_los_finished_collectors = 0;
+  los_slide_started = 0;
+#endif
+  POINTER_SIZE_INT heap_size = (POINTER_SIZE_INT)lspace->heap_end - (POINTER_SIZE_INT)lspace->heap_start;
+  unsigned int max_num_regions = (unsigned int)(heap_size / LOS_COMPACT_REGION_SIZE) + 2;
+  /* left over if the last collection failed before the sliding */
+  if(los_regions) STD_FREE(los_regions);
+  los_regions = (Los_Compact_Region*)STD_MALLOC(max_num_regions * sizeof(Los_Compact_Region));
+  assert(los_regions);
+  num_los_regions = 0;
+  next_los_region_for_target = 0;
+  next_los_region_for_slide = 0;
+
   void* dest_addr = lspace->heap_start;
+  POINTER_SIZE_INT region_size = 0;
+  Los_Compact_Region* region = NULL;
   unsigned int iterate_index = 0;
   Partial_Reveal_Object* p_obj = lspace_get_first_marked_object(lspace, &iterate_index);
-  	
+
+  while( p_obj ){
+    if(!region || region_size >= LOS_COMPACT_REGION_SIZE){
+      if(region){
+        region->end = p_obj;
+        region->dest_end = dest_addr;
+      }
+      assert(num_los_regions < max_num_regions);
+      region = &los_regions[num_los_regions++];
+      region->first_obj = p_obj;
+      region->dest_start = dest_addr;
+      region->is_moved = FALSE;
+      region_size = 0;
+    }
+    if(obj_is_pinned(p_obj))
+      dest_addr = p_obj;
+    unsigned int obj_size = lspace_obj_size_at_target(p_obj, dest_addr);
+    region_size += obj_size;
+    dest_addr = (void *)ALIGN_UP_TO_KILO(((POINTER_SIZE_INT) dest_addr + obj_size));
+    p_obj = lspace_get_next_marked_object(lspace, &iterate_index);
+  }
+  if(region){
+    region->end = lspace->heap_end;
+    region->dest_end = dest_addr;
+  }
+
+  /* A region can be moved when the earlier regions its destination overlaps have been moved.
+     Both bounds only go up with the region index. */
+  unsigned int first_dep = 0;
+  unsigned int end_dep = 0;
+  for(unsigned int i = 0; i < num_los_regions; i++){
+    region = &los_regions[i];
+    while(first_dep < i && los_regions[first_dep].end <= region->dest_start)
+      first_dep++;
+    while(end_dep < i && (void*)los_regions[end_dep].first_obj < region->dest_end)
+      end_dep++;
+    region->first_dep = first_dep;
+    region->end_dep = end_dep;
+  }
+
+  lspace->scompact_fa_start = dest_addr;
+  lspace->scompact_fa_end= lspace->heap_end;
+  if(!LOS_ADJUST_BOUNDARY)
+    lspace->last_surviving_size = (POINTER_SIZE_INT)dest_addr - (POINTER_SIZE_INT) lspace->heap_start;
+}
+
+static Los_Compact_Region* lspace_claim_region(volatile unsigned int* next_region)
+{
+  unsigned int index = *next_region;
+  while(index < num_los_regions){
+    if(atomic_cas32(next_region, index + 1, index) == index)
+      return &los_regions[index];
+    index = *next_region;
+  }
+  return NULL;
+}
+
+inline unsigned int lspace_region_start_index(Lspace* lspace, Los_Compact_Region* region)
+{ return (unsigned int)(((POINTER_SIZE_INT)region->first_obj - (POINTER_SIZE_INT)lspace->heap_start) >> BIT_SHIFT_TO_KILO); }
+
+void lspace_compute_object_target(Collector* collector, Lspace* lspace)
+{
   assert(!collector->rem_set);
   collector->rem_set = free_set_pool_get_entry(collector->gc->metadata);
 #ifdef USE_32BITS_HASHCODE  
@@ -253,29 +448,42 @@ void lspace_compute_object_target(Collector* collector, Lspace* lspace)
 #ifdef GC_GEN_STATS
   GC_Gen_Collector_Stats* stats = (GC_Gen_Collector_Stats*)collector->stats;
 #endif
-  while( p_obj ){
-   
-    assert( obj_is_marked_in_vt(p_obj));
-    unsigned int obj_size = vm_object_size(p_obj);
+  Los_Compact_Region* region = lspace_claim_region(&next_los_region_for_target);
+  while( region ){
+    void* dest_addr = region->dest_start;
+    unsigned int iterate_index = lspace_region_start_index(lspace, region);
+    Partial_Reveal_Object* p_obj = lspace_get_next_marked_object_before(lspace, &iterate_index, region->end);
+    assert(p_obj == region->first_obj);
+
+    while( p_obj ){
+      assert( obj_is_marked_in_vt(p_obj));
+      unsigned int obj_size = vm_object_size(p_obj);
 #ifdef GC_GEN_STATS
-  gc_gen_collector_update_moved_los_obj_stats_major(stats, vm_object_size(p_obj));
+      gc_gen_collector_update_moved_los_obj_stats_major(stats, vm_object_size(p_obj));
 #endif
-    assert(((POINTER_SIZE_INT)dest_addr + obj_size) <= (POINTER_SIZE_INT)lspace->heap_end);
+      /* a pinned object is forwarded to itself. The hole before it is freed in lspace_sliding_compact */
+      if(obj_is_pinned(p_obj))
+        dest_addr = p_obj;
+
+      assert(((POINTER_SIZE_INT)dest_addr + obj_size) <= (POINTER_SIZE_INT)lspace->heap_end);
 #ifdef USE_32BITS_HASHCODE 
-    obj_size += hashcode_is_attached(p_obj)? GC_OBJECT_ALIGNMENT : 0 ;
-    Obj_Info_Type obj_info = slide_compact_process_hashcode(p_obj, dest_addr, &obj_size, collector, null, null);
+      obj_size += hashcode_is_attached(p_obj)? GC_OBJECT_ALIGNMENT : 0 ;
+      Obj_Info_Type obj_info = slide_compact_process_hashcode(p_obj, dest_addr, &obj_size, collector, null, null);
 #else
-    Obj_Info_Type obj_info = get_obj_info_raw(p_obj);
+      Obj_Info_Type obj_info = get_obj_info_raw(p_obj);
 #endif
 
-    if( obj_info != 0 ) {
-      collector_remset_add_entry(collector, (Partial_Reveal_Object **)dest_addr);
-      collector_remset_add_entry(collector, (Partial_Reveal_Object **)(POINTER_SIZE_INT)obj_info);
+      if( obj_info != 0 ) {
+        collector_remset_add_entry(collector, (Partial_Reveal_Object **)dest_addr);
+        collector_remset_add_entry(collector, (Partial_Reveal_Object **)(POINTER_SIZE_INT)obj_info);
+      }
+        
+      obj_set_fw_in_oi(p_obj, dest_addr);
+      dest_addr = (void *)ALIGN_UP_TO_KILO(((POINTER_SIZE_INT) dest_addr + obj_size));
+      p_obj = lspace_get_next_marked_object_before(lspace, &iterate_index, region->end);
     }
-      
-    obj_set_fw_in_oi(p_obj, dest_addr);
-    dest_addr = (void *)ALIGN_UP_TO_KILO(((POINTER_SIZE_INT) dest_addr + obj_size));
-    p_obj = lspace_get_next_marked_object(lspace, &iterate_index);
+    assert(dest_addr == region->dest_end);
+    region = lspace_claim_region(&next_los_region_for_target);
   }
 
   pool_put_entry(collector->gc->metadata->collector_remset_pool, collector->rem_set);
@@ -284,25 +492,22 @@ void lspace_compute_object_target(Collector* collector, Lspace* lspace)
   pool_put_entry(collector->gc->metadata->collector_hashcode_pool, collector->hashcode_set);
   collector->hashcode_set = NULL;
 #endif
-  
-  lspace->scompact_fa_start = dest_addr;
-  lspace->scompact_fa_end= lspace->heap_end;
+
+#ifdef GC_GEN_STATS
+  lspace_compact_phase_finish(collector);
+#endif
   return;
 }
 
-void lspace_sliding_compact(Collector* collector, Lspace* lspace)
+static void lspace_sliding_compact_region(Lspace* lspace, Los_Compact_Region* region)
 {
-  unsigned int iterate_index = 0;
-  Partial_Reveal_Object* p_obj; 
-  POINTER_SIZE_INT last_one=(POINTER_SIZE_INT) lspace->heap_start;
-  
-  
-  p_obj = lspace_get_first_marked_object(lspace, &iterate_index);
-  if(!LOS_ADJUST_BOUNDARY)
-    lspace->last_surviving_size=0;
-  
-  if(!p_obj) return;
-  
+  /* the objects of the earlier regions under the destination have to be moved first */
+  for(unsigned int i = region->first_dep; i < region->end_dep; i++)
+    while(!los_regions[i].is_moved);
+
+  POINTER_SIZE_INT last_one = (POINTER_SIZE_INT)region->dest_start;
+  unsigned int iterate_index = lspace_region_start_index(lspace, region);
+  Partial_Reveal_Object* p_obj = lspace_get_next_marked_object_before(lspace, &iterate_index, region->end);
 
   while( p_obj ){
     assert( obj_is_marked_in_vt(p_obj));
@@ -317,21 +522,72 @@ void lspace_sliding_compact(Collector* collector, Lspace* lspace)
     obj_size += (obj_is_sethash_in_vt(p_obj))?GC_OBJECT_ALIGNMENT:0;    
 #endif
     Partial_Reveal_Object *p_target_obj = obj_get_fw_in_oi(p_obj);
+    /* there is a hole before a pinned object. All the objects in it have been moved away */
+    POINTER_SIZE_INT hole_start = ALIGN_UP_TO_KILO(last_one);
+    if(hole_start < (POINTER_SIZE_INT)p_target_obj)
+      free_area_new((void*)hole_start, (POINTER_SIZE_INT)p_target_obj - hole_start);
     POINTER_SIZE_INT target_obj_end = (POINTER_SIZE_INT)p_target_obj + obj_size;
     last_one = target_obj_end;
     if( p_obj != p_target_obj){
       memmove(p_target_obj, p_obj, obj_size);
     }
     set_obj_info(p_target_obj, 0);
-    p_obj = lspace_get_next_marked_object(lspace, &iterate_index);  
+    p_obj = lspace_get_next_marked_object_before(lspace, &iterate_index, region->end);  
   }
+  mem_fence();
+  region->is_moved = TRUE;
+}
 
- if(!LOS_ADJUST_BOUNDARY)
-   lspace->last_surviving_size = ALIGN_UP_TO_KILO(last_one) - (POINTER_SIZE_INT) lspace->heap_start;
+void lspace_sliding_compact(Collector* collector, Lspace* lspace)
+{
+#ifdef GC_GEN_STATS
+  if(atomic_cas32(&los_slide_started, 1, 0) == 0)
+    los_compact_phase_start = time_now();
+#endif
+  /* the regions are claimed in address order, so a region only waits for regions that are being moved */
+  Los_Compact_Region* region = lspace_claim_region(&next_los_region_for_slide);
+  while( region ){
+    lspace_sliding_compact_region(lspace, region);
+    region = lspace_claim_region(&next_los_region_for_slide);
+  }
 
+#ifdef GC_GEN_STATS
+  lspace_compact_phase_finish(collector);
+#endif
   return;
 }
 
+/* called by one collector after lspace_sliding_compact */
+void lspace_release_compact_regions(Lspace* lspace)
+{
+  STD_FREE(los_regions);
+  los_regions = NULL;
+  num_los_regions = 0;
+}
+
+/* The holes were formatted as free areas in lspace_sliding_compact */
+static void lspace_collect_pinned_holes(Lspace* lspace)
+{
+  POINTER_SIZE_INT area_start = (POINTER_SIZE_INT)lspace->heap_start;
+  POINTER_SIZE_INT area_end = (POINTER_SIZE_INT)lspace->scompact_fa_start;
+
+  while(area_start < area_end){
+    if(!*((POINTER_SIZE_INT*)area_start)){
+      Free_Area* fa = (Free_Area*)area_start;
+      assert(fa->size);
+      area_start += fa->size;
+      if(fa->size >= GC_LOS_OBJ_SIZE_THRESHOLD) free_pool_add_area(lspace->free_pool, fa);
+      continue;
+    }
+    Partial_Reveal_Object* p_obj = (Partial_Reveal_Object*)area_start;
+    unsigned int hash_extend_size = 0;
+#ifdef USE_32BITS_HASHCODE
+    hash_extend_size = (hashcode_is_attached(p_obj))?GC_OBJECT_ALIGNMENT:0;
+#endif
+    area_start += ALIGN_UP_TO_KILO(vm_object_size(p_obj) + hash_extend_size);
+  }
+}
+
 void lspace_reset_for_slide(Lspace* lspace)
 {
     GC* gc = lspace->gc;
@@ -432,6 +688,10 @@ void lspace_reset_for_slide(Lspace* lspace)
       }
     }
 
+    /* put the holes left by pinned objects into the pool as well */
+    if(num_pinned_objects)
+      lspace_collect_pinned_holes(lspace);
+
 //    lspace->accumu_alloced_size = 0;    
 //    lspace->last_alloced_size = 0;        
     lspace->period_surviving_size = (POINTER_SIZE_INT)lspace->scompact_fa_start - (POINTER_SIZE_INT)lspace->heap_start;
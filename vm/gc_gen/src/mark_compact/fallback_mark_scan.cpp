@@ -31,7 +31,7 @@ static void scan_slot(Collector* collector, REF *p_ref)
 {
   if( read_slot(p_ref) == NULL) return;
 
-  collector_tracestack_push(collector, p_ref);
+  collector_markstack_push(collector, p_ref);
   return;
 }
 
@@ -45,7 +45,7 @@ static void scan_object(Collector* collector, REF *p_ref)
   if(TRACE_JLC_VIA_VTABLE)
     if(!(vtable->vtmark & VT_FALLBACK_MARKED)) {
       vtable->vtmark |= VT_FALLBACK_MARKED;  //we need different marking for fallback compaction
-      collector_tracestack_push(collector, &(vtable->jlC));
+      collector_markstack_push(collector, &(vtable->jlC));
       //64bits consideration is needed, vtable->jlC is an uncompressed reference
     }
   
@@ -95,17 +95,18 @@ static void scan_object(Collector* collector, REF *p_ref)
 }
 
 
+/* the fallback marking traces slots, so that the slots of forwarded NOS objects are fixed */
+static void drain_markstack(Collector* collector)
+{
+  REF* p_ref;
+  while((p_ref = (REF*)collector_markstack_pop(collector)))
+    scan_object(collector, p_ref);
+}
+
 static void trace_object(Collector* collector, REF *p_ref)
 { 
   scan_object(collector, p_ref);
-  
-  Vector_Block* trace_stack = collector->trace_stack;
-  while( !vector_stack_is_empty(trace_stack)){
-    p_ref = (REF *)vector_stack_pop(trace_stack); 
-    scan_object(collector, p_ref);
-    trace_stack = collector->trace_stack;
-  }
-    
+  drain_markstack(collector);
   return; 
 }
 
@@ -125,6 +126,7 @@ void mark_scan_heap_for_fallback(Collector* collector)
   /* reset the num_finished_collectors to be 0 by one collector. This is necessary for the barrier later. */
   unsigned int num_active_collectors = gc->num_active_collectors;
   atomic_cas32( &num_finished_collectors, 0, num_active_collectors);
+  if(GC_MARK_STEAL) collector_mark_steal_init(collector);
    
   collector->trace_stack = free_task_pool_get_entry(metadata);
 
@@ -141,7 +143,7 @@ void mark_scan_heap_for_fallback(Collector* collector)
       /* root ref can't be NULL, (remset may have NULL ref entry, but this function is only for ALGO_MAJOR */
       assert(*p_ref);
       
-      collector_tracestack_push(collector, p_ref);
+      collector_markstack_push(collector, p_ref);
 
 #ifdef GC_GEN_STATS
       gc_gen_collector_update_rootset_ref_num(stats);   
@@ -150,6 +152,13 @@ void mark_scan_heap_for_fallback(Collector* collector)
     } 
     root_set = pool_iterator_next(metadata->gc_rootset_pool);
   }
+
+  if(GC_MARK_STEAL){
+    /* roots stay in our own mark stack, idle collectors steal them */
+    collector_mark_steal(collector, drain_markstack);
+    return;
+  }
+
   /* put back the last trace_stack task */    
   pool_put_entry(metadata->mark_task_pool, collector->trace_stack);
   
@@ -20,11 +20,20 @@
  */
 
 #include "mspace.h"
+#include "../common/gc_numa.h"
 
 static Boolean mspace_alloc_block(Mspace* mspace, Allocator* allocator)
 {
   alloc_context_reset(allocator);
 
+  /* survivors are copied to the node of the collector */
+  if(gc_numa){
+    Block_Header* alloc_block = gc_numa_alloc_block((Blocked_Space*)mspace, mos_numa_pools);
+    if(alloc_block == NULL) return FALSE;
+    allocator_init_free_block(allocator, alloc_block);
+    return TRUE;
+  }
+
   /* now try to get a new block */
   unsigned int old_free_idx = mspace->free_block_idx;
   unsigned int new_free_idx = old_free_idx+1;
@@ -20,6 +20,7 @@
  */
 
 #include "mspace_collect_compact.h"
+#include "../common/object_pin.h"
 
 
 struct GC_Gen;
@@ -71,6 +72,12 @@ void gc_reset_block_for_collectors(GC* gc, Mspace* mspace)
     collector->cur_target_block = NULL;
     collector->cur_compact_block = NULL;
   }
+  /* the pinned blocks are kept in place, mspace can't be shrunk below them */
+  if(num_pinned_blocks){
+    unsigned int pinned_blk_idx = blocked_space_last_pinned_block_idx((Blocked_Space*)mspace);
+    if(pinned_blk_idx > free_blk_idx)
+      free_blk_idx = pinned_blk_idx;
+  }
   mspace->free_block_idx = free_blk_idx+1;  
   return;
 }
@@ -86,15 +93,18 @@ void gc_init_block_for_collectors(GC* gc, Mspace* mspace)
   
   /*Needn't change LOS size.*/
   if(tuner->kind == TRANS_NOTHING){
+    block = (Block_Header*)&mspace->blocks[0];
     for(i=0; i<gc->num_active_collectors; i++){
       Collector* collector = gc->collectors[i];
-      block = (Block_Header*)&mspace->blocks[i];
+      /* pinned blocks are neither compacted nor used as target */
+      while(block->status == BLOCK_PINNED)
+        block = block->next;
       collector->cur_target_block = block;
       collector->cur_compact_block = block;
       block->status = BLOCK_TARGET;
+      block = block->next;
     }
     
-    block = (Block_Header*)&mspace->blocks[i];
     next_block_for_target = block;
     next_block_for_compact = block;
     return;
@@ -175,6 +185,11 @@ Block_Header* mspace_get_next_compact_block(Collector* collector, Mspace* mspace
       cur_compact_block = (Block_Header*)next_block_for_compact;
       continue;
     }
+    /* the block holds pinned objects, leave it alone */
+    if(cur_compact_block->status == BLOCK_PINNED){
+      cur_compact_block = (Block_Header*)next_block_for_compact;
+      continue;
+    }
     /* got it, set its state to be BLOCK_IN_COMPACT. It must be the first time touched by compactor */
     block_status = cur_compact_block->status;
     assert( !(block_status & (BLOCK_IN_COMPACT|BLOCK_COMPACTED|BLOCK_TARGET)));
@@ -282,7 +297,10 @@ void mspace_collection(Mspace* mspace)
   if(major_is_compact_slide()){
   
     TRACE2("gc.process", "GC: slide compact algo start ... \n");
+    /* move-compact moves the objects together with their vt mark bits, so only slide-compact uses the bitmap */
+    gc_mark_bitmap_in_use = gc_mark_bitmap;
     collector_execute_task(gc, (TaskType)slide_compact_mspace, (Space*)mspace);
+    gc_mark_bitmap_in_use = FALSE;
     TRACE2("gc.process", "\nGC: end of slide compact algo ... \n");
   
   }else if( major_is_compact_move()){      
@@ -23,6 +23,8 @@
 #include "../trace_forward/fspace.h"
 #include "../los/lspace.h"
 #include "../finalizer_weakref/finalizer_weakref.h"
+#include "../common/object_pin.h"
+#include "../common/gc_phase_time.h"
 #ifdef USE_32BITS_HASHCODE
 #include "../common/hashcode.h"
 #endif
@@ -173,7 +175,14 @@ static void mspace_fix_repointed_refs(Collector *collector, Mspace *mspace)
   Block_Header* curr_block = blocked_space_block_iterator_next((Blocked_Space*)mspace);
   
   while( curr_block){
-    if(curr_block->block_idx >= mspace->free_block_idx) break;    
+    if(curr_block->block_idx >= mspace->free_block_idx){
+      /* NOS blocks holding pinned objects are not compacted, but their refs have to be fixed */
+      if(!num_pinned_blocks) break;
+      if(curr_block->status == BLOCK_PINNED)
+        block_fix_ref_after_marking(curr_block);
+      curr_block = blocked_space_block_iterator_next((Blocked_Space*)mspace);
+      continue;
+    }
     curr_block->free = curr_block->new_free; //
     block_fix_ref_after_marking(curr_block);
     curr_block = blocked_space_block_iterator_next((Blocked_Space*)mspace);
@@ -183,8 +192,11 @@ static void mspace_fix_repointed_refs(Collector *collector, Mspace *mspace)
 }
       
 static volatile unsigned int num_marking_collectors = 0;
+static volatile unsigned int num_weakref_collectors = 0;
 static volatile unsigned int num_fixing_collectors = 0;
 static volatile unsigned int num_moving_collectors = 0;
+static volatile unsigned int num_los_repointing_collectors = 0;
+static volatile unsigned int num_los_moving_collectors = 0;
 static volatile unsigned int num_restoring_collectors = 0;
 static volatile unsigned int num_extending_collectors = 0;
 
@@ -214,9 +226,25 @@ void move_compact_mspace(Collector* collector)
   old_num = atomic_inc32(&num_marking_collectors);
   if( ++old_num == num_active_collectors ){
     /* last collector's world here */
+    gc_phase_end(GC_PHASE_MARK);
     /* prepare for next phase */
     gc_init_block_for_collectors(gc, mspace); 
     
+    if(!IGNORE_FINREF )
+      gc_prepare_identify_weakrefs(gc);
+    /* let other collectors go */
+    num_marking_collectors++; 
+  }
+  while(num_marking_collectors != num_active_collectors + 1);
+
+  /* the soft and weak references are identified by all the collectors */
+  atomic_cas32( &num_weakref_collectors, 0, num_active_collectors+1);
+
+  if(!IGNORE_FINREF )
+    collector_identify_weakrefs(collector);
+  old_num = atomic_inc32(&num_weakref_collectors);
+  if( ++old_num == num_active_collectors ){
+    /* last collector's world here */
     if(!IGNORE_FINREF )
       collector_identify_finref(collector);
 #ifndef BUILD_IN_REFERENT
@@ -226,6 +254,7 @@ void move_compact_mspace(Collector* collector)
     }
 #endif
     gc_identify_dead_weak_roots(gc);
+    gc_phase_end(GC_PHASE_REFERENCE);
 
 #ifdef USE_32BITS_HASHCODE
     if((!LOS_ADJUST_BOUNDARY) && (is_fallback))
@@ -233,9 +262,9 @@ void move_compact_mspace(Collector* collector)
 #endif
     debug_num_compact_blocks = 0;
     /* let other collectors go */
-    num_marking_collectors++; 
+    num_weakref_collectors++; 
   }
-  while(num_marking_collectors != num_active_collectors + 1);
+  while(num_weakref_collectors != num_active_collectors + 1);
 
   TRACE2("gc.process", "GC: collector["<<((POINTER_SIZE_INT)collector->thread_handle)<<"]:  finish pass1");
 
@@ -255,25 +284,36 @@ void move_compact_mspace(Collector* collector)
   old_num = atomic_inc32(&num_moving_collectors);
   if( ++old_num == num_active_collectors ){
     /* single thread world */
+    gc_phase_end(GC_PHASE_COMPACT);
     if(lspace->move_object) 
-      lspace_compute_object_target(collector, lspace);    
-    
+      lspace_compute_compact_regions(lspace);
+    num_moving_collectors++; 
+  }
+  while(num_moving_collectors != num_active_collectors + 1);
+
+  atomic_cas32( &num_los_repointing_collectors, 0, num_active_collectors+1);
+  if(lspace->move_object)
+    lspace_compute_object_target(collector, lspace);
+  old_num = atomic_inc32(&num_los_repointing_collectors);
+  if( ++old_num == num_active_collectors ){
+    /* single thread world */
+    gc_phase_end(GC_PHASE_LOS);
     gc->collect_result = gc_collection_result(gc);
     if(!gc->collect_result){
-      num_moving_collectors++; 
+      num_los_repointing_collectors++; 
       return;
     }
     
     if(verify_live_heap){
-      assert( debug_num_compact_blocks == mspace->num_managed_blocks + nos->num_managed_blocks );	
+      assert( debug_num_compact_blocks + num_pinned_blocks == mspace->num_managed_blocks + nos->num_managed_blocks );	
       debug_num_compact_blocks = 0;
     }
 
     gc_reset_block_for_collectors(gc, mspace);
     blocked_space_block_iterator_init((Blocked_Space*)mspace);
-    num_moving_collectors++; 
+    num_los_repointing_collectors++; 
   }
-  while(num_moving_collectors != num_active_collectors + 1);
+  while(num_los_repointing_collectors != num_active_collectors + 1);
   if(!gc->collect_result) return;
   
   TRACE2("gc.process", "GC: collector["<<((POINTER_SIZE_INT)collector->thread_handle)<<"]:  finish pass2");
@@ -292,12 +332,25 @@ void move_compact_mspace(Collector* collector)
     /* last collector's world here */
     lspace_fix_repointed_refs(collector, lspace);   
     gc_fix_rootset(collector, FALSE);
-    if(lspace->move_object)  lspace_sliding_compact(collector, lspace);    
+    gc_phase_end(GC_PHASE_FIX);
 
     num_fixing_collectors++; 
   }
   while(num_fixing_collectors != num_active_collectors + 1);
 
+  if(lspace->move_object){
+    atomic_cas32( &num_los_moving_collectors, 0, num_active_collectors+1);
+    lspace_sliding_compact(collector, lspace);
+    old_num = atomic_inc32(&num_los_moving_collectors);
+    if( ++old_num == num_active_collectors ){
+      /* last collector's world here */
+      gc_phase_end(GC_PHASE_LOS);
+      lspace_release_compact_regions(lspace);
+      num_los_moving_collectors++;
+    }
+    while(num_los_moving_collectors != num_active_collectors + 1);
+  }
+
   TRACE2("gc.process", "GC: collector["<<((POINTER_SIZE_INT)collector->thread_handle)<<"]:  finish pass3");
 
   /* Pass 4: **************************************************
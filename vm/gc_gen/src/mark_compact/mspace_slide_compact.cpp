@@ -22,6 +22,9 @@
 #include "mspace_collect_compact.h"
 #include "../los/lspace.h"
 #include "../finalizer_weakref/finalizer_weakref.h"
+#include "../common/object_pin.h"
+#include "../common/gc_phase_time.h"
+#include "../verify/verify_live_heap.h"
 
 #ifdef GC_GEN_STATS
 #include "../gen/gen_stats.h"
@@ -59,6 +62,10 @@ static void mspace_compute_object_target(Collector* collector, Mspace* mspace)
 #endif
 
   while( curr_block ){
+    /* the verifier has counted the live objects before the collection, which a fallback collection follows */
+    assert(!verify_live_heap || !gc_mark_bitmap_in_use || collect_is_fallback()
+           || mark_bitmap_num_marked(curr_block->base, curr_block->free) == curr_block->num_live_objs);
+
     void* start_pos;
     Partial_Reveal_Object *first_obj = block_get_first_marked_obj_prefetch_next(curr_block, &start_pos);
     if(first_obj){
@@ -160,7 +167,11 @@ static void mspace_fix_repointed_refs(Collector *collector, Mspace *mspace)
   
   /* for ALGO_MAJOR, we must iterate over all compact blocks */
   while( curr_block){
-    block_fix_ref_after_repointing(curr_block); 
+    /* pinned blocks were not walked when computing object targets, so they have no prefetched pointers */
+    if(curr_block->status == BLOCK_PINNED)
+      block_fix_ref_after_marking(curr_block);
+    else
+      block_fix_ref_after_repointing(curr_block); 
     curr_block = blocked_space_block_iterator_next((Blocked_Space*)mspace);
   }
 
@@ -215,7 +226,7 @@ static Block_Header *get_next_dest_block(Mspace *mspace)
         (Block_Header *)round_down_to_size((POINTER_SIZE_INT)(last_block_for_dest->base), GC_BLOCK_SIZE_BYTES);
   for(; cur_dest_block <= last_dest_block; cur_dest_block = cur_dest_block->next){
     if(!cur_dest_block)  return NULL;
-    if(cur_dest_block->status == BLOCK_DEST){
+    if(cur_dest_block->status == BLOCK_DEST || cur_dest_block->status == BLOCK_PINNED){
       continue;
     }
     if(cur_dest_block->dest_counter == 0 && cur_dest_block->src){
@@ -252,7 +263,7 @@ static Block_Header *check_dest_block(Mspace *mspace)
   unsigned int total_dest_counter = 0;
   Block_Header *last_dest_block = (Block_Header *)last_block_for_dest;
   for(; cur_dest_block < last_dest_block; cur_dest_block = cur_dest_block->next){
-    if(cur_dest_block->status == BLOCK_DEST)
+    if(cur_dest_block->status == BLOCK_DEST || cur_dest_block->status == BLOCK_PINNED)
       continue;
     if(cur_dest_block->dest_counter == 0 && cur_dest_block->src){
       return cur_dest_block;
@@ -295,7 +306,7 @@ static inline Partial_Reveal_Object *get_next_first_src_obj(Mspace *mspace)
     }
     
     Partial_Reveal_Object *next_src_obj = GC_BLOCK_HEADER(first_src_obj)->next_src;
-    if(next_src_obj && GC_BLOCK_HEADER(ref_to_obj_ptr((REF)get_obj_info_raw(next_src_obj))) != next_dest_block){
+    if(next_src_obj && GC_BLOCK_HEADER(fw_oi_to_obj_ptr(get_obj_info_raw(next_src_obj))) != next_dest_block){
       next_src_obj = NULL;
     }
     next_dest_block->src = next_src_obj;
@@ -396,9 +407,13 @@ static void mspace_sliding_compact(Collector* collector, Mspace* mspace)
 }
 
 
+static volatile unsigned int num_clearing_collectors = 0;
 static volatile unsigned int num_marking_collectors = 0;
+static volatile unsigned int num_weakref_collectors = 0;
 static volatile unsigned int num_repointing_collectors = 0;
+static volatile unsigned int num_los_repointing_collectors = 0;
 static volatile unsigned int num_fixing_collectors = 0;
+static volatile unsigned int num_los_moving_collectors = 0;
 static volatile unsigned int num_moving_collectors = 0;
 static volatile unsigned int num_restoring_collectors = 0;
 static volatile unsigned int num_extending_collectors = 0;
@@ -411,6 +426,19 @@ void slide_compact_mspace(Collector* collector)
   
   unsigned int num_active_collectors = gc->num_active_collectors;
 
+  /* clear the mark bitmap of the committed parts of the spaces, every collector its own part */
+  if(gc_mark_bitmap_in_use){
+    atomic_cas32( &num_clearing_collectors, 0, num_active_collectors);
+    unsigned int stripe = (unsigned int)(POINTER_SIZE_INT)collector->thread_handle;
+    Space* spaces[] = { (Space*)lspace, (Space*)mspace, gc_get_nos((GC_Gen*)gc) };
+    for(unsigned int i = 0; i < sizeof(spaces)/sizeof(Space*); i++){
+      void* start = spaces[i]->heap_start;
+      gc_mark_bitmap_clear(start, (void*)((POINTER_SIZE_INT)start + spaces[i]->committed_heap_size), stripe, num_active_collectors);
+    }
+    atomic_inc32(&num_clearing_collectors);
+    while(num_clearing_collectors != num_active_collectors);
+  }
+
   /* Pass 1: **************************************************
     *mark all live objects in heap, and save all the slots that 
     *have references  that are going to be repointed.
@@ -430,7 +458,23 @@ void slide_compact_mspace(Collector* collector)
 
    /* last collector's world here */
   if( ++old_num == num_active_collectors ){
+    gc_phase_end(GC_PHASE_MARK);
+    if(!IGNORE_FINREF )
+      gc_prepare_identify_weakrefs(gc);
+    /* let other collectors go */
+    num_marking_collectors++; 
+  }
+  while(num_marking_collectors != num_active_collectors + 1);
 
+  /* the soft and weak references are identified by all the collectors */
+  atomic_cas32( &num_weakref_collectors, 0, num_active_collectors+1);
+
+  if(!IGNORE_FINREF )
+    collector_identify_weakrefs(collector);
+  old_num = atomic_inc32(&num_weakref_collectors);
+
+   /* last collector's world here */
+  if( ++old_num == num_active_collectors ){
     if(!IGNORE_FINREF )
       collector_identify_finref(collector);
 #ifndef BUILD_IN_REFERENT
@@ -440,6 +484,7 @@ void slide_compact_mspace(Collector* collector)
     }
 #endif
     gc_identify_dead_weak_roots(gc);
+    gc_phase_end(GC_PHASE_REFERENCE);
 
     if( gc->tuner->kind != TRANS_NOTHING ) gc_compute_space_tune_size_after_marking(gc);
     //assert(!(gc->tuner->tuning_size % GC_BLOCK_SIZE_BYTES));
@@ -453,9 +498,9 @@ void slide_compact_mspace(Collector* collector)
 
     last_block_for_dest = NULL;
     /* let other collectors go */
-    num_marking_collectors++; 
+    num_weakref_collectors++; 
   }
-  while(num_marking_collectors != num_active_collectors + 1);
+  while(num_weakref_collectors != num_active_collectors + 1);
 
   TRACE2("gc.process", "GC: collector["<<((POINTER_SIZE_INT)collector->thread_handle)<<"]:  finish pass1 and start pass2: relocating mos&nos...");
 
@@ -473,20 +518,32 @@ void slide_compact_mspace(Collector* collector)
   old_num = atomic_inc32(&num_repointing_collectors);
   /*last collector's world here*/
   if( ++old_num == num_active_collectors ){
-    if(lspace->move_object) {
-      TRACE2("gc.process", "GC: collector["<<((POINTER_SIZE_INT)collector->thread_handle)<<"]: pass2: relocating los ...");
-      lspace_compute_object_target(collector, lspace);
-    }
+    gc_phase_end(GC_PHASE_COMPACT);
+    if(lspace->move_object)
+      lspace_compute_compact_regions(lspace);
+    num_repointing_collectors++; 
+  }
+  while(num_repointing_collectors != num_active_collectors + 1);
+
+  atomic_cas32( &num_los_repointing_collectors, 0, num_active_collectors+1);
+  if(lspace->move_object) {
+    TRACE2("gc.process", "GC: collector["<<((POINTER_SIZE_INT)collector->thread_handle)<<"]: pass2: relocating los ...");
+    lspace_compute_object_target(collector, lspace);
+  }
+  old_num = atomic_inc32(&num_los_repointing_collectors);
+  /*last collector's world here*/
+  if( ++old_num == num_active_collectors ){
+    gc_phase_end(GC_PHASE_LOS);
     gc->collect_result = gc_collection_result(gc);
     if(!gc->collect_result){
-      num_repointing_collectors++;
+      num_los_repointing_collectors++;
       return;
     }
     gc_reset_block_for_collectors(gc, mspace);
     gc_init_block_for_fix_repointed_refs(gc, mspace);
-    num_repointing_collectors++; 
+    num_los_repointing_collectors++; 
   }
-  while(num_repointing_collectors != num_active_collectors + 1);
+  while(num_los_repointing_collectors != num_active_collectors + 1);
   if(!gc->collect_result) return;
   TRACE2("gc.process", "GC: collector["<<((POINTER_SIZE_INT)collector->thread_handle)<<"]: finish pass2 and start pass3: repointing...");
 
@@ -501,19 +558,30 @@ void slide_compact_mspace(Collector* collector)
     lspace_fix_repointed_refs(collector, lspace);
     gc_fix_rootset(collector, FALSE);
     gc_init_block_for_sliding_compact(gc, mspace);
-    /*LOS_Shrink: This operation moves objects in LOS, and should be part of Pass 4
-      *lspace_sliding_compact is not binded with los shrink, we could slide compact los individually.
-      *So we use a flag lspace->move_object here, not tuner->kind == TRANS_FROM_LOS_TO_MOS.
-      */
-    if(lspace->move_object)  lspace_sliding_compact(collector, lspace);
+    gc_phase_end(GC_PHASE_FIX);
+    num_fixing_collectors++;
+  }
+  while(num_fixing_collectors != num_active_collectors + 1);
+
+  /*LOS_Shrink: This operation moves objects in LOS, and should be part of Pass 4
+    *lspace_sliding_compact is not binded with los shrink, we could slide compact los individually.
+    *So we use a flag lspace->move_object here, not tuner->kind == TRANS_FROM_LOS_TO_MOS.
+    */
+  atomic_cas32( &num_los_moving_collectors, 0, num_active_collectors+1);
+  if(lspace->move_object)  lspace_sliding_compact(collector, lspace);
+  old_num = atomic_inc32(&num_los_moving_collectors);
+  /*last collector's world here */
+  if( ++old_num == num_active_collectors ){
+    gc_phase_end(GC_PHASE_LOS);
+    if(lspace->move_object)  lspace_release_compact_regions(lspace);
     /*The temp blocks for storing interim infomation is copied to the real place they should be.
       *And the space of the blocks are freed, which is alloced in gc_space_tuner_init_fake_blocks_for_los_shrink.
       */
     last_block_for_dest = (Block_Header *)round_down_to_size((POINTER_SIZE_INT)last_block_for_dest->base, GC_BLOCK_SIZE_BYTES);
     if(gc->tuner->kind == TRANS_FROM_LOS_TO_MOS) gc_space_tuner_release_fake_blocks_for_los_shrink(gc);
-    num_fixing_collectors++;
+    num_los_moving_collectors++;
   }
-  while(num_fixing_collectors != num_active_collectors + 1);
+  while(num_los_moving_collectors != num_active_collectors + 1);
 
   TRACE2("gc.process", "GC: collector["<<((POINTER_SIZE_INT)collector->thread_handle)<<"]: finish pass3 and start pass4: moving...");
 
@@ -542,6 +610,7 @@ void slide_compact_mspace(Collector* collector)
   old_num = atomic_inc32(&num_restoring_collectors);
 
   if( ++old_num == num_active_collectors ){
+    gc_phase_end(GC_PHASE_COMPACT);
     if(gc->tuner->kind != TRANS_NOTHING)
       mspace_update_info_after_space_tuning(mspace);
     num_restoring_collectors++;
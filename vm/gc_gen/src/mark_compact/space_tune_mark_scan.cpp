@@ -34,7 +34,7 @@ static FORCE_INLINE void scan_slot(Collector* collector, REF *p_ref)
     GC_Gen_Collector_Stats* stats = (GC_Gen_Collector_Stats*)collector->stats;
     gc_gen_collector_update_marked_obj_stats_major(stats);
 #endif
-    collector_tracestack_push(collector, p_obj);
+    collector_markstack_push(collector, p_obj);
     unsigned int obj_size = vm_object_size(p_obj);
 #ifdef USE_32BITS_HASHCODE
     obj_size += (hashcode_is_set(p_obj))?GC_OBJECT_ALIGNMENT:0;
@@ -60,7 +60,7 @@ static FORCE_INLINE void scan_object(Collector* collector, Partial_Reveal_Object
     if(vtable->vtmark == VT_UNMARKED) {
       vtable->vtmark = VT_MARKED;
       if(obj_mark_in_vt(vtable->jlC))
-        collector_tracestack_push(collector, vtable->jlC);
+        collector_markstack_push(collector, vtable->jlC);
     }
   
   if( !object_has_ref_field(p_obj) ) return;
@@ -98,17 +98,17 @@ static FORCE_INLINE void scan_object(Collector* collector, Partial_Reveal_Object
 }
 
 
+static void drain_markstack(Collector* collector)
+{
+  Partial_Reveal_Object* p_obj;
+  while((p_obj = (Partial_Reveal_Object*)collector_markstack_pop(collector)))
+    scan_object(collector, p_obj);
+}
+
 static void trace_object(Collector* collector, Partial_Reveal_Object *p_obj)
 { 
   scan_object(collector, p_obj);
-  
-  Vector_Block* trace_stack = collector->trace_stack;
-  while( !vector_stack_is_empty(trace_stack)){
-    p_obj = (Partial_Reveal_Object *)vector_stack_pop(trace_stack); 
-    scan_object(collector, p_obj);
-    trace_stack = collector->trace_stack;
-  }
-    
+  drain_markstack(collector);
   return; 
 }
 
@@ -141,6 +141,7 @@ void mark_scan_heap_for_space_tune(Collector *collector)
   /* reset the num_finished_collectors to be 0 by one collector. This is necessary for the barrier later. */
   unsigned int num_active_collectors = gc->num_active_collectors;
   atomic_cas32( &num_finished_collectors, 0, num_active_collectors);
+  if(GC_MARK_STEAL) collector_mark_steal_init(collector);
    
   collector->trace_stack = free_task_pool_get_entry(metadata);
 
@@ -165,7 +166,7 @@ void mark_scan_heap_for_space_tune(Collector *collector)
          This can be worked around if we want. 
       */
       if(obj_mark_in_vt(p_obj)){
-        collector_tracestack_push(collector, p_obj);
+        collector_markstack_push(collector, p_obj);
 
 #ifdef GC_GEN_STATS 
         gc_gen_collector_update_rootset_ref_num(stats);
@@ -186,6 +187,13 @@ void mark_scan_heap_for_space_tune(Collector *collector)
     } 
     root_set = pool_iterator_next(metadata->gc_rootset_pool);
   }
+
+  if(GC_MARK_STEAL){
+    /* roots stay in our own mark stack, idle collectors steal them */
+    collector_mark_steal(collector, drain_markstack);
+    return;
+  }
+
   /* put back the last trace_stack task */    
   pool_put_entry(metadata->mark_task_pool, collector->trace_stack);
   
@@ -45,11 +45,15 @@ void gc_ms_initialize(GC_MS *gc_ms, POINTER_SIZE_INT min_heap_size, POINTER_SIZE
   assert(max_heap_size <= max_heap_size_bytes);
   assert(max_heap_size >= min_heap_size_bytes);
   
-  void *wspace_base;
+  void *wspace_base = NULL;
+#ifdef COMPRESS_REFERENCE
+  wspace_base = gc_reserve_zero_based_heap(max_heap_size);
+  if(!wspace_base)
+#endif
   wspace_base = vm_reserve_mem(0, max_heap_size);
   wspace_initialize((GC*)gc_ms, wspace_base, max_heap_size, max_heap_size);
   
-  HEAP_BASE = (POINTER_SIZE_INT)wspace_base;
+  gc_set_compressed_ref_mode(wspace_base, (void*)((POINTER_SIZE_INT)wspace_base + max_heap_size));
   
   gc_ms->heap_start = wspace_base;
   gc_ms->heap_end = (void*)((POINTER_SIZE_INT)wspace_base + max_heap_size);
@@ -115,7 +115,7 @@ inline Partial_Reveal_Object *next_alloc_slot_in_chunk(Chunk_Header *chunk)
   
   unsigned int slot_index = next_alloc_slot_index_in_table(table, chunk->slot_index, chunk->slot_num);
   assert((slot_index == MAX_SLOT_INDEX)
-            || (slot_index < chunk->slot_num) && slot_is_alloc_in_table(table, slot_index));
+            || ((slot_index < chunk->slot_num) && slot_is_alloc_in_table(table, slot_index)));
   if(slot_index == MAX_SLOT_INDEX)
     return NULL;
   Partial_Reveal_Object *p_obj = (Partial_Reveal_Object*)slot_index_to_addr(chunk, slot_index);
@@ -51,7 +51,7 @@ static FORCE_INLINE void scan_slot(Collector *collector, REF *p_ref)
 {
   if( read_slot(p_ref) == NULL) return;
   
-  collector_tracestack_push(collector, p_ref);
+  collector_markstack_push(collector, p_ref);
 }
 
 static FORCE_INLINE void scan_object(Collector *collector, REF *p_ref)
@@ -98,16 +98,18 @@ static FORCE_INLINE void scan_object(Collector *collector, REF *p_ref)
 
 }
 
+/* the fallback marking traces slots, so that the slots of forwarded NOS objects are fixed */
+static void drain_markstack(Collector *collector)
+{
+  REF *p_ref;
+  while((p_ref = (REF*)collector_markstack_pop(collector)))
+    scan_object(collector, p_ref);
+}
+
 static void trace_object(Collector *collector, REF *p_ref)
 {
   scan_object(collector, p_ref);
-  
-  Vector_Block *trace_stack = collector->trace_stack;
-  while(!vector_stack_is_empty(trace_stack)){
-    p_ref = (REF*)vector_stack_pop(trace_stack);
-    scan_object(collector, p_ref);
-    trace_stack = collector->trace_stack;
-  }
+  drain_markstack(collector);
 }
 
 /* NOTE:: This is another marking version: marking in color bitmap table.
@@ -137,6 +139,7 @@ void wspace_fallback_mark_scan(Collector *collector, Wspace *wspace)
   /* reset the num_finished_collectors to be 0 by one collector. This is necessary for the barrier later. */
   unsigned int num_active_collectors = gc->num_active_collectors;
   atomic_cas32(&num_finished_collectors, 0, num_active_collectors);
+  if(GC_MARK_STEAL) collector_mark_steal_init(collector);
   
   collector->trace_stack = free_task_pool_get_entry(metadata);
   
@@ -159,10 +162,17 @@ void wspace_fallback_mark_scan(Collector *collector, Wspace *wspace)
          and the second time the value is the ref slot is the old position as expected.
          This can be worked around if we want.
       */
-      collector_tracestack_push(collector, p_ref);
+      collector_markstack_push(collector, p_ref);
     }
     root_set = pool_iterator_next(metadata->gc_rootset_pool);
   }
+
+  if(GC_MARK_STEAL){
+    /* roots stay in our own mark stack, idle collectors steal them */
+    collector_mark_steal(collector, drain_markstack);
+    return;
+  }
+
   /* put back the last trace_stack task */
   pool_put_entry(metadata->mark_task_pool, collector->trace_stack);
   
@@ -17,6 +17,7 @@
 
 #include "wspace_mark_sweep.h"
 #include "../finalizer_weakref/finalizer_weakref.h"
+#include "../utils/prefetch_fifo.h"
 
 static Wspace *wspace_in_marking;
 static FORCE_INLINE Boolean obj_mark_gray(Partial_Reveal_Object *obj)
@@ -75,7 +76,7 @@ static FORCE_INLINE void scan_slot(Collector *collector, REF *p_ref)
   assert(address_belongs_to_gc_heap(p_obj, collector->gc));
   if(obj_mark_gray(p_obj)){
     assert(p_obj);
-    collector_tracestack_push(collector, p_obj);
+    collector_markstack_push(collector, p_obj);
   }
 }
 
@@ -88,7 +89,7 @@ static FORCE_INLINE void scan_object(Collector *collector, Partial_Reveal_Object
     if(vtable->vtmark == VT_UNMARKED) {
       vtable->vtmark = VT_MARKED;
       if(obj_mark_black(vtable->jlC))
-        collector_tracestack_push(collector, vtable->jlC);
+        collector_markstack_push(collector, vtable->jlC);
     }
   
   if(!object_has_ref_field(p_obj)) return;
@@ -100,8 +101,13 @@ static FORCE_INLINE void scan_object(Collector *collector, Partial_Reveal_Object
     unsigned int array_length = array->array_len;
     
     p_ref = (REF *)((POINTER_SIZE_INT)array + (int)array_first_element_offset(array));
-    for (unsigned int i = 0; i < array_length; i++)
+    for (unsigned int i = 0; i < array_length; i++){
+#ifdef PREFETCH_SUPPORTED
+      if(mark_prefetch && i + mark_prefetch_distance < array_length)
+        PREFETCH(read_slot(p_ref + i + mark_prefetch_distance));
+#endif
       scan_slot(collector, p_ref+i);
+    }
     
     return;
   }
@@ -111,6 +117,10 @@ static FORCE_INLINE void scan_object(Collector *collector, Partial_Reveal_Object
   int *ref_iterator = object_ref_iterator_init(p_obj);
   
   for(unsigned int i=0; i<num_refs; i++){
+#ifdef PREFETCH_SUPPORTED
+    if(mark_prefetch && i + 1 < num_refs)
+      PREFETCH(read_slot(object_ref_iterator_get(ref_iterator+i+1, p_obj)));
+#endif
     p_ref = object_ref_iterator_get(ref_iterator+i, p_obj);
     scan_slot(collector, p_ref);
   }
@@ -125,19 +135,52 @@ static FORCE_INLINE void scan_object(Collector *collector, Partial_Reveal_Object
 
 }
 
-static void trace_object(Collector *collector, Partial_Reveal_Object *p_obj)
+#ifdef PREFETCH_SUPPORTED
+/* The gray objects are popped mark_prefetch_distance objects ahead of scanning,
+   and their headers are prefetched when they are popped. */
+static void drain_markstack_prefetch(Collector *collector)
 {
-  scan_object(collector, p_obj);
-  obj_mark_black(p_obj);
+  Prefetch_Fifo fifo;
+  prefetch_fifo_init(&fifo);
   
-  Vector_Block *trace_stack = collector->trace_stack;
-  while(!vector_stack_is_empty(trace_stack)){
-    p_obj = (Partial_Reveal_Object*)vector_stack_pop(trace_stack);
+  while(TRUE){
+    while(prefetch_fifo_size(&fifo) < mark_prefetch_distance){
+      Partial_Reveal_Object *p_obj = (Partial_Reveal_Object*)collector_markstack_pop(collector);
+      if(!p_obj) break;
+      PREFETCH(p_obj);
+      prefetch_fifo_put(&fifo, (POINTER_SIZE_INT)p_obj);
+    }
+    if(prefetch_fifo_is_empty(&fifo)) break;
+    
+    Partial_Reveal_Object *p_obj = (Partial_Reveal_Object*)prefetch_fifo_get(&fifo);
     scan_object(collector, p_obj);
     obj_mark_black(p_obj);
-    trace_stack = collector->trace_stack;
   }
 }
+#endif
+
+static void drain_markstack(Collector *collector)
+{
+#ifdef PREFETCH_SUPPORTED
+  if(mark_prefetch){
+    drain_markstack_prefetch(collector);
+    return;
+  }
+#endif
+  
+  Partial_Reveal_Object *p_obj;
+  while((p_obj = (Partial_Reveal_Object*)collector_markstack_pop(collector))){
+    scan_object(collector, p_obj);
+    obj_mark_black(p_obj);
+  }
+}
+
+static void trace_object(Collector *collector, Partial_Reveal_Object *p_obj)
+{
+  scan_object(collector, p_obj);
+  obj_mark_black(p_obj);
+  drain_markstack(collector);
+}
 
 /* NOTE:: This is another marking version: marking in color bitmap table.
    Originally, we have to mark the object before put it into markstack, to
@@ -166,6 +209,7 @@ void wspace_mark_scan(Collector *collector, Wspace *wspace)
   /* reset the num_finished_collectors to be 0 by one collector. This is necessary for the barrier later. */
   unsigned int num_active_collectors = gc->num_active_collectors;
   atomic_cas32(&num_finished_collectors, 0, num_active_collectors);
+  if(GC_MARK_STEAL) collector_mark_steal_init(collector);
   
   collector->trace_stack = free_task_pool_get_entry(metadata);
   
@@ -191,10 +235,17 @@ void wspace_mark_scan(Collector *collector, Wspace *wspace)
       */
       assert(address_belongs_to_gc_heap(p_obj, gc));
       if(obj_mark_gray(p_obj))
-        collector_tracestack_push(collector, p_obj);
+        collector_markstack_push(collector, p_obj);
     }
     root_set = pool_iterator_next(metadata->gc_rootset_pool);
   }
+
+  if(GC_MARK_STEAL){
+    /* roots stay in our own mark stack, idle collectors steal them */
+    collector_mark_steal(collector, drain_markstack);
+    return;
+  }
+
   /* put back the last trace_stack task */
   pool_put_entry(metadata->mark_task_pool, collector->trace_stack);
   
@@ -25,6 +25,7 @@
 #include "../common/gc_metadata.h"
 #include "../finalizer_weakref/finalizer_weakref.h"
 #include "../common/compressed_ref.h"
+#include "../common/gc_phase_time.h"
 
 #ifdef GC_GEN_STATS
 #include "../gen/gen_stats.h"
@@ -311,6 +312,7 @@ void gen_ss_pool(Collector* collector)
     return;
   }
   /* single collector world */
+  gc_phase_end(GC_PHASE_MARK);
   gc->collect_result = gc_collection_result(gc);
   if(!gc->collect_result){
 #ifndef BUILD_IN_REFERENT
@@ -330,8 +332,10 @@ void gen_ss_pool(Collector* collector)
     }
 #endif
   gc_identify_dead_weak_roots(gc);
+  gc_phase_end(GC_PHASE_REFERENCE);
   
   gc_fix_rootset(collector, FALSE);
+  gc_phase_end(GC_PHASE_FIX);
   
   TRACE2("gc.process", "GC: collector[0] finished");
 
@@ -21,6 +21,7 @@
 #include "../thread/collector_alloc.h"
 #include "../common/gc_metadata.h"
 #include "../finalizer_weakref/finalizer_weakref.h"
+#include "../common/gc_phase_time.h"
 
 #ifdef GC_GEN_STATS
 #include "../gen/gen_stats.h"
@@ -287,6 +288,7 @@ void nongen_ss_pool(Collector* collector)
     TRACE2("gc.process", "GC: collector["<<(POINTER_SIZE_INT)collector->thread_handle<<"] finished");
     return;
   }
+  gc_phase_end(GC_PHASE_MARK);
   gc->collect_result = gc_collection_result(gc);
   if(!gc->collect_result){
 #ifndef BUILD_IN_REFERENT
@@ -306,8 +308,10 @@ void nongen_ss_pool(Collector* collector)
   }
 #endif
   gc_identify_dead_weak_roots(gc);
+  gc_phase_end(GC_PHASE_REFERENCE);
   
   gc_fix_rootset(collector, FALSE);
+  gc_phase_end(GC_PHASE_FIX);
   
   TRACE2("gc.process", "GC: collector[0] finished");
 
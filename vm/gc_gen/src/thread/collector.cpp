@@ -26,6 +26,9 @@
 #include "../finalizer_weakref/finalizer_weakref.h"
 #include "../common/space_tuner.h"
 #include "../mark_sweep/wspace.h"
+#include "../utils/stealable_stack.h"
+#include "../common/object_pin.h"
+#include "../common/gc_numa.h"
 
 unsigned int MINOR_COLLECTORS = 0;
 unsigned int MAJOR_COLLECTORS = 0;
@@ -85,7 +88,7 @@ static void collector_reset_thread(Collector *collector)
   GC_Metadata* metadata = collector->gc->metadata;
   
   if(gc_is_gen_mode() && collect_is_minor()){
-    if( NOS_PARTIAL_FORWARD || minor_is_semispace() ){
+    if( NOS_PARTIAL_FORWARD || minor_is_semispace() || num_pinned_blocks ){
       assert(collector->rem_set==NULL);
       collector->rem_set = free_set_pool_get_entry(metadata);
     }
@@ -167,6 +170,9 @@ static int collector_thread_func(void *arg)
   Collector *collector = (Collector *)arg;
   assert(collector);
   
+  if(gc_numa)
+    gc_numa_bind_collector((unsigned int)(POINTER_SIZE_INT)collector->thread_handle);
+
   while(true){
     /* Waiting for newly assigned task */
     collector_wait_for_task(collector); 
@@ -179,7 +185,9 @@ static int collector_thread_func(void *arg)
       return 1;
     }
       
+    int64 task_start_time = time_now();
     task_func(collector);
+    collector->time_working += time_now() - task_start_time;
 
    //conducted after collection to return last TLB in hand 
    #if !defined(USE_UNIQUE_MARK_SWEEP_GC) && !defined(USE_UNIQUE_MOVE_COMPACT_GC)
@@ -255,6 +263,7 @@ void collector_destruct(GC* gc)
     collector_destruct_stats(collector);
 #endif
     gc_destruct_collector_alloc(gc, collector);   
+    stealable_stack_destruct(collector->mark_stack);
   }
   assert(live_collector_num == 0);
   
@@ -285,6 +294,8 @@ void collector_initialize(GC* gc)
     /* FIXME:: thread_handle is for temporary control */
     collector->thread_handle = (VmThreadHandle)(POINTER_SIZE_INT)i;
     collector->gc = gc;
+    collector->mark_stack = stealable_stack_create();
+    collector->steal_seed = i + 1;
     //init collector allocator (mainly for semi-space which has two target spaces)
     gc_init_collector_alloc(gc, collector);
     //init thread scheduling related stuff, creating collector thread
@@ -311,6 +322,23 @@ void collector_execute_task(GC* gc, TaskType task_func, Space* space)
   return;
 }
 
+/* runs task_func on the first num_collectors collectors before the collection starts,
+   so unlike collector_execute_task it doesn't prepare the collectors for collecting */
+void collector_execute_enumeration_task(GC* gc, TaskType task_func, unsigned int num_collectors)
+{
+  assert(num_collectors <= gc->num_collectors);
+  for(unsigned int i=0; i<num_collectors; i++){
+    Collector* collector = gc->collectors[i];
+    collector->task_func = task_func;
+    collector->collector_is_active = TRUE;
+    notify_collector_to_work(collector);
+  }
+  for(unsigned int i=0; i<num_collectors; i++)
+    wait_collector_to_finish(gc->collectors[i]);
+
+  return;
+}
+
 /* FIXME:: unimplemented. the design intention for this API is to lauch specified num of collectors. There might be already
    some collectors running. The specified num would be additional num. */
 void collector_execute_task_concurrent(GC* gc, TaskType task_func, Space* space, unsigned int num_collectors)
@@ -364,6 +392,12 @@ int64 gc_get_collector_time(GC* gc)
   return time_collector;
 }
 
+void gc_reset_collector_time_working(GC* gc)
+{
+  for(unsigned int i=0; i<gc->num_collectors; i++)
+    gc->collectors[i]->time_working = 0;
+}
+
 
 
 
@@ -51,6 +51,8 @@ typedef struct Collector{
   int64 time_measurement_end;
   /* End of Allocator --> */
 
+  int64 time_working; /* time spent in tasks since the collection started, in us */
+
   /* FIXME:: for testing */
   Space* collect_space;
   
@@ -58,9 +60,15 @@ typedef struct Collector{
   Allocator* backup_allocator;
 
   Vector_Block *trace_stack;
+  Stealable_Stack *mark_stack; /* work-stealing mark stack, used when GC_MARK_STEAL is on */
+  unsigned int steal_seed; /* random seed for picking steal victims */
   
   Vector_Block* rep_set; /* repointed set */
   Vector_Block* rem_set;
+  Vector_Block* root_set; /* roots found while enumerating thread stacks in parallel */
+#ifdef COMPRESS_REFERENCE
+  Vector_Block* uncompressed_root_set;
+#endif
 #ifdef USE_32BITS_HASHCODE
   Vector_Block* hashcode_set;
 #endif
@@ -104,6 +112,7 @@ void collector_reset(GC* gc);
 
 void collector_execute_task(GC* gc, TaskType task_func, Space* space);
 void collector_execute_task_concurrent(GC* gc, TaskType task_func, Space* space, unsigned int num_collectors);
+void collector_execute_enumeration_task(GC* gc, TaskType task_func, unsigned int num_collectors);
 void collector_release_weakref_sets(GC* gc, unsigned int num_collectors);
 
 void collector_restore_obj_info(Collector* collector);
@@ -118,6 +127,7 @@ void gc_gen_hook_for_collector_init(Collector *collector);
 Boolean is_collector_finished(GC* gc);
 void wait_collection_finish(GC* gc);
 int64 gc_get_collector_time(GC* gc);
+void gc_reset_collector_time_working(GC* gc);
 
 inline Boolean gc_collection_result(GC* gc)
 {
@@ -27,6 +27,7 @@
 
 struct GC_Gen;
 Space* gc_get_nos(GC_Gen* gc);
+void lspace_flush_mutator_cache(Mutator* mutator);
 void mutator_initialize(GC* gc, void *unused_gc_information) 
 {
   /* FIXME:: make sure gc_info is cleared */
@@ -34,6 +35,9 @@ void mutator_initialize(GC* gc, void *unused_gc_information)
   memset(mutator, 0, sizeof(Mutator));
   mutator->alloc_space = gc_get_nos((GC_Gen*)gc);
   mutator->gc = gc;
+  mutator->tlab_num_blocks = 1;
+  if(gc_alloc_sample_interval)
+    mutator_init_alloc_sampler(mutator);
     
   if(gc_is_gen_mode()){
     mutator->rem_set = free_set_pool_get_entry(gc->metadata);
@@ -72,6 +76,7 @@ void mutator_destruct(GC* gc, void *unused_gc_information)
   Mutator *mutator = (Mutator *)gc_get_tls();
 
   alloc_context_reset((Allocator*)mutator);
+  lspace_flush_mutator_cache(mutator);
 
 
   lock(gc->mutator_list_lock);     // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -121,12 +126,24 @@ void mutator_destruct(GC* gc, void *unused_gc_information)
   return;
 }
 
+/* the blocks left in the TLAB are wasted till the collection frees them */
+static void mutator_retire_tlab(Mutator* mutator)
+{
+  if(mutator->alloc_block)
+    mutator->tlab_waste_size += (POINTER_SIZE_INT)mutator->end - (POINTER_SIZE_INT)mutator->free;
+  mutator->tlab_waste_size += (POINTER_SIZE_INT)(mutator->tlab_end_block_idx - mutator->tlab_next_block_idx) << GC_BLOCK_SHIFT_COUNT;
+  mutator->tlab_next_block_idx = 0;
+  mutator->tlab_end_block_idx = 0;
+}
+
 void gc_reset_mutator_context(GC* gc)
 {
   TRACE2("gc.process", "GC: reset mutator context  ...\n");
   Mutator *mutator = gc->mutator_list;
   while (mutator) {
+    mutator_retire_tlab(mutator);
     alloc_context_reset((Allocator*)mutator);    
+    lspace_flush_mutator_cache(mutator);
     mutator = mutator->next;
   }  
   return;
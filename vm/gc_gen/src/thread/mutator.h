@@ -58,12 +58,31 @@ typedef struct Mutator {
   POINTER_SIZE_INT new_obj_occupied_size;
   POINTER_SIZE_INT write_barrier_marked_size;
 
+  /* LOS cache, see lspace.h */
+  void* los_cache_free;
+  void* los_cache_end;
+
+  /* adaptive TLAB, see fspace_alloc.cpp */
+  unsigned int tlab_num_blocks;     /* the number of NOS blocks claimed at a refill */
+  unsigned int tlab_next_block_idx; /* [next, end) are claimed and not used yet */
+  unsigned int tlab_end_block_idx;
+  unsigned int num_tlab_refills;    /* since last collection */
+  POINTER_SIZE_INT tlab_waste_size; /* the unused block tails since last collection */
+
+  /* allocation sampling, see mutator_alloc.cpp */
+  POINTER_SIZE_INT alloc_sample_interval; /* the current interval, drawn at random */
+  POINTER_SIZE_INT alloc_sample_left;     /* the bytes of the interval not allocated yet */
+  unsigned int alloc_sample_seed;
+
 } Mutator;
 
 void mutator_initialize(GC* gc, void* tls_gc_info);
 void mutator_destruct(GC* gc, void* tls_gc_info); 
 void mutator_reset(GC *gc);
 
+extern POINTER_SIZE_INT gc_alloc_sample_interval;
+void mutator_init_alloc_sampler(Mutator* mutator);
+
 void gc_reset_mutator_context(GC* gc);
 void gc_prepare_mutator_remset(GC* gc);
 
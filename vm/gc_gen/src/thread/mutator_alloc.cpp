@@ -58,9 +58,51 @@ void gc_alloc_statistic_obj_distrubution(unsigned int size)
 
 extern Boolean mutator_need_block;
 
+/* Allocation sampling (gc.alloc_sample_interval=<size>).
+   The sampler is only looked at when a mutator takes a new NOS block or allocates a LOS
+   object, so the fast path is untouched, and gc_alloc has a single test when sampling is off.
+   The bytes allocated in the retired block, or the LOS object, are counted down from an
+   interval drawn at random in [interval/2, interval*3/2), so the samples don't lock onto
+   periodic allocation patterns. The allocation that exhausts the interval is reported to
+   the VM with vm_sample_allocation(), which charges the bytes counted to its site. */
+
+POINTER_SIZE_INT gc_alloc_sample_interval = 0; /* in bytes, 0 if allocations are not sampled */
+
+static POINTER_SIZE_INT mutator_next_alloc_sample_interval(Mutator* mutator)
+{
+  /* xorshift, the seed is never 0 */
+  unsigned int x = mutator->alloc_sample_seed;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  mutator->alloc_sample_seed = x;
+  return gc_alloc_sample_interval/2 + (POINTER_SIZE_INT)x % gc_alloc_sample_interval;
+}
+
+void mutator_init_alloc_sampler(Mutator* mutator)
+{
+  mutator->alloc_sample_seed = (unsigned int)((POINTER_SIZE_INT)mutator ^ (POINTER_SIZE_INT)time_now()) | 1;
+  mutator->alloc_sample_interval = mutator_next_alloc_sample_interval(mutator);
+  mutator->alloc_sample_left = mutator->alloc_sample_interval;
+}
+
+static void mutator_alloc_sample(Mutator* mutator, Managed_Object_Handle p_obj, unsigned size, POINTER_SIZE_INT alloc_size)
+{
+  if(mutator->alloc_sample_left > alloc_size){
+    mutator->alloc_sample_left -= alloc_size;
+    return;
+  }
+
+  POINTER_SIZE_INT sampled_size = mutator->alloc_sample_interval - mutator->alloc_sample_left + alloc_size;
+  mutator->alloc_sample_interval = mutator_next_alloc_sample_interval(mutator);
+  mutator->alloc_sample_left = mutator->alloc_sample_interval;
+  vm_sample_allocation(p_obj, size, sampled_size);
+}
+
 Managed_Object_Handle gc_alloc(unsigned size, Allocation_Handle ah, void *unused_gc_tls) 
 {
   Managed_Object_Handle p_obj = NULL;
+  POINTER_SIZE_INT sample_size = 0;
  
   /* All requests for space should be multiples of 4 (IA32) or 8(IPF) */
   assert((size % GC_OBJECT_ALIGNMENT) == 0);
@@ -90,6 +132,7 @@ Managed_Object_Handle gc_alloc(unsigned size, Allocation_Handle ah, void *unused
 
   if ( size > GC_LOS_OBJ_SIZE_THRESHOLD ){
     p_obj = (Managed_Object_Handle)los_alloc(size, allocator);
+    if(gc_alloc_sample_interval) sample_size = size;
 
 #ifdef GC_GEN_STATS
     if (p_obj != NULL){
@@ -99,10 +142,19 @@ Managed_Object_Handle gc_alloc(unsigned size, Allocation_Handle ah, void *unused
     }
 #endif /* #ifdef GC_GEN_STATS */
 
+  }else if(gc_alloc_sample_interval){
+    /* nos_alloc retires the block if the object doesn't fit in it */
+    Block_Header* block = (Block_Header*)allocator->alloc_block;
+    POINTER_SIZE_INT block_used_size = block? (POINTER_SIZE_INT)allocator->free - (POINTER_SIZE_INT)block->base : 0;
+    p_obj = (Managed_Object_Handle)nos_alloc(size, allocator);
+    if((Block_Header*)allocator->alloc_block != block) sample_size = block_used_size;
   }else{
       p_obj = (Managed_Object_Handle)nos_alloc(size, allocator);
   }
 
+  if(p_obj == NULL && gc_heap_dump_on_oom)
+    gc_gen_heap_dump_on_oom((GC_Gen*)allocator->gc);
+
 #endif /* defined(USE_UNIQUE_MARK_SWEEP_GC) else */
 
   if( p_obj == NULL )
@@ -114,6 +166,9 @@ Managed_Object_Handle gc_alloc(unsigned size, Allocation_Handle ah, void *unused
   
   if(type_has_fin && !IGNORE_FINREF)
     mutator_add_finalizer((Mutator*)allocator, (Partial_Reveal_Object*)p_obj);
+
+  if(sample_size)
+    mutator_alloc_sample((Mutator*)allocator, p_obj, size, sample_size);
     
   return (Managed_Object_Handle)p_obj;
 }
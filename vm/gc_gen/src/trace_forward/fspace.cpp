@@ -23,6 +23,7 @@
 
 #ifdef PREFETCH_SUPPORTED
 Boolean mark_prefetch = FALSE;
+unsigned int mark_prefetch_distance = 8;
 #endif
 
 Boolean NOS_PARTIAL_FORWARD = FALSE;
@@ -142,6 +143,8 @@ void fspace_reset_after_collection(Fspace* fspace)
     block->next_src = NULL;
     assert(!block->dest_counter);
     if(block->status == BLOCK_FREE) continue;
+    /* the block holds pinned objects, it's set to BLOCK_USED in gc_reset_pinned_blocks */
+    if(block->status == BLOCK_PINNED) continue;
     block->status = BLOCK_FREE; 
     block->free = block->base;
 
@@ -52,6 +52,13 @@ void* fspace_heap_start_adjust(Fspace* fspace, void* new_heap_start, POINTER_SIZ
 void* fspace_alloc(unsigned size, Allocator *allocator);
 Boolean fspace_alloc_block(Fspace* fspace, Allocator* allocator);
 
+/* adaptive TLAB (gc.adaptive_tlab) */
+extern Boolean gc_adaptive_tlab;
+#define TLAB_MAX_NUM_BLOCKS 16
+#define TLAB_REFILLS_PER_GC 8
+
+void gc_update_mutator_tlabs(GC* gc);
+
 void fspace_reset_after_collection(Fspace* fspace);
 
 /* gen mode */
@@ -20,33 +20,79 @@
  */
 
 #include "fspace.h"
+#include "../thread/mutator.h"
 #include "../common/gc_concurrent.h"
 #include "../common/collection_scheduler.h"
+#include "../common/gc_numa.h"
+
+/* Adaptive TLAB (gc.adaptive_tlab).
+   A mutator allocates in NOS block by block. With the option, a refill claims a run of
+   tlab_num_blocks consecutive blocks with one atomic operation, and the next refills take the
+   blocks of the run without touching the space. Before every collection the run size of a
+   mutator is adapted to the number of blocks it has taken since the last collection, so that it
+   refills about TLAB_REFILLS_PER_GC times, and the threads that allocate little keep taking a
+   single block. A block is the smallest TLAB, since the objects can't straddle the block headers.
+   The claimed blocks that are not used by the collection count as waste, together with the
+   unused tails of the retired blocks. */
+
+Boolean gc_adaptive_tlab = FALSE;
+
+/* the next free block of the run claimed at the last refill */
+static Block_Header* mutator_take_claimed_block(Fspace* fspace, Mutator* mutator)
+{
+  while(mutator->tlab_next_block_idx < mutator->tlab_end_block_idx){
+    Block_Header* block = (Block_Header*)&(fspace->blocks[mutator->tlab_next_block_idx - fspace->first_block_idx]);
+    mutator->tlab_next_block_idx++;
+    /* skip the block kept for pinned objects in last collection */
+    if(block->status == BLOCK_FREE) return block;
+  }
+  return NULL;
+}
 
 Boolean fspace_alloc_block(Fspace* fspace, Allocator* allocator)
 {    
+  /* only the mutators allocate in NOS */
+  Mutator* mutator = (Mutator*)allocator;
+  if(allocator->alloc_block)
+    mutator->tlab_waste_size += (POINTER_SIZE_INT)allocator->end - (POINTER_SIZE_INT)allocator->free;
   alloc_context_reset(allocator);
 
-  /* now try to get a new block */
+  if(gc_numa){
+    Block_Header* alloc_block = gc_numa_alloc_block((Blocked_Space*)fspace, nos_numa_pools);
+    if(alloc_block == NULL) return FALSE;
+    allocator_init_free_block(allocator, alloc_block);
+    mutator->num_alloc_blocks++;
+    return TRUE;
+  }
+
+  Block_Header* alloc_block = mutator_take_claimed_block(fspace, mutator);
+
+  /* now try to get new blocks */
   unsigned int old_free_idx = fspace->free_block_idx;
-  unsigned int new_free_idx = old_free_idx+1;
-  while(old_free_idx <= fspace->ceiling_block_idx){   
+  while(alloc_block == NULL && old_free_idx <= fspace->ceiling_block_idx){
+    unsigned int num_blocks = mutator->tlab_num_blocks;
+    unsigned int num_free_blocks = fspace->ceiling_block_idx + 1 - old_free_idx;
+    /* the last free blocks are handed out one by one, so no mutator runs out of NOS while others hold a run */
+    if(num_blocks > 1 && num_free_blocks < num_blocks * allocator->gc->num_mutators)
+      num_blocks = 1;
+
+    unsigned int new_free_idx = old_free_idx + num_blocks;
     unsigned int allocated_idx = atomic_cas32(&fspace->free_block_idx, new_free_idx, old_free_idx);
-    if(allocated_idx != old_free_idx){     /* if failed */  
-      old_free_idx = fspace->free_block_idx;
-      new_free_idx = old_free_idx+1;
-      continue;
+    if(allocated_idx == old_free_idx){
+      /* ok, got them */
+      mutator->num_tlab_refills++;
+      mutator->tlab_next_block_idx = allocated_idx;
+      mutator->tlab_end_block_idx = new_free_idx;
+      alloc_block = mutator_take_claimed_block(fspace, mutator);
     }
-    /* ok, got one */
-    Block_Header* alloc_block = (Block_Header*)&(fspace->blocks[allocated_idx - fspace->first_block_idx]);
-    
-    allocator_init_free_block(allocator, alloc_block);
-
-    return TRUE;
+    old_free_idx = fspace->free_block_idx;
   }
 
-  return FALSE;
-  
+  if(alloc_block == NULL) return FALSE;
+
+  allocator_init_free_block(allocator, alloc_block);
+  mutator->num_alloc_blocks++;
+  return TRUE;
 }
 
 /* FIXME:: the collection should be separated from the allocation */
@@ -67,7 +113,8 @@ void* fspace_alloc(unsigned size, Allocator *allocator)
   while( !fspace_alloc_block(fspace, allocator)){
     vm_gc_lock_enum();
     /* after holding lock, try if other thread collected already */
-    if ( !blocked_space_has_free_block((Blocked_Space*)fspace) ) {  
+    if ( !blocked_space_has_free_block((Blocked_Space*)fspace) &&
+         !(gc_numa && gc_numa_pools_have_block(nos_numa_pools)) ) {  
         if(attempts < 2) {
 #ifdef GC_GEN_STATS
         GC_Gen* gc = (GC_Gen*)allocator->gc;
@@ -96,4 +143,32 @@ void* fspace_alloc(unsigned size, Allocator *allocator)
   
 }
 
+/* called before every collection of GC_Gen, after the mutator TLABs are retired */
+void gc_update_mutator_tlabs(GC* gc)
+{
+  unsigned int num_refills = 0;
+  POINTER_SIZE_INT waste_size = 0;
+
+  for(Mutator* mutator = gc->mutator_list; mutator; mutator = mutator->next){
+    num_refills += mutator->num_tlab_refills;
+    waste_size += mutator->tlab_waste_size;
 
+    if(gc_adaptive_tlab){
+      /* half way to the run size that gives TLAB_REFILLS_PER_GC refills, so a burst doesn't swing it */
+      unsigned int num_blocks = (mutator->tlab_num_blocks + mutator->num_alloc_blocks / TLAB_REFILLS_PER_GC) / 2;
+      if(num_blocks < 1) num_blocks = 1;
+      if(num_blocks > TLAB_MAX_NUM_BLOCKS) num_blocks = TLAB_MAX_NUM_BLOCKS;
+      mutator->tlab_num_blocks = num_blocks;
+    }
+
+    mutator->num_alloc_blocks = 0;
+    mutator->num_tlab_refills = 0;
+    mutator->tlab_waste_size = 0;
+  }
+
+#ifdef GC_GEN_STATS
+  GC_Gen_Stats* stats = ((GC_Gen*)gc)->stats;
+  stats->num_tlab_refills = num_refills;
+  stats->tlab_waste_size = waste_size;
+#endif
+}
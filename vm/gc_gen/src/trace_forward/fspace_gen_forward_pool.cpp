@@ -25,6 +25,9 @@
 #include "../common/gc_metadata.h"
 #include "../finalizer_weakref/finalizer_weakref.h"
 #include "../common/compressed_ref.h"
+#include "../common/object_pin.h"
+#include "../common/gc_phase_time.h"
+#include "../utils/prefetch_fifo.h"
 
 #ifdef GC_GEN_STATS
 #include "../gen/gen_stats.h"
@@ -115,8 +118,8 @@ static FORCE_INLINE void forward_object(Collector *collector, REF *p_ref)
     return;
   }
 
-  /* only mark the objects that will remain in fspace */
-  if(NOS_PARTIAL_FORWARD && !fspace_object_to_be_forwarded(p_obj, (Fspace*)space)) {
+  /* only mark the objects that will remain in fspace, including the objects in pinned blocks */
+  if((NOS_PARTIAL_FORWARD && !fspace_object_to_be_forwarded(p_obj, (Fspace*)space)) || obj_is_in_pinned_block(p_obj)) {
     assert(!obj_is_fw_in_oi(p_obj));
     /* this obj remains in fspace, remember its ref slot for next GC if p_ref is not root. 
        we don't need remember root ref. Actually it's wrong to rem root ref since they change in next GC */
@@ -204,22 +207,43 @@ void trace_forwarded_gen_jlC_from_vtable(Collector* collector, Partial_Reveal_Ob
   return;
 }
 
+#ifdef PREFETCH_SUPPORTED
+/* The slots are popped mark_prefetch_distance slots ahead of forwarding,
+   and the objects they point to are prefetched when they are popped. */
+static void trace_object_prefetch(Collector *collector, REF *p_ref)
+{
+  Prefetch_Fifo fifo;
+  prefetch_fifo_init(&fifo);
+  forward_object(collector, p_ref);
+
+  /* trace_stack is cleared if forwarding fails, the slots left in the fifo are dropped as well */
+  while(collector->result){
+    Vector_Block* trace_stack = (Vector_Block*)collector->trace_stack;
+    while(prefetch_fifo_size(&fifo) < mark_prefetch_distance && !vector_stack_is_empty(trace_stack)){
+      p_ref = (REF *)vector_stack_pop(trace_stack);
+      PREFETCH( read_slot(p_ref) );
+      prefetch_fifo_put(&fifo, (POINTER_SIZE_INT)p_ref);
+    }
+    if(prefetch_fifo_is_empty(&fifo)) break;
+    forward_object(collector, (REF *)prefetch_fifo_get(&fifo));
+  }
+}
+#endif
+
 static void trace_object(Collector *collector, REF *p_ref)
 { 
+#ifdef PREFETCH_SUPPORTED
+  if(mark_prefetch){
+    trace_object_prefetch(collector, p_ref);
+    return;
+  }
+#endif
+
   forward_object(collector, p_ref);
   
   Vector_Block* trace_stack = (Vector_Block*)collector->trace_stack;
   while( !vector_stack_is_empty(trace_stack)){
     p_ref = (REF *)vector_stack_pop(trace_stack); 
-#ifdef PREFETCH_SUPPORTED    
-    /* DO PREFETCH */
-   if(mark_prefetch) {
-     if(!vector_stack_is_empty(trace_stack)) {
-        REF *pref = (REF*)vector_stack_read(trace_stack, 0);
-        PREFETCH( read_slot(pref) );
-     }
-   }
-#endif   
     forward_object(collector, p_ref);
     trace_stack = (Vector_Block*)collector->trace_stack;
   }
@@ -349,6 +373,7 @@ void gen_forward_pool(Collector* collector)
     return;
   }
 
+  gc_phase_end(GC_PHASE_MARK);
   gc->collect_result = gc_collection_result(gc);
   if(!gc->collect_result){
 #ifndef BUILD_IN_REFERENT
@@ -368,8 +393,10 @@ void gen_forward_pool(Collector* collector)
     }
 #endif
   gc_identify_dead_weak_roots(gc);
+  gc_phase_end(GC_PHASE_REFERENCE);
   
   gc_fix_rootset(collector, FALSE);
+  gc_phase_end(GC_PHASE_FIX);
   
   TRACE2("gc.process", "GC: collector[0] finished");
 
@@ -25,6 +25,9 @@
 #include "../thread/collector.h"
 #include "../common/gc_metadata.h"
 #include "../finalizer_weakref/finalizer_weakref.h"
+#include "../common/object_pin.h"
+#include "../common/gc_phase_time.h"
+#include "../utils/prefetch_fifo.h"
 
 #ifdef GC_GEN_STATS
 #include "../gen/gen_stats.h"
@@ -102,6 +105,18 @@ static FORCE_INLINE void forward_object(Collector* collector, REF *p_ref)
     return;
   }
 
+  /* objects in pinned blocks remain in NOS, they are only marked */
+  if(obj_is_in_pinned_block(p_obj)){
+    if(obj_mark_in_oi(p_obj)){
+#ifdef GC_GEN_STATS
+      GC_Gen_Collector_Stats* stats = (GC_Gen_Collector_Stats*)collector->stats;
+      gc_gen_collector_update_marked_nos_obj_stats_minor(stats);
+#endif
+      scan_object(collector, p_obj);
+    }
+    return;
+  }
+
   /* following is the logic for forwarding */  
   Partial_Reveal_Object* p_target_obj = collector_forward_object(collector, p_obj);
   
@@ -136,25 +151,47 @@ static FORCE_INLINE void forward_object(Collector* collector, REF *p_ref)
   return;
 }
 
+#ifdef PREFETCH_SUPPORTED
+/* The slots are popped mark_prefetch_distance slots ahead of forwarding,
+   and the objects they point to are prefetched when they are popped. */
+static void trace_object_prefetch(Collector *collector, REF *p_ref)
+{
+  Prefetch_Fifo fifo;
+  prefetch_fifo_init(&fifo);
+  forward_object(collector, p_ref);
+
+  /* trace_stack is cleared if forwarding fails, the slots left in the fifo are dropped as well */
+  while(collector->result){
+    Vector_Block* trace_stack = (Vector_Block*)collector->trace_stack;
+    while(prefetch_fifo_size(&fifo) < mark_prefetch_distance && !vector_stack_is_empty(trace_stack)){
+      p_ref = (REF *)vector_stack_pop(trace_stack);
+      PREFETCH( read_slot(p_ref) );
+      prefetch_fifo_put(&fifo, (POINTER_SIZE_INT)p_ref);
+    }
+    if(prefetch_fifo_is_empty(&fifo)) break;
+    forward_object(collector, (REF *)prefetch_fifo_get(&fifo));
+  }
+}
+#endif
+
 static void trace_object(Collector *collector, REF *p_ref)
 { 
-  forward_object(collector, p_ref);
+#ifdef PREFETCH_SUPPORTED
+  if(mark_prefetch){
+    trace_object_prefetch(collector, p_ref);
+    return;
+  }
+#endif
 
+  forward_object(collector, p_ref);
+  
   Vector_Block* trace_stack = (Vector_Block*)collector->trace_stack;
   while( !vector_stack_is_empty(trace_stack)){
     p_ref = (REF *)vector_stack_pop(trace_stack); 
-#ifdef PREFETCH_SUPPORTED    
-    /* DO PREFETCH */
-   if(mark_prefetch) {
-     if(!vector_stack_is_empty(trace_stack)) {
-        REF *pref = (REF*)vector_stack_read(trace_stack, 0);
-        PREFETCH( read_slot(pref) );
-     }
-   }
-#endif    
     forward_object(collector, p_ref);
     trace_stack = (Vector_Block*)collector->trace_stack;
   }
+    
   return; 
 }
  
@@ -274,6 +311,7 @@ void nongen_forward_pool(Collector* collector)
     TRACE2("gc.process", "GC: collector["<<(POINTER_SIZE_INT)collector->thread_handle<<"] finished");
     return;
   }
+  gc_phase_end(GC_PHASE_MARK);
   gc->collect_result = gc_collection_result(gc);
   if(!gc->collect_result){
 #ifndef BUILD_IN_REFERENT
@@ -293,8 +331,10 @@ void nongen_forward_pool(Collector* collector)
     }
 #endif
   gc_identify_dead_weak_roots(gc);
+  gc_phase_end(GC_PHASE_REFERENCE);
   
   gc_fix_rootset(collector, FALSE);
+  gc_phase_end(GC_PHASE_FIX);
   
   TRACE2("gc.process", "GC: collector[0] finished");
 
@@ -0,0 +1,58 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _PREFETCH_FIFO_H_
+#define _PREFETCH_FIFO_H_
+
+/* A small thread-local ring of the entries a tracing loop is going to process next.
+   The loop prefetches what an entry refers to when it puts the entry in, so the
+   memory has most probably arrived in the cache when the entry comes out. */
+
+#define PREFETCH_FIFO_MAX_SIZE 16  /* must be a power of two */
+
+typedef struct Prefetch_Fifo{
+  POINTER_SIZE_INT entries[PREFETCH_FIFO_MAX_SIZE];
+  /* free running, wrapped when the entries are accessed */
+  unsigned int head;
+  unsigned int tail;
+}Prefetch_Fifo;
+
+inline void prefetch_fifo_init(Prefetch_Fifo* fifo)
+{
+  fifo->head = 0;
+  fifo->tail = 0;
+}
+
+inline unsigned int prefetch_fifo_size(Prefetch_Fifo* fifo)
+{ return fifo->tail - fifo->head; }
+
+inline Boolean prefetch_fifo_is_empty(Prefetch_Fifo* fifo)
+{ return fifo->head == fifo->tail; }
+
+inline void prefetch_fifo_put(Prefetch_Fifo* fifo, POINTER_SIZE_INT entry)
+{
+  assert(prefetch_fifo_size(fifo) < PREFETCH_FIFO_MAX_SIZE);
+  fifo->entries[fifo->tail++ & (PREFETCH_FIFO_MAX_SIZE - 1)] = entry;
+}
+
+inline POINTER_SIZE_INT prefetch_fifo_get(Prefetch_Fifo* fifo)
+{
+  assert(!prefetch_fifo_is_empty(fifo));
+  return fifo->entries[fifo->head++ & (PREFETCH_FIFO_MAX_SIZE - 1)];
+}
+
+#endif /* _PREFETCH_FIFO_H_ */
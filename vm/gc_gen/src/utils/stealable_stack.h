@@ -0,0 +1,121 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _STEALABLE_STACK_H_
+#define _STEALABLE_STACK_H_
+
+#include "../common/gc_common.h"
+
+/* Chase-Lev style work-stealing deque with a fixed-size circular buffer.
+   The owner pushes and pops at the bottom end (LIFO, DFS order), other
+   collectors steal from the top end (FIFO). top only ever grows, so there
+   is no ABA problem on the CAS; indices are compared with signed distance
+   so they can wrap around freely and never need to be reset.
+   When the buffer is full, push fails and the caller has to keep the entry
+   somewhere else (the collector trace_stack, which overflows into mark_task_pool). */
+
+/* this size must be 2's power */
+#define STEALABLE_STACK_ENTRY_NUM (8*KB)
+#define STEALABLE_STACK_INDEX_MASK (STEALABLE_STACK_ENTRY_NUM - 1)
+
+typedef struct Stealable_Stack{
+  volatile unsigned int top;    /* next entry to steal */
+  volatile unsigned int bottom; /* next free entry of the owner */
+  volatile POINTER_SIZE_INT entries[STEALABLE_STACK_ENTRY_NUM];
+}Stealable_Stack;
+
+inline Stealable_Stack* stealable_stack_create()
+{
+  unsigned int size = sizeof(Stealable_Stack);
+  Stealable_Stack* stack = (Stealable_Stack*)STD_MALLOC(size);
+  memset((void*)stack, 0, size);
+  return stack;
+}
+
+inline void stealable_stack_destruct(Stealable_Stack* stack)
+{
+  STD_FREE(stack);
+}
+
+inline unsigned int stealable_stack_size(Stealable_Stack* stack)
+{
+  int size = (int)(stack->bottom - stack->top);
+  return (size > 0)? (unsigned int)size : 0;
+}
+
+inline Boolean stealable_stack_is_empty(Stealable_Stack* stack)
+{ return (int)(stack->bottom - stack->top) <= 0; }
+
+/* only called by the owner */
+FORCE_INLINE Boolean stealable_stack_push(Stealable_Stack* stack, POINTER_SIZE_INT value)
+{
+  assert(value);
+  unsigned int bottom = stack->bottom;
+  if((int)(bottom - stack->top) >= STEALABLE_STACK_ENTRY_NUM)
+    return FALSE;
+
+  stack->entries[bottom & STEALABLE_STACK_INDEX_MASK] = value;
+  /* entry must be visible before the new bottom. Volatile stores are kept in order on IA32/EM64T. */
+#ifdef _IPF_
+  mem_fence();
+#endif
+  stack->bottom = bottom + 1;
+  return TRUE;
+}
+
+/* only called by the owner. Returns 0 if empty. */
+FORCE_INLINE POINTER_SIZE_INT stealable_stack_pop(Stealable_Stack* stack)
+{
+  unsigned int bottom = stack->bottom - 1;
+  stack->bottom = bottom;
+  /* the bottom store must be ordered before the top load, otherwise we race with a thief */
+  mem_fence();
+  unsigned int top = stack->top;
+
+  int size = (int)(bottom - top);
+  if(size < 0){ /* was empty */
+    stack->bottom = top;
+    return 0;
+  }
+
+  POINTER_SIZE_INT value = stack->entries[bottom & STEALABLE_STACK_INDEX_MASK];
+  if(size > 0) return value;
+
+  /* the last entry, race with thieves for it */
+  if(atomic_cas32(&stack->top, top + 1, top) != top)
+    value = 0;
+  stack->bottom = top + 1;
+  return value;
+}
+
+/* called by other collectors. Returns 0 if empty or if we lost the race. */
+inline POINTER_SIZE_INT stealable_stack_steal(Stealable_Stack* stack)
+{
+  unsigned int top = stack->top;
+  mem_fence();
+  unsigned int bottom = stack->bottom;
+
+  if((int)(bottom - top) <= 0) return 0;
+
+  POINTER_SIZE_INT value = stack->entries[top & STEALABLE_STACK_INDEX_MASK];
+  if(atomic_cas32(&stack->top, top + 1, top) != top)
+    return 0;
+
+  return value;
+}
+
+#endif /* #ifndef _STEALABLE_STACK_H_ */
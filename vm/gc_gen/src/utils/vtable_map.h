@@ -0,0 +1,110 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _VTABLE_MAP_H_
+#define _VTABLE_MAP_H_
+
+#include "../common/gc_common.h"
+
+/* Per-class map of a heap walk: an open addressing hash table keyed by the vtable, with the
+   number and the size of the objects found, and some data of the user of the map. A map is
+   only used by one thread, the maps of the walking collectors are merged afterwards. */
+
+typedef struct Vtable_Map_Entry{
+  Partial_Reveal_VTable* vt;
+  POINTER_SIZE_INT num_objs;
+  POINTER_SIZE_INT objs_size;
+  void* data;
+}Vtable_Map_Entry;
+
+typedef struct Vtable_Map{
+  Vtable_Map_Entry* entries;
+  unsigned int capacity; /* power of 2 */
+  unsigned int num_entries;
+}Vtable_Map;
+
+#define VTABLE_MAP_INIT_CAPACITY 1024
+
+inline void vtable_map_initialize(Vtable_Map* map)
+{
+  unsigned int size = VTABLE_MAP_INIT_CAPACITY * sizeof(Vtable_Map_Entry);
+  map->entries = (Vtable_Map_Entry*)STD_MALLOC(size);
+  assert(map->entries);
+  memset(map->entries, 0, size);
+  map->capacity = VTABLE_MAP_INIT_CAPACITY;
+  map->num_entries = 0;
+}
+
+inline void vtable_map_destruct(Vtable_Map* map)
+{
+  STD_FREE(map->entries);
+  map->entries = NULL;
+  map->capacity = 0;
+  map->num_entries = 0;
+}
+
+inline unsigned int vtable_map_hash(Partial_Reveal_VTable* vt, unsigned int capacity)
+{
+  /* the vtables are at least word aligned */
+  POINTER_SIZE_INT key = (POINTER_SIZE_INT)vt >> 3;
+  return (unsigned int)((key ^ (key >> 10) ^ (key >> 20)) & (capacity - 1));
+}
+
+inline Vtable_Map_Entry* vtable_map_find_slot(Vtable_Map_Entry* entries, unsigned int capacity, Partial_Reveal_VTable* vt)
+{
+  unsigned int index = vtable_map_hash(vt, capacity);
+  while(entries[index].vt != NULL && entries[index].vt != vt)
+    index = (index + 1) & (capacity - 1);
+  return &entries[index];
+}
+
+inline void vtable_map_grow(Vtable_Map* map)
+{
+  unsigned int capacity = map->capacity << 1;
+  unsigned int size = capacity * sizeof(Vtable_Map_Entry);
+  Vtable_Map_Entry* entries = (Vtable_Map_Entry*)STD_MALLOC(size);
+  assert(entries);
+  memset(entries, 0, size);
+
+  for(unsigned int i = 0; i < map->capacity; i++){
+    Vtable_Map_Entry* entry = &map->entries[i];
+    if(entry->vt != NULL)
+      *vtable_map_find_slot(entries, capacity, entry->vt) = *entry;
+  }
+
+  STD_FREE(map->entries);
+  map->entries = entries;
+  map->capacity = capacity;
+}
+
+/* the entry of vt, a new one is zeroed but for the vtable */
+inline Vtable_Map_Entry* vtable_map_get(Vtable_Map* map, Partial_Reveal_VTable* vt)
+{
+  Vtable_Map_Entry* entry = vtable_map_find_slot(map->entries, map->capacity, vt);
+  if(entry->vt != NULL) return entry;
+
+  /* keep the table at most half full */
+  if((map->num_entries + 1) * 2 > map->capacity){
+    vtable_map_grow(map);
+    entry = vtable_map_find_slot(map->entries, map->capacity, vt);
+  }
+  entry->vt = vt;
+  map->num_entries++;
+  return entry;
+}
+
+#endif /* _VTABLE_MAP_H_ */
@@ -54,6 +54,12 @@ enum EM_PCTYPE {
     
 };
 
+/**
+ * The value of entry-backedge profile OSR offsets when no
+ * on-stack replacement was requested or compiled.
+ */
+#define EM_NO_OSR_PC ((U_32)-1)
+
 /** 
  * A EM interface used to access to profile collectors.
  */
@@ -168,6 +174,36 @@ typedef struct EM_ProfileAccessInterface {
  */
     U_32 (*eb_profiler_get_backedge_threshold)(PC_Handle pch);
 
+/**
+ * Request the address of the OSR bytecode offset.
+ * JIT generating entry-backedge profile stores there the offset of
+ * the loop header it wants to leave through on-stack replacement
+ * right before calling <code>eb_profiler_osr_callback</code>.
+ * The offset is <code>EM_NO_OSR_PC</code> until then.
+ */
+    void* (*eb_profiler_get_osr_pc_addr)(Method_Profile_Handle mph);
+
+/**
+ * Request the address of the OSR entry offset.
+ * JIT using entry-backedge profile that compiles the method with an
+ * on-stack replacement entry stores there the bytecode offset this
+ * entry continues the execution from.
+ */
+    void* (*eb_profiler_get_osr_entry_pc_addr)(Method_Profile_Handle mph);
+
+/**
+ * JIT generating entry-backedge profile calls this method from managed
+ * code when the backedge counter limit is reached in a loop header.
+ * The method is compiled by the next JIT in the chain synchronously.
+ *
+ * @return The entry point of the new code if it has an on-stack
+ *         replacement entry for the requested offset, <code>NULL</code>
+ *         otherwise.
+ *
+ * @sa eb_profiler_get_osr_pc_addr()
+ */
+    void* (*eb_profiler_osr_callback)(Method_Profile_Handle mph);
+
 
 
     //EDGE profiler interface
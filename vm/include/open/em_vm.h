@@ -43,6 +43,8 @@ extern "C" {
 #   define OPEN_EM_VM_PROFILER_NEEDS_THREAD_SUPPORT "open.property.em.vm.profiler_needs_thread_support"
 /// The runtime property name to request EM profiler thread timeout.
 #   define OPEN_EM_VM_PROFILER_THREAD_TIMEOUT "open.property.em.vm.profiler_thread_timeout"
+/// The runtime property name to request the number of EM background compilation threads.
+#   define OPEN_EM_VM_COMPILATION_THREADS "open.property.em.vm.compilation_threads"
 
   /** 
    * The structure comprises all EM to VM interface methods.
@@ -130,6 +132,21 @@ extern "C" {
 
         void (*ClassloaderUnloadingCallback) (Class_Loader_Handle class_handle);
 
+  /**
+   * The method is run by each of the background compilation threads
+   * supported by VM, the number of threads is given by the
+   * <code>OPEN_EM_VM_COMPILATION_THREADS</code> property.
+   * It compiles the queued methods and returns only after
+   * <code>CompilationThreadsShutdown</code> is called.
+   */
+        void (*CompilationThreadRun) ();
+
+  /**
+   * Stops the background compilation threads, the queued methods
+   * are not compiled.
+   */
+        void (*CompilationThreadsShutdown) ();
+
     };
     typedef const struct _OpenEmVm* OpenEmVmHandle;
 
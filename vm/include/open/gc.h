@@ -662,8 +662,14 @@ VMEXPORT extern unsigned int (*gc_time_since_last_gc)();
 extern void (*gc_write_barrier)(Managed_Object_Handle p_base_of_obj_with_slot);
 VMEXPORT extern void * (*gc_heap_base_address)();
 VMEXPORT extern void * (*gc_heap_ceiling_address)();
+VMEXPORT extern void * (*gc_heap_compressed_base_address)();
+VMEXPORT extern U_32 (*gc_heap_compressed_shift)();
 
 extern Boolean (*gc_supports_class_unloading)();
+extern Boolean (*gc_enumerate_thread_stacks_in_parallel)(unsigned int num_threads);
+extern Boolean (*gc_dump_heap)(const char* file_name);
+extern Boolean (*gc_print_class_histogram)(const char* file_name);
+extern void (*gc_notify_data_dump_request)();
 
 #else // USE_GC_STATIC
 
@@ -798,6 +804,42 @@ GCExport Boolean gc_clear_mutator_block_flag();
 
 GCExport Boolean gc_supports_class_unloading();
 
+/**
+ * The VM calls this function during root set enumeration to let the GC
+ * threads enumerate the stacks of <code>num_threads</code> stopped threads.
+ * Each GC thread calls <code>vm_enumerate_thread_stacks()</code> and adds
+ * the reported roots to a root set of its own.
+ *
+ * @return <code>FALSE</code> if the stacks were not enumerated, the VM
+ *         enumerates them sequentially then.
+ */
+GCExport Boolean gc_enumerate_thread_stacks_in_parallel(unsigned int num_threads);
+
+/**
+ * Writes the live objects of the heap to <code>file_name</code> in the HPROF
+ * binary format. The GC chooses the file name if <code>file_name</code> is
+ * <code>NULL</code>. Must be called from a thread attached to the VM.
+ *
+ * @return <code>FALSE</code> if the heap was not dumped.
+ */
+GCExport Boolean gc_dump_heap(const char* file_name);
+
+/**
+ * Prints the number of live objects and their bytes for every class, by
+ * decreasing bytes, to <code>file_name</code>, or to the standard output if
+ * it's <code>NULL</code>. Must be called from a thread attached to the VM.
+ *
+ * @return <code>FALSE</code> if the histogram was not printed.
+ */
+GCExport Boolean gc_print_class_histogram(const char* file_name);
+
+/**
+ * The VM calls this function when the user asks for a data dump, e.g., with
+ * Ctrl+Break, from a thread attached to the VM. The GC dumps what it was
+ * configured to dump.
+ */
+GCExport void gc_notify_data_dump_request();
+
 // XXX move this elsewhere -salikh
 #ifdef JNIEXPORT
 
@@ -878,6 +920,21 @@ GCExport void *gc_heap_base_address();
  */
 GCExport void *gc_heap_ceiling_address();
 
+/**
+ * @return The address a compressed reference is relative to.
+ *
+ * A compressed reference <code>ref</code> points to
+ * <code>base + (ref << shift)</code>. The base is zero if the heap
+ * is reserved low enough, otherwise it's usually the heap base address.
+ */
+GCExport void *gc_heap_compressed_base_address();
+
+/**
+ * @return The shift applied to compressed references, zero unless the
+ *         heap is larger than 4GB.
+ */
+GCExport U_32 gc_heap_compressed_shift();
+
 #endif // USE_GC_STATIC
 
 
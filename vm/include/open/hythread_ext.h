@@ -392,8 +392,22 @@ typedef struct hythread_start_proc_data {
 
 typedef struct tm_props {
     int use_soft_unreservation;
+    int adaptive_spin;      // spin on contended thin locks before yielding
+    int spin_limit;         // upper bound of the learned spin limits, in pauses
 } tm_props;
 
+/**
+ * Thin monitor contention counters. They are updated without
+ * synchronization, so they are approximate.
+ */
+typedef struct hythread_thin_monitor_stats_t {
+    U_64 spins;             // contended enters which spun
+    U_64 spin_acquires;     // ... and acquired the lock while spinning
+    U_64 spin_pauses;       // pause instructions executed while spinning
+    U_64 yields;            // yields waiting for a thin lock to be released
+    U_64 inflations;        // thin locks inflated to fat monitors
+} hythread_thin_monitor_stats_t;
+
 extern VMIMPORT tm_props *tm_properties;
 
 //@}
@@ -537,6 +551,9 @@ IDATA hysem_set(hysem_t sem, IDATA count);
 IDATA VMCALL hythread_thin_monitor_create(hythread_thin_monitor_t *lockword);
 IDATA VMCALL hythread_thin_monitor_enter(hythread_thin_monitor_t *lockword);
 IDATA VMCALL hythread_thin_monitor_try_enter(hythread_thin_monitor_t *lockword);
+IDATA VMCALL hythread_thin_monitor_spin_enter(hythread_thin_monitor_t *lockword);
+void VMCALL hythread_thin_monitor_yield();
+void VMCALL hythread_thin_monitor_get_stats(hythread_thin_monitor_stats_t *stats);
 IDATA VMCALL hythread_thin_monitor_exit(hythread_thin_monitor_t *lockword);
 IDATA VMCALL hythread_thin_monitor_release(hythread_thin_monitor_t *lockword);
 IDATA VMCALL hythread_thin_monitor_wait(hythread_thin_monitor_t *lockword);
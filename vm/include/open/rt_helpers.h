@@ -243,6 +243,17 @@ enum VM_RT_SUPPORT {
  *
  * @return Interface vtable with method entries for the implementation
  *         of that interface by the actual class of the object.
+ */
+    VM_RT_GET_INTERFACE_VTABLE_IC=405,
+/**
+ * @param The parameters are the following:
+ *        \arg Object reference
+ *        \arg Inline cache of the call site created by
+ *             <code>vm_create_interface_call_cache</code>
+ *
+ * @return The same as <code>VM_RT_GET_INTERFACE_VTABLE_VER0</code> for
+ *         the interface of the cache. The receiver types seen by the call
+ *         site are remembered in the cache.
  */
 
  /////
@@ -245,6 +245,18 @@ DECLARE_OPEN(void *, vm_get_heap_base_address, ());
  */
 DECLARE_OPEN(void *, vm_get_heap_ceiling_address, ());
 
+/**
+ * @return The base of compressed references: a compressed reference
+ *         <code>ref</code> points to <code>base + (ref << shift)</code>.
+ *         It may be zero, and it's the managed null in compressed mode.
+ */
+DECLARE_OPEN(void *, vm_get_heap_compressed_base_address, ());
+
+/**
+ * @return The shift of compressed references.
+ */
+DECLARE_OPEN(U_32, vm_get_heap_compressed_shift, ());
+
 /**
  * @return <code>TRUE</code> if vtable pointers within objects are to be treated
  *         as offsets rather than raw pointers.
@@ -218,6 +218,20 @@ DECLARE_OPEN(void, vm_patch_code_block, (U_8* code_block, U_8* new_code, size_t
  */
 DECLARE_OPEN(JIT_Result, vm_compile_method, (JIT_Handle jit, Method_Handle method));
 
+/**
+ * Called by a JIT to create an inline cache for an <code>invokeinterface</code>
+ * call site of <code>intfc</code> methods in the code of <code>caller</code>.
+ * The cache is passed to the <code>VM_RT_GET_INTERFACE_VTABLE_IC</code> helper.
+ *
+ * The cache starts with the monomorphic entry: a pointer-sized vtable word,
+ * as it is stored in the object header, followed by the interface vtable for
+ * it. The JIT may compare the vtable word of the receiver with the first word
+ * of the cache and take the second word without calling the helper if they match.
+ *
+ * @return The cache or <code>NULL</code> if inline caches are disabled.
+ */
+DECLARE_OPEN(void *, vm_create_interface_call_cache, (Method_Handle caller, Class_Handle intfc));
+
 
 /**
 * Adds information about inlined method.
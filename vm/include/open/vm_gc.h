@@ -78,6 +78,16 @@ VMEXPORT void vm_gc_unlock_enum();
  */
 VMEXPORT void vm_enumerate_root_set_all_threads();
 
+/**
+ * Enumerates the stacks of the threads stopped by
+ * vm_enumerate_root_set_all_threads() which are not claimed yet by
+ * another caller.
+ *
+ * The function may be called concurrently by the GC threads, but only
+ * from within <code>gc_enumerate_thread_stacks_in_parallel()</code>.
+ */
+VMEXPORT void vm_enumerate_thread_stacks();
+
 
 /**
  * GC calls this function to restart managed threads after root set 
@@ -193,6 +203,18 @@ VMEXPORT void vm_enqueue_reference(Managed_Object_Handle p_obj);
 
 VMEXPORT void set_native_ref_enqueue_thread_flag(Boolean flag);
 
+/**
+ * GC calls this function for an allocation picked by the allocation
+ * sampler, after the object has got its vtable. The sample stands for
+ * the <code>sampled_bytes</code> the thread has allocated since its
+ * previous sample. The function is called in the allocating thread.
+ *
+ * @param p_obj         - the sampled object
+ * @param size          - the size of the object
+ * @param sampled_bytes - the bytes allocated since the previous sample
+ */
+VMEXPORT void vm_sample_allocation(Managed_Object_Handle p_obj, unsigned size, size_t sampled_bytes);
+
 /*
  * Returns handle of a class for a specified vtable
  *
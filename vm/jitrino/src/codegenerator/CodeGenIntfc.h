@@ -160,7 +160,10 @@ public:
         FillArrayWithConst,
         SaveThisState,
         ReadThisState,
+        ReadOsrBuffer,
         LockedCompareAndExchange,
+        VolatileLoad,
+        VolatileStore,
         AddValueProfileValue,
         ArrayCopyDirect,
         ArrayCopyReverse,
@@ -332,7 +332,8 @@ static bool isHeapBase(Opnd* immOpnd) {
     return false;
 #else 
     int64 heapBase = (int64)VMInterface::getHeapBase();
-    return immOpnd->getImmValue() == heapBase;
+    // zero-based compressed references are decoded without adding the base
+    return heapBase != 0 && immOpnd->getImmValue() == heapBase;
 #endif
 }
 
@@ -1457,6 +1457,59 @@ InstCodeSelector::heapBaseOpnd(Type* type, POINTER_SIZE_INT heapBase) {
     }
     return heapBaseOpnd;
 }
+
+//_______________________________________________________________________________________________________________
+//  Uncompress a zero-extended compressed reference: base + (ref << shift).
+//  Base is omitted for zero-based references, shift for heaps up to 4GB.
+
+Opnd*
+InstCodeSelector::decompressOpnd(Type* dstType, Opnd* src) {
+    POINTER_SIZE_INT heapBase = (POINTER_SIZE_INT)VMInterface::getHeapBase();
+    U_32 heapShift = VMInterface::getHeapShift();
+    Opnd* offset = src;
+    if (heapShift != 0) {
+        offset = irManager.newOpnd(typeManager.getInt64Type());
+        appendInsts(irManager.newInstEx(Mnemonic_SHL, 1, offset, src,
+                                        irManager.newImmOpnd(typeManager.getInt32Type(), heapShift)));
+    }
+    if (heapBase != 0) {
+        Type* unmanagedPtrType = typeManager.getUnmanagedPtrType(typeManager.getInt8Type());
+        return simpleOp_I8(Mnemonic_ADD, dstType, offset, heapBaseOpnd(unmanagedPtrType, heapBase));
+    }
+    Opnd* dst = irManager.newOpnd(dstType);
+    copyOpndTrivialOrTruncatingConversion(dst, offset);
+    return dst;
+}
+
+//_______________________________________________________________________________________________________________
+//  Compress a reference: (ref - base) >> shift, truncated to the compressed type.
+
+Opnd*
+InstCodeSelector::compressOpnd(Type* dstType, Opnd* src) {
+    POINTER_SIZE_INT heapBase = (POINTER_SIZE_INT)VMInterface::getHeapBase();
+    U_32 heapShift = VMInterface::getHeapShift();
+    Type* unmanagedPtrType = typeManager.getUnmanagedPtrType(typeManager.getInt8Type());
+    Opnd* dst = irManager.newOpnd(dstType);
+    if (heapShift == 0) {
+        if (heapBase != 0) {
+            appendInsts(irManager.newInstEx(Mnemonic_SUB, 1, dst, src, heapBaseOpnd(unmanagedPtrType, heapBase)));
+        } else {
+            copyOpndTrivialOrTruncatingConversion(dst, src);
+        }
+        return dst;
+    }
+    Opnd* offset = src;
+    if (heapBase != 0) {
+        offset = irManager.newOpnd(typeManager.getInt64Type());
+        appendInsts(irManager.newInstEx(Mnemonic_SUB, 1, offset, src, heapBaseOpnd(unmanagedPtrType, heapBase)));
+    }
+    Opnd* shifted = irManager.newOpnd(typeManager.getInt64Type());
+    appendInsts(irManager.newInstEx(Mnemonic_SHR, 1, shifted, offset,
+                                    irManager.newImmOpnd(typeManager.getInt32Type(), heapShift)));
+    copyOpndTrivialOrTruncatingConversion(dst, shifted);
+    return dst;
+}
+
 //_______________________________________________________________________________________________________________
 //  Branch if src is zero
 
@@ -2123,10 +2176,7 @@ CG_OpndHandle* InstCodeSelector::simpleLdInd(Type * dstType, Opnd * addr,
         // loading compressed 32-bit managed address, ensure zero-extention
         copyOpnd(dst, opnd, true);
         // uncompress
-        Type* unmanagedPtrType = typeManager.getUnmanagedPtrType(typeManager.getInt8Type());
-        Opnd* heapBase = heapBaseOpnd(unmanagedPtrType, (POINTER_SIZE_INT)VMInterface::getHeapBase());
-        dst = simpleOp_I8(Mnemonic_ADD, dstType, dst, heapBase);
-        return dst;
+        return decompressOpnd(dstType, dst);
     } 
     else 
 #endif
@@ -2153,11 +2203,8 @@ void InstCodeSelector::simpleStInd(Opnd * addr,
     // Actually, there is only one possible case caused by magics:
     // unmanaged pointer to Int8
     if(irManager.refsAreCompressed() && memType > Type::Float && !src->getType()->isUnmanagedPtr()) {
-        Type * unmanagedPtrType = typeManager.getUnmanagedPtrType(typeManager.getInt8Type());
-        Opnd * heap_base = heapBaseOpnd(unmanagedPtrType, (POINTER_SIZE_INT)VMInterface::getHeapBase());
-        Opnd * compressed_src = irManager.newOpnd(typeManager.compressType(src->getType()));
+        Opnd * compressed_src = compressOpnd(typeManager.compressType(src->getType()), src);
         Opnd * opnd = irManager.newMemOpndAutoKind(typeManager.compressType(src->getType()), addr);
-        appendInsts(irManager.newInstEx(Mnemonic_SUB, 1, compressed_src, src, heap_base));
         appendInsts(irManager.newCopyPseudoInst(Mnemonic_MOV, opnd, compressed_src));
     } else
 #endif
@@ -2438,7 +2485,7 @@ CG_OpndHandle* InstCodeSelector::ldRef(Type *dstType,
             
             Opnd* memOpnd = irManager.newMemOpnd(typeManager.getSystemStringType(), MemOpndKind_Heap,
                                                  ptr, NULL, NULL, NULL); 
-            retOpnd = simpleOp_I8(Mnemonic_ADD, memOpnd->getType(), memOpnd, base);
+            retOpnd = decompressOpnd(memOpnd->getType(), memOpnd);
         } else {
 #ifdef _EM64T_ // in uncompressed mode the ptr can be greater than MAX_INT32 so it can not be an immediate
             Opnd * tmp = irManager.newImmOpnd(irManager.getTypeFromTag(Type::UInt64),
@@ -2605,13 +2652,27 @@ CG_OpndHandle*  InstCodeSelector::tau_ldIntfTableAddr(Type *         dstType,
                                                      CG_OpndHandle* base, 
                                                      NamedType*     vtableType)
 {
+    Opnd * retOpnd=irManager.newOpnd(dstType);
+
+    // the helper checks the monomorphic entry of the call site cache first
+    void * ic = compilationInterface.createInterfaceCallCache(vtableType);
+    if (ic != NULL) {
+        Opnd * helperOpnds[] = {
+            (Opnd*)base,
+            irManager.newImmOpnd(getRuntimeIdType(), (POINTER_SIZE_INT)ic)
+        };
+        CallInst * callInst=irManager.newRuntimeHelperCallInst(
+            VM_RT_GET_INTERFACE_VTABLE_IC,
+            2, helperOpnds, retOpnd);
+        appendInsts(callInst);
+        return retOpnd;
+    }
+
     Opnd * helperOpnds[] = {
         (Opnd*)base,
         irManager.newImmOpnd(getRuntimeIdType(), Opnd::RuntimeInfo::Kind_TypeRuntimeId, vtableType)
     };
 
-    Opnd * retOpnd=irManager.newOpnd(dstType);
-
     CallInst * callInst=irManager.newRuntimeHelperCallInst(
         VM_RT_GET_INTERFACE_VTABLE_VER0,
         2, helperOpnds, retOpnd);
@@ -2806,6 +2867,20 @@ CG_OpndHandle* InstCodeSelector::callhelper(U_32              numArgs,
         appendInsts(ii);
         break;
     }
+    case ReadOsrBuffer:
+    {
+        assert(numArgs == 0);
+        Type* int32type = typeManager.getInt32Type();
+        Type* unmanPtr = typeManager.getUnmanagedPtrType(int32type);
+
+        Opnd * tlsBase = createTlsBaseLoadSequence(irManager, currentBasicBlock, unmanPtr);
+        U_32 offsetInTLS = VMInterface::osrBufferTLSOffset();
+        Opnd* pBuffer = irManager.newMemOpnd(dstOpnd->getType(), MemOpndKind_Any, tlsBase, offsetInTLS);
+        appendInsts(irManager.newCopyPseudoInst(Mnemonic_MOV, dstOpnd, pBuffer));
+        // the buffer is taken once, recursive calls must not see it
+        appendInsts(irManager.newCopyPseudoInst(Mnemonic_MOV, pBuffer, irManager.newImmOpnd(dstOpnd->getType(), 0)));
+        break;
+    }
     case LockedCompareAndExchange:
     {
         assert(numArgs == 3);
@@ -2839,6 +2914,27 @@ CG_OpndHandle* InstCodeSelector::callhelper(U_32              numArgs,
         appendInsts(irManager.newInst(Mnemonic_SETZ, dstOpnd));
         break;
     }
+    case VolatileLoad:
+    {
+        assert(numArgs == 1);
+        Opnd** opnds = (Opnd**)args;
+        // loads are not reordered with other loads on IA-32, a plain move is enough
+        Opnd* memOpnd = irManager.newMemOpnd(dstOpnd->getType(), opnds[0]);
+        appendInsts(irManager.newCopyPseudoInst(Mnemonic_MOV, dstOpnd, memOpnd));
+        break;
+    }
+    case VolatileStore:
+    {
+        assert(numArgs == 2);
+        Opnd** opnds = (Opnd**)args;
+        // xchg with a memory operand is implicitly locked and so is a full fence
+        Type* valueType = opnds[1]->getType();
+        Opnd* memOpnd = irManager.newMemOpnd(valueType, opnds[0]);
+        Opnd* valueOpnd = irManager.newOpnd(valueType, Constraint(OpndKind_GPReg));
+        appendInsts(irManager.newCopyPseudoInst(Mnemonic_MOV, valueOpnd, opnds[1]));
+        appendInsts(irManager.newInst(Mnemonic_XCHG, memOpnd, valueOpnd));
+        break;
+    }
     case AddValueProfileValue:
     {
         assert(numArgs == 2);
@@ -2943,6 +3039,7 @@ CG_OpndHandle* InstCodeSelector::callvmhelper(U_32              numArgs,
     case VM_RT_MONITOR_EXIT:
     case VM_RT_GC_HEAP_WRITE_REF:
     case VM_RT_GET_INTERFACE_VTABLE_VER0:
+    case VM_RT_GET_INTERFACE_VTABLE_IC:
     case VM_RT_CHECKCAST:
     case VM_RT_INSTANCEOF:
     
@@ -376,8 +376,8 @@ private:
                                       Opnd *srcBaseTau, Opnd *srcOffsetTau);
     void                copyContext(Opnd * dst, Opnd * src);
     void                copyBase(Opnd * dst, Opnd * src);
-    void                decompressOpnd(Opnd *dst, Opnd *src);
-    void                compressOpnd(Opnd *dst, Opnd *src);
+    Opnd*               decompressOpnd(Type *dstType, Opnd *src);
+    Opnd*               compressOpnd(Type *dstType, Opnd *src);
     void                makeComparable(Opnd*& srcOpnd1, Opnd*& srcOpnd2);
     CG_OpndHandle*      simpleLdInd(Type * dstType, Opnd *addr, Type::Tag memType,
                                     Opnd *baseTau, Opnd *offsetTau);
@@ -1179,7 +1179,7 @@ protected:
     unsigned    m_methentry_threshold;
     /**
      * @brief Threshold for back edges counter which fires recompilation 
-     *        (in synchronized recompilation mode).
+     *        (in synchronized recompilation mode) and on-stack replacement.
      */
     unsigned    m_backedge_threshold;
     /**
@@ -1191,6 +1191,29 @@ protected:
      * @brief Recompilation handler (in synchronized recompilation mode).
      */
     void *      m_recomp_handler_ptr;
+    /**
+     * @brief On-stack replacement handler, returns entry point of the 
+     *        recompiled code or NULL.
+     * @see JMF_PROF_OSR
+     */
+    void *      m_osr_handler_ptr;
+    /**
+     * @brief Pointer to the PC of loop header the OSR is requested for.
+     * @see JMF_PROF_OSR
+     */
+    unsigned *  m_p_osr_pc;
+    /**
+     * @brief Pointer to the PC of loop header the recompiled code has 
+     *        OSR entry for.
+     * @see JMF_PROF_OSR
+     */
+    unsigned *  m_p_osr_entry_pc;
+    /**
+     * @brief Offset of the thread local slot the recompiled code takes 
+     *        the local variables from.
+     * @see JMF_PROF_OSR
+     */
+    unsigned    m_osr_buffer_tls_offset;
     
     /**
      * @brief The byte code of the method being compiled.
@@ -83,9 +83,14 @@ void CodeGen::gen_arr_load(jtype jt)
                           elem.index(), elem.scale());
         mov(Opnd(i32, gr_ref), where32);
         //sx(Opnd(jobj, gr_ref), where32);
-        movp(gr_base, OBJ_BASE);
         Opnd obj(jobj, gr_ref);
-        alu(alu_add, obj, Opnd(jobj, gr_base));
+        if (OBJ_SHIFT != 0) {
+            alu(alu_shl, obj, Opnd((int)OBJ_SHIFT));
+        }
+        if (OBJ_BASE != NULL) {
+            movp(gr_base, OBJ_BASE);
+            alu(alu_add, obj, Opnd(jobj, gr_base));
+        }
         //
         runlock(gr_ref);
         runlock(gr_base);
@@ -315,9 +320,14 @@ void CodeGen::do_field_op(const FieldOpInfo& fieldOp)
                 Opnd where32(i32, where.base(), where.disp(), 
                               where.index(), where.scale());
                 mov(Opnd(i32, gr_ref), where32);
-                movp(gr_base, OBJ_BASE);
                 Opnd obj(jobj, gr_ref);
-                alu(alu_add, obj, Opnd(jobj, gr_base));
+                if (OBJ_SHIFT != 0) {
+                    alu(alu_shl, obj, Opnd((int)OBJ_SHIFT));
+                }
+                if (OBJ_BASE != NULL) {
+                    movp(gr_base, OBJ_BASE);
+                    alu(alu_add, obj, Opnd(jobj, gr_base));
+                }
                 //
                 runlock(gr_ref);
                 runlock(gr_base);
@@ -364,7 +374,7 @@ void CodeGen::do_field_op(const FieldOpInfo& fieldOp)
 
     if (!is_ia32() && g_refs_squeeze && jt == jobj && vis_imm(0)) {
         const Val& s = m_jframe->dip(0);
-        unsigned ref = (unsigned)(int_ptr)((const char*)s.pval() - OBJ_BASE);
+        unsigned ref = (unsigned)((int_ptr)((const char*)s.pval() - OBJ_BASE) >> OBJ_SHIFT);
         Opnd where32(i32, where.base(), where.disp(), 
                           where.index(), where.scale());
         mov(where32, Opnd(ref));
@@ -382,6 +392,9 @@ void CodeGen::do_field_op(const FieldOpInfo& fieldOp)
             void * inv_base = (void*)-(int_ptr)OBJ_BASE;
             movp(tmp, inv_base);
             alu(alu_add, Opnd(jobj, tmp), s0.as_opnd());
+            if (OBJ_SHIFT != 0) {
+                alu(alu_shr, Opnd(jobj, tmp), Opnd((int)OBJ_SHIFT));
+            }
             // store the resulting I_32
             Opnd where32(i32, where.base(), where.disp(), 
                           where.index(), where.scale());
@@ -761,6 +761,133 @@ void Compiler::gen_return(const CallSig& cs)
     }
 }
 
+void Compiler::gen_osr_check(void)
+{
+    if (!is_set(JMF_PROF_OSR) || m_jframe->size() != 0) {
+        return;
+    }
+    // An exception escaped from the recompiled code would be caught here 
+    // once again.
+    for (unsigned i=0; i<m_handlers.size(); i++) {
+        const HandlerInfo& hi = m_handlers[i];
+        if (hi.start <= m_pc && m_pc < hi.end) {
+            return;
+        }
+    }
+    if (is_set(DBG_TRACE_CG)) { dbg(";;>osr.check\n"); }
+    
+    // The back branch that leads here has just reached the threshold:
+    // cmp [counter], threshold
+    // jne keep_going
+    AR ar = valloc(jobj);
+    movp(ar, m_p_backedge_counter);
+    alu(alu_cmp, Opnd(i32, ar, 0), Opnd((int)m_backedge_threshold));
+    unsigned br_off = br(ne, 0, 0, taken);
+    
+    BBState saveBB;
+    push_all_state(&saveBB);
+    
+    // Ask EM to recompile the method with OSR entry for this loop header
+    ar = valloc(jobj);
+    movp(ar, m_p_osr_pc);
+    mov(Opnd(i32, ar, 0), Opnd((int)m_pc));
+    SYNC_FIRST(static const CallSig cs_osr(CCONV_HELPERS, jobj, jobj));
+    gen_call_vm(cs_osr, m_osr_handler_ptr, 0, m_profile_handle);
+    AR gr_entry = cs_osr.ret_reg(0);
+    alu(alu_test, Opnd(jobj, gr_entry), Opnd(jobj, gr_entry));
+    unsigned br_null = br(z, 0, 0);
+    st(jobj, gr_entry, m_base, voff(m_stack.scratch()));
+    // Another thread might have requested another loop header meanwhile
+    ar = valloc(jobj);
+    movp(ar, m_p_osr_entry_pc);
+    alu(alu_cmp, Opnd(i32, ar, 0), Opnd((int)m_pc));
+    unsigned br_other = br(ne, 0, 0);
+    
+    // The locals area of the frame becomes the buffer for the recompiled
+    // code: local #i is at the i-th slot. Put there the locals which live
+    // on callee-save registers (scratch ones were parked by the call 
+    // above) or on input args.
+    const unsigned vars = m_infoBlock.get_num_locals();
+    for (unsigned i=0; i<vars; i++) {
+        const Val& v = m_jframe->var(i);
+        int slot = voff(m_stack.local(i));
+        if (v.is_reg()) {
+            do_mov(Val(jtmov(v.jt()), m_base, slot), v);
+            if (is_wide(v.jt())) {
+                ++i;
+            }
+        }
+        else if (vis_arg(i)) {
+            jtype jt = m_ci.jt(vget_arg(i));
+            unsigned words = is_wide(jt) ? 8/STACK_SLOT_SIZE : 1;
+            AR gtmp = valloc(jobj);
+            for (unsigned k=0; k<words; k++) {
+                unsigned disp = k*STACK_SLOT_SIZE;
+                mov(Opnd(iplatf, gtmp), Opnd(iplatf, m_base, vlocal_off(i)+disp));
+                mov(Opnd(iplatf, m_base, slot+disp), Opnd(iplatf, gtmp));
+            }
+            if (is_wide(jt)) {
+                ++i;
+            }
+        }
+    }
+    gen_call_vm(platform_v, rt_helper_get_tls_base_ptr, 0);
+    AR gr_tls = platform_v.ret_reg(0);
+    rlock(gr_tls);
+    AR gr_buf = valloc(jobj);
+    lea(Opnd(jobj, gr_buf), Opnd(jobj, m_base, voff(m_stack.local(0))));
+    mov(Opnd(jobj, gr_tls, m_osr_buffer_tls_offset), Opnd(jobj, gr_buf));
+    runlock(gr_tls);
+    
+    // Call the recompiled code. It takes everything from the buffer, so 
+    // the args are only to keep the calling convention.
+    rlock(m_ci);
+    AR gr = valloc(jobj);
+    rlock(gr);
+    ld(jobj, gr, m_base, voff(m_stack.scratch()));
+    if (m_ci.size() != 0) {
+        alu(alu_sub, sp, m_ci.size());
+    }
+    for (unsigned i=0; i<m_ci.count(); i++) {
+        jtype jt = m_ci.jt(i);
+        AR arg = m_ci.reg(i);
+        if (arg != ar_x) {
+            if (is_f(jt)) {
+                do_mov(Val(jt, arg), jt == flt32 ? Val((float)0) : Val((double)0));
+            }
+            else {
+                mov(Opnd(iplatf, arg), Opnd(iplatf, (int_ptr)0));
+            }
+            continue;
+        }
+        unsigned words = is_wide(jt) ? 8/STACK_SLOT_SIZE : 1;
+        for (unsigned k=0; k<words; k++) {
+            mov(Opnd(iplatf, sp, m_ci.off(i)+k*STACK_SLOT_SIZE), Opnd(iplatf, (int_ptr)0));
+        }
+    }
+    call(Opnd(jobj, gr), m_ci, is_set(DBG_CHECK_STACK));
+    runlock(gr);
+    runlock(m_ci);
+    
+    // ... and return whatever it returned
+    jtype retType = m_ci.ret_jt();
+    if (retType != jvoid) {
+        gen_save_ret(m_ci);
+        if (retType < i32) {
+            retType = i32;
+        }
+    }
+    CallSig cs_ret(CCONV_MANAGED, retType);
+    gen_return(cs_ret);
+    
+    // keep_going:
+    patch(br_null, ip());
+    patch(br_other, ip());
+    pop_all_state(&saveBB);
+    patch(br_off, ip());
+    if (is_set(DBG_TRACE_CG)) { dbg(";;>~osr.check\n"); }
+}
+
 void CodeGen::gen_invoke(JavaByteCodes opcod, Method_Handle meth, unsigned short cpIndex,
                          const ::std::vector<jtype> &args, jtype retType)
 {
@@ -866,22 +993,65 @@ void CodeGen::gen_invoke(JavaByteCodes opcod, Method_Handle meth, unsigned short
         rlock(thiz);
         gen_check_null(thiz, true);
 
+        AR gr_ret = cs_vtbl.ret_reg(0);
+        AR gr_thiz = thiz.reg();
+        AR gr_ic = ar_x;
+        unsigned br_hit = NOTHING;
+        void * ic = vm_create_interface_call_cache(m_method, klass);
+        if (ic != NULL) {
+            // Both outcomes of the inline cache check must leave the same
+            // state, so park everything before the check rather than in
+            // the helper call.
+            runlock(thiz);
+            vpark();
+            gen_gc_stack(-1, true);
+            gr_thiz = valloc(jobj);
+            rlock(gr_thiz);
+            mov(Opnd(jobj, gr_thiz), vstack(thiz_depth).as_opnd());
+            AR gr_vtbl = valloc(jobj);
+            rlock(gr_vtbl);
+            if (g_vtbl_squeeze) {
+                ld4(gr_vtbl, gr_thiz, rt_vtable_offset);
+            }
+            else {
+                ld(jobj, gr_vtbl, gr_thiz, rt_vtable_offset);
+            }
+            gr_ic = valloc(jobj);
+            rlock(gr_ic);
+            movp(gr_ic, ic);
+            // the monomorphic entry comes first: the vtable, then the 
+            // interface vtable
+            alu(alu_cmp, Opnd(iplatf, gr_vtbl), Opnd(iplatf, gr_ic, 0));
+            runlock(gr_vtbl);
+            unsigned br_miss = br(ne, 0, 0, hint_none);
+            ld(jobj, gr_ret, gr_ic, sizeof(void*));
+            br_hit = br(cond_none, 0, 0, hint_none);
+            patch(br_miss, ip());
+        }
+
         // Prepare args for ldInterface helper
         if (cs_vtbl.reg(0) == gr_x) {
             assert(cs_vtbl.size() != 0);
             alu(alu_sub, sp, cs_vtbl.size());
-            st(jobj, thiz.reg(), sp, cs_vtbl.off(0));
+            st(jobj, gr_thiz, sp, cs_vtbl.off(0));
         }
         else {
             if (cs_vtbl.size() != 0) {
                 assert(cs_vtbl.caller_pops());
                 alu(alu_sub, sp, cs_vtbl.size());                    
             }
-            mov(cs_vtbl.get(0), thiz.as_opnd());
+            mov(cs_vtbl.get(0), Opnd(jobj, gr_thiz));
+        }
+        if (ic != NULL) {
+            runlock(gr_thiz);
+            gen_call_vm(cs_vtbl, rt_helper_get_vtable_ic, 1, ic);
+            patch(br_hit, ip());
+            runlock(gr_ic);
+        }
+        else {
+            runlock(thiz);
+            gen_call_vm(cs_vtbl, rt_helper_get_vtable, 1, klass);
         }
-        runlock(thiz);
-        gen_call_vm(cs_vtbl, rt_helper_get_vtable, 1, klass);
-        AR gr_ret = cs_vtbl.ret_reg(0);
         runlock(cs_vtbl);
         //
         // Method's vtable is in gr_ret now, prepare stack
@@ -60,6 +60,7 @@ using std::stack;
     #include "Jitrino.h"
     #include "EMInterface.h"
     #include "JITInstanceContext.h"
+    #include "VMInterface.h"
 #endif
 /**
 * A lock used to protect method's data in multi-threaded compilation.
@@ -163,6 +164,9 @@ JIT_Result Compiler::compile(Compile_Handle ch, Method_Handle method,
     if (!get_bool_arg("bbp", true)) {
         compile_flags &= ~JMF_BBPOLLING;
     }
+    if (!get_bool_arg("osr", true)) {
+        compile_flags &= ~JMF_PROF_OSR;
+    }
 
     m_lazy_resolution  = get_bool_arg("lazyResolution", true);
 
@@ -370,6 +374,14 @@ JIT_Result Compiler::compile(Compile_Handle ch, Method_Handle method,
         compile_flags |= JMF_REPORT_THIS;
     }
 
+    // The recompiled code can't take over the monitor of a synchronized 
+    // method, nor the frame being watched by JVMTI.
+    if (meth_is_sync() || g_jvmtiMode || 
+        compilation_params.exe_notify_method_entry || 
+        compilation_params.exe_notify_method_exit) {
+        compile_flags &= ~JMF_PROF_OSR;
+    }
+
     m_infoBlock.init(bc_size, max_stack, num_locals, num_input_slots, 
                      compile_flags);
     m_infoBlock.set_compile_params(compilation_params);
@@ -693,6 +705,9 @@ void Compiler::comp_parse_bytecode(void)
             ++ji.ref_count;
             BBInfo& nbb = comp_create_bb(jinst.get_target(i));
             nbb.jsr_target = nbb.jsr_target || jinst.is_jsr();
+            if (!jinst.is_jsr() && jinst.get_target(i) <= jinst.pc) {
+                nbb.backedge_target = true;
+            }
         }
         if (jinst.is_switch()) {
             JInst& ji = m_insts[jinst.get_def_target()];
@@ -1096,6 +1111,9 @@ bool Compiler::comp_gen_insts(unsigned pc, unsigned parentPC,
         }
 #endif
         STATS_INC(Stats::opcodesSeen[m_insts[m_pc].opcode], 1);
+        if (m_pc == bbinfo.start && bbinfo.backedge_target) {
+            gen_osr_check();
+        }
         handle_inst();
 #ifdef _DEBUG
         vcheck();
@@ -1475,7 +1493,8 @@ void Compiler::initStatics(void)
 
     g_refs_squeeze = vm_is_heap_compressed();
     g_vtbl_squeeze = vm_is_vtable_compressed();
-    OBJ_BASE  = (const char*)vm_get_heap_base_address();
+    OBJ_BASE  = (const char*)vm_get_heap_compressed_base_address();
+    OBJ_SHIFT = vm_get_heap_compressed_shift();
     VTBL_BASE = (const char*)vm_get_vtable_base_address();
     NULL_REF  = g_refs_squeeze ? OBJ_BASE : NULL;
 
@@ -1495,6 +1514,8 @@ void Compiler::initStatics(void)
     
     rt_helper_get_vtable = 
               (char*)vm_helper_get_addr(VM_RT_GET_INTERFACE_VTABLE_VER0);
+    rt_helper_get_vtable_ic = 
+              (char*)vm_helper_get_addr(VM_RT_GET_INTERFACE_VTABLE_IC);
 
     rt_helper_throw = 
                 (char*)vm_helper_get_addr(VM_RT_THROW);
@@ -1616,6 +1637,14 @@ void Compiler::initProfilingData(unsigned * pflags)
             m_profile_handle = mp->getHandle();
             m_recomp_handler_ptr = (void*)pi->getEBProfilerSyncModeCallback();
         }
+        // EM refuses OSR if there is no JIT to recompile with
+        *pflags |= JMF_PROF_OSR;
+        m_backedge_threshold = pi->getBackedgeThreshold();
+        m_profile_handle = mp->getHandle();
+        m_osr_handler_ptr = (void*)pi->getEBProfilerOsrCallback();
+        m_p_osr_pc = mp->getOsrPcAddr();
+        m_p_osr_entry_pc = mp->getOsrEntryPcAddr();
+        m_osr_buffer_tls_offset = VMInterface::osrBufferTLSOffset();
         g_compileLock.unlock();
     }
 #endif
@@ -301,6 +301,17 @@ private:
      * @see gen_bb_leave
      */
     void gen_bb_enter(void);
+    /**
+     * @brief Generates on-stack replacement check at the loop header.
+     *
+     * When back branches counter reaches the threshold, the local 
+     * variables are put to the local variables area of the frame, and 
+     * the recompiled code is called to continue from the loop header.
+     * Its result is then returned as the result of this method.
+     * Does nothing if JMF_PROF_OSR not set, the operand stack is not empty
+     * or the loop header is covered by an exception handler.
+     */
+    void gen_osr_check(void);
     /**
      * @brief Generates code to leave current basic block.
      *
@@ -357,6 +368,13 @@ private:
      */
     bool gen_magic(void);
 
+    /**
+     * @brief Generates the Atomics method as inline code.
+     * @return  - true if the code was generated, false if the method must
+     *            be called.
+     */
+    bool gen_atomics_magic(const char* mname, const char* msig);
+
     
     //
     // Method being compiled info
@@ -1016,14 +1016,25 @@ public:
     }
 
     /**
-    * Generates CMPXCHG operation.
+    * Generates CMPXCHG operation on a value of the given type.
     */
-    void cmpxchg(bool lockPrefix, AR addrBaseReg, AR newReg, AR oldReg)
+    void cmpxchg(bool lockPrefix, AR addrBaseReg, AR newReg, AR oldReg, jtype jt = i32)
     {
         if (is_trace_on()) {
             trace(string("cmpxchg:")+ (lockPrefix ? "(locked) ":"") + to_str(addrBaseReg), to_str(newReg), to_str(oldReg));
         }
-        cmpxchg_impl(lockPrefix, addrBaseReg, newReg, oldReg);
+        cmpxchg_impl(lockPrefix, addrBaseReg, newReg, oldReg, jt);
+    }
+
+    /**
+    * Generates a full memory fence.
+    */
+    void fence(void)
+    {
+        if (is_trace_on()) {
+            trace("fence", "", "");
+        }
+        fence_impl();
     }
 
     /**
@@ -1478,7 +1489,9 @@ private:
     /// Implementation of cmovcc().
     void cmovcc_impl(COND c, const Opnd& op0, const Opnd& op1);
     /// Implementation of cmpxchg().
-    void cmpxchg_impl(bool lockPrefix, AR addrReg, AR newReg, AR oldReg);
+    void cmpxchg_impl(bool lockPrefix, AR addrReg, AR newReg, AR oldReg, jtype jt);
+    /// Implementation of fence().
+    void fence_impl(void);
     /// Implementation of volatile64 get and set ops().
     void volatile64_op_impl(Opnd& where, AR hi_part, AR lo_part, bool is_put);
     /// Implementation of lea().
@@ -698,36 +698,51 @@ static void xchg_regs(Encoder * enc, RegName reg1, RegName reg2) {
     enc->ip(EncoderBase::encode(enc->ip(), Mnemonic_XCHG, xargs));
 }
 
-void Encoder::cmpxchg_impl(bool lockPrefix, AR addrReg, AR newReg, AR oldReg) {
+void Encoder::cmpxchg_impl(bool lockPrefix, AR addrReg, AR newReg, AR oldReg, jtype jt) {
+    // the registers are exchanged as a whole, only cmpxchg itself
+    // works on the value size
     RegName dNewReg = devirt(newReg);
     RegName dOldReg = devirt(oldReg);
     RegName dAddrReg = devirt(addrReg);
-    bool eaxFix = dOldReg != RegName_EAX;
+    RegName dEAX = devirt(virt(RegName_EAX));
+    bool eaxFix = !equals(dOldReg, RegName_EAX);
     if (eaxFix) {
-        if (dAddrReg == RegName_EAX) {
+        if (equals(dAddrReg, RegName_EAX)) {
             dAddrReg = dOldReg;
-        } else if (dNewReg == RegName_EAX) {
+        } else if (equals(dNewReg, RegName_EAX)) {
             dNewReg = dOldReg;
         }
-        xchg_regs(this, dOldReg, RegName_EAX);
+        xchg_regs(this, dOldReg, dEAX);
     }
 
     if (lockPrefix) {
         ip(EncoderBase::prefix(ip(), InstPrefix_LOCK));
     }
 
+    OpndSize sz = to_size(jt);
     EncoderBase::Operands args;
-    args.add(EncoderBase::Operand(OpndSize_32, dAddrReg, 0)); //TODO: EM64t fix!
-    args.add(dNewReg);
-    args.add(RegName_EAX);
+    args.add(EncoderBase::Operand(sz, dAddrReg, 0));
+    args.add(getAliasReg(dNewReg, sz));
+    args.add(getAliasReg(dEAX, sz));
     ip(EncoderBase::encode(ip(), Mnemonic_CMPXCHG, args));
 
     if (eaxFix) {
-        xchg_regs(this, RegName_EAX, devirt(oldReg));
+        xchg_regs(this, dEAX, devirt(oldReg));
     }
 
 }
 
+void Encoder::fence_impl(void)
+{
+    // a locked read-modify-write orders all the memory accesses
+    // and is cheaper than mfence
+    ip(EncoderBase::prefix(ip(), InstPrefix_LOCK));
+    EncoderBase::Operands args;
+    args.add(EncoderBase::Operand(OpndSize_32, devirt(sp), 0));
+    args.add(EncoderBase::Operand(OpndSize_32, (long long)0));
+    ip(EncoderBase::encode(ip(), Mnemonic_OR, args));
+}
+
 static void mov_regs(Encoder* enc, RegName r_dst, RegName r_src) {
     EncoderBase::Operands args;
     args.add(r_dst);
@@ -276,6 +276,13 @@ inline bool to_bool(const char * val)
  */
 #define JMF_PROF_SYNC_CHECK (0x00000008)
 
+/**
+ * @brief Generate code to check back branches counter at loop headers and
+ *        to continue the execution in the recompiled code once the
+ *        threshold is reached (on-stack replacement).
+ */
+#define JMF_PROF_OSR        (0x00000010)
+
 #ifdef JET_PROTO
 #define JMF_ALIGN_STACK     (0x00010000)
 #define JMF_SP_FRAME        (0x00020000)
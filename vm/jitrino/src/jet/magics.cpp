@@ -80,6 +80,111 @@ static void vstack_replace_top_opnd(Compiler* c, jtype jt) {
     }
 }
 
+bool Compiler::gen_atomics_magic(const char* mname, const char* msig)
+{
+    // the type of the slot comes from the name, booleans are left to the natives
+    jtype jt;
+    if (strstr(mname, "Int") != NULL)           { jt = i32; }
+    else if (strstr(mname, "Long") != NULL)     { jt = i64; }
+    else if (strstr(mname, "Object") != NULL)   { jt = jobj; }
+    else {
+        return false;
+    }
+    // no single instruction to access a long on IA-32
+    if (is_big(jt)) {
+        return false;
+    }
+    // the natives update references through the GC
+    if (jt == jobj && (g_refs_squeeze || compilation_params.exe_insert_write_barriers || 
+                       get_bool_arg("wb4j", false) || get_bool_arg("wb4c", false))) {
+        return false;
+    }
+
+    bool is_cas = !strncmp(mname, "compareAndSet", 13);
+    bool is_get = !strncmp(mname, "get", 3);
+    bool is_put = !strncmp(mname, "set", 3);
+    if (!is_cas && !is_get && !is_put) {
+        return false;
+    }
+    // the slot is either (Object, long offset) or (array, int index)
+    bool is_array = msig[1] == '[';
+    unsigned val_slots = is_wide(jt) ? 2 : 1;
+    unsigned num_vals = is_cas ? 2 : (is_put ? 1 : 0);
+    unsigned off_depth = num_vals * val_slots;
+    unsigned ref_depth = off_depth + (is_array ? 1 : 2);
+
+    // stack: [.., ref, offset, (expected), (value)]
+    Val& ref = vstack(ref_depth, true);
+    rlock(ref);
+    Val& off = vstack(off_depth, true);
+    rlock(off);
+    gen_check_null(ref_depth);
+    if (is_array) {
+        gen_check_bounds(ref_depth, off_depth);
+    }
+
+    AR gr_addr = valloc(jobj);
+    rlock(gr_addr);
+    if (is_array) {
+        lea(Opnd(jobj, gr_addr), 
+            Opnd(jt, ref.reg(), jtypes[jt].rt_offset, off.reg(), jtypes[jt].size));
+    } else {
+        // only the low part of the offset matters on IA-32
+        mov(Opnd(jobj, gr_addr), ref.as_opnd());
+        alu(alu_add, Opnd(jobj, gr_addr), Opnd(jobj, off.reg()));
+    }
+    runlock(off);
+    runlock(ref);
+
+    if (is_get) {
+        // loads are not reordered with other loads
+        AR gr_val = valloc(jt);
+        mov(Opnd(jt, gr_val), Opnd(jt, gr_addr, 0));
+        runlock(gr_addr);
+        vpop();
+        vpop();
+        vpush(Val(jt, gr_val));
+        return true;
+    }
+
+    if (is_put) {
+        Val& val = vstack(0, true);
+        rlock(val);
+        mov(Opnd(jt, gr_addr, 0), val.as_opnd());
+        fence();
+        runlock(val);
+        runlock(gr_addr);
+        vpop();
+        vpop();
+        vpop();
+        return true;
+    }
+
+    // cmpxchg overwrites the expected value, so it's copied
+    Val& val = vstack(0, true);
+    rlock(val);
+    AR gr_expected = valloc(jt);
+    rlock(gr_expected);
+    mov(Opnd(jt, gr_expected), vstack(val_slots).as_opnd());
+    AR gr_res = valloc(i32);
+    rlock(gr_res);
+    mov(Opnd(i32, gr_res), Opnd(g_iconst_0));
+
+    cmpxchg(true, gr_addr, val.reg(), gr_expected, jt);
+    cmovcc(z, Opnd(i32, gr_res), vaddr(i32, &g_iconst_1));
+
+    runlock(gr_res);
+    runlock(gr_expected);
+    runlock(val);
+    runlock(gr_addr);
+    vpop();
+    vpop();
+    vpop();
+    vpop();
+    vpush(Val(i32, gr_res));
+    return true;
+}
+
 bool Compiler::gen_magic(void)
 {
     const JInst& jinst = m_insts[m_pc];
@@ -94,6 +199,16 @@ bool Compiler::gen_magic(void)
     
     const char* kname = class_cp_get_entry_class_name(m_klass, (unsigned short)jinst.op0);
 
+    if (opkod == OPCODE_INVOKESTATIC && 
+        !strcmp(kname, "org/apache/harmony/util/concurrent/Atomics")) {
+        if (!get_bool_arg("Atomics_as_magic", true)) {
+            return false;
+        }
+        const char* mname = class_cp_get_entry_name(m_klass, (unsigned short)jinst.op0);
+        const char* msig = class_cp_get_entry_descriptor(m_klass, (unsigned short)jinst.op0);
+        return gen_atomics_magic(mname, msig);
+    }
+
     if (!VMMagicUtils::isVMMagicClass(kname)) {
         return false;
     }
@@ -46,6 +46,7 @@ char *  StaticConsts::rt_helper_init_class = NULL;
 char *  StaticConsts::rt_helper_aastore = NULL;
 char *  StaticConsts::rt_helper_multinewarray = NULL;
 char *  StaticConsts::rt_helper_get_vtable = NULL;
+char *  StaticConsts::rt_helper_get_vtable_ic = NULL;
 char *  StaticConsts::rt_helper_checkcast = NULL;
 char *  StaticConsts::rt_helper_instanceof = NULL;
 
@@ -83,6 +84,7 @@ bool StaticConsts::g_jvmtiMode = false;
 
 const char* StaticConsts::NULL_REF = NULL;
 const char* StaticConsts::OBJ_BASE = NULL;
+unsigned StaticConsts::OBJ_SHIFT = 0;
 const char* StaticConsts::VTBL_BASE = NULL;
 bool StaticConsts::g_refs_squeeze = false;
 bool StaticConsts::g_vtbl_squeeze = false;
@@ -63,6 +63,7 @@ public:
     static char *       rt_helper_init_class;
     static char *       rt_helper_multinewarray;
     static char *       rt_helper_get_vtable;
+    static char *       rt_helper_get_vtable_ic;
     static char *       rt_helper_checkcast;
     static char *       rt_helper_instanceof;
 
@@ -139,6 +140,11 @@ public:
      */
     static const char*  OBJ_BASE;
     
+    /**
+     * @brief Shift for compressed references: ref -> OBJ_BASE + (ref << OBJ_SHIFT).
+     */
+    static unsigned     OBJ_SHIFT;
+    
     /**
      * @brief Base for compressed vtables.
      */
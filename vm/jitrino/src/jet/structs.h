@@ -413,6 +413,7 @@ struct BBInfo {
         code_size = 0;
         ehandler = false;
         jsr_target = false;
+        backedge_target = false;
         processed = false;
     }
     /**
@@ -459,6 +460,11 @@ struct BBInfo {
      * before a code which is generated for its first bytecode.
      */
     bool    ehandler;
+    /**
+     * \b true if the basic block is a target of at least one back branch,
+     * that is a loop header.
+     */
+    bool    backedge_target;
     /**
      * \b true if the basic block was processed in 
      * Compiler::comp_gen_code_bb().
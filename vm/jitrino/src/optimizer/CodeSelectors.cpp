@@ -395,7 +395,10 @@ JitHelperCallOp::Id _BlockCodeSelector::convertJitHelperId(JitHelperCallId callI
         case InitializeArray:           return JitHelperCallOp::InitializeArray;
         case SaveThisState:             return JitHelperCallOp::SaveThisState;
         case ReadThisState:             return JitHelperCallOp::ReadThisState;
+        case ReadOsrBuffer:             return JitHelperCallOp::ReadOsrBuffer;
         case LockedCompareAndExchange:  return JitHelperCallOp::LockedCompareAndExchange;
+        case VolatileLoad:              return JitHelperCallOp::VolatileLoad;
+        case VolatileStore:             return JitHelperCallOp::VolatileStore;
         case AddValueProfileValue:      return JitHelperCallOp::AddValueProfileValue;
         case FillArrayWithConst:        return JitHelperCallOp::FillArrayWithConst;
         case ArrayCopyDirect:           return JitHelperCallOp::ArrayCopyDirect;
@@ -604,6 +604,222 @@ System_identityHashCode_Handler::run() {
     callInst->unlink();       
 }
 
+HLOAPIMagicHandler*
+atomicsHandler(MemoryManager& mm, MethodCallInst* callInst, bool needWriteBarriers, bool compRefs) {
+    MethodDesc* md = callInst->getMethodDesc();
+    const char* methodName = md->getName();
+
+    if (!strcmp(methodName, "arrayBaseOffset") || !strcmp(methodName, "arrayIndexScale")) {
+        return new (mm) Atomics_arrayLayout_HLO_Handler(callInst);
+    }
+
+    // booleans are left to the natives
+    bool isInt = strstr(methodName, "Int") != NULL;
+    bool isLong = strstr(methodName, "Long") != NULL;
+    bool isObject = strstr(methodName, "Object") != NULL;
+    if (!isInt && !isLong && !isObject) {
+        return NULL;
+    }
+#ifndef _EM64T_
+    // there is no single instruction to access a long here
+    if (isLong) {
+        return NULL;
+    }
+#endif
+    // the natives update references through the GC
+    if (isObject && (needWriteBarriers || compRefs)) {
+        return NULL;
+    }
+
+    if (!strncmp(methodName, "compareAndSet", 13)) {
+        return new (mm) Atomics_compareAndSet_HLO_Handler(callInst);
+    } else if (!strncmp(methodName, "get", 3)) {
+        return new (mm) Atomics_getVolatile_HLO_Handler(callInst);
+    } else if (!strncmp(methodName, "set", 3)) {
+        return new (mm) Atomics_setVolatile_HLO_Handler(callInst);
+    }
+    return NULL;
+}
+
+//
+// Generates the address of the slot accessed by an Atomics method.
+// The slot is given either as (Object, long offset) or as (array, int index).
+// Ends the current node with the checks.
+//
+static Opnd*
+genAtomicsSlotAddr(HLOAPIMagicIRBuilder* builder, Opnd* base, Opnd* offset,
+                   Type* slotType, Node* dispatch) {
+    InstFactory& instFactory = builder->getInstFactory();
+    TypeManager& typeManager = builder->getTypeManager();
+
+    Type* slotPtrType = typeManager.getManagedPtrType(slotType);
+    Opnd* addr = builder->createOpnd(slotPtrType);
+    Opnd* tauNullChecked = builder->genTauCheckNull(base);
+
+    if (offset->getType()->isInt8()) {
+        // node
+        builder->genFallthroughNode(dispatch);
+        Modifier mod = Modifier(Overflow_None)|Modifier(Exception_Never)|Modifier(Strict_No);
+        Opnd* ptrOffset = builder->createOpnd(typeManager.getIntPtrType());
+        builder->appendInst(instFactory.makeConv(mod, Type::IntPtr, ptrOffset, offset));
+        builder->appendInst(instFactory.makeAddOffset(addr, base, ptrOffset));
+    } else {
+        // node
+        builder->genFallthroughNode(dispatch);
+        builder->genTauCheckBounds(base, offset, tauNullChecked);
+
+        // node
+        builder->genFallthroughNode(dispatch);
+        Opnd* elemBase = builder->createOpnd(slotPtrType);
+        builder->appendInst(instFactory.makeLdArrayBaseAddr(slotType, elemBase, base));
+        builder->appendInst(instFactory.makeAddScaledIndex(addr, elemBase, offset));
+    }
+    return addr;
+}
+
+static Type*
+getAtomicsSlotType(TypeManager& typeManager, MethodDesc* md) {
+    const char* methodName = md->getName();
+    if (strstr(methodName, "Long") != NULL) {
+        return typeManager.getInt64Type();
+    } else if (strstr(methodName, "Object") != NULL) {
+        return typeManager.getSystemObjectType();
+    }
+    assert(strstr(methodName, "Int") != NULL);
+    return typeManager.getInt32Type();
+}
+
+void
+Atomics_arrayLayout_HLO_Handler::run() {
+    IRManager* irm = builder->getIRManager();
+    InstFactory& instFactory = builder->getInstFactory();
+
+    // the first two are tau operands
+    Opnd* dst = callInst->getDst();
+    Opnd* arrayClass = callInst->getSrc(2);
+
+    // fold only class literals
+    Inst* classDef = arrayClass->isSsaOpnd() ? arrayClass->getInst() : NULL;
+    while (classDef != NULL && classDef->getOpcode() == Op_Copy && classDef->getSrc(0)->isSsaOpnd()) {
+        classDef = classDef->getSrc(0)->getInst();
+    }
+    if (classDef == NULL || classDef->getOpcode() != Op_LdRef) {
+        return;
+    }
+    TokenInst* ldRef = classDef->asTokenInst();
+    NamedType* type = irm->getCompilationInterface().getNamedType(
+        ldRef->getEnclosingMethod()->getParentHandle(), ldRef->getToken());
+    if (type->isUnresolvedType() || !type->isArrayType()) {
+        return;
+    }
+    ArrayType* arrayType = type->asArrayType();
+
+    I_32 value;
+    if (!strcmp(callInst->getMethodDesc()->getName(), "arrayIndexScale")) {
+        value = (I_32)VMInterface::getArrayElemSize(arrayType->getVMTypeHandle());
+    } else {
+        value = (I_32)arrayType->getArrayElemOffset();
+    }
+
+    builder->setCurrentBCOffset(callInst->getBCOffset());
+    builder->setCurrentNode(callInst->getNode());
+    builder->appendInst(instFactory.makeLdConst(dst, value));
+    callInst->unlink();
+}
+
+void
+Atomics_compareAndSet_HLO_Handler::run() {
+    InstFactory&        instFactory = builder->getInstFactory();
+    ControlFlowGraph&   cfg         = builder->getControlFlowGraph();
+
+    Node* firstNode = callInst->getNode();
+    Node* lastNode = cfg.splitNodeAtInstruction(callInst, true, true, instFactory.makeLabel());
+    Node* dispatch = firstNode->getExceptionEdgeTarget();
+    assert(dispatch);
+    callInst->unlink();
+    cfg.removeEdge(firstNode->findEdge(true, lastNode));
+
+    builder->setCurrentBCOffset(callInst->getBCOffset());
+    builder->setCurrentNode(firstNode);
+
+    // the first two are tau operands
+    Opnd* dst      = callInst->getDst();
+    Opnd* base     = callInst->getSrc(2);
+    Opnd* offset   = callInst->getSrc(3);
+    Opnd* expected = callInst->getSrc(4);
+    Opnd* value    = callInst->getSrc(5);
+
+    Type* slotType = getAtomicsSlotType(builder->getTypeManager(), callInst->getMethodDesc());
+    Opnd* addr = genAtomicsSlotAddr(builder, base, offset, slotType, dispatch);
+
+    // lock cmpxchg
+    Opnd* opnds[] = {addr, expected, value};
+    builder->appendInst(instFactory.makeJitHelperCall(dst, LockedCompareAndExchange, NULL, NULL, 3, opnds));
+    builder->genEdgeFromCurrent(lastNode);
+
+    cfg.orderNodes(true);
+}
+
+void
+Atomics_getVolatile_HLO_Handler::run() {
+    InstFactory&        instFactory = builder->getInstFactory();
+    ControlFlowGraph&   cfg         = builder->getControlFlowGraph();
+
+    Node* firstNode = callInst->getNode();
+    Node* lastNode = cfg.splitNodeAtInstruction(callInst, true, true, instFactory.makeLabel());
+    Node* dispatch = firstNode->getExceptionEdgeTarget();
+    assert(dispatch);
+    callInst->unlink();
+    cfg.removeEdge(firstNode->findEdge(true, lastNode));
+
+    builder->setCurrentBCOffset(callInst->getBCOffset());
+    builder->setCurrentNode(firstNode);
+
+    // the first two are tau operands
+    Opnd* dst    = callInst->getDst();
+    Opnd* base   = callInst->getSrc(2);
+    Opnd* offset = callInst->getSrc(3);
+
+    Type* slotType = getAtomicsSlotType(builder->getTypeManager(), callInst->getMethodDesc());
+    Opnd* addr = genAtomicsSlotAddr(builder, base, offset, slotType, dispatch);
+
+    Opnd* opnds[] = {addr};
+    builder->appendInst(instFactory.makeJitHelperCall(dst, VolatileLoad, NULL, NULL, 1, opnds));
+    builder->genEdgeFromCurrent(lastNode);
+
+    cfg.orderNodes(true);
+}
+
+void
+Atomics_setVolatile_HLO_Handler::run() {
+    InstFactory&        instFactory = builder->getInstFactory();
+    ControlFlowGraph&   cfg         = builder->getControlFlowGraph();
+
+    Node* firstNode = callInst->getNode();
+    Node* lastNode = cfg.splitNodeAtInstruction(callInst, true, true, instFactory.makeLabel());
+    Node* dispatch = firstNode->getExceptionEdgeTarget();
+    assert(dispatch);
+    callInst->unlink();
+    cfg.removeEdge(firstNode->findEdge(true, lastNode));
+
+    builder->setCurrentBCOffset(callInst->getBCOffset());
+    builder->setCurrentNode(firstNode);
+
+    // the first two are tau operands
+    Opnd* base   = callInst->getSrc(2);
+    Opnd* offset = callInst->getSrc(3);
+    Opnd* value  = callInst->getSrc(4);
+
+    Type* slotType = getAtomicsSlotType(builder->getTypeManager(), callInst->getMethodDesc());
+    Opnd* addr = genAtomicsSlotAddr(builder, base, offset, slotType, dispatch);
+
+    Opnd* opnds[] = {addr, value};
+    builder->appendInst(instFactory.makeJitHelperCall(OpndManager::getNullOpnd(), VolatileStore, NULL, NULL, 2, opnds));
+    builder->genEdgeFromCurrent(lastNode);
+
+    cfg.orderNodes(true);
+}
+
 Node*
 HLOAPIMagicIRBuilder::genNodeAfter(Node* srcNode, LabelInst* label, Node* dispatch) {
     currentNode = cfg.createBlockNode(label);
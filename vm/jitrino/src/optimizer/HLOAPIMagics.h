@@ -129,10 +129,16 @@ DECLARE_HLO_MAGIC_INLINER(String_compareTo_HLO_Handler);
 DECLARE_HLO_MAGIC_INLINER(String_regionMatches_HLO_Handler);
 DECLARE_HLO_MAGIC_INLINER(String_indexOf_HLO_Handler);
 DECLARE_HLO_MAGIC_INLINER(System_identityHashCode_Handler);
+DECLARE_HLO_MAGIC_INLINER(Atomics_arrayLayout_HLO_Handler);
+DECLARE_HLO_MAGIC_INLINER(Atomics_compareAndSet_HLO_Handler);
+DECLARE_HLO_MAGIC_INLINER(Atomics_getVolatile_HLO_Handler);
+DECLARE_HLO_MAGIC_INLINER(Atomics_setVolatile_HLO_Handler);
 
 DEFINE_SESSION_ACTION(HLOAPIMagicSession, hlo_api_magic, "APIMagics HLO Pass")
 
 bool arraycopyOptimizable(Inst* arraycopyCall, bool needWriteBarriers);
+HLOAPIMagicHandler* atomicsHandler(MemoryManager& mm, MethodCallInst* callInst,
+                                   bool needWriteBarriers, bool compRefs);
 
 void
 HLOAPIMagicSession::_run(IRManager& irm)
@@ -141,6 +147,7 @@ HLOAPIMagicSession::_run(IRManager& irm)
  
     //finding all api magic calls
     StlVector<HLOAPIMagicHandler*> handlers(mm);
+    bool compRefs = getBoolArg("compressedReferences", false);
     ControlFlowGraph& fg = irm.getFlowGraph();
     const Nodes& nodes = fg.getNodesPostOrder();//process checking only reachable nodes.
     for (Nodes::const_iterator it = nodes.begin(), end = nodes.end(); it!=end; ++it) {
@@ -166,6 +173,15 @@ HLOAPIMagicSession::_run(IRManager& irm)
                         }
                     }
                 }
+                if (!strcmp(className, "org/apache/harmony/util/concurrent/Atomics")) {
+                    if (getBoolArg("Atomics_as_magic", true)) {
+                        HLOAPIMagicHandler* handler = atomicsHandler(mm, callInst,
+                            irm.getCompilationInterface().needWriteBarriers(), compRefs);
+                        if (handler != NULL) {
+                            handlers.push_back(handler);
+                        }
+                    }
+                }
                 if (!strcmp(className, "java/lang/String")) {
                     if (!strcmp(methodName, "compareTo") && !strcmp(signature, "(Ljava/lang/String;)I")) {
                         if(getBoolArg("String_compareTo_as_magic", true))
@@ -183,7 +199,6 @@ HLOAPIMagicSession::_run(IRManager& irm)
     }
 
     if(handlers.size() != 0) {
-        bool compRefs = getBoolArg("compressedReferences", false);
         HLOAPIMagicIRBuilder builder = HLOAPIMagicIRBuilder(&irm, mm, compRefs);
         //running all handlers
         for (StlVector<HLOAPIMagicHandler*>::const_iterator it = handlers.begin(), end = handlers.end(); it!=end; ++it) {
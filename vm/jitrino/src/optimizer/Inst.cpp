@@ -453,8 +453,14 @@ void JitHelperCallInst::handlePrintEscape(::std::ostream& os, char code) const {
         os << "SaveThisState"; break;
     case ReadThisState:
         os << "ReadThisState"; break;
+    case ReadOsrBuffer:
+        os << "ReadOsrBuffer"; break;
     case LockedCompareAndExchange:
         os << "LockedCmpExchange"; break;
+    case VolatileLoad:
+        os << "VolatileLoad"; break;
+    case VolatileStore:
+        os << "VolatileStore"; break;
     case AddValueProfileValue:
         os << "AddValueProfileValue"; break;
     case FillArrayWithConst:
@@ -2005,6 +2011,9 @@ InstFactory::makeJitHelperCall(Opnd* dst, JitHelperCallId id,
         case StringCompareTo:
         case StringIndexOf:
         case StringRegionMatches:
+        case LockedCompareAndExchange:
+        case VolatileLoad:
+        case VolatileStore:
             mod = Modifier(Exception_Never);
             break;
         default:
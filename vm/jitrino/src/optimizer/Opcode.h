@@ -269,7 +269,10 @@ enum JitHelperCallId {
     FillArrayWithConst,
     SaveThisState, //todo: replace with GetTLS + offset sequence
     ReadThisState, //todo: replace with GetTLS + offset sequence
+    ReadOsrBuffer, // takes the OSR buffer of the thread and clears it
     LockedCompareAndExchange,
+    VolatileLoad,  // a load which is neither moved nor merged with other loads
+    VolatileStore, // a store followed by a full memory fence
     AddValueProfileValue,
     ArrayCopyDirect,
     ArrayCopyReverse,
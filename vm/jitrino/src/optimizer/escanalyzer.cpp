@@ -417,7 +417,10 @@ EscAnalyzer::instrExam(Node* node) {
                         case FillArrayWithConst:
                         case SaveThisState:
                         case ReadThisState:
+                        case ReadOsrBuffer:
                         case LockedCompareAndExchange:
+                        case VolatileLoad:
+                        case VolatileStore:
                         case AddValueProfileValue:
                         case ArrayCopyDirect:
                         case ArrayCopyReverse:
@@ -629,7 +629,7 @@ MemoryOptInitWalker::applyToInst(Inst *i)
             case InitializeArray:
             case SaveThisState:
             case ReadThisState:
-            case LockedCompareAndExchange:
+            case ReadOsrBuffer:
             case AddValueProfileValue:
             case ArrayCopyDirect:
             case ArrayCopyReverse:
@@ -647,6 +647,12 @@ MemoryOptInitWalker::applyToInst(Inst *i)
             case ClassIsFinalizable:
             case ClassGetFastCheckDepth:
                 break;
+            case LockedCompareAndExchange:
+            case VolatileLoad:
+            case VolatileStore:
+                // memory accesses must not be moved across a fence
+                thePass->effectAnyGlobal(n, i);
+                break;
             default:
                 assert(0);
                 break;
@@ -185,6 +185,9 @@ JavaByteCodeTranslator::JavaByteCodeTranslator(CompilationInterface& ci,
             irBuilder.genStVar(var,arg);
         stateInfo->stack[j].vars = new (memManager) SlotVar(prepass.getVarInc(0, j));
     }
+    if (osrEntryPc != EM_NO_OSR_PC) {
+        genOsrEntry();
+    }
     // check for synchronized methods
     if (methodToCompile.isSynchronized()) {
         if (methodToCompile.isStatic()) {
@@ -253,10 +256,105 @@ JavaByteCodeTranslator::initLocalVars() {
     javaTypeMap[JavaLabelPrepass::D]   = typeManager.getDoubleType();
     javaTypeMap[JavaLabelPrepass::A]   = typeManager.getSystemObjectType();
     javaTypeMap[JavaLabelPrepass::RET] = typeManager.getIntPtrType();
+
+    // the OSR entry defines all the live locals of its loop header,
+    // so they can't be kept as single-def temporaries
+    osrEntryPc = findOsrEntryPc();
+    if (osrEntryPc != EM_NO_OSR_PC) {
+        StateInfo* state = prepass.stateTable->getStateInfo(osrEntryPc);
+        for (U_32 k=0; k < numVars; k++) {
+            SlotVar* vars = state->stack[k].vars;
+            if (state->stack[k].type != NULL && vars != NULL) {
+                vars->mergeVarIncarnations(&typeManager);
+                vars->getVarIncarnation()->setMultipleDefs();
+            }
+        }
+    }
     prepass.createMultipleDefVarOpnds(&irBuilder);
 
 }
 
+//
+// Returns the loop header the first tier asked to enter by on-stack replacement,
+// if the entry can be compiled for it, EM_NO_OSR_PC otherwise.
+//
+U_32
+JavaByteCodeTranslator::findOsrEntryPc() {
+    if (&methodToCompile != compilationInterface.getMethodToCompile()
+        || methodToCompile.isSynchronized() || prepass.getHasJsrLabels()) {
+        return EM_NO_OSR_PC;
+    }
+    ProfilingInterface* pi = compilationInterface.getCompilationContext()->getProfilingInterface();
+    if (pi == NULL || !pi->isProfilingEnabled(ProfileType_EntryBackedge, JITProfilingRole_USE)) {
+        return EM_NO_OSR_PC;
+    }
+    EntryBackedgeMethodProfile* mp = pi->getEBMethodProfile(memManager, methodToCompile);
+    if (mp == NULL) {
+        return EM_NO_OSR_PC;
+    }
+    U_32 pc = mp->getOsrPc();
+    if (pc >= methodToCompile.getByteCodeSize() || !prepass.isLabel(pc) || !prepassVisited->getBit(pc)) {
+        return EM_NO_OSR_PC;
+    }
+    // the first tier leaves the frame with an empty operand stack only
+    StateInfo* state = prepass.stateTable->getStateInfo(pc);
+    if (state == NULL || state->stackDepth != numVars) {
+        return EM_NO_OSR_PC;
+    }
+    for (U_32 k=0; k < numVars; k++) {
+        Type* type = state->stack[k].type;
+        if (type != NULL && (type->tag == Type::IntPtr || type->isUnmanagedPtr())) {
+            return EM_NO_OSR_PC;
+        }
+    }
+    if (Log::isEnabled()) {
+        Log::out() << "OSR entry at " << pc << ::std::endl;
+    }
+    mp->setOsrEntryPc(pc);
+    return pc;
+}
+
+//
+// The first tier passes the locals of the interrupted frame in a buffer,
+// one stack slot per local, the address is taken from the thread.
+// If there is no buffer the method is entered normally.
+//
+void
+JavaByteCodeTranslator::genOsrEntry() {
+    Type* bufType = typeManager.getUnmanagedPtrType(typeManager.getInt8Type());
+    Opnd* buf = irBuilder.genJitHelperCall(ReadOsrBuffer, bufType, 0, NULL);
+    LabelInst* normalEntry = irBuilder.createLabel();
+    newFallthroughBlock();
+    irBuilder.genBranch(Type::IntPtr, Cmp_Zero, normalEntry, buf);
+
+    newFallthroughBlock();
+    Modifier mod = Modifier(Overflow_None)|Modifier(Exception_Never);
+    Opnd* tauSafe = irBuilder.genTauSafe();
+    StateInfo* state = prepass.stateTable->getStateInfo(osrEntryPc);
+    for (U_32 k=0; k < numVars; k++) {
+        StateInfo::SlotInfo& slot = state->stack[k];
+        if (slot.type == NULL || slot.vars == NULL) {
+            continue;
+        }
+        VarOpnd* var = slot.vars->getVarIncarnation()->getOpnd()->asVarOpnd();
+        assert(var != NULL);
+        Type* varType = var->getType();
+        Opnd* addr = irBuilder.genAddScaledIndex(buf, irBuilder.genLdConstant((I_32)(k*sizeof(POINTER_SIZE_INT))));
+        Opnd* val;
+        if (varType->isObject()) {
+            Opnd* ref = irBuilder.genTauLdInd(AutoCompress_No, bufType, Type::UnmanagedPtr, addr, tauSafe, tauSafe);
+            val = irBuilder.genConvUnmanaged(varType, varType->tag, mod, ref);
+        } else {
+            val = irBuilder.genTauLdInd(AutoCompress_No, varType, varType->tag, addr, tauSafe, tauSafe);
+        }
+        irBuilder.genStVar(var, val);
+    }
+    irBuilder.genJump(getLabel(labelId(osrEntryPc)));
+
+    irBuilder.genLabel(normalEntry);
+    cfgBuilder.genBlockAfterCurrent(normalEntry);
+}
+
 void 
 JavaByteCodeTranslator::initArgs() {
     // incoming argument and return value information
@@ -1505,7 +1603,7 @@ void JavaByteCodeTranslator::genCallWithResolve(JavaByteCodes bc, unsigned cpInd
         const char* mname = CompilationInterface::getMethodName(methodToCompile.getParentHandle(), cpIndex);
         if (VMMagicUtils::isVMMagicClass(kname)) {
             assert(bc == OPCODE_INVOKESTATIC || bc == OPCODE_INVOKEVIRTUAL);
-            UNUSED bool res = genVMMagic(mname, numArgs, args, returnType);    
+            UNUSED bool res = genVMMagic(mname, numArgs, args, sig->getParamTypes(), returnType);    
             assert(res);
             return;
         } else if (isVMHelperClass(kname)) {
@@ -1544,7 +1642,7 @@ JavaByteCodeTranslator::invokevirtual(U_32 constPoolIndex) {
 
     const char* className = methodDesc->getParentType()->getName();
     if (VMMagicUtils::isVMMagicClass(className)) {
-        UNUSED bool res = genVMMagic(methodDesc->getName(), numArgs, srcOpnds, returnType);
+        UNUSED bool res = genVMMagic(methodDesc->getName(), numArgs, srcOpnds, getParamTypes(methodDesc), returnType);
         assert(res);
         return;
     }
@@ -2324,7 +2422,7 @@ JavaByteCodeTranslator::genInvokeStatic(MethodDesc * methodDesc,
     const char* kname = methodDesc->getParentType()->getName(); 
     const char* mname = methodDesc->getName(); 
     if (VMMagicUtils::isVMMagicClass(kname)) {
-        UNUSED bool res = genVMMagic(mname, numArgs, srcOpnds, returnType);    
+        UNUSED bool res = genVMMagic(mname, numArgs, srcOpnds, getParamTypes(methodDesc), returnType);    
         assert(res);
         return;
     } else if (isVMHelperClass(kname) && !methodDesc->isNative()) {
@@ -2739,7 +2837,16 @@ U_32 JavaByteCodeTranslator::getNumericValue(const U_8* byteCodes, U_32 offset,
     return off - offset;
 }
 
-bool JavaByteCodeTranslator::genVMMagic(const char* mname, U_32 numArgs, Opnd **srcOpnds, Type *magicRetType) {
+Type** JavaByteCodeTranslator::getParamTypes(MethodDesc * methodDesc) {
+    U_32 numParams = methodDesc->getNumParams();
+    Type** paramTypes = new (memManager) Type*[numParams];
+    for (U_32 i = 0; i < numParams; i++) {
+        paramTypes[i] = methodDesc->getParamType(i);
+    }
+    return paramTypes;
+}
+
+bool JavaByteCodeTranslator::genVMMagic(const char* mname, U_32 numArgs, Opnd **srcOpnds, Type **paramTypes, Type *magicRetType) {
     Type* resType = convertVMMagicType2HIR(typeManager, magicRetType);
     Type* cmpResType = typeManager.getInt32Type();
     Opnd* tauSafe = irBuilder.genTauSafe();
@@ -2939,7 +3046,14 @@ bool JavaByteCodeTranslator::genVMMagic(const char* mname, U_32 numArgs, Opnd **
         if (numArgs == 3) { // store by offset
             effectiveAddress = irBuilder.genAddScaledIndex(arg0, srcOpnds[2]);
         }
-        irBuilder.genTauStInd(arg1->getType(), effectiveAddress, arg1, tauSafe, tauSafe, tauSafe);
+        // byte, short and char values are widened to int on the java stack,
+        // so the store size has to be taken from the signature
+        Type* storeType = arg1->getType();
+        Type::Tag paramTag = paramTypes[1]->tag;
+        if (paramTag == Type::Int8 || paramTag == Type::Int16 || paramTag == Type::Char) {
+            storeType = paramTypes[1];
+        }
+        irBuilder.genTauStInd(storeType, effectiveAddress, arg1, tauSafe, tauSafe, tauSafe);
         return true;
     }
 
@@ -269,7 +269,8 @@ private:
     //
     bool    needsReturnLabel(U_32 off);
     void    genInvokeStatic(MethodDesc * methodDesc,U_32 numArgs,Opnd ** srcOpnds,Type * returnType);
-    bool    genVMMagic(const char* mname, U_32 numArgs,Opnd ** srcOpnds,Type * returnType);
+    bool    genVMMagic(const char* mname, U_32 numArgs,Opnd ** srcOpnds,Type ** paramTypes,Type * returnType);
+    Type**  getParamTypes(MethodDesc * methodDesc);
     bool    genVMHelper(const char* mname, U_32 numArgs,Opnd ** srcOpnds,Type * returnType);
     
     bool    genMinMax(MethodDesc * methodDesc,U_32 numArgs,Opnd ** srcOpnds, Type * returnType);
@@ -282,6 +283,8 @@ private:
     void    initJsrEntryMap();
     void    initArgs();
     void    initLocalVars();
+    U_32    findOsrEntryPc();
+    void    genOsrEntry();
 
     //
     // labels and control flow
@@ -386,6 +389,8 @@ private:
     StateInfo           *stateInfo;
     U_32              firstVarRef;
     U_32              numberVarRef;
+    // loop header the on-stack replacement entry continues from, EM_NO_OSR_PC if none
+    U_32              osrEntryPc;
     // Synchronization
     Opnd*               lockAddr;
     Opnd*               oldLockValue;
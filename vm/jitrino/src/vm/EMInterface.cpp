@@ -50,7 +50,9 @@ MethodProfile* ProfilingInterface::getMethodProfile(MemoryManager& mm, ProfileTy
     } else {
         U_32* eCounter = (U_32*)profileAccessInterface->eb_profiler_get_entry_counter_addr(mpHandle);
         U_32* bCounter = (U_32*)profileAccessInterface->eb_profiler_get_backedge_counter_addr(mpHandle);
-        p = new (mm) EntryBackedgeMethodProfile(mpHandle, md, eCounter, bCounter);
+        U_32* osrPc = (U_32*)profileAccessInterface->eb_profiler_get_osr_pc_addr(mpHandle);
+        U_32* osrEntryPc = (U_32*)profileAccessInterface->eb_profiler_get_osr_entry_pc_addr(mpHandle);
+        p = new (mm) EntryBackedgeMethodProfile(mpHandle, md, eCounter, bCounter, osrPc, osrEntryPc);
     }
     return p;
 }
@@ -153,8 +155,10 @@ EntryBackedgeMethodProfile* ProfilingInterface::createEBMethodProfile(MemoryMana
     assert(mpHandle!=0);
     U_32* eCounter = (U_32*)profileAccessInterface->eb_profiler_get_entry_counter_addr(mpHandle);
     U_32* bCounter = (U_32*)profileAccessInterface->eb_profiler_get_backedge_counter_addr(mpHandle);
+    U_32* osrPc = (U_32*)profileAccessInterface->eb_profiler_get_osr_pc_addr(mpHandle);
+    U_32* osrEntryPc = (U_32*)profileAccessInterface->eb_profiler_get_osr_entry_pc_addr(mpHandle);
 
-    EntryBackedgeMethodProfile* p = new (mm) EntryBackedgeMethodProfile(mpHandle, md, eCounter, bCounter);
+    EntryBackedgeMethodProfile* p = new (mm) EntryBackedgeMethodProfile(mpHandle, md, eCounter, bCounter, osrPc, osrEntryPc);
     return p;
 }
 
@@ -224,6 +228,11 @@ ProfilingInterface::PC_Callback_Fn* ProfilingInterface::getEBProfilerSyncModeCal
     return (PC_Callback_Fn*)profileAccessInterface->eb_profiler_sync_mode_callback;
 }
 
+ProfilingInterface::OSR_Callback_Fn* ProfilingInterface::getEBProfilerOsrCallback() const {
+    assert(profileAccessInterface->eb_profiler_osr_callback!=NULL);
+    return (OSR_Callback_Fn*)profileAccessInterface->eb_profiler_osr_callback;
+}
+
 
 U_32  EdgeMethodProfile::getNumCounters() const {
     return profileAccessInterface->edge_profiler_get_num_counters(getHandle());
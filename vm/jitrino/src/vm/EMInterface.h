@@ -56,17 +56,27 @@ private:
 
 class EntryBackedgeMethodProfile : public MethodProfile {
 public:
-    EntryBackedgeMethodProfile(Method_Profile_Handle mph, MethodDesc& md, U_32* _entryCounter, U_32 *_backedgeCounter)
-        : MethodProfile(mph, ProfileType_EntryBackedge, md),  entryCounter(_entryCounter), backedgeCounter(_backedgeCounter){}
+    EntryBackedgeMethodProfile(Method_Profile_Handle mph, MethodDesc& md, U_32* _entryCounter, U_32 *_backedgeCounter,
+                               U_32* _osrPc, U_32* _osrEntryPc)
+        : MethodProfile(mph, ProfileType_EntryBackedge, md),  entryCounter(_entryCounter), backedgeCounter(_backedgeCounter),
+        osrPc(_osrPc), osrEntryPc(_osrEntryPc){}
 
         U_32 getEntryExecCount() const {return *entryCounter;}
         U_32 getBackedgeExecCount() const {return *backedgeCounter;}
         U_32* getEntryCounter() const {return entryCounter;}
         U_32* getBackedgeCounter() const {return backedgeCounter;}
+        // loop header the first tier asks to enter by on-stack replacement, EM_NO_OSR_PC if none
+        U_32 getOsrPc() const {return *osrPc;}
+        U_32* getOsrPcAddr() const {return osrPc;}
+        // loop header the OSR entry of the optimized code was compiled for
+        U_32* getOsrEntryPcAddr() const {return osrEntryPc;}
+        void setOsrEntryPc(U_32 pc) {*osrEntryPc = pc;}
 
 private:
     U_32* entryCounter;
     U_32* backedgeCounter;
+    U_32* osrPc;
+    U_32* osrEntryPc;
 };
 
 class EdgeMethodProfile : public MethodProfile {
@@ -121,6 +131,8 @@ public:
 
     typedef void PC_Callback_Fn(Method_Profile_Handle);
     PC_Callback_Fn* getEBProfilerSyncModeCallback() const;
+    typedef void* OSR_Callback_Fn(Method_Profile_Handle);
+    OSR_Callback_Fn* getEBProfilerOsrCallback() const;
 
 
     EdgeMethodProfile* createEdgeMethodProfile(MemoryManager& mm, MethodDesc& md, U_32 numEdgeCounters, U_32* counterKeys, U_32 checkSum);
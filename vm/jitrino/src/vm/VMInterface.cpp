@@ -214,9 +214,12 @@ static  vm_get_system_string_class_t  vm_get_system_string_class = 0;
 static  vm_get_vtable_base_address_t  vm_get_vtable_base_address = 0; //POINTER_SIZE_INT vm_get_vtable_base_address()
 static  vm_get_heap_base_address_t  vm_get_heap_base_address = 0; //vm_get_heap_base_address
 static  vm_get_heap_ceiling_address_t  vm_get_heap_ceiling_address = 0; //vm_get_heap_ceiling_address
+static  vm_get_heap_compressed_base_address_t  vm_get_heap_compressed_base_address = 0; //vm_get_heap_compressed_base_address
+static  vm_get_heap_compressed_shift_t  vm_get_heap_compressed_shift = 0; //vm_get_heap_compressed_shift
 static  vm_is_heap_compressed_t  vm_is_heap_compressed = 0;//vm_is_heap_compressed();
 static  vm_is_vtable_compressed_t  vm_is_vtable_compressed = 0;//vm_is_vtable_compressed();
 static  vm_patch_code_block_t vm_patch_code_block = 0;
+static  vm_create_interface_call_cache_t vm_create_interface_call_cache = 0;
 static  vm_compile_method_t vm_compile_method = 0;
 static  vm_register_jit_recompiled_method_callback_t vm_register_jit_recompiled_method_callback = 0;
 static  vm_compiled_method_load_t vm_compiled_method_load = 0;
@@ -405,9 +408,12 @@ static vm_enumerate_root_interior_pointer_t vm_enumerate_root_interior_pointer =
         vm_get_vtable_base_address = GET_INTERFACE(vm, vm_get_vtable_base_address);
         vm_get_heap_base_address = GET_INTERFACE(vm, vm_get_heap_base_address);
         vm_get_heap_ceiling_address = GET_INTERFACE(vm, vm_get_heap_ceiling_address);
+        vm_get_heap_compressed_base_address = GET_INTERFACE(vm, vm_get_heap_compressed_base_address);
+        vm_get_heap_compressed_shift = GET_INTERFACE(vm, vm_get_heap_compressed_shift);
         vm_is_heap_compressed = GET_INTERFACE(vm, vm_is_heap_compressed);
         vm_is_vtable_compressed = GET_INTERFACE(vm, vm_is_vtable_compressed);
         vm_patch_code_block = GET_INTERFACE(vm, vm_patch_code_block);
+        vm_create_interface_call_cache = GET_INTERFACE(vm, vm_create_interface_call_cache);
         vm_compile_method = GET_INTERFACE(vm, vm_compile_method);
         vm_register_jit_recompiled_method_callback = GET_INTERFACE(vm, vm_register_jit_recompiled_method_callback);
         vm_compiled_method_load = GET_INTERFACE(vm, vm_compiled_method_load);
@@ -480,6 +486,19 @@ VMInterface::flagTLSThreadStateOffset() {
     return (U_32)offset;
 }
 
+// the frame being replaced passes its locals to the OSR entry through this slot
+U_32
+VMInterface::osrBufferTLSOffset() {
+    static UDATA key = 0;
+    static size_t offset = 0;
+    if (key == 0) {
+        vm_tls_alloc(&key);
+        offset = vm_tls_get_offset(key);
+    }
+    assert(fit32(offset));
+    return (U_32)offset;
+}
+
 I_32
 VMInterface::getTLSBaseOffset() {
     return (I_32) vm_get_tls_offset_in_segment();
@@ -961,6 +980,12 @@ CompilationInterface::getRuntimeHelperAddressForType(VM_RT_SUPPORT id, Type* typ
     return addr;
 }
 
+void*
+CompilationInterface::createInterfaceCallCache(NamedType* intfc) {
+    return vm_create_interface_call_cache(methodToCompile->getMethodHandle(),
+        (Class_Handle)intfc->getVMTypeHandle());
+}
+
 HELPER_CALLING_CONVENTION 
 CompilationInterface::getRuntimeHelperCallingConvention(VM_RT_SUPPORT id) {
     return vm_helper_get_calling_convention(id);
@@ -1051,7 +1076,11 @@ void CompilationInterface::sendCompiledMethodLoadEvent(MethodDesc* methodDesc, M
 }
 
 void * VMInterface::getHeapBase() {
-    return vm_get_heap_base_address();
+    return vm_get_heap_compressed_base_address();
+}
+
+U_32 VMInterface::getHeapShift() {
+    return vm_get_heap_compressed_shift();
 }
 
 void * VMInterface::getHeapCeiling() {
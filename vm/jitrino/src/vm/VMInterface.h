@@ -86,6 +86,7 @@ public:
 
     static U_32      flagTLSSuspendRequestOffset();
     static U_32      flagTLSThreadStateOffset();
+    static U_32      osrBufferTLSOffset();
     static I_32       getTLSBaseOffset();
     static bool        useFastTLSAccess();
 
@@ -103,8 +104,11 @@ public:
 
     //
     // returns the base for the heap (addend to compressed heap references)
+    // and the shift of compressed heap references: ref -> base + (ref << shift).
+    // The base may be zero, the shift is zero unless the heap is larger than 4GB.
     //
     static void*       getHeapBase();
+    static U_32        getHeapShift();
     static void*       getHeapCeiling();
 
 
@@ -304,6 +308,12 @@ public:
     void*       getRuntimeHelperAddress(VM_RT_SUPPORT);
     void*       getRuntimeHelperAddressForType(VM_RT_SUPPORT, Type*);
     MethodDesc* getMagicHelper(VM_RT_SUPPORT);
+    /**
+     * Creates the inline cache for an interface call site of the compiled
+     * method, to be passed to <code>VM_RT_GET_INTERFACE_VTABLE_IC</code>.
+     * Returns <code>NULL</code> if the VM doesn't use inline caches.
+     */
+    void*       createInterfaceCallCache(NamedType* intfc);
 
     Type*      getFieldType(Class_Handle enclClass, U_32 cpIndex);
 
@@ -48,6 +48,11 @@ extern "C" {
 void port_rw_barrier(void);
 void port_write_barrier(void);
 
+PORT_INLINE void port_pause(void)
+{
+    asm volatile ("" : : : "memory");
+}
+
 #else /* POSIX */
 #error "Windows/IPF is not supported!"
 #endif /* POSIX */
@@ -88,6 +93,15 @@ PORT_INLINE void port_write_barrier(void)
      */
      asm volatile ("sfence" : : : "memory");
 }
+
+/**
+ * Tells the processor that the thread is in a spin-wait loop, which saves
+ * power and avoids the memory order violation on the loop exit.
+ */
+PORT_INLINE void port_pause(void)
+{
+    asm volatile ("pause" : : : "memory");
+}
 #endif /* !defined(_IPF_) */
 
 #else /* !defined (POSIX) */
@@ -100,6 +114,7 @@ PORT_INLINE void port_write_barrier(void)
     void _WriteBarrier(void);
     void _mm_mfence(void);
     void _mm_sfence(void);
+    void _mm_pause(void);
 #endif
 
 #if !defined(__INTEL_COMPILER)
@@ -133,6 +148,12 @@ PORT_INLINE void port_write_barrier(void)
     _WriteBarrier();
 }
 
+PORT_INLINE void port_pause(void)
+{
+    _mm_pause();
+    _ReadWriteBarrier();
+}
+
 
 #endif /* !defined (POSIX) */
 
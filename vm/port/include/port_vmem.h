@@ -179,6 +179,85 @@ APR_DECLARE(apr_status_t) port_vmem_allocate(void **addr, size_t size, unsigned
  */
 APR_DECLARE(apr_status_t) port_vmem_free(void *addr, size_t size);
 
+/**
+ * @defgroup vmem_numa NUMA memory placement
+ * On the systems without NUMA support the machine is reported as a single
+ * node and the placement functions return <code>APR_ENOTIMPL</code>.
+ * @{
+ */
+
+/**
+ * Returns the number of NUMA nodes, that is the highest node number plus one,
+ * or 1 if the system is not NUMA or the topology can't be determined.
+ */
+APR_DECLARE(unsigned int) port_vmem_numa_nodes();
+
+/**
+ * Returns the NUMA node of the processor the calling thread is running on.
+ * The result may be out of date as soon as it is returned unless the thread
+ * is bound to the node with port_vmem_run_on_node().
+ */
+APR_DECLARE(unsigned int) port_vmem_numa_current_node();
+
+/**
+ * Binds a memory region to a NUMA node. The pages of the region are 
+ * allocated on the node when they are touched for the first time, 
+ * the pages already allocated stay where they are.
+ * @param address - the starting address of the region, page aligned
+ * @param amount  - the size of the region in bytes
+ * @param node    - the node, less than port_vmem_numa_nodes()
+ * @return <code>APR_SUCCESS</code> if OK; otherwise, an error code.
+ */
+APR_DECLARE(apr_status_t) port_vmem_bind_node(void *address, size_t amount, 
+                                              unsigned int node);
+
+/**
+ * Spreads the pages of a memory region over all NUMA nodes round-robin
+ * as they are touched for the first time.
+ * @param address - the starting address of the region, page aligned
+ * @param amount  - the size of the region in bytes
+ * @return <code>APR_SUCCESS</code> if OK; otherwise, an error code.
+ */
+APR_DECLARE(apr_status_t) port_vmem_interleave(void *address, size_t amount);
+
+/**
+ * Restricts the calling thread to the processors of a NUMA node, so that
+ * the thread keeps running close to the memory it allocates.
+ * @param node - the node, less than port_vmem_numa_nodes()
+ * @return <code>APR_SUCCESS</code> if OK; otherwise, an error code.
+ */
+APR_DECLARE(apr_status_t) port_vmem_run_on_node(unsigned int node);
+
+/** @} */
+
+/**
+ * @defgroup vmem_huge Transparent huge pages
+ * Unlike the large pages of port_vmem_reserve() on some systems, transparent
+ * huge pages need no memory set aside in advance: the system backs the
+ * advised memory with huge pages where it can and with default pages
+ * elsewhere.
+ * @{
+ */
+
+/**
+ * Returns the size of a transparent huge page, or 0 if the system doesn't
+ * support them or they are disabled.
+ */
+APR_DECLARE(size_t) port_vmem_huge_page_size();
+
+/**
+ * Asks the system to back a memory region with transparent huge pages.
+ * Only the parts of the region aligned to port_vmem_huge_page_size() can
+ * get them.
+ * @param address - the starting address of the region, page aligned
+ * @param amount  - the size of the region in bytes
+ * @return <code>APR_SUCCESS</code> if OK; <code>APR_ENOTIMPL</code> if 
+ *         transparent huge pages are not available; otherwise, an error code.
+ */
+APR_DECLARE(apr_status_t) port_vmem_advise_huge_pages(void *address, size_t amount);
+
+/** @} */
+
 /** @} */
 
 #ifdef __cplusplus
@@ -18,8 +18,12 @@
  * @author Alexey V. Varlamov
  */  
 
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sched.h>
+#include <string.h>
 #include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
@@ -53,11 +57,30 @@ static int convertProtectionBits(unsigned int mode){
     return bits;
 }
 
+static void* map_anonymous(void *address, size_t size, int protection) {
+#ifdef MAP_ANONYMOUS
+    return mmap(address, size, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#elif defined(MAP_ANON)
+    return mmap(address, size, protection, MAP_PRIVATE | MAP_ANON, -1, 0);
+#else
+    int fd = open("/dev/zero", O_RDONLY);
+    void *start = mmap(address, size, protection, MAP_PRIVATE, fd, 0);
+    close(fd);
+    return start;
+#endif
+}
+
 APR_DECLARE(apr_status_t) port_vmem_reserve(port_vmem_t **block, void **address, 
         size_t size, unsigned int mode, 
         size_t page, apr_pool_t *pool) {
 
     void *start = 0;
+    /* large pages are transparent huge pages, there is no point in them
+       if the region can't be aligned */
+    size_t huge_page = 0;
+    if (PORT_VMEM_PAGESIZE_LARGE == page && NULL == *address) {
+        huge_page = port_vmem_page_sizes()[1];
+    }
     if (PORT_VMEM_PAGESIZE_DEFAULT == page || PORT_VMEM_PAGESIZE_LARGE == page) {
         page = port_vmem_page_sizes()[0];
     }
@@ -65,17 +88,25 @@ APR_DECLARE(apr_status_t) port_vmem_reserve(port_vmem_t **block, void **address,
     int protection = convertProtectionBits(mode);
 
     errno = 0;
-    size = (size + page - 1) & ~(page - 1); /* Align */
-
-#ifdef MAP_ANONYMOUS
-    start = mmap(*address, size, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-#elif defined(MAP_ANON)
-    start = mmap(*address, size, protection, MAP_PRIVATE | MAP_ANON, -1, 0);
-#else
-    int fd = open("/dev/zero", O_RDONLY);
-    start = mmap(*address, size, protection, MAP_PRIVATE, fd, 0);
-    close(fd);
-#endif
+    if (huge_page) {
+        size = (size + huge_page - 1) & ~(huge_page - 1);
+        start = map_anonymous(NULL, size + huge_page, protection);
+        if (MAP_FAILED != start) {
+            /* trim the region to huge page boundaries */
+            size_t head = (huge_page - ((size_t)start & (huge_page - 1))) & (huge_page - 1);
+            if (head) {
+                munmap(start, head);
+            }
+            start = (char*)start + head;
+            munmap((char*)start + size, huge_page - head);
+            if (APR_SUCCESS == port_vmem_advise_huge_pages(start, size)) {
+                page = huge_page;
+            }
+        }
+    } else {
+        size = (size + page - 1) & ~(page - 1); /* Align */
+        start = map_anonymous(*address, size, protection);
+    }
 
     if (MAP_FAILED == start) {
         return apr_get_os_error();
@@ -121,9 +152,10 @@ APR_DECLARE(apr_status_t) port_vmem_release(/*void *address, size_t amount,*/
 
 APR_DECLARE(size_t *) port_vmem_page_sizes() {
 
-	static size_t page_sizes[2];
+	static size_t page_sizes[3];
 	if (!page_sizes[0]) {
-		page_sizes[1] = 0;
+		page_sizes[2] = 0;
+		page_sizes[1] = port_vmem_huge_page_size();
 		page_sizes[0] = sysconf(_SC_PAGE_SIZE);
 		if (!page_sizes[0]) {
 			page_sizes[0] = 4*1024;
@@ -239,6 +271,200 @@ APR_DECLARE(apr_status_t) port_vmem_free(void *addr, size_t size)
 	return APR_SUCCESS;
 }
 
+/* the memory policies of mbind(2), numaif.h comes with libnuma which is not required */
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#define MPOL_INTERLEAVE 3
+#endif
+
+/* the node masks passed to the kernel are a single word */
+#define NUMA_MAX_NODES (sizeof(unsigned long) * CHAR_BIT)
+
+/* Reads the first line of a sysfs file, returns 0 on failure */
+static int read_sys_line(const char* path, char* buf, int size)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+    char* line = fgets(buf, size, file);
+    fclose(file);
+    return line != NULL;
+}
+
+/* Calls add() for every number of a list like "0-3,8,10-11" */
+static void for_each_listed(const char* list, void (*add)(unsigned long item, void* arg), void* arg)
+{
+    char* p = (char*)list;
+    while (*p >= '0' && *p <= '9') {
+        unsigned long first = strtoul(p, &p, 10);
+        unsigned long last = first;
+        if (*p == '-') {
+            last = strtoul(p + 1, &p, 10);
+        }
+        for (; first <= last; first++) {
+            add(first, arg);
+        }
+        if (*p != ',') {
+            break;
+        }
+        p++;
+    }
+}
+
+static void update_max(unsigned long item, void* arg) {
+    if (item > *(unsigned long*)arg) {
+        *(unsigned long*)arg = item;
+    }
+}
+
+APR_DECLARE(unsigned int) port_vmem_numa_nodes()
+{
+    static unsigned int num_nodes = 0;
+    if (!num_nodes) {
+        char buf[256];
+        unsigned long max_node = 0;
+        if (read_sys_line("/sys/devices/system/node/online", buf, sizeof(buf))) {
+            for_each_listed(buf, update_max, &max_node);
+        }
+        if (max_node >= NUMA_MAX_NODES) {
+            max_node = NUMA_MAX_NODES - 1;
+        }
+        num_nodes = (unsigned int)max_node + 1;
+    }
+    return num_nodes;
+}
+
+APR_DECLARE(unsigned int) port_vmem_numa_current_node()
+{
+#ifdef SYS_getcpu
+    unsigned int cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0 && node < port_vmem_numa_nodes()) {
+        return node;
+    }
+#endif
+    return 0;
+}
+
+#ifdef SYS_mbind
+static apr_status_t set_memory_policy(void *address, size_t amount, int policy, 
+                                      unsigned long nodes) {
+    errno = 0;
+    if (syscall(SYS_mbind, address, amount, policy, &nodes, NUMA_MAX_NODES, 0)) {
+        return apr_get_os_error();
+    }
+    return APR_SUCCESS;
+}
+#endif
+
+APR_DECLARE(apr_status_t) port_vmem_bind_node(void *address, size_t amount, 
+                                              unsigned int node)
+{
+    if (node >= port_vmem_numa_nodes()) {
+        return APR_EINVAL;
+    }
+#ifdef SYS_mbind
+    return set_memory_policy(address, amount, MPOL_BIND, 1UL << node);
+#else
+    return APR_ENOTIMPL;
+#endif
+}
+
+APR_DECLARE(apr_status_t) port_vmem_interleave(void *address, size_t amount)
+{
+#ifdef SYS_mbind
+    unsigned int num_nodes = port_vmem_numa_nodes();
+    unsigned long nodes = (num_nodes == NUMA_MAX_NODES) ? ~0UL : (1UL << num_nodes) - 1;
+    return set_memory_policy(address, amount, MPOL_INTERLEAVE, nodes);
+#else
+    return APR_ENOTIMPL;
+#endif
+}
+
+#ifndef FREEBSD
+static void add_cpu(unsigned long cpu, void* arg) {
+    if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, (cpu_set_t*)arg);
+    }
+}
+#endif
+
+APR_DECLARE(apr_status_t) port_vmem_run_on_node(unsigned int node)
+{
+    if (node >= port_vmem_numa_nodes()) {
+        return APR_EINVAL;
+    }
+#ifndef FREEBSD
+    char path[64];
+    char buf[1024];
+    cpu_set_t cpus;
+
+    sprintf(path, "/sys/devices/system/node/node%u/cpulist", node);
+    if (!read_sys_line(path, buf, sizeof(buf))) {
+        return APR_ENOENT;
+    }
+    CPU_ZERO(&cpus);
+    for_each_listed(buf, add_cpu, &cpus);
+    if (CPU_COUNT(&cpus) == 0) {
+        return APR_ENOENT;
+    }
+
+    errno = 0;
+    if (sched_setaffinity(0, sizeof(cpus), &cpus)) {
+        return apr_get_os_error();
+    }
+    return APR_SUCCESS;
+#else
+    return APR_ENOTIMPL;
+#endif
+}
+
+#if defined(__linux__) && !defined(MADV_HUGEPAGE)
+#define MADV_HUGEPAGE 14
+#endif
+
+APR_DECLARE(size_t) port_vmem_huge_page_size()
+{
+#ifdef MADV_HUGEPAGE
+    static size_t huge_page_size = (size_t)-1;
+    if (huge_page_size == (size_t)-1) {
+        char buf[128];
+        size_t size = 0;
+        /* the active mode is bracketed, e.g. "always [madvise] never" */
+        if (read_sys_line("/sys/kernel/mm/transparent_hugepage/enabled", buf, sizeof(buf))
+                && !strstr(buf, "[never]")) {
+            size = 2*1024*1024;
+            if (read_sys_line("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", buf, sizeof(buf))) {
+                unsigned long pmd_size = strtoul(buf, NULL, 10);
+                if (pmd_size) {
+                    size = pmd_size;
+                }
+            }
+        }
+        huge_page_size = size;
+    }
+    return huge_page_size;
+#else
+    return 0;
+#endif
+}
+
+APR_DECLARE(apr_status_t) port_vmem_advise_huge_pages(void *address, size_t amount)
+{
+#ifdef MADV_HUGEPAGE
+    if (port_vmem_huge_page_size() == 0) {
+        return APR_ENOTIMPL;
+    }
+    errno = 0;
+    if (madvise(address, amount, MADV_HUGEPAGE)) {
+        return apr_get_os_error();
+    }
+    return APR_SUCCESS;
+#else
+    return APR_ENOTIMPL;
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
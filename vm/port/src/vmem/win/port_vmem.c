@@ -142,8 +142,9 @@ APR_DECLARE(apr_status_t) port_vmem_reserve(port_vmem_t **block, void **address,
 	int large = 0;
     size_t* ps = port_vmem_page_sizes();
 
-    if ((pageSize == PORT_VMEM_PAGESIZE_LARGE && ps[1] != 0)
-            || pageSize > ps[0]) {
+    /* large pages are committed read-write at once, so they can't hold code */
+    if (((pageSize == PORT_VMEM_PAGESIZE_LARGE && ps[1] != 0)
+            || pageSize > ps[0]) && !(mode & PORT_VMEM_MODE_EXECUTE)) {
 
 		/* Using large pages on Win64 seems to require MEM_COMMIT and PAGE_READWRITE.*/
 		action = MEM_COMMIT | MEM_LARGE_PAGES;
@@ -266,6 +267,65 @@ APR_DECLARE(apr_status_t) port_vmem_free(void *addr, size_t UNREF size)
 	return APR_SUCCESS;
 }
 
+APR_DECLARE(unsigned int) port_vmem_numa_nodes()
+{
+    ULONG highest_node;
+    if (!GetNumaHighestNodeNumber(&highest_node)) {
+        return 1;
+    }
+    return (unsigned int)highest_node + 1;
+}
+
+APR_DECLARE(unsigned int) port_vmem_numa_current_node()
+{
+    /* MAXIMUM_PROCESSORS only queries the ideal processor of the thread */
+    DWORD processor = SetThreadIdealProcessor(GetCurrentThread(), MAXIMUM_PROCESSORS);
+    UCHAR node;
+    if (processor == (DWORD)-1 || !GetNumaProcessorNode((UCHAR)processor, &node)
+            || node >= port_vmem_numa_nodes()) {
+        return 0;
+    }
+    return node;
+}
+
+/* The node of the memory is chosen when it is reserved with VirtualAllocExNuma,
+   an already reserved region can't be rebound. */
+APR_DECLARE(apr_status_t) port_vmem_bind_node(void* UNREF address, size_t UNREF amount, 
+                                              unsigned int UNREF node)
+{
+    return APR_ENOTIMPL;
+}
+
+APR_DECLARE(apr_status_t) port_vmem_interleave(void* UNREF address, size_t UNREF amount)
+{
+    return APR_ENOTIMPL;
+}
+
+APR_DECLARE(apr_status_t) port_vmem_run_on_node(unsigned int node)
+{
+    ULONGLONG mask;
+    if (node >= port_vmem_numa_nodes() || !GetNumaNodeProcessorMask((UCHAR)node, &mask)
+            || mask == 0) {
+        return APR_EINVAL;
+    }
+    if (!SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)mask)) {
+        return apr_get_os_error();
+    }
+    return APR_SUCCESS;
+}
+
+/* Windows has no transparent huge pages, only the locked large pages
+   reserved with PORT_VMEM_PAGESIZE_LARGE */
+APR_DECLARE(size_t) port_vmem_huge_page_size()
+{
+    return 0;
+}
+
+APR_DECLARE(apr_status_t) port_vmem_advise_huge_pages(void* UNREF address, size_t UNREF amount)
+{
+    return APR_ENOTIMPL;
+}
+
 #ifdef __cplusplus
 }
 #endif
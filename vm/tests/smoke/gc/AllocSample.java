@@ -0,0 +1,97 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+package gc;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.InputStreamReader;
+
+/**
+ * Runs a VM with gc.alloc_sample_interval set, requests the data dump
+ * and checks that the allocation site of the VM shows up in the dump.
+ * The data dump is requested with SIGQUIT, so the test only runs
+ * where there is /bin/sh.
+ */
+public class AllocSample {
+
+    static final String SITE = "gc/AllocSample.allocate(";
+
+    static Object live;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            child();
+            return;
+        }
+
+        if (!new File("/bin/sh").exists()) {
+            System.out.println("no /bin/sh, skipped");
+            System.out.println("PASS");
+            return;
+        }
+
+        String java = System.getProperty("java.home") + File.separator
+            + "bin" + File.separator + "java";
+        ProcessBuilder pb = new ProcessBuilder(new String[] {
+            java, "-XX:gc.alloc_sample_interval=64k",
+            "-classpath", System.getProperty("java.class.path"),
+            "gc.AllocSample", "child" });
+        pb.redirectErrorStream(true);
+        Process p = pb.start();
+        p.getOutputStream().close();
+
+        boolean header = false;
+        boolean site = false;
+        BufferedReader in = new BufferedReader(new InputStreamReader(p.getInputStream()));
+        String line;
+        while ((line = in.readLine()) != null) {
+            if (line.startsWith("Allocation sites:"))
+                header = true;
+            else if (header && line.indexOf(SITE) != -1)
+                site = true;
+        }
+        int code = p.waitFor();
+
+        if (code != 0) {
+            System.out.println("FAIL: the VM exited with " + code);
+        } else if (!header) {
+            System.out.println("FAIL: no allocation sites in the data dump");
+        } else if (!site) {
+            System.out.println("FAIL: " + SITE + " is not an allocation site");
+        } else {
+            System.out.println("PASS");
+        }
+    }
+
+    static void child() throws Exception {
+        for (int i = 0; i < 64; i++)
+            allocate();
+
+        // the dump is printed by a thread of its own, give it time to finish
+        Process kill = Runtime.getRuntime().exec(new String[] {
+            "/bin/sh", "-c", "kill -QUIT $PPID" });
+        kill.waitFor();
+        Thread.sleep(3000);
+    }
+
+    static void allocate() {
+        Object[] list = new Object[1024];
+        for (int i = 0; i < list.length; i++)
+            list[i] = new byte[512];
+        live = list;
+    }
+}
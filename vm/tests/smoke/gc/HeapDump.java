@@ -0,0 +1,323 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+package gc;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedReader;
+import java.io.ByteArrayInputStream;
+import java.io.DataInputStream;
+import java.io.EOFException;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStreamReader;
+
+/**
+ * Runs a VM with gc.heap_dump_on_signal and gc.class_histogram_on_signal
+ * set, and requests the data dump. Checks the HPROF header and the framing
+ * of the records, and of the sub-records in the heap dump segments, of the
+ * dump it writes, and that the class histogram it prints is sorted by
+ * bytes and counts the instances of a marker class.
+ * The data dump is requested with SIGQUIT, so the test only runs
+ * where there is /bin/sh.
+ */
+public class HeapDump {
+
+    static final int MARKER_LENGTH = 12345;
+
+    static final int HPROF_STRING = 0x01;
+    static final int HPROF_LOAD_CLASS = 0x02;
+    static final int HPROF_STACK_TRACE = 0x05;
+    static final int HPROF_HEAP_DUMP_SEGMENT = 0x1C;
+    static final int HPROF_HEAP_DUMP_END = 0x2C;
+
+    static final int HPROF_ROOT_UNKNOWN = 0xFF;
+    static final int HPROF_ROOT_STICKY_CLASS = 0x05;
+    static final int HPROF_CLASS_DUMP = 0x20;
+    static final int HPROF_INSTANCE_DUMP = 0x21;
+    static final int HPROF_OBJ_ARRAY_DUMP = 0x22;
+    static final int HPROF_PRIM_ARRAY_DUMP = 0x23;
+
+    static final int HPROF_INT = 10;
+
+    static final int NUM_MARKER_INSTANCES = 777;
+
+    static class Marker {
+        int value;
+    }
+
+    static int[] marker;
+    static Marker[] markerInstances;
+
+    static int idSize;
+    static int numSegments = 0;
+    static int numClasses = 0;
+    static int numInstances = 0;
+    static boolean markerFound = false;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            child();
+            return;
+        }
+
+        if (!new File("/bin/sh").exists()) {
+            System.out.println("no /bin/sh, skipped");
+            System.out.println("PASS");
+            return;
+        }
+
+        File dump = File.createTempFile("HeapDump", ".hprof");
+        dump.delete();
+
+        String java = System.getProperty("java.home") + File.separator
+            + "bin" + File.separator + "java";
+        ProcessBuilder pb = new ProcessBuilder(new String[] {
+            java, "-XX:gc.heap_dump_on_signal=true",
+            "-XX:gc.heap_dump_file=" + dump.getPath(),
+            "-XX:gc.class_histogram_on_signal=true",
+            "-classpath", System.getProperty("java.class.path"),
+            "gc.HeapDump", "child" });
+        pb.redirectErrorStream(true);
+        Process p = pb.start();
+        p.getOutputStream().close();
+        BufferedReader out = new BufferedReader(new InputStreamReader(p.getInputStream()));
+        String histogramError = checkHistogram(out);
+        while (out.readLine() != null)
+            ;
+        int code = p.waitFor();
+
+        if (code != 0) {
+            System.out.println("FAIL: the VM exited with " + code);
+            return;
+        }
+        if (histogramError != null) {
+            System.out.println("FAIL: " + histogramError);
+            dump.delete();
+            return;
+        }
+        if (!dump.exists()) {
+            System.out.println("FAIL: no heap dump " + dump);
+            return;
+        }
+
+        String error;
+        try {
+            error = check(dump);
+        } catch (EOFException e) {
+            error = "truncated";
+        } catch (IOException e) {
+            error = e.getMessage();
+        }
+        dump.delete();
+
+        if (error != null) {
+            System.out.println("FAIL: " + error);
+        } else {
+            System.out.println(numSegments + " segments, " + numClasses + " classes, "
+                + numInstances + " instances");
+            System.out.println("PASS");
+        }
+    }
+
+    static void child() throws Exception {
+        marker = new int[MARKER_LENGTH];
+        markerInstances = new Marker[NUM_MARKER_INSTANCES];
+        for (int i = 0; i < markerInstances.length; i++)
+            markerInstances[i] = new Marker();
+
+        // the dump is written by a thread of its own, give it time to finish
+        Process kill = Runtime.getRuntime().exec(new String[] {
+            "/bin/sh", "-c", "kill -QUIT $PPID" });
+        kill.waitFor();
+        Thread.sleep(5000);
+    }
+
+    // The rows of the histogram are "<rank>: <instances> <bytes> <class name>",
+    // the classes by decreasing bytes, and a "Total" row ends it.
+    static String checkHistogram(BufferedReader out) throws IOException {
+        int numRows = 0;
+        long lastBytes = Long.MAX_VALUE;
+        long markerCount = -1;
+        String line;
+        while ((line = out.readLine()) != null) {
+            String[] row = line.trim().split("\\s+");
+            if (row.length == 3 && row[0].equals("Total") && numRows > 0)
+                break;
+            if (row.length != 4 || !row[0].equals((numRows + 1) + ":"))
+                continue;
+            long instances;
+            long bytes;
+            try {
+                instances = Long.parseLong(row[1]);
+                bytes = Long.parseLong(row[2]);
+            } catch (NumberFormatException e) {
+                continue;
+            }
+            numRows++;
+            if (bytes > lastBytes)
+                return "the histogram is not sorted by bytes at row " + numRows;
+            lastBytes = bytes;
+            if (row[3].endsWith("HeapDump$Marker"))
+                markerCount = instances;
+        }
+
+        if (numRows == 0)
+            return "no class histogram";
+        if (line == null)
+            return "no Total row in the class histogram";
+        if (markerCount != NUM_MARKER_INSTANCES)
+            return markerCount + " instances of HeapDump$Marker in the class histogram, "
+                + NUM_MARKER_INSTANCES + " expected";
+        System.out.println(numRows + " classes in the histogram");
+        return null;
+    }
+
+    static String check(File dump) throws IOException {
+        DataInputStream in = new DataInputStream(
+            new BufferedInputStream(new FileInputStream(dump)));
+        try {
+            StringBuffer format = new StringBuffer();
+            int c;
+            while ((c = in.readUnsignedByte()) != 0)
+                format.append((char)c);
+            if (!format.toString().equals("JAVA PROFILE 1.0.2"))
+                return "bad format " + format;
+            idSize = in.readInt();
+            if (idSize != 4 && idSize != 8)
+                return "bad id size " + idSize;
+            if (in.readLong() <= 0)
+                return "bad time stamp";
+
+            while (true) {
+                int tag = in.read();
+                if (tag == -1)
+                    return "no HEAP DUMP END record";
+                in.readInt();
+                long length = in.readInt() & 0xffffffffL;
+
+                switch (tag) {
+                case HPROF_STRING:
+                case HPROF_LOAD_CLASS:
+                case HPROF_STACK_TRACE:
+                    skip(in, length);
+                    break;
+                case HPROF_HEAP_DUMP_SEGMENT:
+                    byte[] segment = new byte[(int)length];
+                    in.readFully(segment);
+                    numSegments++;
+                    String error = checkSegment(segment);
+                    if (error != null)
+                        return "segment " + numSegments + ": " + error;
+                    break;
+                case HPROF_HEAP_DUMP_END:
+                    if (length != 0)
+                        return "HEAP DUMP END of length " + length;
+                    if (in.read() != -1)
+                        return "data after HEAP DUMP END";
+                    if (numSegments == 0)
+                        return "no HEAP DUMP SEGMENT";
+                    if (numClasses == 0 || numInstances == 0)
+                        return "no classes or no instances";
+                    if (!markerFound)
+                        return "no int[" + MARKER_LENGTH + "]";
+                    return null;
+                default:
+                    return "unknown record tag " + tag;
+                }
+            }
+        } finally {
+            in.close();
+        }
+    }
+
+    static String checkSegment(byte[] segment) throws IOException {
+        DataInputStream in = new DataInputStream(new ByteArrayInputStream(segment));
+        while (in.available() > 0) {
+            int tag = in.readUnsignedByte();
+            switch (tag) {
+            case HPROF_ROOT_UNKNOWN:
+            case HPROF_ROOT_STICKY_CLASS:
+                skip(in, idSize);
+                break;
+            case HPROF_CLASS_DUMP:
+                // class, stack trace, super class, loader, signers, domain, reserved
+                skip(in, idSize + 4 + 6 * idSize);
+                in.readInt();
+                int num = in.readUnsignedShort();
+                for (int i = 0; i < num; i++) {
+                    in.readUnsignedShort();
+                    skip(in, typeSize(in.readUnsignedByte()));
+                }
+                num = in.readUnsignedShort();
+                for (int i = 0; i < num; i++) {
+                    skip(in, idSize);
+                    skip(in, typeSize(in.readUnsignedByte()));
+                }
+                num = in.readUnsignedShort();
+                skip(in, num * (idSize + 1));
+                numClasses++;
+                break;
+            case HPROF_INSTANCE_DUMP:
+                skip(in, idSize + 4 + idSize);
+                skip(in, in.readInt() & 0xffffffffL);
+                numInstances++;
+                break;
+            case HPROF_OBJ_ARRAY_DUMP:
+                skip(in, idSize + 4);
+                long length = in.readInt() & 0xffffffffL;
+                skip(in, idSize + length * idSize);
+                break;
+            case HPROF_PRIM_ARRAY_DUMP:
+                skip(in, idSize + 4);
+                length = in.readInt() & 0xffffffffL;
+                int type = in.readUnsignedByte();
+                if (type == HPROF_INT && length == MARKER_LENGTH)
+                    markerFound = true;
+                skip(in, length * typeSize(type));
+                break;
+            default:
+                return "unknown sub-record tag " + tag;
+            }
+        }
+        return null;
+    }
+
+    static int typeSize(int type) throws IOException {
+        switch (type) {
+        case 2: return idSize;  // object
+        case 4: return 1;       // boolean
+        case 5: return 2;       // char
+        case 6: return 4;       // float
+        case 7: return 8;       // double
+        case 8: return 1;       // byte
+        case 9: return 2;       // short
+        case 10: return 4;      // int
+        case 11: return 8;      // long
+        }
+        throw new IOException("unknown type " + type);
+    }
+
+    static void skip(DataInputStream in, long n) throws IOException {
+        while (n > 0) {
+            int skipped = in.skipBytes((int)Math.min(n, Integer.MAX_VALUE));
+            if (skipped <= 0)
+                throw new EOFException();
+            n -= skipped;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+package gc;
+
+/**
+ * Allocates large arrays from many threads at once and reports the allocation rate.
+ * Most of the arrays are in the 8k-256k range, which is served from the thread local LOS caches,
+ * some are larger and go to the LOS free lists directly.
+ */
+public class LOSThreads extends Thread {
+
+    final static long megabyte = 1048576;
+
+    // total bytes to allocate
+    static long total_allocate = 2000 * megabyte;
+    // arrays kept alive by every thread
+    static int window = 16;
+
+    static int thread_count = 16;
+    static long thread_allocate = total_allocate / thread_count;
+
+    final static int sizes[] = { 8192, 16384, 32768, 65536, 131072, 131072, 262144, 1048576 };
+
+    static boolean started = false;
+    static volatile boolean failed = false;
+
+    public static void main (String[] args) {
+        init_from_properties();
+        Thread[] threads = new Thread[thread_count];
+        for (int i = 0; i < thread_count; i++) {
+            threads[i] = new LOSThreads();
+            threads[i].start();
+        }
+        long start = System.currentTimeMillis();
+        synchronized (LOSThreads.class) {
+            LOSThreads.class.notifyAll();
+            started = true;
+        }
+
+        for (int i = 0; i < thread_count; i++) {
+            try {
+                threads[i].join();
+            } catch (InterruptedException e) {}
+        }
+        long time = System.currentTimeMillis() - start;
+        if (time == 0) time = 1;
+        System.out.println("" + thread_count + " threads allocated " + (total_allocate/megabyte)
+            + " Mb of large arrays in " + time + " ms, " + (total_allocate/megabyte*1000/time) + " Mb/s");
+
+        if (failed) {
+            System.out.println("FAILED, a large array was not zeroed or was overwritten");
+        } else {
+            System.out.println("PASSED");
+        }
+    }
+
+    public void run () {
+        synchronized (this.getClass()) {
+            if (!started)
+                try {
+                    this.getClass().wait();
+                } catch (InterruptedException e) {}
+        }
+        byte[][] live = new byte[window][];
+        long allocated = 0;
+        int n = (int)getId();
+        while (allocated < thread_allocate) {
+            int size = sizes[n++ % sizes.length] - 16;
+            byte[] a = new byte[size];
+            if (a[0] != 0 || a[size - 1] != 0) {
+                failed = true;
+            }
+            a[0] = (byte)n;
+            a[size - 1] = (byte)n;
+
+            int slot = n % window;
+            byte[] old = live[slot];
+            if (old != null && old[0] != old[old.length - 1]) {
+                failed = true;
+            }
+            live[slot] = a;
+            allocated += size;
+        }
+    }
+
+    public static long parseSize (String x) throws NumberFormatException {
+        int len = x.length();
+        long factor = 1;
+        switch (x.charAt(len-1)) {
+            case 'k': factor = 1024; len--; break;
+            case 'm': factor = 1048576; len--; break;
+            case 'g': factor = 1073741824; len--; break;
+        }
+        long result = Long.parseLong(x.substring(0,len));
+        return factor * result;
+    }
+
+    public static void init_from_properties() {
+        try {
+            total_allocate = parseSize(System.getProperty("allocate"));
+            System.out.println("allocating " + (total_allocate/1048576) + " Mb");
+        } catch (Exception e) { /* ignore */ }
+
+        try {
+            thread_count = Integer.parseInt(System.getProperty("threads"));
+            System.out.println("using " + thread_count + " threads");
+        } catch (Exception e) { /* ignore */ }
+
+        thread_allocate = total_allocate / thread_count;
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "PinnedElements.h"
+
+JNIEXPORT jboolean JNICALL Java_jni_PinnedElements_holdElements
+  (JNIEnv * jni_env, jclass clazz, jintArray array)
+{
+    jsize length = (*jni_env)->GetArrayLength(jni_env, array);
+    jmethodID collect = (*jni_env)->GetStaticMethodID(jni_env, clazz, "collect", "()V");
+    void* critical;
+    jint* elems;
+    jsize i;
+
+    /* the critical section pins the array while the elements are taken */
+    critical = (*jni_env)->GetPrimitiveArrayCritical(jni_env, array, NULL);
+    elems = (*jni_env)->GetIntArrayElements(jni_env, array, NULL);
+    (*jni_env)->ReleasePrimitiveArrayCritical(jni_env, array, critical, JNI_ABORT);
+    if (elems == NULL)
+        return JNI_FALSE;
+
+    /* the array can only move if elems is a copy */
+    (*jni_env)->CallStaticVoidMethod(jni_env, clazz, collect);
+    if ((*jni_env)->ExceptionCheck(jni_env)) {
+        (*jni_env)->ReleaseIntArrayElements(jni_env, array, elems, JNI_ABORT);
+        return JNI_FALSE;
+    }
+
+    for (i = 0; i < length; i++)
+        elems[i]++;
+    (*jni_env)->ReleaseIntArrayElements(jni_env, array, elems, 0);
+    return JNI_TRUE;
+}
@@ -0,0 +1,40 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class jni_PinnedElements */
+
+#ifndef _Included_jni_PinnedElements
+#define _Included_jni_PinnedElements
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef jni_PinnedElements_LENGTH
+#define jni_PinnedElements_LENGTH 1000L
+/*
+ * Class:     jni_PinnedElements
+ * Method:    holdElements
+ * Signature: ([I)Z
+ */
+JNIEXPORT jboolean JNICALL Java_jni_PinnedElements_holdElements
+  (JNIEnv *, jclass, jintArray);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,72 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+package jni;
+
+/**
+ * Holds the elements of an int array across a forced GC. The array is
+ * also held by a critical section while the elements are taken, which is
+ * dropped before the GC, so the elements must have a pin of their own,
+ * or be a copy.
+ */
+public class PinnedElements {
+
+    static {
+        System.loadLibrary("PinnedElements");
+    }
+
+    static final int LENGTH = 1000;
+
+    // returns false if an exception was thrown by collect()
+    static native boolean holdElements(int[] array);
+
+    // called back by holdElements() while it holds the elements
+    static void collect() {
+        Object[] garbage = new Object[1000];
+        for (int i = 0; i < 100000; i++) {
+            garbage[i % garbage.length] = new int[i % 100];
+        }
+        System.gc();
+    }
+
+    public static void main(String[] args) {
+        // new garbage in front of the array, so the GC has a reason to move it
+        Object[] garbage = new Object[1000];
+        for (int i = 0; i < garbage.length; i++) {
+            garbage[i] = new int[i % 100];
+        }
+        int[] array = new int[LENGTH];
+        for (int i = 0; i < LENGTH; i++) {
+            array[i] = i;
+        }
+        garbage = null;
+
+        if (!holdElements(array)) {
+            System.out.println("FAILED: exception in collect()");
+            return;
+        }
+
+        // holdElements() has added 1 to every element
+        for (int i = 0; i < LENGTH; i++) {
+            if (array[i] != i + 1) {
+                System.out.println("FAILED: array[" + i + "] = " + array[i]);
+                return;
+            }
+        }
+        System.out.println("PASSED");
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+package perf;
+
+/**
+ * Measures the cost of an interface call as the number of interfaces
+ * implemented by the receiver class grows, 1, 2, 4, ... 32. The calls go
+ * through a megamorphic call site, which misses the inline cache and looks
+ * the interface up in the interface table of the receiver. With the hashed
+ * lookup the time should stay about flat.
+ */
+public class InterfaceDispatch {
+
+    static final int ITERATIONS = 20000000;
+
+    // I<n-1> is implemented with the interfaces it extends by the receivers
+    // of n interfaces, the other ones just add to the count
+    interface I0 { int get(); }
+    interface I1 extends I0 {}
+    interface I2 {}
+    interface I3 extends I1, I2 {}
+    interface I4 {} interface I5 {} interface I6 {}
+    interface I7 extends I3, I4, I5, I6 {}
+    interface I8 {} interface I9 {} interface I10 {} interface I11 {}
+    interface I12 {} interface I13 {} interface I14 {}
+    interface I15 extends I7, I8, I9, I10, I11, I12, I13, I14 {}
+    interface I16 {} interface I17 {} interface I18 {} interface I19 {}
+    interface I20 {} interface I21 {} interface I22 {} interface I23 {}
+    interface I24 {} interface I25 {} interface I26 {} interface I27 {}
+    interface I28 {} interface I29 {} interface I30 {}
+    interface I31 extends I15, I16, I17, I18, I19, I20, I21, I22, I23,
+                          I24, I25, I26, I27, I28, I29, I30 {}
+
+    // the receivers of n interfaces return n, the subclasses are there to
+    // have more receiver types at the call site than the inline cache holds
+    static class R1 implements I0 { public int get() { return 1; } }
+    static class R2 implements I1 { public int get() { return 2; } }
+    static class R4 implements I3 { public int get() { return 4; } }
+    static class R8 implements I7 { public int get() { return 8; } }
+    static class R16 implements I15 { public int get() { return 16; } }
+    static class R32 implements I31 { public int get() { return 32; } }
+
+    static class R1a extends R1 {} static class R1b extends R1 {} static class R1c extends R1 {}
+    static class R1d extends R1 {} static class R1e extends R1 {}
+    static class R2a extends R2 {} static class R2b extends R2 {} static class R2c extends R2 {}
+    static class R2d extends R2 {} static class R2e extends R2 {}
+    static class R4a extends R4 {} static class R4b extends R4 {} static class R4c extends R4 {}
+    static class R4d extends R4 {} static class R4e extends R4 {}
+    static class R8a extends R8 {} static class R8b extends R8 {} static class R8c extends R8 {}
+    static class R8d extends R8 {} static class R8e extends R8 {}
+    static class R16a extends R16 {} static class R16b extends R16 {} static class R16c extends R16 {}
+    static class R16d extends R16 {} static class R16e extends R16 {}
+    static class R32a extends R32 {} static class R32b extends R32 {} static class R32c extends R32 {}
+    static class R32d extends R32 {} static class R32e extends R32 {}
+
+    static final I0[][] RECEIVERS = {
+        { new R1(), new R1a(), new R1b(), new R1c(), new R1d(), new R1e() },
+        { new R2(), new R2a(), new R2b(), new R2c(), new R2d(), new R2e() },
+        { new R4(), new R4a(), new R4b(), new R4c(), new R4d(), new R4e() },
+        { new R8(), new R8a(), new R8b(), new R8c(), new R8d(), new R8e() },
+        { new R16(), new R16a(), new R16b(), new R16c(), new R16d(), new R16e() },
+        { new R32(), new R32a(), new R32b(), new R32c(), new R32d(), new R32e() },
+    };
+
+    static int call(I0[] receivers) {
+        int sum = 0;
+        for (int i = 0; i < ITERATIONS; i++) {
+            sum += receivers[i % receivers.length].get();
+        }
+        return sum;
+    }
+
+    // All the receivers go through the call site in call(), the first pass
+    // warms up the code.
+    static boolean run(I0[] receivers) {
+        int n = receivers[0].get();
+        call(receivers);
+        long start = System.currentTimeMillis();
+        int sum = call(receivers);
+        long time = System.currentTimeMillis() - start;
+        System.out.println(n + " interfaces: " + time + " ms");
+        return sum == ITERATIONS * n;
+    }
+
+    public static void main(String[] args) {
+        boolean passed = true;
+        for (int i = 0; i < RECEIVERS.length; i++) {
+            passed &= run(RECEIVERS[i]);
+        }
+        System.out.println(passed ? "PASSED" : "FAILED");
+    }
+}
@@ -57,6 +57,75 @@ int test_hythread_thin_monitor_enter(void){
     return 0;
 }
 
+/*
+ * Test hythread_thin_monitor_spin_enter
+ */
+int test_hythread_thin_monitor_spin_enter(void){
+    IDATA status;
+    hythread_thin_monitor_t lockword_ptr;
+    hythread_thin_monitor_stats_t before, after;
+    status = hythread_thin_monitor_create(&lockword_ptr);
+    tf_assert_same(status, TM_ERROR_NONE);
+    hythread_thin_monitor_get_stats(&before);
+    hythread_suspend_disable();
+    status = hythread_thin_monitor_spin_enter(&lockword_ptr);
+    tf_assert_same(status, TM_ERROR_NONE);
+
+    status = hythread_thin_monitor_exit(&lockword_ptr);
+    tf_assert_same(status, TM_ERROR_NONE);
+    hythread_suspend_enable();
+    hythread_thin_monitor_get_stats(&after);
+    tf_assert(after.spins > before.spins);
+    tf_assert(after.spin_acquires > before.spin_acquires);
+    return 0;
+}
+
+/*
+ * Test hythread_thin_monitor_enter spinning on a lock held for long,
+ * then inflating it
+ */
+int test_hythread_thin_monitor_spin_enter_contended(void){
+    void **args;
+    hythread_t thread = NULL;
+    hythread_thin_monitor_t lockword_ptr;
+    hythread_thin_monitor_stats_t before, after;
+    IDATA status;
+
+    args = (void**)calloc(3, sizeof(void *));
+
+    status = hythread_thin_monitor_create(&lockword_ptr);
+    tf_assert_same(status, TM_ERROR_NONE);
+    hythread_thin_monitor_get_stats(&before);
+    hythread_suspend_disable();
+    status = hythread_thin_monitor_enter(&lockword_ptr);
+    hythread_suspend_enable();
+    tf_assert_same(status, TM_ERROR_NONE);
+
+    args[0] = &lockword_ptr;
+    args[1] = 0;
+    status = hythread_create(&thread, 0, 0, 0,
+        (hythread_entrypoint_t)start_proc, args);
+    tf_assert_same(status, TM_ERROR_NONE);
+
+    // much longer than the spin limit, the other thread gives up spinning
+    hythread_sleep(500);
+    tf_assert_same(args[1], 0);
+
+    hythread_suspend_disable();
+    status = hythread_thin_monitor_exit(&lockword_ptr);
+    hythread_suspend_enable();
+    tf_assert_same(status, TM_ERROR_NONE);
+    test_thread_join(thread, 1);
+    tf_assert_same((IDATA)args[1], 1);
+
+    hythread_thin_monitor_get_stats(&after);
+    tf_assert(after.spins > before.spins);
+    tf_assert(after.spin_pauses > before.spin_pauses);
+    tf_assert(after.inflations > before.inflations);
+    tf_assert(hythread_is_fat_lock(lockword_ptr));
+    return 0;
+}
+
 /*
  * Test hythread_thin_monitor timed wait timeout
  */
@@ -189,6 +258,8 @@ int start_proc(void *args) {
 TEST_LIST_START
     TEST(test_hythread_thin_monitor_enter)
     TEST(test_hythread_thin_monitor_try_enter)
+    TEST(test_hythread_thin_monitor_spin_enter)
+    TEST(test_hythread_thin_monitor_spin_enter_contended)
     TEST(test_hythread_thin_monitor_wait_timed_illegal)
     TEST(test_hythread_thin_monitor_wait_timed)
     TEST(test_hythread_thin_monitor_fat_unlock)
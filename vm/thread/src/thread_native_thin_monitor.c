@@ -35,10 +35,31 @@
  */
 //@{
 
-#if !defined (_IPF_)
-// spin with try_lock SPIN_COUNT times
-#define SPIN_COUNT 5
-#endif // !defined (_IPF_)
+/*
+ * Contended thin locks are spun on before the thread falls back to yielding
+ * and inflation. The spin limit, counted in pause instructions, is learned
+ * per monitor: it grows when spinning acquires the lock and shrinks when it
+ * doesn't. There are no spare bits in the lockword, so the limits are kept
+ * in a side table indexed by the lockword address; monitors sharing a slot
+ * share the history.
+ * The spinning thread has suspend disabled, since the lockword is in the
+ * object, so the spin is kept short and stops as soon as the thread is asked
+ * to suspend, e.g. for a GC, not to hold off the safepoint.
+ */
+#define SPIN_HISTORY_SIZE 1024
+#define SPIN_HISTORY_SLOT(lockword_ptr) \
+    ((((POINTER_SIZE_INT)(lockword_ptr) >> 3) ^ ((POINTER_SIZE_INT)(lockword_ptr) >> 13)) \
+        & (SPIN_HISTORY_SIZE - 1))
+#define SPIN_LIMIT_MIN 64
+#define SPIN_LIMIT_INITIAL 256
+#define SPIN_LIMIT_DEFAULT_MAX 2048
+#define SPIN_BACKOFF_MAX 64
+
+// zero means the slot is not used yet
+static volatile U_32 spin_limits[SPIN_HISTORY_SIZE];
+
+// statistics, updated without synchronization
+static hythread_thin_monitor_stats_t thin_monitor_stats;
 
 /*
  * 32bit lock word
@@ -297,7 +318,6 @@ IDATA hythread_thin_monitor_try_enter(hythread_thin_monitor_t *lockword_ptr) {
     IDATA lock_id;
     IDATA status;
     hythread_monitor_t fat_monitor;
-    int UNUSED i;
     assert(!hythread_is_suspend_enabled());
     assert((UDATA)lockword_ptr > 4);    
     assert(tm_self_tls);
@@ -330,12 +350,8 @@ IDATA hythread_thin_monitor_try_enter(hythread_thin_monitor_t *lockword_ptr) {
         }        
     } 
 
-    // Fast path didn't work, someoneelse is holding the monitor (or it isn't reserved yet):   
-
-    // DO SPIN FOR A WHILE, this will decrease the number of fat locks.
-#ifdef SPIN_COUNT
-    for (i = SPIN_COUNT; i >=0; i--, lockword = *lockword_ptr, lock_id = THREAD_ID(lockword)) { 
-#endif
+    // Fast path didn't work, someoneelse is holding the monitor (or it isn't reserved yet).
+    // Contended callers spin in hythread_thin_monitor_spin_enter().
 
         // Check if monitor is free and thin
         if (lock_id == 0) {
@@ -345,12 +361,7 @@ IDATA hythread_thin_monitor_try_enter(hythread_thin_monitor_t *lockword_ptr) {
             // Acquire monitor
             if (0 != port_atomic_cas16 (((volatile apr_uint16_t*) lockword_ptr)+1, 
                                         (apr_uint16_t) this_id, 0)) {
-
-#ifdef SPIN_COUNT
-                continue; 
-#else
                 return TM_ERROR_EBUSY;
-#endif
             }
 
 #ifdef LOCK_RESERVATION
@@ -370,11 +381,6 @@ IDATA hythread_thin_monitor_try_enter(hythread_thin_monitor_t *lockword_ptr) {
                 fat_monitor = locktable_get_fat_monitor(FAT_LOCK_ID(lockword)); //  find fat_monitor in lock table
             
                 status = hythread_monitor_try_enter(fat_monitor);
-#ifdef SPIN_COUNT
-                if (status == TM_ERROR_EBUSY) {
-                    continue; 
-                }
-#endif
                 return status;
             }
 
@@ -383,21 +389,111 @@ IDATA hythread_thin_monitor_try_enter(hythread_thin_monitor_t *lockword_ptr) {
             else if (IS_RESERVED(lockword)) {
                 status = hythread_unreserve_lock(lockword_ptr);
                 if (status != TM_ERROR_NONE) {
-#ifdef SPIN_COUNT
-                    if (status == TM_ERROR_EBUSY) {
-                        continue;
-                    }
-#endif //SPIN_COUNT
                     return status;
                 }
                 return hythread_thin_monitor_try_enter(lockword_ptr);
             }
 #endif 
-#ifdef SPIN_COUNT
-        hythread_yield();
+    return TM_ERROR_EBUSY;
+}
+
+/**
+ * Spins trying to lock the contended thin monitor.
+ *
+ * The thread backs off exponentially with pause instructions between the
+ * attempts, which are only made when the lock looks free. Spinning stops
+ * after the spin limit learned for the monitor is used up, when the
+ * monitor gets inflated, since the fat monitor parks its waiters anyway,
+ * or when the thread is asked to suspend, so that the caller can reach a
+ * safepoint.
+ *
+ * @param[in] lockword_ptr monitor addr 
+ * @return TM_ERROR_EBUSY if the monitor wasn't acquired
+ */
+IDATA VMCALL hythread_thin_monitor_spin_enter(hythread_thin_monitor_t *lockword_ptr) {
+    U_32 slot = (U_32)SPIN_HISTORY_SLOT(lockword_ptr);
+    U_32 max_limit = SPIN_LIMIT_DEFAULT_MAX;
+    U_32 limit = spin_limits[slot];
+    U_32 pauses = 0;
+    U_32 backoff = 1;
+    U_32 lockword;
+    U_32 i;
+    IDATA status = TM_ERROR_EBUSY;
+    hythread_t self = tm_self_tls;
+
+    assert(!hythread_is_suspend_enabled());
+
+    if (tm_properties != NULL) {
+        if (!tm_properties->adaptive_spin) {
+            return hythread_thin_monitor_try_enter(lockword_ptr);
+        }
+        if (tm_properties->spin_limit >= SPIN_LIMIT_MIN) {
+            max_limit = tm_properties->spin_limit;
+        }
+    }
+    if (limit == 0) {
+        limit = SPIN_LIMIT_INITIAL;
     }
+    if (limit > max_limit) {
+        limit = max_limit;
+    }
+
+    while (pauses < limit) {
+        lockword = *lockword_ptr;
+        if (IS_FAT_LOCK(lockword) || self->request) {
+            break;
+        }
+        if (THREAD_ID(lockword) == 0
+#ifdef LOCK_RESERVATION
+            || IS_RESERVED(lockword)
 #endif
-    return TM_ERROR_EBUSY;
+            ) {
+            status = hythread_thin_monitor_try_enter(lockword_ptr);
+            if (status != TM_ERROR_EBUSY) {
+                break;
+            }
+        }
+        for (i = 0; i < backoff; i++) {
+            port_pause();
+        }
+        pauses += backoff;
+        if (backoff < SPIN_BACKOFF_MAX) {
+            backoff <<= 1;
+        }
+    }
+
+    thin_monitor_stats.spins++;
+    thin_monitor_stats.spin_pauses += pauses;
+    if (status == TM_ERROR_NONE) {
+        thin_monitor_stats.spin_acquires++;
+        // let the next contender spin twice as long as this one needed
+        if (pauses * 2 > limit) {
+            limit = pauses * 2 < max_limit ? pauses * 2 : max_limit;
+        }
+        spin_limits[slot] = limit;
+    } else if (status == TM_ERROR_EBUSY && pauses >= limit) {
+        // the lock is held for long, don't waste the processor on it
+        spin_limits[slot] = limit / 2 > SPIN_LIMIT_MIN ? limit / 2 : SPIN_LIMIT_MIN;
+    }
+    return status;
+}
+
+/**
+ * Yields the processor while waiting for a thin monitor to be released.
+ */
+void VMCALL hythread_thin_monitor_yield() {
+    thin_monitor_stats.yields++;
+    hythread_yield();
+}
+
+/**
+ * Fills in the thin monitor contention counters.
+ *
+ * @param[out] stats counters collected since the start
+ */
+void VMCALL hythread_thin_monitor_get_stats(hythread_thin_monitor_stats_t *stats) {
+    assert(stats);
+    *stats = thin_monitor_stats;
 }
 
 
@@ -417,6 +513,11 @@ IDATA hythread_thin_monitor_enter(hythread_thin_monitor_t *lockword_ptr) {
         return TM_ERROR_NONE;
     }
 
+    status = hythread_thin_monitor_spin_enter(lockword_ptr);
+    if (status != TM_ERROR_EBUSY) {
+        return status;
+    }
+
     while (hythread_thin_monitor_try_enter(lockword_ptr) == TM_ERROR_EBUSY) {
         if (IS_FAT_LOCK(*lockword_ptr)) {
             fat_monitor = locktable_get_fat_monitor(FAT_LOCK_ID(*lockword_ptr)); //  find fat_monitor in lock table
@@ -427,7 +528,7 @@ IDATA hythread_thin_monitor_enter(hythread_thin_monitor_t *lockword_ptr) {
             return status; // lock fat_monitor
         } 
         //hythread_safe_point();
-        hythread_yield();
+        hythread_thin_monitor_yield();
     }
     if (IS_FAT_LOCK(*lockword_ptr)) {
         // lock already inflated
@@ -685,6 +786,7 @@ hythread_monitor_t VMCALL hythread_inflate_lock(hythread_thin_monitor_t *lockwor
     if (status != TM_ERROR_NONE) {
         return NULL;
     } 
+    thin_monitor_stats.inflations++;
     status = hythread_monitor_enter(fat_monitor);
     if (status != TM_ERROR_NONE) {
         return NULL;
@@ -1176,6 +1176,13 @@ public:
         return (size_t)((char*)(&dummy->m_depth));
     }
 
+    /** Gets offset of m_id field in struct Class.
+     * @note Interface vtable helper uses returned offset.*/
+    static size_t get_offset_of_id() {
+        Class* dummy=NULL;
+        return (size_t)((char*)(&dummy->m_id));
+    }
+
     /** Gets offset of m_is_suitable_for_fast_instanceof field in struct Class.
      * @note Instanceof helper uses returned offset.*/
     static size_t get_offset_of_fast_instanceof_flag() {
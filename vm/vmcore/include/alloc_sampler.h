@@ -0,0 +1,38 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _ALLOC_SAMPLER_H_
+#define _ALLOC_SAMPLER_H_
+
+#include <stdio.h>
+
+/**
+ * The maximum number of frames kept for an allocation site,
+ * the innermost ones.
+ */
+#define ALLOC_SAMPLE_MAX_FRAMES 8
+
+/**
+ * Prints the allocation sites sampled by GC (<code>gc.alloc_sample_interval</code>),
+ * the sites which allocate the most bytes first. Prints nothing if no
+ * allocation has been sampled.
+ *
+ * @param out - the stream to print to
+ */
+void alloc_sampler_print(FILE* out);
+
+#endif // _ALLOC_SAMPLER_H_
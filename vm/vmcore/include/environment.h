@@ -99,6 +99,7 @@ struct Global_Env {
     Lock_Manager *p_handle_lock;
     Lock_Manager *p_dclist_lock;
     Lock_Manager *p_suspend_lock;
+    Lock_Manager *p_inline_cache_lock;
 
     /**
      * If set to true, DLRVM will store JARs which are adjacent in boot class path
@@ -113,6 +114,29 @@ struct Global_Env {
      */
     bool map_bootsrtap_jars;
 
+    /**
+     * If set to true, JITs get inline caches for <code>invokeinterface</code>
+     * call sites, see inline_cache.h.
+     */
+    bool use_inline_caches;
+
+    /**
+     * If set to true, the state of every inline cache is printed at shutdown.
+     */
+    bool print_inline_caches;
+
+    /**
+     * If set to true, the thin monitor contention counters are printed
+     * at shutdown.
+     */
+    bool print_lock_stats;
+
+    /**
+     * The GC threads enumerate the thread stacks if there are at least
+     * this many threads to enumerate, zero turns it off.
+     */
+    unsigned parallel_enumeration_threshold;
+
     /**
      * If set to true by the <code>-compact_fields</code> command-line option,
      * the VM will not pad out fields of less than 32 bits to four bytes.
@@ -145,8 +169,18 @@ struct Global_Env {
 
     U_8* heap_end;
 
+    /**
+     * Base and shift of compressed references, a compressed reference
+     * <code>ref</code> points to <code>compressed_base + (ref << compressed_shift)</code>.
+     * The base is <code>NULL</code> if the heap is reserved low enough,
+     * otherwise it's usually <code>heap_base</code>.
+     */
+
+    U_8* compressed_base;
+    unsigned compressed_shift;
+
     /** 
-     * This will be set to either <code>NULL</code> or <code>heap_base</code> depending
+     * This will be set to either <code>NULL</code> or <code>compressed_base</code> depending
      * on whether compressed references are used.
      */
 
@@ -0,0 +1,117 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef _INLINE_CACHE_H_
+#define _INLINE_CACHE_H_
+
+#include "open/types.h"
+#include "object_layout.h"
+
+class Class;
+class ClassLoader;
+struct Method;
+
+/**
+ * The number of receiver types a polymorphic inline cache remembers
+ * before the call site goes megamorphic.
+ */
+#define INLINE_CACHE_POLY_ENTRIES 4
+
+/**
+ * The state of an inline cache. It only moves forward:
+ * unlinked -> monomorphic -> polymorphic -> megamorphic.
+ */
+enum Inline_Cache_State {
+    IC_UNLINKED = 0,
+    IC_MONOMORPHIC,
+    IC_POLYMORPHIC,
+    IC_MEGAMORPHIC
+};
+
+/**
+ * One receiver type of an inline cache. <code>vtable</code> is the vtable
+ * word as it is stored in the object, i.e. an offset from the vtable base
+ * if vtables are compressed.
+ */
+struct Inline_Cache_Entry {
+    volatile POINTER_SIZE_INT vtable;
+    void* intfc_vtable;
+};
+
+/**
+ * The inline cache of an <code>invokeinterface</code> call site.
+ *
+ * The call site compares the vtable word of the receiver with
+ * <code>mono.vtable</code> and takes <code>mono.intfc_vtable</code> if they
+ * match, so the layout of <code>mono</code> is known to the JITs. Otherwise
+ * the <code>VM_RT_GET_INTERFACE_VTABLE_IC</code> helper looks up the
+ * polymorphic entries and, if there is no match, searches the interface
+ * table and remembers the result while the cache is not megamorphic.
+ *
+ * The entries are never rewritten once published: the interface vtable
+ * is written before the vtable word, so a reader which matched the
+ * vtable word always sees its interface vtable. Updates are serialized by
+ * <code>p_inline_cache_lock</code>. Entries are only cleared when a class
+ * loader is unloaded, which happens while the world is stopped.
+ */
+struct Inline_Cache {
+    Inline_Cache_Entry mono;
+    Inline_Cache_Entry poly[INLINE_CACHE_POLY_ENTRIES];
+    volatile U_32 num_poly;
+    volatile U_32 state;
+
+    Class* intfc;
+    Method* caller;
+
+    // statistics, updated without synchronization
+    U_32 num_misses;         // calls which didn't match the monomorphic entry
+    U_32 num_poly_hits;      // misses served by the polymorphic entries
+    U_32 num_searches;       // misses which searched the interface table
+
+    Inline_Cache* next;
+};
+
+/**
+ * Creates an inline cache for a call site of <code>intfc</code> methods
+ * compiled as a part of <code>caller</code>. The cache is allocated in the
+ * class loader of the caller and lives as long as its code.
+ *
+ * @return The new cache or <code>NULL</code> if inline caches are disabled.
+ */
+Inline_Cache* inline_cache_create(Method* caller, Class* intfc);
+
+/**
+ * The miss path of the inline cache helper.
+ *
+ * @return The interface vtable of <code>intfc</code> for the class of
+ *         <code>obj</code>, or <code>NULL</code> if the class doesn't
+ *         implement it.
+ */
+void* inline_cache_miss(ManagedObject* obj, Inline_Cache* ic);
+
+/**
+ * Forgets the caches of the methods of the unloaded class loader and
+ * clears the entries for its classes from the other caches.
+ * Must be called while the world is stopped.
+ */
+void inline_cache_class_loader_unloading(ClassLoader* cl);
+
+/**
+ * Prints the state and counters of every inline cache.
+ */
+void inline_cache_print_stats();
+
+#endif // _INLINE_CACHE_H_
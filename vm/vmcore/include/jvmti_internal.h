@@ -416,6 +416,10 @@ void jvmti_remove_single_step_breakpoints(DebugUtilsTI *ti, jvmti_thread_t jvmti
 // NCAI extension
 jvmtiError JNICALL jvmtiGetNCAIEnvironment(jvmtiEnv* jvmti_env, ...);
 
+// Heap dump and class histogram extensions
+jvmtiError JNICALL jvmtiDumpHeap(jvmtiEnv* jvmti_env, ...);
+jvmtiError JNICALL jvmtiPrintClassHistogram(jvmtiEnv* jvmti_env, ...);
+
 // Object check functions
 Boolean is_valid_throwable_object(jthread thread);
 Boolean is_valid_thread_object(jthread thread);
@@ -82,7 +82,7 @@ typedef U_32          COMPRESSED_REFERENCE;
 
 #define REFS_IS_COMPRESSED_MODE 1
 #define REF_SIZE (sizeof(U_32))
-#define REF_MANAGED_NULL VM_Global_State::loader_env->heap_base
+#define REF_MANAGED_NULL VM_Global_State::loader_env->compressed_base
 #define REF_INIT_BY_ADDR(_ref_addr_, _val_)                                 \
     *((COMPRESSED_REFERENCE*)(_ref_addr_)) = (COMPRESSED_REFERENCE)(_val_)
 
@@ -103,7 +103,7 @@ typedef U_32          COMPRESSED_REFERENCE;
                     sizeof(ManagedObject *))
 #define REF_MANAGED_NULL                                                    \
     (VM_Global_State::loader_env->compress_references ?                     \
-            VM_Global_State::loader_env->heap_base : NULL)
+            VM_Global_State::loader_env->compressed_base : NULL)
 #define REF_INIT_BY_ADDR(_ref_addr_, _val_)                                 \
     if (VM_Global_State::loader_env->compress_references) {                 \
         *((COMPRESSED_REFERENCE*)(_ref_addr_)) =                            \
@@ -142,7 +142,8 @@ inline ManagedObject *get_raw_reference_pointer(ManagedObject **slot_addr)
     COMPRESSED_REFERENCE offset = *((COMPRESSED_REFERENCE *)slot_addr);
     assert(is_compressed_reference(offset));
     if (offset != 0) {
-        return (ManagedObject*)((POINTER_SIZE_INT)vm_get_heap_base_address() + offset);
+        return (ManagedObject*)((POINTER_SIZE_INT)vm_get_heap_compressed_base_address()
+            + ((POINTER_SIZE_INT)offset << vm_get_heap_compressed_shift()));
     }
 
     return NULL;
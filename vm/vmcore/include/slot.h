@@ -53,18 +53,21 @@ private:
         void *value;
     } content;
 
+    // base and shift of compressed references, see gc_heap_compressed_base_address()
     static void* heap_base;
     static void* heap_ceiling;
+    static unsigned heap_shift;
 
 public:
     Slot(void *v) {
         set_address(v);
     }
 
-    static void init(void* base, void* ceiling)
+    static void init(void* base, void* ceiling, unsigned shift)
     {
         heap_base = base;
         heap_ceiling = ceiling;
+        heap_shift = shift;
     }
 
     // Sets the raw value of the slot.
@@ -81,7 +84,7 @@ public:
         REFS_RUNTIME_SWITCH_IF
 #ifdef REFS_RUNTIME_OR_COMPRESSED
             assert(content.compressed != NULL);
-            return (void*)((UDATA)*content.compressed + (UDATA)heap_base);
+            return (void*)(((UDATA)*content.compressed << heap_shift) + (UDATA)heap_base);
 #endif // REFS_RUNTIME_OR_COMPRESSED
         REFS_RUNTIME_SWITCH_ELSE
 #ifdef REFS_RUNTIME_OR_UNCOMPRESSED
@@ -96,7 +99,7 @@ public:
         REFS_RUNTIME_SWITCH_IF
 #ifdef REFS_RUNTIME_OR_COMPRESSED
             if (obj != NULL) {
-                *content.compressed = (U_32) ((UDATA)obj - (UDATA)heap_base);
+                *content.compressed = (U_32) (((UDATA)obj - (UDATA)heap_base) >> heap_shift);
             } else {
                 *content.compressed = 0;
             }
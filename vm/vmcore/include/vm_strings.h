@@ -78,6 +78,11 @@ void string_get_unicode_region(ManagedObject* str, unsigned offset, unsigned cou
 // Encode characters offset..offset+count-1 into UTF8 and place in res
 void string_get_utf8_region(ManagedObject* str, unsigned offset, unsigned count, char* res);
 
+// GC must be disabled
+// Returns the char array holding the characters, and the index of the first character in offset.
+// Returns NULL if the string is compressed, i.e., kept in a byte array
+Vector_Handle string_get_char_array(ManagedObject* str, unsigned* offset);
+
 //*** Handle versions
 
 ObjectHandle string_create_from_utf8_h(const char* buf, unsigned length);
@@ -30,16 +30,31 @@ typedef struct {
     Class* intfc_class;      // id of interface
 } Intfc_Table_Entry;
 
+/**
+ * The interface table of a class.
+ *
+ * Besides the list of the implemented interfaces, the table has an
+ * open addressing hash of them keyed by the interface id, so that the
+ * dispatch doesn't depend on the number of interfaces. The hash has at
+ * least twice as many slots as there are entries, so a probe sequence
+ * always ends with an empty slot.
+ */
 typedef struct Intfc_Table {
-#ifdef POINTER64
-    // see INTFC_TABLE_OVERHEAD
-    U_32 dummy;   // padding
-#endif
+    Intfc_Table_Entry* hash;    // the hash slots; the empty ones have no class
+    U_32 hash_mask;             // the number of slots minus one
     U_32 n_entries;
     Intfc_Table_Entry entry[1];
 } Intfc_Table;
 
-#define INTFC_TABLE_OVERHEAD    (sizeof(void*))
+#define INTFC_TABLE_OVERHEAD    (sizeof(Intfc_Table) - sizeof(Intfc_Table_Entry))
+
+/**
+ * @return The first hash slot of an interface with the given id.
+ */
+inline unsigned intfc_table_hash(unsigned intfc_id, U_32 hash_mask)
+{
+    return intfc_id & hash_mask;
+}
 
 #ifdef POINTER64
 #define OBJECT_HEADER_SIZE 0
@@ -1691,6 +1691,18 @@ void *vm_get_heap_ceiling_address()
 } //vm_get_heap_ceiling_address
 
 
+void *vm_get_heap_compressed_base_address()
+{
+    return (void *)VM_Global_State::loader_env->compressed_base;
+} //vm_get_heap_compressed_base_address
+
+
+U_32 vm_get_heap_compressed_shift()
+{
+    return VM_Global_State::loader_env->compressed_shift;
+} //vm_get_heap_compressed_shift
+
+
 BOOLEAN vm_is_vtable_compressed()
 {
     return ManagedObject::are_vtable_pointers_compressed();
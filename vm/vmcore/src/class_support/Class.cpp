@@ -493,8 +493,8 @@ void* Class::helper_get_interface_vtable(ManagedObject* obj, Class* iid)
 {
     VTable* vt = obj->vt();
     Intfc_Table* intfTable  = vt->intfc_table;
-    unsigned num_intfc = intfTable->n_entries;
 #ifdef VM_STATS
+    unsigned num_intfc = intfTable->n_entries;
     UNSAFE_REGION_START
     VM_Statistics::get_vm_stats().num_invokeinterface_calls++;
     switch(num_intfc) {
@@ -506,8 +506,11 @@ void* Class::helper_get_interface_vtable(ManagedObject* obj, Class* iid)
         VM_Statistics::get_vm_stats().invokeinterface_calls_size_max = num_intfc;
     UNSAFE_REGION_END
 #endif
-    for(unsigned i = 0; i < num_intfc; i++) {
-        const Intfc_Table_Entry& intfEntry = intfTable->entry[i];
+    // the number of probes is counted as the search depth
+    unsigned i = 0;
+    unsigned slot = intfc_table_hash(iid->get_id(), intfTable->hash_mask);
+    for(; intfTable->hash[slot].intfc_class != NULL; i++) {
+        const Intfc_Table_Entry& intfEntry = intfTable->hash[slot];
         Class* intfc = intfEntry.intfc_class;
         if(intfc == iid) {
 #ifdef VM_STATS
@@ -524,6 +527,7 @@ void* Class::helper_get_interface_vtable(ManagedObject* obj, Class* iid)
             unsigned char** table = intfEntry.table;
             return (void*)table;
         }
+        slot = (slot + 1) & intfTable->hash_mask;
     }
     return NULL;
 }
@@ -958,10 +962,10 @@ String* class_name_get_java_name(const String* class_name) {
 #ifndef REFS_USE_UNCOMPRESSED
 bool is_compressed_reference(COMPRESSED_REFERENCE compressed_ref) 
 {
-    // A compressed reference is an offset into the heap.
+    // A compressed reference is a shifted offset from the compressed base.
     uint64 heap_max_size = (VM_Global_State::loader_env->heap_end
-        - VM_Global_State::loader_env->heap_base);
-    return ((uint64) compressed_ref) < heap_max_size;
+        - VM_Global_State::loader_env->compressed_base);
+    return (((uint64) compressed_ref) << VM_Global_State::loader_env->compressed_shift) < heap_max_size;
 } // is_compressed_reference
 
 
@@ -974,8 +978,9 @@ COMPRESSED_REFERENCE compress_reference(ManagedObject *obj) {
      if(obj == NULL)
          compressed_ref = 0;
      else
-         compressed_ref = (COMPRESSED_REFERENCE)((POINTER_SIZE_INT)obj
-            - (POINTER_SIZE_INT)VM_Global_State::loader_env->heap_base);
+         compressed_ref = (COMPRESSED_REFERENCE)(((POINTER_SIZE_INT)obj
+            - (POINTER_SIZE_INT)VM_Global_State::loader_env->compressed_base)
+            >> VM_Global_State::loader_env->compressed_shift);
     assert(is_compressed_reference(compressed_ref));
     return compressed_ref;
 } //compress_reference
@@ -990,7 +995,8 @@ ManagedObject *uncompress_compressed_reference(COMPRESSED_REFERENCE compressed_r
     if (compressed_ref == 0) {
         return NULL;
     } else {
-        return (ManagedObject *)(VM_Global_State::loader_env->heap_base + compressed_ref);
+        return (ManagedObject *)(VM_Global_State::loader_env->compressed_base
+            + ((POINTER_SIZE_INT)compressed_ref << VM_Global_State::loader_env->compressed_shift));
     }
 } //uncompress_compressed_reference
 #endif // REFS_USE_UNCOMPRESSED
@@ -65,6 +65,8 @@ ready_for_exceptions(false)
     sort_fields = false;
 #endif // !IPF_
     heap_base = heap_end = managed_null = NULL;
+    compressed_base = NULL;
+    compressed_shift = 0;
 
     JavaLangString_String = string_pool.lookup("java/lang/String");
     JavaLangStringBuffer_String = string_pool.lookup("java/lang/StringBuffer");
@@ -155,6 +157,7 @@ ready_for_exceptions(false)
     p_method_call_lock = new Lock_Manager();
     p_dclist_lock = new Lock_Manager();
     p_suspend_lock = new Lock_Manager();
+    p_inline_cache_lock = new Lock_Manager();
 
     //
     // preloaded classes
@@ -256,6 +259,7 @@ Global_Env::~Global_Env()
     delete p_method_call_lock;
     delete p_dclist_lock;
     delete p_suspend_lock;
+    delete p_inline_cache_lock;
 
     // Unload jit instances.
     vm_delete_all_jits();
@@ -321,6 +325,13 @@ static size_t parse_size_prop(const char* name, size_t default_size) {
 void Global_Env::init_pools() {
     size_t pool_size;
 
+    // large pages are transparent huge pages on Linux, the pools are aligned to them
+    size_t *ps = port_vmem_page_sizes();
+    if (ps[1] != 0 && use_large_pages) {
+        system_page_size = ps[1];
+        TRACE2("init", "code and vtable pools use " << (ps[1] >> 10) << "KB pages");
+    }
+
     pool_size = parse_size_prop("vm.code_pool_size.stubs", DEFAULT_JIT_CODE_POOL_SIZE);
     assert(pool_size);
     GlobalCodeMemoryManager = new PoolManager(pool_size, use_large_pages,
@@ -505,13 +505,33 @@ public:
 //
 Intfc_Table *create_intfc_table(Class* clss, unsigned n_entries)
 {
-    unsigned size = INTFC_TABLE_OVERHEAD + (n_entries * sizeof(Intfc_Table_Entry));
+    // keep the hash at most half full
+    unsigned n_slots = 1;
+    while(n_slots < 2 * n_entries) {
+        n_slots <<= 1;
+    }
+    unsigned size = INTFC_TABLE_OVERHEAD + ((n_entries + n_slots) * sizeof(Intfc_Table_Entry));
     Intfc_Table *table = (Intfc_Table*) clss->get_class_loader()->Alloc(size);
     memset(table,0,size);
     table->n_entries = n_entries;
+    table->hash = &table->entry[n_entries];
+    table->hash_mask = n_slots - 1;
     return table;
 }
 
+//
+// intfc_table_add_to_hash
+//
+static void intfc_table_add_to_hash(Intfc_Table* table, const Intfc_Table_Entry& entry)
+{
+    unsigned slot = intfc_table_hash(entry.intfc_class->get_id(), table->hash_mask);
+    while(table->hash[slot].intfc_class != NULL) {
+        assert(table->hash[slot].intfc_class != entry.intfc_class);
+        slot = (slot + 1) & table->hash_mask;
+    }
+    table->hash[slot] = entry;
+}
+
 
 static void build_interface_table_descriptors(Class* cls, std::vector<Class*>& result, int depth)
 {
@@ -1086,6 +1106,7 @@ Intfc_Table* Class::create_and_populate_interface_table(const std::vector<Class*
                 // Don't count static initializers of interfaces.
                 vtable_offset--;
             }
+            intfc_table_add_to_hash(intfc_table, intfc_table->entry[i]);
         }
         // Set the vtable entries to point to the code address.
         unsigned meth_idx = m_num_virtual_method_entries;
@@ -55,6 +55,7 @@
 #include "jarfile_util.h"
 #include "jni_utils.h"
 #include "mem_alloc.h"
+#include "inline_cache.h"
 
 #include "port_sysencoding.h"
 
@@ -606,6 +607,7 @@ void ClassLoader::StartUnloading()
     // iterate in reverse order to unload child loaders first
     for (it = unloadinglist.rbegin(); it != unloadinglist.rend(); it++)
     {
+        inline_cache_class_loader_unloading(*it);
         UnloadClassLoader(*it);
     }
     
@@ -758,7 +758,7 @@ NativeCodePtr exn_get_rth_throw()
         cs = lil_parse_onto_end(cs,
             "jc i0=%0i:ref,%n;"
             "o0=i0;" "j %o;" ":%g;" "o0=0:ref;" ":%g;",
-            VM_Global_State::loader_env->heap_base);
+            VM_Global_State::loader_env->managed_null);
 #endif // REFS_RUNTIME_OR_COMPRESSED
     REFS_RUNTIME_SWITCH_ELSE
 #ifdef REFS_RUNTIME_OR_UNCOMPRESSED
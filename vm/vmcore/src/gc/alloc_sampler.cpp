@@ -0,0 +1,199 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Allocation sampling. GC picks an allocation about every
+ * gc.alloc_sample_interval bytes a thread allocates and reports it with
+ * vm_sample_allocation(). The sample is charged to its allocation site,
+ * that is the class of the object and the innermost frames of the stack,
+ * with the bytes allocated since the previous sample of the thread, so the
+ * bytes of a site estimate what the site has allocated. The sites are
+ * printed on the data dump request (SIGQUIT or Ctrl+Break).
+ */
+
+#define LOG_DOMAIN "vm.core"
+#include "cxxlog.h"
+
+#include <stdlib.h>
+#include "open/vm_gc.h"
+#include "port_malloc.h"
+#include "alloc_sampler.h"
+#include "lock_manager.h"
+#include "class_member.h"
+#include "object_layout.h"
+#include "vtable.h"
+#include "vm_threads.h"
+#include "stack_trace.h"
+
+#define ALLOC_SITES_TABLE_SIZE 1024
+#define ALLOC_SITES_PRINT_MAX 64
+
+struct Alloc_Site {
+    Alloc_Site* next;
+    Class* clss;
+    unsigned depth;
+    StackTraceFrame frames[ALLOC_SAMPLE_MAX_FRAMES];
+    uint64 num_samples;
+    uint64 sampled_size;    // the sizes of the sampled objects
+    uint64 estimated_size;  // the bytes allocated by the site, estimated
+};
+
+static Alloc_Site* alloc_sites[ALLOC_SITES_TABLE_SIZE];
+static unsigned num_alloc_sites = 0;
+static Lock_Manager alloc_sites_lock;
+
+static unsigned alloc_site_hash(Class* clss, StackTraceFrame* frames, unsigned depth)
+{
+    POINTER_SIZE_INT hash = (POINTER_SIZE_INT)clss;
+    for (unsigned i = 0; i < depth; i++) {
+        hash = hash * 31 + (POINTER_SIZE_INT)frames[i].method;
+        hash = hash * 31 + (POINTER_SIZE_INT)frames[i].ip;
+    }
+    return (unsigned)((hash ^ (hash >> 16)) % ALLOC_SITES_TABLE_SIZE);
+}
+
+static bool alloc_site_matches(Alloc_Site* site, Class* clss,
+                               StackTraceFrame* frames, unsigned depth)
+{
+    if (site->clss != clss || site->depth != depth)
+        return false;
+    for (unsigned i = 0; i < depth; i++) {
+        if (site->frames[i].method != frames[i].method
+            || site->frames[i].ip != frames[i].ip
+            || site->frames[i].depth != frames[i].depth)
+            return false;
+    }
+    return true;
+}
+
+void vm_sample_allocation(Managed_Object_Handle p_obj, unsigned size, size_t sampled_bytes)
+{
+    Class* clss = ((ManagedObject*)p_obj)->vt()->clss;
+
+    unsigned depth = 0;
+    StackTraceFrame* frames = NULL;
+    VM_thread* p_thread = get_thread_ptr();
+    // allocations of the threads which are not attached are charged to the class only
+    if (p_thread != NULL)
+        st_get_trace(p_thread, &depth, &frames);
+    if (frames == NULL)
+        depth = 0;
+    if (depth > ALLOC_SAMPLE_MAX_FRAMES)
+        depth = ALLOC_SAMPLE_MAX_FRAMES;
+    for (unsigned i = 0; i < depth; i++)
+        frames[i].outdated_this = NULL;
+
+    unsigned index = alloc_site_hash(clss, frames, depth);
+
+    LMAutoUnlock aulock(&alloc_sites_lock);
+
+    Alloc_Site* site = alloc_sites[index];
+    while (site != NULL && !alloc_site_matches(site, clss, frames, depth))
+        site = site->next;
+
+    if (site == NULL) {
+        site = (Alloc_Site*)STD_MALLOC(sizeof(Alloc_Site));
+        if (site == NULL) {
+            aulock.ForceUnlock();
+            if (frames != NULL) STD_FREE(frames);
+            return;
+        }
+        memset(site, 0, sizeof(Alloc_Site));
+        site->clss = clss;
+        site->depth = depth;
+        for (unsigned i = 0; i < depth; i++)
+            site->frames[i] = frames[i];
+        site->next = alloc_sites[index];
+        alloc_sites[index] = site;
+        num_alloc_sites++;
+    }
+
+    site->num_samples++;
+    site->sampled_size += size;
+    site->estimated_size += sampled_bytes;
+
+    aulock.ForceUnlock();
+    if (frames != NULL)
+        STD_FREE(frames);
+}
+
+static int compare_alloc_sites(const void* a, const void* b)
+{
+    uint64 size_a = (*(Alloc_Site**)a)->estimated_size;
+    uint64 size_b = (*(Alloc_Site**)b)->estimated_size;
+    if (size_a == size_b) return 0;
+    return size_a > size_b ? -1 : 1;
+}
+
+static void alloc_site_print(FILE* out, Alloc_Site* site)
+{
+    fprintf(out, "%" FMT64 "u bytes (%" FMT64 "u samples, %" FMT64 "u sampled bytes) of %s\n",
+        site->estimated_size, site->num_samples, site->sampled_size,
+        site->clss->get_name()->bytes);
+
+    for (unsigned i = 0; i < site->depth; i++) {
+        StackTraceFrame* stf = &site->frames[i];
+        fprintf(out, "\tat %s.%s%s", stf->method->get_class()->get_name()->bytes,
+            stf->method->get_name()->bytes, stf->method->get_descriptor()->bytes);
+
+        const char* file;
+        int line;
+        get_file_and_line(stf->method, stf->ip, false, stf->depth, &file, &line);
+        if (line == -2)
+            fprintf(out, " (Native Method)");
+        else if (file) {
+            if (line == -1)
+                fprintf(out, " (%s)", file);
+            else
+                fprintf(out, " (%s:%d)", file, line);
+        }
+        fprintf(out, "\n");
+    }
+}
+
+void alloc_sampler_print(FILE* out)
+{
+    LMAutoUnlock aulock(&alloc_sites_lock);
+
+    if (num_alloc_sites == 0)
+        return;
+
+    Alloc_Site** sites = (Alloc_Site**)STD_MALLOC(num_alloc_sites * sizeof(Alloc_Site*));
+    if (sites == NULL)
+        return;
+
+    unsigned num_sites = 0;
+    uint64 total_size = 0;
+    for (unsigned i = 0; i < ALLOC_SITES_TABLE_SIZE; i++) {
+        for (Alloc_Site* site = alloc_sites[i]; site != NULL; site = site->next) {
+            sites[num_sites++] = site;
+            total_size += site->estimated_size;
+        }
+    }
+    assert(num_sites == num_alloc_sites);
+    qsort(sites, num_sites, sizeof(Alloc_Site*), compare_alloc_sites);
+
+    fprintf(out, "\nAllocation sites: %u, estimated allocation: %" FMT64 "u bytes\n",
+        num_sites, total_size);
+    for (unsigned i = 0; i < num_sites && i < ALLOC_SITES_PRINT_MAX; i++) {
+        fprintf(out, "\n");
+        alloc_site_print(out, sites[i]);
+    }
+    fflush(out);
+
+    STD_FREE(sites);
+}
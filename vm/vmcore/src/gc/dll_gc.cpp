@@ -58,6 +58,8 @@ static void default_gc_add_root_set_entry_managed_pointer(void **slot,
                                                           Boolean is_pinned);
 static void *default_gc_heap_base_address();
 static void *default_gc_heap_ceiling_address();
+static void *default_gc_heap_compressed_base_address();
+static U_32 default_gc_heap_compressed_shift();
 static void default_gc_test_safepoint();
 /* $$$ GMJ static I_32 default_gc_get_hashcode(Managed_Object_Handle); */
 
@@ -66,6 +68,10 @@ static void default_gc_add_weak_root_set_entry(
         Managed_Object_Handle*, Boolean, Boolean);
 
 static Boolean default_gc_supports_class_unloading();
+static Boolean default_gc_enumerate_thread_stacks_in_parallel(unsigned int num_threads);
+static Boolean default_gc_dump_heap(const char* file_name);
+static Boolean default_gc_print_class_histogram(const char* file_name);
+static void default_gc_notify_data_dump_request();
 
 Boolean (*gc_supports_compressed_references)() = 0;
 void (*gc_add_root_set_entry)(Managed_Object_Handle *ref, Boolean is_pinned) = 0;
@@ -112,6 +118,8 @@ int64  (*gc_total_memory)()                  = 0;
 int64  (*gc_max_memory)()                    = 0;
 void * (*gc_heap_base_address)()             = 0;
 void * (*gc_heap_ceiling_address)()          = 0;
+void * (*gc_heap_compressed_base_address)()  = 0;
+U_32   (*gc_heap_compressed_shift)()         = 0;
 void   (*gc_test_safepoint)()                = 0;
 
 void (*gc_wrapup)() = default_gc_wrapup;
@@ -130,6 +138,10 @@ void (*gc_set_mutator_block_flag)() = 0;
 Boolean (*gc_clear_mutator_block_flag)() = 0;
 
 Boolean (*gc_supports_class_unloading)() = 0;
+Boolean (*gc_enumerate_thread_stacks_in_parallel)(unsigned int num_threads) = 0;
+Boolean (*gc_dump_heap)(const char* file_name) = 0;
+Boolean (*gc_print_class_histogram)(const char* file_name) = 0;
+void (*gc_notify_data_dump_request)() = 0;
 
 static apr_dso_handle_sym_t getFunction(apr_dso_handle_t *handle, const char *name, const char *dllName)
 {
@@ -307,6 +319,16 @@ void vm_add_gc(const char *dllName)
                             "gc_heap_ceiling_address", 
                             dllName, 
                             (apr_dso_handle_sym_t)default_gc_heap_ceiling_address);
+    gc_heap_compressed_base_address = (void * (*)()) 
+        getFunctionOptional(handle, 
+                            "gc_heap_compressed_base_address", 
+                            dllName, 
+                            (apr_dso_handle_sym_t)default_gc_heap_compressed_base_address);
+    gc_heap_compressed_shift = (U_32 (*)()) 
+        getFunctionOptional(handle, 
+                            "gc_heap_compressed_shift", 
+                            dllName, 
+                            (apr_dso_handle_sym_t)default_gc_heap_compressed_shift);
     gc_supports_frontier_allocation = (Boolean (*)(unsigned *offset_of_current, unsigned *offset_of_limit)) 
         getFunctionOptional(handle, 
                             "gc_supports_frontier_allocation", 
@@ -324,6 +346,30 @@ void vm_add_gc(const char *dllName)
                             "gc_supports_class_unloading", 
                             dllName,
                             (apr_dso_handle_sym_t)default_gc_supports_class_unloading);     
+
+    gc_enumerate_thread_stacks_in_parallel = (Boolean (*)(unsigned int))
+        getFunctionOptional(handle,
+                            "gc_enumerate_thread_stacks_in_parallel",
+                            dllName,
+                            (apr_dso_handle_sym_t)default_gc_enumerate_thread_stacks_in_parallel);
+
+    gc_dump_heap = (Boolean (*)(const char*))
+        getFunctionOptional(handle,
+                            "gc_dump_heap",
+                            dllName,
+                            (apr_dso_handle_sym_t)default_gc_dump_heap);
+
+    gc_print_class_histogram = (Boolean (*)(const char*))
+        getFunctionOptional(handle,
+                            "gc_print_class_histogram",
+                            dllName,
+                            (apr_dso_handle_sym_t)default_gc_print_class_histogram);
+
+    gc_notify_data_dump_request = (void (*)())
+        getFunctionOptional(handle,
+                            "gc_notify_data_dump_request",
+                            dllName,
+                            (apr_dso_handle_sym_t)default_gc_notify_data_dump_request);
 } //vm_add_gc
 
 
@@ -476,6 +522,19 @@ static void *default_gc_heap_ceiling_address()
 } //default_gc_heap_ceiling_address
 
 
+// GCs that don't know about shifted references use the heap base as is
+static void *default_gc_heap_compressed_base_address()
+{
+    return gc_heap_base_address();
+} //default_gc_heap_compressed_base_address
+
+
+static U_32 default_gc_heap_compressed_shift()
+{
+    return 0;
+} //default_gc_heap_compressed_shift
+
+
 static void default_gc_test_safepoint()
 {
     // Do nothing.
@@ -558,4 +617,23 @@ static Boolean default_gc_supports_class_unloading()
 {
     return TRUE;
 } //default_gc_supports_class_unloading
+
+static Boolean default_gc_enumerate_thread_stacks_in_parallel(unsigned int UNREF num_threads)
+{
+    return FALSE;
+} //default_gc_enumerate_thread_stacks_in_parallel
+
+static Boolean default_gc_dump_heap(const char* UNREF file_name)
+{
+    return FALSE;
+} //default_gc_dump_heap
+
+static Boolean default_gc_print_class_histogram(const char* UNREF file_name)
+{
+    return FALSE;
+} //default_gc_print_class_histogram
+
+static void default_gc_notify_data_dump_request()
+{
+} //default_gc_notify_data_dump_request
 #endif // !USE_GC_STATIC
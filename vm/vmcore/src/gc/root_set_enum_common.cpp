@@ -148,7 +148,8 @@ void vm_enumerate_static_fields()
 
 
 // 20030405 Note: When compressing references, vm_enumerate_root_reference() expects to be called with slots
-// containing *managed* refs (represented by heap_base if null, not 0/NULL), so those refs must not be NULL. 
+// containing *managed* refs (represented by managed_null if null, not 0/NULL), so those refs must not be NULL
+// unless managed_null is NULL itself, i.e. compressed references are zero-based. 
 #ifdef _DEBUG
 static void check_ref(void** ref)
 {
@@ -157,8 +158,8 @@ static void check_ref(void** ref)
         // 20030324 DEBUG: verify the slot whose reference is being passed.
         ManagedObject **p_obj = (ManagedObject **)ref;  
         ManagedObject* obj = *p_obj;
-        assert(obj != NULL);    // See the comment at the top of the procedure.
-        if ((void *)obj != VM_Global_State::loader_env->heap_base) {
+        assert(obj != NULL || VM_Global_State::loader_env->managed_null == NULL);    // See the comment at the top of the procedure.
+        if ((void *)obj != VM_Global_State::loader_env->managed_null) {
             assert(((POINTER_SIZE_INT)VM_Global_State::loader_env->heap_base <= (POINTER_SIZE_INT)obj)
                 && ((POINTER_SIZE_INT)obj <= (POINTER_SIZE_INT)VM_Global_State::loader_env->heap_end));
         } 
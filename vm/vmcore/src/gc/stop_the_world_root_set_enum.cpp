@@ -17,6 +17,9 @@
 #define LOG_DOMAIN "enumeration"
 #include "cxxlog.h"
 
+#include <vector>
+#include <apr_atomic.h>
+
 #include "vtable.h"
 #include "root_set_enum_internal.h"
 #include "GlobalClassLoaderIterator.h"
@@ -49,6 +52,11 @@ vm_time_end_hook(apr_time_t *start_time, apr_time_t *end_time)
 }
 //////////////////////////////////////////////////////////////////////
 
+// the stopped threads, except the current one, and the index of the next
+// one to enumerate; the GC threads claim them concurrently
+static std::vector<VM_thread*> threads_to_enumerate;
+static volatile apr_uint32_t next_thread_to_enumerate;
+
 
 static void 
 vm_enumerate_the_current_thread(VM_thread * vm_thread)
@@ -110,24 +118,38 @@ stop_the_world_root_set_enumeration()
 
     current_vm_thread = p_TLS_vmthread;
     // Run through list of active threads and enumerate each one of them.
+    threads_to_enumerate.clear();
     hythread_t tm_thread = hythread_iterator_next(&iterator);    
     while (tm_thread) {
         vm_thread_t thread = jthread_get_vm_thread(tm_thread);
         //assert(thread);
         if (thread && thread != current_vm_thread) {
-            vm_enumerate_thread(thread);
-            // Enumeration for this thread is complete.
-            //thread->gc_status = gc_enumeration_done;
-            //assert(thread->gc_status==gc_enumeration_done);
-            //thread->gc_status=gc_enumeration_done;
+            threads_to_enumerate.push_back(thread);
         }
         tm_thread = hythread_iterator_next(&iterator);
     }
 
+    vm_time_start_hook(&_start_time);
+    next_thread_to_enumerate = 0;
+    unsigned num_threads = (unsigned)threads_to_enumerate.size();
+    unsigned threshold = VM_Global_State::loader_env->parallel_enumeration_threshold;
+    bool parallel = threshold != 0 && num_threads >= threshold
+        && gc_enumerate_thread_stacks_in_parallel(num_threads);
+    if (!parallel) {
+        vm_enumerate_thread_stacks();
+    }
+    assert(next_thread_to_enumerate >= num_threads);
+
     vm_enumerate_the_current_thread(current_vm_thread);
+    apr_time_t stacks_time = vm_time_end_hook(&_start_time, &_end_time);
+    INFO2("enumeration", "Thread stacks enumeration time: " << stacks_time << " mksec, "
+        << num_threads + 1 << " threads" << (parallel ? ", in parallel" : ""));
 
     // finally, process all the global refs
+    vm_time_start_hook(&_start_time);
     vm_enumerate_root_set_global_refs();
+    apr_time_t globals_time = vm_time_end_hook(&_start_time, &_end_time);
+    INFO2("enumeration", "Global references enumeration time: " << globals_time << " mksec");
 
     TRACE2("enumeration", "enumeration complete");
 
@@ -136,6 +158,26 @@ stop_the_world_root_set_enumeration()
 
 
 
+void vm_enumerate_thread_stacks()
+{
+    // the stack walk expects the enumerating thread to be gc-unsafe
+    bool suspend_enabled = hythread_is_suspend_enabled() != 0;
+    if (suspend_enabled) {
+        hythread_suspend_disable();
+    }
+
+    apr_uint32_t num_threads = (apr_uint32_t)threads_to_enumerate.size();
+    apr_uint32_t index;
+    while ((index = apr_atomic_inc32(&next_thread_to_enumerate)) < num_threads) {
+        vm_enumerate_thread(threads_to_enumerate[index]);
+    }
+
+    if (suspend_enabled) {
+        hythread_suspend_enable();
+    }
+} // vm_enumerate_thread_stacks
+
+
 // Entry point into root-set-enumeration code.
 
 void 
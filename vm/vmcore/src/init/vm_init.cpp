@@ -64,6 +64,7 @@ VMEXPORT bool dump_stubs = false;
 
 void* Slot::heap_base = NULL;
 void* Slot::heap_ceiling = NULL;
+unsigned Slot::heap_shift = 0;
 
 Class* preload_class(Global_Env * vm_env, const char * classname) {
     String * s = vm_env->string_pool.lookup(classname);
@@ -257,9 +258,14 @@ static jint process_compression_modes(Global_Env * vm_env)
 
     size_t ms = vm_property_get_size("gc.ms", 0, VM_PROPERTIES);
     size_t mx = vm_property_get_size("gc.mx", 0, VM_PROPERTIES);
-    // Currently 4Gb is maximum for compressed mode
-    // If GC cannot allocate heap up to 4Gb, gc_init() will fail
+    // Currently 32Gb is maximum for compressed mode, where references
+    // are shifted by the 8-byte object alignment (4Gb on IPF, unshifted)
+    // If GC cannot allocate heap up to that size, gc_init() will fail
+#ifdef _IPF_
     size_t max_size = ((int64)4096)*1024*1024;
+#else
+    size_t max_size = ((int64)4096)*1024*1024 << 3;
+#endif
 
 #ifdef REFS_USE_COMPRESSED
     if (ms >= max_size || mx >= max_size)
@@ -794,6 +800,9 @@ int vm_init1(JavaVM_Internal * java_vm, JavaVMInitArgs * vm_arguments) {
     }
 
     tm_properties->use_soft_unreservation = vm_property_get_boolean("thread.soft_unreservation", FALSE, VM_PROPERTIES);
+    tm_properties->adaptive_spin = vm_property_get_boolean("thread.adaptive_spin", TRUE, VM_PROPERTIES);
+    tm_properties->spin_limit = vm_property_get_integer("thread.spin_limit", 2048, VM_PROPERTIES);
+    vm_env->print_lock_stats = vm_property_get_boolean("thread.lock_stats.print", FALSE, VM_PROPERTIES);
 
     parse_vm_arguments2(vm_env);
 
@@ -808,6 +817,10 @@ int vm_init1(JavaVM_Internal * java_vm, JavaVMInitArgs * vm_arguments) {
     vm_env->compact_fields = vm_property_get_boolean("vm.compact_fields", vm_env->compact_fields, VM_PROPERTIES);
     vm_env->use_common_jar_cache = vm_property_get_boolean("vm.common_jar_cache", TRUE, VM_PROPERTIES);
     vm_env->map_bootsrtap_jars = vm_property_get_boolean("vm.map_bootstrap_jars", FALSE, VM_PROPERTIES);
+    vm_env->use_inline_caches = vm_property_get_boolean("vm.inline_caches", TRUE, VM_PROPERTIES);
+    vm_env->print_inline_caches = vm_property_get_boolean("vm.inline_caches.print", FALSE, VM_PROPERTIES);
+    vm_env->parallel_enumeration_threshold = vm_property_get_integer("vm.gc.parallel_enumeration_threshold", 16, VM_PROPERTIES);
+    vm_env->use_large_pages = vm_property_get_boolean("vm.use_large_pages", FALSE, VM_PROPERTIES);
 
     vm_env->init_pools();
 
@@ -835,11 +848,14 @@ int vm_init1(JavaVM_Internal * java_vm, JavaVMInitArgs * vm_arguments) {
     if (status != JNI_OK) return status;
 
     // TODO: change all uses of Class::heap_base to Slot::heap_base
-    Slot::init(gc_heap_base_address(), gc_heap_ceiling_address());
+    Slot::init(gc_heap_compressed_base_address(), gc_heap_ceiling_address(),
+        gc_heap_compressed_shift());
 
     // TODO: find another way to initialize the following.
     vm_env->heap_base = (U_8*)gc_heap_base_address();
     vm_env->heap_end  = (U_8*)gc_heap_ceiling_address();
+    vm_env->compressed_base = (U_8*)gc_heap_compressed_base_address();
+    vm_env->compressed_shift = gc_heap_compressed_shift();
     vm_env->managed_null = REF_MANAGED_NULL;
 
     // 20030404 This handshaking protocol isn't quite correct. It doesn't
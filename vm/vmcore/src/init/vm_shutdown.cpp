@@ -24,7 +24,7 @@
 #include <stdlib.h>
 #include <apr_thread_mutex.h>
 
-#include "open/hythread.h"
+#include "open/hythread_ext.h"
 #include "open/gc.h"
 
 #include "jthread.h"
@@ -36,7 +36,9 @@
 #include "nogc.h"
 #include "jni_utils.h"
 #include "vm_stats.h"
+#include "inline_cache.h"
 #include "thread_dump.h"
+#include "alloc_sampler.h"
 #include "interpreter.h"
 #include "finalize.h"
 #include "signals.h"
@@ -201,6 +203,15 @@ static void vm_shutdown_stop_java_threads(Global_Env * vm_env) {
     TRACE2("shutdown", "shutting down threads complete");
 }
 
+static void print_thin_monitor_stats() {
+    hythread_thin_monitor_stats_t stats;
+    hythread_thin_monitor_get_stats(&stats);
+    printf("Thin monitors: %" FMT64 "u spins (%" FMT64 "u acquired, %" FMT64 "u pauses), "
+        "%" FMT64 "u yields, %" FMT64 "u inflations\n",
+        (uint64)stats.spins, (uint64)stats.spin_acquires, (uint64)stats.spin_pauses,
+        (uint64)stats.yields, (uint64)stats.inflations);
+}
+
 /**
  * A native analogue of <code>java.lang.System.execShutdownSequence</code>.
  */
@@ -209,6 +220,12 @@ void exec_native_shutdown_sequence() {
 #ifdef VM_STATS
     VM_Statistics::get_vm_stats().print();
 #endif
+    if (VM_Global_State::loader_env->print_inline_caches) {
+        inline_cache_print_stats();
+    }
+    if (VM_Global_State::loader_env->print_lock_stats) {
+        print_thin_monitor_stats();
+    }
 }
 
 /**
@@ -364,7 +381,9 @@ static IDATA vm_dump_entry_point(void * data) {
     if (status == JNI_OK) {
         // TODO: specify particular VM to notify.
         jvmti_notify_data_dump_request();
+        gc_notify_data_dump_request();
         st_print_all(stdout);
+        alloc_sampler_print(stdout);
         DetachCurrentThread(java_vm);
     }
 
@@ -0,0 +1,205 @@
+/*
+ *  Licensed to the Apache Software Foundation (ASF) under one or more
+ *  contributor license agreements.  See the NOTICE file distributed with
+ *  this work for additional information regarding copyright ownership.
+ *  The ASF licenses this file to You under the Apache License, Version 2.0
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#define LOG_DOMAIN "vm.ic"
+#include "cxxlog.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "open/hythread_ext.h"
+#include "open/vm_ee.h"
+#include "port_barriers.h"
+
+#include "Class.h"
+#include "classloader.h"
+#include "environment.h"
+#include "inline_cache.h"
+#include "vtable.h"
+
+// all the caches, for unloading and statistics
+static Inline_Cache* inline_caches = NULL;
+
+static POINTER_SIZE_INT object_get_vtable_word(ManagedObject* obj)
+{
+#ifdef USE_COMPRESSED_VTABLE_POINTERS
+    return (POINTER_SIZE_INT)obj->vt_offset;
+#else
+    return (POINTER_SIZE_INT)obj->vt_raw;
+#endif
+}
+
+static Class* vtable_word_get_class(POINTER_SIZE_INT vtable)
+{
+    return ManagedObject::allocation_handle_to_vtable((Allocation_Handle)vtable)->clss;
+}
+
+Inline_Cache* inline_cache_create(Method* caller, Class* intfc)
+{
+    Global_Env* env = VM_Global_State::loader_env;
+    if (!env->use_inline_caches) {
+        return NULL;
+    }
+
+    Inline_Cache* ic = (Inline_Cache*)
+        caller->get_class()->get_class_loader()->Alloc(sizeof(Inline_Cache));
+    memset(ic, 0, sizeof(Inline_Cache));
+    ic->intfc = intfc;
+    ic->caller = caller;
+
+    // the lock is also taken by class unloading, so it must not be held
+    // by a thread stopped for the collection
+    hythread_suspend_disable();
+    env->p_inline_cache_lock->_lock();
+    ic->next = inline_caches;
+    inline_caches = ic;
+    env->p_inline_cache_lock->_unlock();
+    hythread_suspend_enable();
+    return ic;
+}
+
+void* inline_cache_miss(ManagedObject* obj, Inline_Cache* ic)
+{
+    POINTER_SIZE_INT vtable = object_get_vtable_word(obj);
+    ic->num_misses++;
+
+    U_32 num_poly = ic->num_poly;
+    for (U_32 i = 0; i < num_poly; i++) {
+        if (ic->poly[i].vtable == vtable) {
+            ic->num_poly_hits++;
+            return ic->poly[i].intfc_vtable;
+        }
+    }
+
+    ic->num_searches++;
+    void* intfc_vtable = Class::helper_get_interface_vtable(obj, ic->intfc);
+    if (intfc_vtable == NULL || ic->state == IC_MEGAMORPHIC) {
+        return intfc_vtable;
+    }
+
+    LMAutoUnlock aulock(VM_Global_State::loader_env->p_inline_cache_lock);
+    Inline_Cache_Entry* entry = NULL;
+    switch (ic->state) {
+    case IC_UNLINKED:
+        entry = &ic->mono;
+        ic->state = IC_MONOMORPHIC;
+        break;
+    case IC_MONOMORPHIC:
+    case IC_POLYMORPHIC:
+        if (ic->mono.vtable == vtable) {
+            // another thread has linked the same receiver
+            break;
+        }
+        for (U_32 i = 0; i < ic->num_poly; i++) {
+            if (ic->poly[i].vtable == vtable) {
+                return intfc_vtable;
+            }
+        }
+        if (ic->num_poly < INLINE_CACHE_POLY_ENTRIES) {
+            entry = &ic->poly[ic->num_poly];
+            ic->state = IC_POLYMORPHIC;
+        } else {
+            TRACE("inline cache " << ic << " of "
+                << ic->caller->get_class()->get_name()->bytes << "."
+                << ic->caller->get_name()->bytes << " goes megamorphic");
+            ic->state = IC_MEGAMORPHIC;
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (entry != NULL) {
+        entry->intfc_vtable = intfc_vtable;
+        port_write_barrier();
+        entry->vtable = vtable;
+        if (entry != &ic->mono) {
+            port_write_barrier();
+            ic->num_poly++;
+        }
+    }
+    return intfc_vtable;
+}
+
+static void inline_cache_clear_entry(Inline_Cache* ic, Inline_Cache_Entry* entry, ClassLoader* cl)
+{
+    if (entry->vtable != 0 && vtable_word_get_class(entry->vtable)->get_class_loader() == cl) {
+        entry->vtable = 0;
+        entry->intfc_vtable = NULL;
+        // the freed slot is not reused, the same address may be taken by another vtable
+        ic->state = IC_MEGAMORPHIC;
+    }
+}
+
+void inline_cache_class_loader_unloading(ClassLoader* cl)
+{
+    LMAutoUnlock aulock(VM_Global_State::loader_env->p_inline_cache_lock);
+    Inline_Cache** link = &inline_caches;
+    while (*link != NULL) {
+        Inline_Cache* ic = *link;
+        if (ic->caller->get_class()->get_class_loader() == cl) {
+            // the memory is released with the class loader
+            *link = ic->next;
+            continue;
+        }
+        inline_cache_clear_entry(ic, &ic->mono, cl);
+        for (U_32 i = 0; i < ic->num_poly; i++) {
+            inline_cache_clear_entry(ic, &ic->poly[i], cl);
+        }
+        link = &ic->next;
+    }
+}
+
+static const char* inline_cache_state_name(U_32 state)
+{
+    switch (state) {
+    case IC_UNLINKED:     return "unlinked";
+    case IC_MONOMORPHIC:  return "monomorphic";
+    case IC_POLYMORPHIC:  return "polymorphic";
+    case IC_MEGAMORPHIC:  return "megamorphic";
+    default:              return "unknown";
+    }
+}
+
+void inline_cache_print_stats()
+{
+    hythread_suspend_disable();
+    VM_Global_State::loader_env->p_inline_cache_lock->_lock();
+    U_32 num_caches[IC_MEGAMORPHIC + 1] = {0};
+
+    printf("Inline caches: state, receiver types, misses, polymorphic hits, interface table searches\n");
+    for (Inline_Cache* ic = inline_caches; ic != NULL; ic = ic->next) {
+        num_caches[ic->state]++;
+        U_32 num_types = (ic->mono.vtable != 0 ? 1 : 0) + ic->num_poly;
+        printf("%s.%s%s -> %s: %s %u %u %u %u\n",
+            ic->caller->get_class()->get_name()->bytes,
+            ic->caller->get_name()->bytes,
+            ic->caller->get_descriptor()->bytes,
+            ic->intfc->get_name()->bytes,
+            inline_cache_state_name(ic->state), num_types,
+            ic->num_misses, ic->num_poly_hits, ic->num_searches);
+    }
+    printf("Inline caches total: %u unlinked, %u monomorphic, %u polymorphic, %u megamorphic\n",
+        num_caches[IC_UNLINKED], num_caches[IC_MONOMORPHIC],
+        num_caches[IC_POLYMORPHIC], num_caches[IC_MEGAMORPHIC]);
+    VM_Global_State::loader_env->p_inline_cache_lock->_unlock();
+    hythread_suspend_enable();
+}
+
+void* vm_create_interface_call_cache(Method_Handle caller, Class_Handle intfc)
+{
+    return inline_cache_create((Method*)caller, (Class*)intfc);
+}
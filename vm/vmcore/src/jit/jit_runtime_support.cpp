@@ -49,6 +49,7 @@
 #include "compile.h"
 
 #include "dump.h"
+#include "inline_cache.h"
 #include "vm_stats.h"
 #include "port_threadunsafe.h"
 
@@ -661,12 +662,20 @@ static void* rth_get_interface_vtable(ManagedObject* obj, Class* iid)
 }
 
 // Get interface vtable helper
+// The interface is looked up in the hash of the interface table of the object class
 static NativeCodePtr rth_get_lil_get_interface_vtable(int* dyn_count)
 {
     static NativeCodePtr addr = NULL;
 
     if (!addr) {
-        void* (*p_get_ivtable)(ManagedObject*, Class*) = rth_get_interface_vtable;
+        const POINTER_SIZE_INT vtable_add = vm_is_vtable_compressed() ? (POINTER_SIZE_INT)vm_get_vtable_base_address() : 0;
+        const POINTER_SIZE_INT intfc_table_off = (POINTER_SIZE_INT)&((VTable*)NULL)->intfc_table;
+        unsigned entry_shift = 0;
+        while (((unsigned)1 << entry_shift) < sizeof(Intfc_Table_Entry)) {
+            entry_shift++;
+        }
+        assert(((unsigned)1 << entry_shift) == sizeof(Intfc_Table_Entry));
+
         LilCodeStub* cs = lil_parse_code_stub("entry 0:stdcall:ref,pint:pint;");
         assert(cs);
         if (dyn_count) {
@@ -674,22 +683,107 @@ static NativeCodePtr rth_get_lil_get_interface_vtable(int* dyn_count)
             assert(cs);
         }
         cs = lil_parse_onto_end(cs,
-            "jc i0=%0i:ref,null;"
+            "locals 4;"
+            "jc i0=%0i:ref,null;",
+            VM_Global_State::loader_env->managed_null);
+        assert(cs);
+        cs = lil_parse_onto_end(cs,
+            vm_is_vtable_compressed() ? "ld l0,[i0+%0i:g4],zx;" : "ld l0,[i0+%0i:pint];",
+            object_get_vtable_offset());
+        assert(cs);
+        // l0 = hash slots, l1 = slot index, l2 = hash mask
+        cs = lil_parse_onto_end(cs,
+            "ld l0,[l0+%0i:pint];"
+            "ld l2,[l0+%1i:g4],zx;"
+            "ld l0,[l0+%2i:pint];"
+            "ld l1,[i1+%3i:g4],zx;"
+            "l1=l1&l2;"
+            ":probe;"
+            "l3=l1:pint<<%4i;"
+            "l3=l0+l3;"
+            "ld l3,[l3+%5i:pint];"
+            "jc l3=i1,found;"
+            "jc l3=0,notfound;"
+            "l1=l1+1;"
+            "l1=l1&l2;"
+            "j probe;"
+            ":found;"
+            "l3=l1:pint<<%6i;"
+            "l3=l0+l3;"
+            "ld l3,[l3+%7i:pint];"
+            "r=l3;"
+            "ret;"
+            ":notfound;"
+            "tailcall %8i;"
+            ":null;"
+            "r=0;"
+            "ret;",
+            vtable_add+intfc_table_off,
+            (POINTER_SIZE_INT)OFFSET(Intfc_Table, hash_mask),
+            (POINTER_SIZE_INT)OFFSET(Intfc_Table, hash),
+            (POINTER_SIZE_INT)Class::get_offset_of_id(),
+            (POINTER_SIZE_INT)entry_shift,
+            (POINTER_SIZE_INT)OFFSET(Intfc_Table_Entry, intfc_class),
+            (POINTER_SIZE_INT)entry_shift,
+            (POINTER_SIZE_INT)OFFSET(Intfc_Table_Entry, table),
+            lil_npc_to_fp(exn_get_rth_throw_incompatible_class_change_exception()));
+        assert(cs && lil_is_valid(cs));
+        addr = LilCodeGenerator::get_platform()->compile(cs);
+
+        DUMP_STUB(addr, "rth_get_interface_vtable", lil_cs_get_code_size(cs));
+
+        lil_free_code_stub(cs);
+    }
+
+    return addr;
+}
+
+// Get interface vtable through the inline cache of the call site
+// The monomorphic entry is checked in the stub, the rest is up to inline_cache_miss
+static NativeCodePtr rth_get_lil_get_interface_vtable_ic(int* dyn_count)
+{
+    static NativeCodePtr addr = NULL;
+
+    if (!addr) {
+        void* (*p_ic_miss)(ManagedObject*, Inline_Cache*) = inline_cache_miss;
+        LilCodeStub* cs = lil_parse_code_stub("entry 0:stdcall:ref,pint:pint;");
+        assert(cs);
+        if (dyn_count) {
+            cs = lil_parse_onto_end(cs, "inc [%0i:pint];", dyn_count);
+            assert(cs);
+        }
+        cs = lil_parse_onto_end(cs,
+            "locals 2;"
+            "jc i0=%0i:ref,null;",
+            VM_Global_State::loader_env->managed_null);
+        assert(cs);
+        cs = lil_parse_onto_end(cs,
+            vm_is_vtable_compressed() ? "ld l0,[i0+%0i:g4],zx;" : "ld l0,[i0+%0i:pint];",
+            object_get_vtable_offset());
+        assert(cs);
+        cs = lil_parse_onto_end(cs,
+            "ld l1,[i1+%0i:pint];"
+            "jc l0!=l1,miss;"
+            "ld l1,[i1+%1i:pint];"
+            "r=l1;"
+            "ret;"
+            ":miss;"
             "in2out platform:pint;"
-            "call %1i;"
+            "call %2i;"
             "jc r=0,notfound;"
             "ret;"
             ":notfound;"
-            "tailcall %2i;"
+            "tailcall %3i;"
             ":null;"
             "r=0;"
             "ret;",
-            VM_Global_State::loader_env->managed_null, p_get_ivtable,
+            OFFSET(Inline_Cache, mono.vtable), OFFSET(Inline_Cache, mono.intfc_vtable),
+            p_ic_miss,
             lil_npc_to_fp(exn_get_rth_throw_incompatible_class_change_exception()));
         assert(cs && lil_is_valid(cs));
         addr = LilCodeGenerator::get_platform()->compile(cs);
 
-        DUMP_STUB(addr, "rth_get_interface_vtable", lil_cs_get_code_size(cs));
+        DUMP_STUB(addr, "rth_get_interface_vtable_ic", lil_cs_get_code_size(cs));
 
         lil_free_code_stub(cs);
     }
@@ -1690,6 +1784,8 @@ NativeCodePtr rth_get_lil_helper(VM_RT_SUPPORT f)
     // Misc
     case VM_RT_GET_INTERFACE_VTABLE_VER0:
         return rth_get_lil_get_interface_vtable(dyn_count);
+    case VM_RT_GET_INTERFACE_VTABLE_IC:
+        return rth_get_lil_get_interface_vtable_ic(dyn_count);
     case VM_RT_INITIALIZE_CLASS:
         return rth_get_lil_initialize_class(dyn_count);
     case VM_RT_GC_SAFE_POINT:
@@ -114,6 +114,10 @@ static JIT_RT_Function_Entry _jit_rt_function_entries_base[] = {
             "org/apache/harmony/drlvm/VMHelperFastPath",   "getInterfaceVTable3",
             "(Lorg/vmmagic/unboxed/Address;Ljava/lang/Object;)Lorg/vmmagic/unboxed/Address;",   NULL},
 
+    {VM_RT_GET_INTERFACE_VTABLE_IC,            "VM_RT_GET_INTERFACE_VTABLE_IC",
+            INTERRUPTIBLE_ALWAYS,              CALLING_CONVENTION_STDCALL,              2,
+            NULL,   NULL,   NULL,   NULL},
+
     {VM_RT_INITIALIZE_CLASS,                   "VM_RT_INITIALIZE_CLASS",
             INTERRUPTIBLE_ALWAYS,              CALLING_CONVENTION_STDCALL,              1,
             NULL,   NULL,   NULL,   NULL},
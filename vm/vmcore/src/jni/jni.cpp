@@ -1420,6 +1420,28 @@ const jchar* JNICALL GetStringCritical(JNIEnv *jni_env, jstring s, jboolean* isC
 {
     TRACE("GetStringCritical called");
     assert(hythread_is_suspend_enabled());
+
+    if (!s || exn_raised()) return NULL;
+
+    assert(check_is_jstring_class(s));
+
+    // Pin the character array to avoid the copy. 
+    // Compressed strings and arrays which GC can't pin are copied as usual.
+    tmn_suspend_disable();       //---------------------------------v
+    unsigned offset;
+    Vector_Handle char_array = string_get_char_array(((ObjectHandle)s)->object, &offset);
+    if (char_array) {
+        gc_pin_object((Managed_Object_Handle*)&char_array);
+        if (gc_is_object_pinned((Managed_Object_Handle)char_array)) {
+            TRACE2("jni.pin", "pinning string chars " << char_array);
+            const jchar* chars = (const jchar*)get_vector_element_address_uint16(char_array, offset);
+            tmn_suspend_enable();        //---------------------------------^
+            if (isCopy) *isCopy = JNI_FALSE;
+            return chars;
+        }
+    }
+    tmn_suspend_enable();        //---------------------------------^
+
     return GetStringChars(jni_env, s, isCopy);
 }
 
@@ -1427,7 +1449,23 @@ void JNICALL ReleaseStringCritical(JNIEnv * jni_env, jstring s, const jchar* cst
 {
     TRACE("ReleaseStringCritical called");
     assert(hythread_is_suspend_enabled());
-    ReleaseStringChars(jni_env, s, cstr);
+
+    if (!s || !cstr) return;
+
+    tmn_suspend_disable();       //---------------------------------v
+    unsigned offset;
+    Vector_Handle char_array = string_get_char_array(((ObjectHandle)s)->object, &offset);
+    bool no_copy = char_array 
+        && (const jchar*)get_vector_element_address_uint16(char_array, offset) == cstr;
+    if (no_copy) {
+        TRACE2("jni.pin", "unpinning string chars " << char_array);
+        gc_unpin_object((Managed_Object_Handle*)&char_array);
+    }
+    tmn_suspend_enable();        //---------------------------------^
+
+    if (!no_copy) {
+        ReleaseStringChars(jni_env, s, cstr);
+    }
 }
 
 VMEXPORT jweak JNICALL NewWeakGlobalRef(JNIEnv * jni_env, jobject obj)
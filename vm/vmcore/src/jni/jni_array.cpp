@@ -332,6 +332,24 @@ jdoubleArray JNICALL NewDoubleArray(JNIEnv * jni_env, jsize length)
 /////////////////////////////////////////////////////////////////////////////
 // begin Get<Type>ArrayElements functions
 
+// Pins the array on behalf of the caller, who is then given a pointer into
+// the heap, and the pin is dropped by Release<Type>ArrayElements.
+// The pin of another holder, e.g. GetStringCritical, is not enough since it
+// can be dropped before the elements are released.
+// GC silently declines to pin some objects, then the elements are copied.
+// An object which is in the pin table was pinnable and stays where it is,
+// so the pin of this call has been taken too.
+static bool pin_array_elements(ObjectHandle h)
+{
+    gc_pin_object((Managed_Object_Handle*)h);
+
+    tmn_suspend_disable();       //---------------------------------v
+    Boolean is_pinned = gc_is_object_pinned((Managed_Object_Handle)h->object);
+    tmn_suspend_enable();        //---------------------------------^
+
+    return is_pinned != FALSE;
+} //pin_array_elements
+
 
 jboolean *JNICALL GetBooleanArrayElements(JNIEnv * jni_env,
                                           jbooleanArray array,
@@ -347,10 +365,9 @@ jboolean *JNICALL GetBooleanArrayElements(JNIEnv * jni_env,
     tmn_suspend_disable();       //---------------------------------v
     Vector_Handle java_array = (Vector_Handle)h->object;
     int length = get_vector_length(java_array);
-    Boolean is_pinned = gc_is_object_pinned((ManagedObject *)java_array);
     tmn_suspend_enable();        //---------------------------------^
 
-    if(is_pinned) {
+    if(pin_array_elements(h)) {
         // No copy needed.
         if(isCopy) {
             *isCopy = JNI_FALSE;
@@ -395,10 +412,9 @@ jbyte *JNICALL GetByteArrayElements(JNIEnv * jni_env,
     tmn_suspend_disable();       //---------------------------------v
     Vector_Handle java_array = (Vector_Handle)h->object;
     int length = get_vector_length(java_array);
-    Boolean is_pinned = gc_is_object_pinned((ManagedObject *)java_array);
     tmn_suspend_enable();        //---------------------------------^
 
-    if(is_pinned) {
+    if(pin_array_elements(h)) {
         // No copy needed.
         if(isCopy) {
             *isCopy = JNI_FALSE;
@@ -443,10 +459,9 @@ jchar *JNICALL GetCharArrayElements(JNIEnv * jni_env,
     tmn_suspend_disable();       //---------------------------------v
     Vector_Handle java_array = (Vector_Handle)h->object;
     int length = get_vector_length(java_array);
-    Boolean is_pinned = gc_is_object_pinned((ManagedObject *)java_array);
     tmn_suspend_enable();        //---------------------------------^
 
-    if(is_pinned) {
+    if(pin_array_elements(h)) {
         // No copy needed.
         if(isCopy) {
             *isCopy = JNI_FALSE;
@@ -491,10 +506,9 @@ jshort *JNICALL GetShortArrayElements(JNIEnv * jni_env,
     tmn_suspend_disable();       //---------------------------------v
     Vector_Handle java_array = (Vector_Handle)h->object;
     int length = get_vector_length(java_array);
-    Boolean is_pinned = gc_is_object_pinned((ManagedObject *)java_array);
     tmn_suspend_enable();        //---------------------------------^
 
-    if(is_pinned) {
+    if(pin_array_elements(h)) {
         // No copy needed.
         if(isCopy) {
             *isCopy = JNI_FALSE;
@@ -538,10 +552,9 @@ jint *JNICALL GetIntArrayElements(JNIEnv * jni_env,
 
     tmn_suspend_disable();       //---------------------------------v
     Vector_Handle java_array = (Vector_Handle)h->object;
-    Boolean is_pinned = gc_is_object_pinned((ManagedObject *)java_array);
     tmn_suspend_enable();        //---------------------------------^
 
-    if(is_pinned) {
+    if(pin_array_elements(h)) {
         // No copy needed.
         if(isCopy) {
             *isCopy = JNI_FALSE;
@@ -588,10 +601,9 @@ jlong *JNICALL GetLongArrayElements(JNIEnv * jni_env,
     tmn_suspend_disable();       //---------------------------------v
     Vector_Handle java_array = (Vector_Handle)h->object;
     int length = get_vector_length(java_array);
-    Boolean is_pinned = gc_is_object_pinned((ManagedObject *)java_array);
     tmn_suspend_enable();        //---------------------------------^
 
-    if(is_pinned) {
+    if(pin_array_elements(h)) {
         // No copy needed.
         if(isCopy) {
             *isCopy = JNI_FALSE;
@@ -635,10 +647,9 @@ jfloat *JNICALL GetFloatArrayElements(JNIEnv * jni_env,
 
     tmn_suspend_disable();       //---------------------------------v
     Vector_Handle java_array = (Vector_Handle)h->object;
-    Boolean is_pinned = gc_is_object_pinned((ManagedObject *)java_array);
     tmn_suspend_enable();        //---------------------------------^
 
-    if(is_pinned) {
+    if(pin_array_elements(h)) {
         // No copy needed.
         if(isCopy) {
             *isCopy = JNI_FALSE;
@@ -685,10 +696,9 @@ jdouble *JNICALL GetDoubleArrayElements(JNIEnv * jni_env,
     tmn_suspend_disable();       //---------------------------------v
     Vector_Handle java_array = (Vector_Handle)h->object;
     int length = get_vector_length(java_array);
-    Boolean is_pinned = gc_is_object_pinned((ManagedObject *)java_array);
     tmn_suspend_enable();        //---------------------------------^
 
-    if(is_pinned) {
+    if(pin_array_elements(h)) {
         // No copy needed.
         if(isCopy) {
             *isCopy = JNI_FALSE;
@@ -749,7 +759,10 @@ void JNICALL ReleaseBooleanArrayElements(JNIEnv * jni_env,
     tmn_suspend_enable();        //---------------------------------^
 
     if(no_copy) {
-        // Nothing to do.
+        // The array was pinned by Get<Type>ArrayElements.
+        if(mode != JNI_COMMIT) {
+            gc_unpin_object((Managed_Object_Handle*)h);
+        }
         return;
     }
 
@@ -803,7 +816,10 @@ void JNICALL ReleaseByteArrayElements(JNIEnv * jni_env,
     tmn_suspend_enable();        //---------------------------------^
 
     if(no_copy) {
-        // Nothing to do.
+        // The array was pinned by Get<Type>ArrayElements.
+        if(mode != JNI_COMMIT) {
+            gc_unpin_object((Managed_Object_Handle*)h);
+        }
         return;
     }
 
@@ -856,7 +872,10 @@ void JNICALL ReleaseCharArrayElements(JNIEnv * jni_env,
     tmn_suspend_enable();        //---------------------------------^
 
     if(no_copy) {
-        // Nothing to do.
+        // The array was pinned by Get<Type>ArrayElements.
+        if(mode != JNI_COMMIT) {
+            gc_unpin_object((Managed_Object_Handle*)h);
+        }
         return;
     }
 
@@ -910,7 +929,10 @@ void JNICALL ReleaseShortArrayElements(JNIEnv * jni_env,
     tmn_suspend_enable();        //---------------------------------^
 
     if(no_copy) {
-        // Nothing to do.
+        // The array was pinned by Get<Type>ArrayElements.
+        if(mode != JNI_COMMIT) {
+            gc_unpin_object((Managed_Object_Handle*)h);
+        }
         return;
     }
 
@@ -964,7 +986,10 @@ void JNICALL ReleaseIntArrayElements(JNIEnv * jni_env,
     tmn_suspend_enable();        //---------------------------------^
 
     if(no_copy) {
-        // Nothing to do.
+        // The array was pinned by Get<Type>ArrayElements.
+        if(mode != JNI_COMMIT) {
+            gc_unpin_object((Managed_Object_Handle*)h);
+        }
         return;
     }
 
@@ -1018,7 +1043,10 @@ void JNICALL ReleaseLongArrayElements(JNIEnv * jni_env,
     tmn_suspend_enable();        //---------------------------------^
 
     if(no_copy) {
-        // Nothing to do.
+        // The array was pinned by Get<Type>ArrayElements.
+        if(mode != JNI_COMMIT) {
+            gc_unpin_object((Managed_Object_Handle*)h);
+        }
         return;
     }
 
@@ -1072,7 +1100,10 @@ void JNICALL ReleaseFloatArrayElements(JNIEnv * jni_env,
     tmn_suspend_enable();        //---------------------------------^
 
     if(no_copy) {
-        // Nothing to do.
+        // The array was pinned by Get<Type>ArrayElements.
+        if(mode != JNI_COMMIT) {
+            gc_unpin_object((Managed_Object_Handle*)h);
+        }
         return;
     }
 
@@ -1127,7 +1158,10 @@ void JNICALL ReleaseDoubleArrayElements(JNIEnv * jni_env,
     tmn_suspend_enable();        //---------------------------------^
 
     if(no_copy) {
-        // Nothing to do.
+        // The array was pinned by Get<Type>ArrayElements.
+        if(mode != JNI_COMMIT) {
+            gc_unpin_object((Managed_Object_Handle*)h);
+        }
         return;
     }
 
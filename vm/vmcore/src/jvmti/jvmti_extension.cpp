@@ -54,6 +54,36 @@ static jvmtiError jvmtiGetNCAIEnvironmentErrors[] =
     JVMTI_ERROR_NONE,
 };
 
+static jvmtiParamInfo jvmtiDumpHeapParams[] =
+{
+    {
+        const_cast<char*>("file_name"),
+        JVMTI_KIND_IN_BUF,
+        JVMTI_TYPE_CCHAR,
+        JNI_TRUE
+    }
+};
+
+static jvmtiError jvmtiDumpHeapErrors[] =
+{ // Universal errors are excluded according to specification
+    JVMTI_ERROR_NOT_AVAILABLE,
+};
+
+static jvmtiParamInfo jvmtiPrintClassHistogramParams[] =
+{
+    {
+        const_cast<char*>("file_name"),
+        JVMTI_KIND_IN_BUF,
+        JVMTI_TYPE_CCHAR,
+        JNI_TRUE
+    }
+};
+
+static jvmtiError jvmtiPrintClassHistogramErrors[] =
+{ // Universal errors are excluded according to specification
+    JVMTI_ERROR_NOT_AVAILABLE,
+};
+
 static JvmtiExtension jvmti_extension_list[] =
 {
     {
@@ -67,6 +97,30 @@ static JvmtiExtension jvmti_extension_list[] =
             sizeof(jvmtiGetNCAIEnvironmentErrors) / sizeof(jvmtiError),
             jvmtiGetNCAIEnvironmentErrors
         }
+    },
+    {
+        NULL,
+        {
+            jvmtiDumpHeap,
+            const_cast<char*>("org.apache.harmony.vm.DumpHeap"),
+            const_cast<char*>("Writes the live objects to a file in the HPROF binary format"),
+            sizeof(jvmtiDumpHeapParams) / sizeof(jvmtiParamInfo),
+            jvmtiDumpHeapParams,
+            sizeof(jvmtiDumpHeapErrors) / sizeof(jvmtiError),
+            jvmtiDumpHeapErrors
+        }
+    },
+    {
+        NULL,
+        {
+            jvmtiPrintClassHistogram,
+            const_cast<char*>("org.apache.harmony.vm.PrintClassHistogram"),
+            const_cast<char*>("Prints the number of live objects and their bytes for every class"),
+            sizeof(jvmtiPrintClassHistogramParams) / sizeof(jvmtiParamInfo),
+            jvmtiPrintClassHistogramParams,
+            sizeof(jvmtiPrintClassHistogramErrors) / sizeof(jvmtiError),
+            jvmtiPrintClassHistogramErrors
+        }
     }
 
 };
@@ -146,10 +200,9 @@ jvmtiGetExtensionFunctions(jvmtiEnv* env,
 
     memset(array, 0, arr_size);
 
-    JvmtiExtension *ex = jvmti_extension_list;
     for (int iii = 0; iii < extensions_number; iii++)
     {
-        jvmtiExtensionFunctionInfo *info = &ex->info;
+        jvmtiExtensionFunctionInfo *info = &jvmti_extension_list[iii].info;
 
         array[iii].func = info->func;
         array[iii].param_count = info->param_count;
@@ -210,8 +263,6 @@ jvmtiGetExtensionFunctions(jvmtiEnv* env,
         strcpy(array[iii].short_description, info->short_description);
         memcpy(array[iii].errors, info->errors,
             info->error_count * sizeof(jvmtiError));
-
-        ex = ex->next;
     }
 
     *extensions = array;
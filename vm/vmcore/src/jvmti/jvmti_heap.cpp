@@ -170,6 +170,73 @@ jvmtiForceGarbageCollection(jvmtiEnv* env)
     return JVMTI_ERROR_NONE;
 }
 
+/*
+ * Dump Heap
+ *
+ * Extension function org.apache.harmony.vm.DumpHeap. Writes the live
+ * objects of the heap to a file in the HPROF binary format, the GC
+ * chooses the file name if it's NULL. This function does not return
+ * until the dump is written.
+ */
+jvmtiError JNICALL
+jvmtiDumpHeap(jvmtiEnv* env, ...)
+{
+    TRACE2("jvmti.heap", "DumpHeap called");
+    SuspendEnabledChecker sec;
+
+    va_list args;
+    va_start(args, env);
+    // DumpHeap function has following prototype:
+    // DumpHeap(jvmtiEnv* jvmti_env, const char* file_name);
+    const char* file_name = va_arg(args, const char*);
+    va_end(args);
+
+    /*
+     * Check given env & current phase.
+     */
+    jvmtiPhase phases[] = {JVMTI_PHASE_LIVE};
+
+    CHECK_EVERYTHING();
+
+    if (!gc_dump_heap(file_name))
+        return JVMTI_ERROR_NOT_AVAILABLE;
+
+    return JVMTI_ERROR_NONE;
+}
+
+/*
+ * Print Class Histogram
+ *
+ * Extension function org.apache.harmony.vm.PrintClassHistogram. Prints
+ * the number of live objects and their bytes for every class to a file,
+ * or to the standard output if the file name is NULL.
+ */
+jvmtiError JNICALL
+jvmtiPrintClassHistogram(jvmtiEnv* env, ...)
+{
+    TRACE2("jvmti.heap", "PrintClassHistogram called");
+    SuspendEnabledChecker sec;
+
+    va_list args;
+    va_start(args, env);
+    // PrintClassHistogram function has following prototype:
+    // PrintClassHistogram(jvmtiEnv* jvmti_env, const char* file_name);
+    const char* file_name = va_arg(args, const char*);
+    va_end(args);
+
+    /*
+     * Check given env & current phase.
+     */
+    jvmtiPhase phases[] = {JVMTI_PHASE_LIVE};
+
+    CHECK_EVERYTHING();
+
+    if (!gc_print_class_histogram(file_name))
+        return JVMTI_ERROR_NOT_AVAILABLE;
+
+    return JVMTI_ERROR_NONE;
+}
+
 static jvmtiError allocate_iteration_state(TIEnv* ti_env)
 {
     assert(NULL == ti_env->iteration_state);
@@ -25,7 +25,9 @@ class EMThreadSupport {
 	private static boolean active = false;
 	private static int timeout = 0;
 	private static Thread profilerThread = null;
+	private static Thread[] compilationThreads = null;
     static void initialize() {
+		startCompilationThreads();
 		boolean needThreadsSuport = needProfilerThreadSupport();
 		if (!needThreadsSuport) {
 			return;
@@ -48,6 +50,24 @@ class EMThreadSupport {
 		profilerThread.start();
 	}
 
+	private static void startCompilationThreads() {
+		int n = getCompilationThreads();
+		if (n <= 0) {
+			return;
+		}
+		Runnable compilationWorker = new Runnable() {
+			public void run() {
+				runCompilationThread();
+			}
+		};
+		compilationThreads = new Thread[n];
+		for (int i = 0; i < n; i++) {
+			compilationThreads[i] = new Thread(Thread.systemThreadGroup, compilationWorker, "compilation thread " + i);
+			compilationThreads[i].setDaemon(true);
+			compilationThreads[i].start();
+		}
+	}
+
 
     static void shutdown() {
 		active = false;
@@ -58,6 +78,12 @@ class EMThreadSupport {
 			if(profilerThread != null) {
 				profilerThread.join();
 			}
+			if(compilationThreads != null) {
+				shutdownCompilationThreads();
+				for (int i = 0; i < compilationThreads.length; i++) {
+					compilationThreads[i].join();
+				}
+			}
 		} catch (InterruptedException e) {
 		}
 	}
@@ -84,5 +110,11 @@ class EMThreadSupport {
 
 	private static native int getTimeout();
 
+	private static native int getCompilationThreads();
+
+	private static native void runCompilationThread();
+
+	private static native void shutdownCompilationThreads();
+
 
 }
@@ -25,11 +25,25 @@ package java.lang.ref;
  */
 public class SoftReference<T> extends Reference<T> {
 
+    /*
+     * The time of the last garbage collection, in milliseconds. It is
+     * updated by the GC, which finds the field by its name.
+     */
+	private static long clock;
+
+    /*
+     * The clock when the reference was created or last read with get().
+     * The GC keeps the referent of a recently used reference alive, see
+     * the gc.softref_lru_ms_per_mb option.
+     */
+	private long timestamp;
+
     /**
      * @com.intel.drl.spec_ref 
      */
 	public SoftReference(T referent) {
 		super(referent);
+		timestamp = clock;
 	}
 
     /**
@@ -37,12 +51,18 @@ public class SoftReference<T> extends Reference<T> {
      */
 	public SoftReference(T referent, ReferenceQueue<? super T> q) {
 		super(referent, q);
+		timestamp = clock;
 	}
 
     /**
      * @com.intel.drl.spec_ref 
      */
 	public T get() {
-		return super.get();
+		T referent = super.get();
+		/* don't dirty the object if nothing has changed */
+		if (timestamp != clock) {
+			timestamp = clock;
+		}
+		return referent;
 	}
 }
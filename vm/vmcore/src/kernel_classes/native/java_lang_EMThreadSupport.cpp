@@ -58,4 +58,27 @@ Java_java_lang_EMThreadSupport_getTimeout(JNIEnv *jenv, jclass cls)
 }
 
 
+JNIEXPORT jint JNICALL 
+Java_java_lang_EMThreadSupport_getCompilationThreads(JNIEnv *jenv, jclass cls) 
+{
+    const char* threads_string = VM_Global_State::loader_env->em_component->
+        GetProperty(OPEN_EM_VM_COMPILATION_THREADS);
+    return threads_string == NULL ? 0 : atoi(threads_string);
+}
+
+
+JNIEXPORT void JNICALL 
+Java_java_lang_EMThreadSupport_runCompilationThread(JNIEnv *jenv, jclass cls) 
+{
+    return VM_Global_State::loader_env->em_interface->CompilationThreadRun();
+}
+
+
+JNIEXPORT void JNICALL 
+Java_java_lang_EMThreadSupport_shutdownCompilationThreads(JNIEnv *jenv, jclass cls) 
+{
+    return VM_Global_State::loader_env->em_interface->CompilationThreadsShutdown();
+}
+
+
 
@@ -58,6 +58,24 @@ Java_java_lang_EMThreadSupport_onTimeout(JNIEnv *, jclass);
 JNIEXPORT jint JNICALL
 Java_java_lang_EMThreadSupport_getTimeout(JNIEnv *, jclass);
 
+/*
+ * Method: java.lang.EMThreadSupport.getCompilationThreads()I
+ */
+JNIEXPORT jint JNICALL
+Java_java_lang_EMThreadSupport_getCompilationThreads(JNIEnv *, jclass);
+
+/*
+ * Method: java.lang.EMThreadSupport.runCompilationThread()V
+ */
+JNIEXPORT void JNICALL
+Java_java_lang_EMThreadSupport_runCompilationThread(JNIEnv *, jclass);
+
+/*
+ * Method: java.lang.EMThreadSupport.shutdownCompilationThreads()V
+ */
+JNIEXPORT void JNICALL
+Java_java_lang_EMThreadSupport_shutdownCompilationThreads(JNIEnv *, jclass);
+
 
 #ifdef __cplusplus
 }
@@ -672,7 +672,7 @@ LilCodeStub* oh_gen_init_handle(LilCodeStub* cs, const char* base_var, unsigned
     if (null_check && REFS_IS_COMPRESSED_MODE) {
         sprintf(buf,
                 "jc %s=0x%"PI_FMT"X:ref,%%n; st [%s+%"PI_FMT"d:ref],%s; j %%o; :%%g; st [%s+%"PI_FMT"d:ref],0; :%%g;",
-                val, (POINTER_SIZE_INT)VM_Global_State::loader_env->heap_base,
+                val, (POINTER_SIZE_INT)VM_Global_State::loader_env->managed_null,
                 base_var, offset,
                 val, base_var, offset);
     } else {
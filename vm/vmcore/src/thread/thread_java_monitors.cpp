@@ -91,6 +91,12 @@ IDATA VMCALL jthread_monitor_enter(jobject monitor)
     }
 #endif //LOCK_RESERVATION
 
+    // the lock is often released shortly, spin before blocking
+    status = hythread_thin_monitor_spin_enter(lockword);
+    if (status != TM_ERROR_EBUSY) {
+        goto entered;
+    }
+
     native_thread = hythread_self();
     hythread_thread_lock(native_thread);
     state = hythread_get_state(native_thread);
@@ -130,7 +136,7 @@ IDATA VMCALL jthread_monitor_enter(jobject monitor)
             }
             goto contended_entered;
         }
-        hythread_yield();
+        hythread_thin_monitor_yield();
     }
     assert(status == TM_ERROR_NONE);
     if (!hythread_is_fat_lock(*lockword)) {
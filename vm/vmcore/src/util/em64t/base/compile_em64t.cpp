@@ -150,12 +150,12 @@ void compile_protect_arguments(Method_Handle method, GcFrame * gc) {
 }
 
 // Convert a reference, if null, from a managed null
-// (represented by heap_base) to an unmanaged one (NULL/0). Uses %rdi.
+// (represented by managed_null) to an unmanaged one (NULL/0). Uses %rdi.
 char * gen_convert_managed_to_unmanaged_null_em64t(char * ss,
                                                   const R_Opnd & input_param1) {
 #ifdef REFS_RUNTIME_OR_COMPRESSED
     REFS_RUNTIME_SWITCH_IF
-        ss = mov(ss, r11_opnd, Imm_Opnd(size_64, (int64)VM_Global_State::loader_env->heap_base));
+        ss = mov(ss, r11_opnd, Imm_Opnd(size_64, (int64)VM_Global_State::loader_env->managed_null));
         ss = alu(ss, cmp_opc, input_param1, r11_opnd, size_64);
         ss = branch8(ss, Condition_NE, Imm_Opnd(size_8, 0));  // not null, branch around the mov 0
         char *backpatch_address__not_managed_null = ((char *)ss) - 1;
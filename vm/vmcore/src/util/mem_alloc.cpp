@@ -124,7 +124,7 @@ PoolDescriptor* PoolManager::allocate_pool_storage(size_t size)
          mem_protection |= PORT_VMEM_MODE_EXECUTE;
     }
 
-    size_t ps = (!_is_code && _use_large_pages) ?
+    size_t ps = _use_large_pages ?
          PORT_VMEM_PAGESIZE_LARGE : PORT_VMEM_PAGESIZE_DEFAULT;
 
     apr_status_t status = port_vmem_reserve(&pDesc->_descriptor, &pool_storage,
@@ -247,7 +247,7 @@ VirtualMemoryPool::VirtualMemoryPool(size_t initial_size,
     if (_is_code)
          mem_protection |= PORT_VMEM_MODE_EXECUTE;
 
-    size_t ps = (!_is_code && _use_large_pages) ?
+    size_t ps = _use_large_pages ?
          PORT_VMEM_PAGESIZE_LARGE : PORT_VMEM_PAGESIZE_DEFAULT;
 
     apr_status_t status = port_vmem_reserve(&_vmem, (void**) &_base, _reserved,
@@ -428,6 +428,16 @@ static void string_get_buffer(ManagedObject* str, StringBuffer* buf)
     }
 }
 
+Vector_Handle string_get_char_array(ManagedObject* str, unsigned* offset)
+{
+    if (f_value_char_offset == 0) init_fields();
+    assert(f_value_char_offset);
+
+    U_8* str_raw = (U_8*)str;
+    *offset = *(U_32*)(str_raw + f_offset_offset);
+    return get_raw_reference_pointer((ManagedObject**)(str_raw+f_value_char_offset));
+}
+
 // GC must be disabled
 // result is zero terminated
 // Caller should free the result